@@ -0,0 +1,159 @@
+#ifndef MATH_AABB_H_
+#define MATH_AABB_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <ostream>
+#include "math/frustum.h"
+#include "math/matrix.h"
+#include "math/parallel.h"
+#include "math/vector_float.h"
+
+
+namespace math {
+
+// aabb is the axis-aligned box of the points p for which min <= p <= max holds in every component.
+// The box is empty if min > max in any component. aabb::empty is the bounds of no points,
+// merging it with any box or point leaves the latter unchanged.
+struct aabb final {
+	// min = +FLT_MAX, max = -FLT_MAX.
+	static const aabb empty;
+
+
+	constexpr aabb() noexcept = default;
+
+	constexpr aabb(const float3& min, const float3& max) noexcept : min(min), max(max) {}
+
+
+	float3 min;
+	float3 max;
+};
+
+
+inline bool operator==(const aabb& l, const aabb& r) noexcept
+{
+	return (l.min == r.min) && (l.max == r.max);
+}
+
+inline bool operator!=(const aabb& l, const aabb& r) noexcept
+{
+	return !(l == r);
+}
+
+std::ostream& operator<<(std::ostream& out, const aabb& b);
+
+std::wostream& operator<<(std::wostream& out, const aabb& b);
+
+// Returns true if the min and the max corners of l and r differ by no more than max_abs_diff in every component.
+inline bool approx_equal(const aabb& l, const aabb& r, float max_abs_diff = 1e-5f) noexcept
+{
+	return approx_equal(l.min, r.min, max_abs_diff) && approx_equal(l.max, r.max, max_abs_diff);
+}
+
+// Returns true if the box contains no points.
+inline bool is_empty(const aabb& b) noexcept
+{
+	return (b.min.x > b.max.x) || (b.min.y > b.max.y) || (b.min.z > b.max.z);
+}
+
+// Returns the center of the non-empty box.
+inline float3 center(const aabb& b) noexcept
+{
+	assert(!is_empty(b));
+	return 0.5f * (b.min + b.max);
+}
+
+// Returns the half size of the non-empty box: b = [center(b) - extent(b), center(b) + extent(b)].
+inline float3 extent(const aabb& b) noexcept
+{
+	assert(!is_empty(b));
+	return 0.5f * (b.max - b.min);
+}
+
+// Returns the surface area of the non-empty box.
+inline float surface_area(const aabb& b) noexcept
+{
+	assert(!is_empty(b));
+	const float3 d = b.max - b.min;
+	return 2.0f * ((d.x * d.y) + (d.y * d.z) + (d.z * d.x));
+}
+
+// Returns true if the point p is inside the box or on its boundary.
+inline bool contains(const aabb& b, const float3& p) noexcept
+{
+	return (b.min.x <= p.x) && (p.x <= b.max.x)
+		&& (b.min.y <= p.y) && (p.y <= b.max.y)
+		&& (b.min.z <= p.z) && (p.z <= b.max.z);
+}
+
+// Returns true if the boxes have at least one common point, touching boxes intersect.
+inline bool intersects(const aabb& l, const aabb& r) noexcept
+{
+	return (l.min.x <= r.max.x) && (r.min.x <= l.max.x)
+		&& (l.min.y <= r.max.y) && (r.min.y <= l.max.y)
+		&& (l.min.z <= r.max.z) && (r.min.z <= l.max.z);
+}
+
+// Returns true if the box is not completely outside any of the frustum planes, see intersects(f, min, max).
+inline bool intersects(const frustum& f, const aabb& b) noexcept
+{
+	return intersects(f, b.min, b.max);
+}
+
+// Returns the common part of the boxes, it is empty if the boxes do not intersect.
+inline aabb intersection(const aabb& l, const aabb& r) noexcept
+{
+	return aabb(
+		float3(std::max(l.min.x, r.min.x), std::max(l.min.y, r.min.y), std::max(l.min.z, r.min.z)),
+		float3(std::min(l.max.x, r.max.x), std::min(l.max.y, r.max.y), std::min(l.max.z, r.max.z)));
+}
+
+// Returns the smallest box which contains both boxes (their union).
+inline aabb merge(const aabb& l, const aabb& r) noexcept
+{
+	return aabb(
+		float3(std::min(l.min.x, r.min.x), std::min(l.min.y, r.min.y), std::min(l.min.z, r.min.z)),
+		float3(std::max(l.max.x, r.max.x), std::max(l.max.y, r.max.y), std::max(l.max.z, r.max.z)));
+}
+
+// Returns the smallest box which contains the box b and the point p.
+inline aabb merge(const aabb& b, const float3& p) noexcept
+{
+	return merge(b, aabb(p, p));
+}
+
+// Returns the bounds of the box b transformed by the affine matrix m.
+// Rather than transforming the 8 corners, the center is transformed as a point and the extent
+// by the absolute values of the 3x3 part of m: the result is the bounds of the 8 transformed corners (up to rounding).
+// The transformed empty box is empty.
+inline aabb transform(const float3x4& m, const aabb& b) noexcept
+{
+	if (is_empty(b)) return aabb::empty;
+
+	const float3 c = transform_point(m, center(b));
+	const float3 e = extent(b);
+	const float3 te(
+		(std::abs(m.m00) * e.x) + (std::abs(m.m01) * e.y) + (std::abs(m.m02) * e.z),
+		(std::abs(m.m10) * e.x) + (std::abs(m.m11) * e.y) + (std::abs(m.m12) * e.z),
+		(std::abs(m.m20) * e.x) + (std::abs(m.m21) * e.y) + (std::abs(m.m22) * e.z));
+
+	return aabb(c - te, c + te);
+}
+
+// As above, m is expected to be affine, its last row is ignored.
+inline aabb transform(const float4x4& m, const aabb& b) noexcept
+{
+	return transform(float3x4(m), b);
+}
+
+
+// Returns the bounds of the points, aabb::empty if count is 0.
+// If pool is not nullptr large inputs are split into ranges which are reduced on its threads.
+// The implementation is chosen at run time (see math/dispatch.h).
+aabb bounds(const float3* points, size_t count, thread_pool* pool = nullptr);
+
+} // namespace math
+
+#endif // MATH_AABB_H_
@@ -0,0 +1,290 @@
+#ifndef MATH_BVH_H_
+#define MATH_BVH_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "math/aabb.h"
+#include "math/parallel.h"
+#include "math/ray.h"
+#include "math/vector_float.h"
+
+
+namespace math {
+
+// bvh is a bounding volume hierarchy of primitives given by their bounds (triangles, spheres, objects, ...).
+// It answers the ray and the box queries in about O(log(n)) instead of testing every primitive.
+//
+// The hierarchy is built with the binned surface area heuristic. Every node has up to 4 children whose
+// bounds are stored as a structure of arrays, so a ray is tested against all of them at once.
+// A child is either a node or a leaf: a range of up to max_leaf_size primitive indices.
+// The nodes are stored in a flat array, the root is node 0 and the children follow their parents.
+//
+// The queries call the caller's function for the primitives of the leaves the query reaches,
+// bvh itself knows the primitives only by their indices.
+class bvh final {
+public:
+
+	// The number of children of a node.
+	static constexpr size_t width = 4;
+
+	// The maximum number of primitives of a leaf.
+	static constexpr size_t max_leaf_size = 4;
+
+	// The nodes deeper than that split their primitives at the median rather than by the heuristic,
+	// which limits the depth of the hierarchy (see stack_size).
+	static constexpr size_t max_sah_depth = 32;
+
+	// children[k] of an unused child slot.
+	static constexpr uint32_t empty_slot = UINT32_MAX;
+
+	struct node final {
+		// The bounds of the children.
+		float min_x[width];
+		float min_y[width];
+		float min_z[width];
+		float max_x[width];
+		float max_y[width];
+		float max_z[width];
+		// The index of the child node if counts[k] is 0, otherwise the leaf of the counts[k] primitives
+		// primitive_indices()[children[k]], ..., primitive_indices()[children[k] + counts[k] - 1].
+		uint32_t children[width];
+		uint32_t counts[width];
+	};
+
+
+	bvh() noexcept = default;
+
+	// Builds the hierarchy of count primitives, bounds[i] is the bounds of the primitive i.
+	// If pool is not nullptr the binning of the large ranges and the building of the subtrees
+	// run on its threads.
+	bvh(const aabb* bounds, size_t count, thread_pool* pool = nullptr);
+
+
+	// Returns the bounds of all the primitives, aabb::empty if there are none.
+	const aabb& bounds() const noexcept
+	{
+		return bounds_;
+	}
+
+	// Finds the primitive the ray hits first within [0, t_max].
+	// intersect(uint32_t primitive, float t_max, float& t) must return true and set t if the ray hits
+	// the primitive at a distance from [0, t_max], e.g. by calling one of the math::intersects(const ray&, ...).
+	// Returns true and sets primitive and t if there is a hit, they are not changed otherwise.
+	template<typename Intersect>
+	bool closest_hit(const ray& r, float t_max, Intersect intersect, uint32_t& primitive, float& t) const;
+
+	// Returns true if the ray hits any primitive within [0, t_max], e.g. the occlusion (shadow) rays.
+	// The traversal stops at the first hit, intersect is the same as the one of closest_hit.
+	template<typename Intersect>
+	bool any_hit(const ray& r, float t_max, Intersect intersect) const;
+
+	// Calls func(uint32_t primitive) for every primitive of the leaves whose bounds intersect b.
+	// The primitives are the candidates: their own bounds may still miss b.
+	template<typename Func>
+	void query(const aabb& b, Func func) const;
+
+	// Updates the bounds of the nodes after the primitives have moved, the hierarchy itself is kept.
+	// bounds[i] is the new bounds of the primitive i, the number of the primitives is the same.
+	// The queries stay correct, their speed degrades as the primitives move far from their original places.
+	void refit(const aabb* bounds) noexcept;
+
+	size_t node_count() const noexcept
+	{
+		return nodes_.size();
+	}
+
+	const node* nodes() const noexcept
+	{
+		return nodes_.data();
+	}
+
+	// Returns the primitive indices the leaves refer to, a permutation of [0, size()).
+	const uint32_t* primitive_indices() const noexcept
+	{
+		return indices_.data();
+	}
+
+	// Returns the number of primitives.
+	size_t size() const noexcept
+	{
+		return indices_.size();
+	}
+
+private:
+
+	// The heuristic may split off a single primitive per level, so the nodes at depth max_sah_depth may still have almost
+	// 2^32 primitives. The median splits at least halve them: the nodes are at most 30 levels deeper,
+	// leaves of up to 4 primitives are not pushed. A node pushes up to 3 children more than it pops.
+	static constexpr size_t stack_size = 3 * (max_sah_depth + 30) + 1;
+
+	struct stack_entry final {
+		uint32_t node;
+		float t;
+	};
+
+
+	std::vector<node> nodes_;
+	std::vector<uint32_t> indices_;
+	aabb bounds_ = aabb::empty;
+};
+
+
+namespace detail {
+
+// Tests the ray (o, 1 / d = inv_d) against the children of n as intersects(const ray&, const aabb&, ...) does.
+// Returns the mask of the children hit within [0, t_max], t_near[k] is the entry distance of the child k.
+// The loops over the SoA bounds are vectorized by the compiler.
+inline uint32_t intersect_children(const bvh::node& n, const float3& o, const float3& inv_d, float t_max,
+	float t_near[bvh::width]) noexcept
+{
+	float t_far[bvh::width];
+	for (size_t k = 0; k < bvh::width; ++k) {
+		const float x0 = (n.min_x[k] - o.x) * inv_d.x, x1 = (n.max_x[k] - o.x) * inv_d.x;
+		const float y0 = (n.min_y[k] - o.y) * inv_d.y, y1 = (n.max_y[k] - o.y) * inv_d.y;
+		const float z0 = (n.min_z[k] - o.z) * inv_d.z, z1 = (n.max_z[k] - o.z) * inv_d.z;
+		const float tn = std::max(std::max(std::min(x0, x1), std::min(y0, y1)), std::max(std::min(z0, z1), 0.0f));
+		const float tf = std::min(std::min(std::max(x0, x1), std::max(y0, y1)), std::min(std::max(z0, z1), t_max));
+		t_near[k] = tn;
+		t_far[k] = tf;
+	}
+
+	uint32_t mask = 0;
+	for (size_t k = 0; k < bvh::width; ++k) {
+		if (n.children[k] != bvh::empty_slot && t_near[k] <= t_far[k])
+			mask |= uint32_t(1) << k;
+	}
+
+	return mask;
+}
+
+// Returns the bounds of the child k of n.
+inline aabb child_bounds(const bvh::node& n, size_t k) noexcept
+{
+	assert(k < bvh::width);
+	return aabb(float3(n.min_x[k], n.min_y[k], n.min_z[k]), float3(n.max_x[k], n.max_y[k], n.max_z[k]));
+}
+
+} // namespace detail
+
+
+template<typename Intersect>
+bool bvh::closest_hit(const ray& r, float t_max, Intersect intersect, uint32_t& primitive, float& t) const
+{
+	if (nodes_.empty()) return false;
+
+	const float3 inv_d(1.0f / r.direction.x, 1.0f / r.direction.y, 1.0f / r.direction.z);
+	stack_entry stack[stack_size];
+	size_t top = 0;
+	stack[top++] = { 0, 0.0f };
+
+	bool hit = false;
+	while (top > 0) {
+		const stack_entry e = stack[--top];
+		// the closest hit found since the node has been pushed is closer than the node.
+		if (e.t > t_max) continue;
+
+		const node& n = nodes_[e.node];
+		float t_near[width];
+		const uint32_t mask = detail::intersect_children(n, r.origin, inv_d, t_max, t_near);
+
+		// the leaves are tested right away, the child nodes are pushed from the farthest to the nearest one.
+		stack_entry children[width];
+		size_t child_count = 0;
+		for (size_t k = 0; k < width; ++k) {
+			if ((mask & (uint32_t(1) << k)) == 0) continue;
+
+			if (n.counts[k] == 0) {
+				size_t j = child_count++;
+				for (; j > 0 && children[j - 1].t < t_near[k]; --j)
+					children[j] = children[j - 1];
+
+				children[j] = { n.children[k], t_near[k] };
+				continue;
+			}
+
+			for (uint32_t j = 0; j < n.counts[k]; ++j) {
+				const uint32_t p = indices_[n.children[k] + j];
+				float tp;
+				if (intersect(p, t_max, tp)) {
+					t_max = tp;
+					primitive = p;
+					hit = true;
+				}
+			}
+		}
+
+		assert(top + child_count <= stack_size);
+		for (size_t j = 0; j < child_count; ++j)
+			stack[top++] = children[j];
+	}
+
+	if (hit) t = t_max;
+	return hit;
+}
+
+template<typename Intersect>
+bool bvh::any_hit(const ray& r, float t_max, Intersect intersect) const
+{
+	if (nodes_.empty()) return false;
+
+	const float3 inv_d(1.0f / r.direction.x, 1.0f / r.direction.y, 1.0f / r.direction.z);
+	stack_entry stack[stack_size];
+	size_t top = 0;
+	stack[top++] = { 0, 0.0f };
+
+	while (top > 0) {
+		const node& n = nodes_[stack[--top].node];
+		float t_near[width];
+		const uint32_t mask = detail::intersect_children(n, r.origin, inv_d, t_max, t_near);
+
+		for (size_t k = 0; k < width; ++k) {
+			if ((mask & (uint32_t(1) << k)) == 0) continue;
+
+			if (n.counts[k] == 0) {
+				assert(top < stack_size);
+				stack[top++] = { n.children[k], t_near[k] };
+				continue;
+			}
+
+			for (uint32_t j = 0; j < n.counts[k]; ++j) {
+				float tp;
+				if (intersect(indices_[n.children[k] + j], t_max, tp)) return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+template<typename Func>
+void bvh::query(const aabb& b, Func func) const
+{
+	if (nodes_.empty()) return;
+
+	stack_entry stack[stack_size];
+	size_t top = 0;
+	stack[top++] = { 0, 0.0f };
+
+	while (top > 0) {
+		const node& n = nodes_[stack[--top].node];
+		for (size_t k = 0; k < width; ++k) {
+			if (n.children[k] == empty_slot || !intersects(detail::child_bounds(n, k), b)) continue;
+
+			if (n.counts[k] == 0) {
+				assert(top < stack_size);
+				stack[top++] = { n.children[k], 0.0f };
+				continue;
+			}
+
+			for (uint32_t j = 0; j < n.counts[k]; ++j)
+				func(indices_[n.children[k] + j]);
+		}
+	}
+}
+
+} // namespace math
+
+#endif // MATH_BVH_H_
@@ -0,0 +1,38 @@
+#ifndef MATH_DISPATCH_H_
+#define MATH_DISPATCH_H_
+
+#include <cstdint>
+#include <ostream>
+
+
+namespace math {
+
+// Instruction set levels the batch functions (the functions which process arrays of values,
+// e.g. mul(const float4x4&, const float4*, float4*, size_t)) are implemented for.
+// Every level includes all the previous ones.
+enum class isa_level : uint8_t {
+	scalar,
+	sse4_1,
+	avx2,		// AVX2 + FMA + F16C
+	avx512		// AVX-512F
+};
+
+std::ostream& operator<<(std::ostream& out, isa_level level);
+
+std::wostream& operator<<(std::wostream& out, isa_level level);
+
+// Returns the level which is used by the batch functions.
+// Unless force_isa_level has been called it equals to supported_isa_level().
+isa_level active_isa_level() noexcept;
+
+// Makes the batch functions use the implementation of the specified level.
+// level must not be greater than supported_isa_level(). Intended for testing and benchmarking.
+void force_isa_level(isa_level level) noexcept;
+
+// Returns the best level supported by the running CPU and OS.
+// The CPU is probed once, the first time a batch function or this function is called.
+isa_level supported_isa_level() noexcept;
+
+} // namespace math
+
+#endif // MATH_DISPATCH_H_
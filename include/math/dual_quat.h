@@ -0,0 +1,192 @@
+#ifndef MATH_DUAL_QUAT_H_
+#define MATH_DUAL_QUAT_H_
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include "math/matrix.h"
+#include "math/transform.h"
+#include "math/vector_float.h"
+#include "math/vector_int.h"
+
+
+namespace math {
+
+// dual_quat is a dual quaternion real + eps * dual (eps^2 = 0).
+// A unit dual quaternion represents a rigid transformation: the rotation real followed by a translation t,
+// where dual = 0.5 * quat(t, 0) * real. It takes 8 floats instead of 16 of the equivalent float4x4.
+struct dual_quat final {
+	static const dual_quat identity;
+	static const dual_quat zero;
+
+
+	dual_quat() noexcept = default;
+
+	dual_quat(const quat& real, const quat& dual) noexcept : real(real), dual(dual) {}
+
+
+	dual_quat& operator+=(const dual_quat& dq) noexcept
+	{
+		real += dq.real;
+		dual += dq.dual;
+		return *this;
+	}
+
+	dual_quat& operator*=(float val) noexcept
+	{
+		real *= val;
+		dual *= val;
+		return *this;
+	}
+
+	// Concatenates the transformations: (*this * dq) applies dq first.
+	dual_quat& operator*=(const dual_quat& dq) noexcept
+	{
+		dual = real * dq.dual + dual * dq.real;
+		real *= dq.real;
+		return *this;
+	}
+
+
+	quat real;
+	quat dual;
+};
+
+static_assert(sizeof(dual_quat) == 8 * sizeof(float), "dual_quat must be 8 packed floats.");
+
+
+inline bool operator==(const dual_quat& l, const dual_quat& r) noexcept
+{
+	return (l.real == r.real) && (l.dual == r.dual);
+}
+
+inline bool operator!=(const dual_quat& l, const dual_quat& r) noexcept
+{
+	return !(l == r);
+}
+
+inline dual_quat operator+(const dual_quat& l, const dual_quat& r) noexcept
+{
+	return dual_quat(l.real + r.real, l.dual + r.dual);
+}
+
+inline dual_quat operator*(const dual_quat& dq, float val) noexcept
+{
+	return dual_quat(dq.real * val, dq.dual * val);
+}
+
+inline dual_quat operator*(float val, const dual_quat& dq) noexcept
+{
+	return dq * val;
+}
+
+// Concatenates the transformations: l * r applies r first.
+inline dual_quat operator*(const dual_quat& l, const dual_quat& r) noexcept
+{
+	return dual_quat(l.real * r.real, l.real * r.dual + l.dual * r.real);
+}
+
+std::ostream& operator<<(std::ostream& out, const dual_quat& dq);
+
+std::wostream& operator<<(std::wostream& out, const dual_quat& dq);
+
+// Returns true if the real and the dual parts of l and r differ by no more than max_abs_diff in every component.
+inline bool approx_equal(const dual_quat& l, const dual_quat& r, float max_abs_diff = 1e-5f) noexcept
+{
+	return approx_equal(l.real, r.real, max_abs_diff) && approx_equal(l.dual, r.dual, max_abs_diff);
+}
+
+// Blends count dual quaternions (dual quaternion linear blending, DLB): normalize(sum(weights[i] * dq[i])).
+// The quaternions whose real parts are in the opposite hemisphere of dq[0].real are negated,
+// so that the blend follows the shortest path. The sum of the weights must not be zero.
+dual_quat blend(const dual_quat* dq, const float* weights, size_t count) noexcept;
+
+// Returns the conjugate (real*, dual*) which is the inverse transformation of a unit dual quaternion.
+inline dual_quat conjugate(const dual_quat& dq) noexcept
+{
+	return dual_quat(conjugate(dq.real), conjugate(dq.dual));
+}
+
+// Returns true if the real part of dq is a unit quaternion.
+inline bool is_normalized(const dual_quat& dq, float max_abs_diff = 1e-2f) noexcept
+{
+	return is_normalized(dq.real, max_abs_diff);
+}
+
+// Scales dq so that its real part becomes a unit quaternion.
+inline dual_quat normalize(const dual_quat& dq) noexcept
+{
+	const float l = len(dq.real);
+	assert(!approx_equal(l, 0.0f));
+	return dq * (1.0f / l);
+}
+
+// Returns the rotation of the unit dual quaternion dq, it is dq.real.
+inline quat rotation(const dual_quat& dq) noexcept
+{
+	assert(is_normalized(dq));
+	return dq.real;
+}
+
+// Returns the translation of the unit dual quaternion dq: the vector part of 2 * dual * conjugate(real).
+inline float3 translation(const dual_quat& dq) noexcept
+{
+	assert(is_normalized(dq));
+
+	const float3 rv(dq.real.x, dq.real.y, dq.real.z);
+	const float3 dv(dq.dual.x, dq.dual.y, dq.dual.z);
+	return 2.0f * (dq.real.a * dv - dq.dual.a * rv + cross(rv, dv));
+}
+
+// Transforms the direction v by the unit dual quaternion dq, i.e. rotates it.
+inline float3 transform_direction(const dual_quat& dq, const float3& v) noexcept
+{
+	assert(is_normalized(dq));
+
+	const float3 rv(dq.real.x, dq.real.y, dq.real.z);
+	return v + 2.0f * cross(rv, cross(rv, v) + dq.real.a * v);
+}
+
+// Transforms the point p by the unit dual quaternion dq: rotates it and translates.
+inline float3 transform_point(const dual_quat& dq, const float3& p) noexcept
+{
+	return transform_direction(dq, p) + translation(dq);
+}
+
+// Returns a dual quaternion that is a concatenation of translation by p and rotation by q,
+// the same transformation as tr_matrix(p, q) performs. q must be a unit quaternion.
+inline dual_quat tr_dual_quat(const float3& p, const quat& q) noexcept
+{
+	assert(is_normalized(q));
+	return dual_quat(q, 0.5f * (quat(p, 0.0f) * q));
+}
+
+// Returns the unit dual quaternion of the rigid transformation m (a rotation and a translation),
+// e.g. the matrix made by tr_matrix.
+inline dual_quat tr_dual_quat(const float4x4& m) noexcept
+{
+	return tr_dual_quat(position(m), from_rotation_matrix(m));
+}
+
+// Returns the matrix of the transformation of the unit dual quaternion dq.
+inline float4x4 tr_matrix(const dual_quat& dq) noexcept
+{
+	return tr_matrix(translation(dq), dq.real);
+}
+
+// Skins count vertices using dual quaternion linear blending of 4 joints per vertex.
+// joints[i] are the indices of the joints in palette, weights[i] are their weights packed
+// with pack_unorm_8_8_8_8: joints[i].x has the weight unpack_unorm_8_8_8_8(weights[i]).x and so on.
+// The weights of each vertex must not all be zero.
+//
+// out_positions[i] = transform_point(b, positions[i]), out_normals[i] = transform_direction(b, normals[i]),
+// where b is the blend of the joints (see blend). normals and out_normals may be nullptr,
+// then the normals are not skinned. The output arrays may be equal to the input ones.
+// The implementation is chosen at run time (see math/dispatch.h).
+void skin(const dual_quat* palette, const float3* positions, const float3* normals,
+	const ubyte4* joints, const uint32_t* weights, float3* out_positions, float3* out_normals, size_t count) noexcept;
+
+} // namespace math
+
+#endif // MATH_DUAL_QUAT_H_
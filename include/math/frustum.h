@@ -0,0 +1,132 @@
+#ifndef MATH_FRUSTUM_H_
+#define MATH_FRUSTUM_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include "math/matrix.h"
+#include "math/vector_float.h"
+#include "math/vector_soa.h"
+
+
+namespace math {
+
+// plane is the set of points p for which dot(normal, p) + distance == 0.
+// The normal points into the positive half-space.
+struct plane final {
+
+	constexpr plane() noexcept : normal(), distance(0) {}
+
+	constexpr plane(const float3& normal, float distance) noexcept : normal(normal), distance(distance) {}
+
+	// Creates the plane (v.x, v.y, v.z) * p + v.w = 0.
+	constexpr explicit plane(const float4& v) noexcept : normal(v.x, v.y, v.z), distance(v.w) {}
+
+
+	float3 normal;
+	float distance;
+};
+
+// frustum is the intersection of the positive half-spaces of its six planes.
+// The planes are normalized and their normals point inside the frustum.
+struct frustum final {
+	// The indices of the planes.
+	static constexpr size_t left = 0;
+	static constexpr size_t right = 1;
+	static constexpr size_t bottom = 2;
+	static constexpr size_t top = 3;
+	static constexpr size_t near_plane = 4;
+	static constexpr size_t far_plane = 5;
+
+
+	plane planes[6];
+};
+
+
+inline bool operator==(const plane& l, const plane& r) noexcept
+{
+	return (l.normal == r.normal) && (l.distance == r.distance);
+}
+
+inline bool operator!=(const plane& l, const plane& r) noexcept
+{
+	return !(l == r);
+}
+
+std::ostream& operator<<(std::ostream& out, const plane& p);
+
+std::wostream& operator<<(std::wostream& out, const plane& p);
+
+// Returns true if the normals and the distances of l and r differ by no more than max_abs_diff in every component.
+inline bool approx_equal(const plane& l, const plane& r, float max_abs_diff = 1e-5f) noexcept
+{
+	return approx_equal(l.normal, r.normal, max_abs_diff) && approx_equal(l.distance, r.distance, max_abs_diff);
+}
+
+// Returns the signed distance between the plane and the point p.
+// The distance is positive in the half-space the normal points to.
+// The result is the euclidean distance only if pl.normal is a unit vector.
+inline float distance(const plane& pl, const float3& p) noexcept
+{
+	return dot(pl.normal, p) + pl.distance;
+}
+
+// Extracts the frustum planes of the DirectX compatible (0 <= z <= w in clip space)
+// view-projection matrix, e.g. perspective_matrix_directx(...) * view_matrix(...).
+frustum frustum_directx(const float4x4& view_projection) noexcept;
+
+// Extracts the frustum planes of the OpenGL compatible (-w <= z <= w in clip space)
+// view-projection matrix, e.g. perspective_matrix_opengl(...) * view_matrix(...).
+frustum frustum_opengl(const float4x4& view_projection) noexcept;
+
+// Returns true if the sphere is not completely outside any of the frustum planes.
+inline bool intersects(const frustum& f, const float3& center, float radius) noexcept
+{
+	for (const plane& pl : f.planes) {
+		if (distance(pl, center) < -radius) return false;
+	}
+
+	return true;
+}
+
+// Returns true if the axis-aligned box [min, max] is not completely outside any of the frustum planes.
+// The test is conservative: a big box near a frustum corner may be reported as intersecting.
+inline bool intersects(const frustum& f, const float3& min, const float3& max) noexcept
+{
+	for (const plane& pl : f.planes) {
+		// the box corner farthest along the normal.
+		const float3& n = pl.normal;
+		const float d = std::max(n.x * min.x, n.x * max.x) + std::max(n.y * min.y, n.y * max.y)
+			+ std::max(n.z * min.z, n.z * max.z) + pl.distance;
+
+		if (d < 0.0f) return false;
+	}
+
+	return true;
+}
+
+// Normalizes the plane so that its normal is a unit vector.
+inline plane normalize(const plane& p) noexcept
+{
+	const float l = len(p.normal);
+	assert(!approx_equal(l, 0.0f));
+	return plane(p.normal / l, p.distance / l);
+}
+
+
+// The batch functions below test every element of the SoA arrays and set bit (i % 32) of visible[i / 32]
+// if the element i intersects the frustum (see the scalar functions above), the rest of the bits are cleared.
+// visible must hold at least (count + 31) / 32 values, where count is the number of elements.
+// The implementation is chosen at run time (see math/dispatch.h).
+
+// Tests the spheres whose centers are (x, y, z) and radii are w.
+void intersects(const frustum& f, const float4_soa& spheres, uint32_t* visible) noexcept;
+
+// Tests the axis-aligned boxes [min[i], max[i]].
+void intersects(const frustum& f, const float3_soa& min, const float3_soa& max, uint32_t* visible) noexcept;
+
+} // namespace math
+
+#endif // MATH_FRUSTUM_H_
@@ -0,0 +1,128 @@
+#ifndef MATH_HIERARCHY_H_
+#define MATH_HIERARCHY_H_
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "math/matrix.h"
+#include "math/parallel.h"
+#include "math/vector_float.h"
+
+
+namespace math {
+
+// hierarchy computes the world matrices of a forest of nodes (e.g. a scene graph or a skeleton):
+// world(i) = world(parent(i)) * trs_matrix(position(i), rotation(i), scale(i)), world(root) is its local matrix.
+//
+// The nodes are stored in breadth-first order: the parent of a node precedes it and the depth of the nodes
+// never decreases, so the nodes of every depth (level) are contiguous and the roots come first.
+// update processes the levels one after another and the nodes of a level in parallel.
+// Only the dirty nodes (the ones whose local transformations have been set since the last update)
+// and their descendants are recomputed.
+class hierarchy final {
+public:
+
+	// parent of the root nodes.
+	static constexpr uint32_t no_parent = UINT32_MAX;
+
+
+	hierarchy() noexcept = default;
+
+	// Creates count nodes, parents[i] is the parent of node i or no_parent.
+	// The local transformations are identities, all the nodes are dirty.
+	hierarchy(const uint32_t* parents, size_t count);
+
+
+	// Returns the number of levels, the depth of the deepest node plus 1.
+	size_t level_count() const noexcept
+	{
+		return level_offsets_.empty() ? 0 : level_offsets_.size() - 1;
+	}
+
+	// Returns the index of the first node of the level l. The level occupies [level_offset(l), level_offset(l + 1)).
+	size_t level_offset(size_t l) const noexcept
+	{
+		assert(l < level_offsets_.size());
+		return level_offsets_[l];
+	}
+
+	uint32_t parent(size_t i) const noexcept
+	{
+		assert(i < size());
+		return parents_[i];
+	}
+
+	const float3& position(size_t i) const noexcept
+	{
+		assert(i < size());
+		return positions_[i];
+	}
+
+	const quat& rotation(size_t i) const noexcept
+	{
+		assert(i < size());
+		return rotations_[i];
+	}
+
+	const float3& scale(size_t i) const noexcept
+	{
+		assert(i < size());
+		return scales_[i];
+	}
+
+	// Sets the local transformation of node i and marks it dirty. q must be a unit quaternion.
+	void set_local(size_t i, const float3& p, const quat& q, const float3& s) noexcept
+	{
+		assert(i < size());
+		assert(is_normalized(q));
+
+		positions_[i] = p;
+		rotations_[i] = q;
+		scales_[i] = s;
+		dirty_[i] = 1;
+		has_dirty_ = true;
+	}
+
+	size_t size() const noexcept
+	{
+		return parents_.size();
+	}
+
+	// Recomputes the world matrices of the dirty nodes and their descendants, then clears the dirty flags.
+	// If pool is not nullptr the nodes of every level are split into ranges which are processed on its threads.
+	void update(thread_pool* pool = nullptr);
+
+	// Returns the world matrix of node i computed by the last update.
+	const float4x4& world(size_t i) const noexcept
+	{
+		assert(i < size());
+		return worlds_[i];
+	}
+
+	// Returns the world matrices of all the nodes.
+	const float4x4* worlds() const noexcept
+	{
+		return worlds_.data();
+	}
+
+private:
+
+	// Updates the nodes [begin, end) of a single level.
+	void update_range(size_t begin, size_t end) noexcept;
+
+
+	std::vector<uint32_t> parents_;
+	std::vector<size_t> level_offsets_;
+	std::vector<float3> positions_;
+	std::vector<quat> rotations_;
+	std::vector<float3> scales_;
+	std::vector<float4x4> worlds_;
+	// uint8_t rather than bool: the threads write the flags of neighbouring nodes.
+	std::vector<uint8_t> dirty_;
+	bool has_dirty_ = false;
+};
+
+} // namespace math
+
+#endif // MATH_HIERARCHY_H_
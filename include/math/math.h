@@ -1,13 +1,27 @@
 #ifndef MATH_MATH_H_
 #define MATH_MATH_H_
 
+#include "math/aabb.h"
+#include "math/bvh.h"
+#include "math/dispatch.h"
+#include "math/dual_quat.h"
+#include "math/frustum.h"
+#include "math/hierarchy.h"
 #include "math/math_traits.h"
 #include "math/matrix.h"
+#include "math/matrix_double.h"
+#include "math/morton.h"
+#include "math/parallel.h"
+#include "math/ray.h"
+#include "math/simd.h"
+#include "math/spatial_hash.h"
 #include "math/transform.h"
 #include "math/utility.h"
 #include "math/vector_bool.h"
+#include "math/vector_double.h"
 #include "math/vector_float.h"
 #include "math/vector_int.h"
+#include "math/vector_soa.h"
 #include "math/vector_utility.h"
 
 #endif // MATH_MATH_H_
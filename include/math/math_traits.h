@@ -3,6 +3,7 @@
 
 #include <type_traits>
 #include "math/matrix.h"
+#include "math/matrix_double.h"
 #include "math/vector_int.h"
 
 
@@ -33,7 +34,10 @@ template<typename M>
 constexpr bool is_matrix() noexcept
 {
 	return std::is_same<M, float3x3>::value
-		|| std::is_same<M, float4x4>::value;
+		|| std::is_same<M, float3x4>::value
+		|| std::is_same<M, float4x4>::value
+		|| std::is_same<M, double3x3>::value
+		|| std::is_same<M, double4x4>::value;
 }
 
 // vector_traits provides various properties of vector types.
@@ -87,6 +91,13 @@ struct vector_traits<vec_int_4<T>> final {
 	static constexpr size_t byte_count		= sizeof(component_type) * component_count;
 };
 
+template<typename T> constexpr size_t vector_traits<vec_int_2<T>>::component_count;
+template<typename T> constexpr size_t vector_traits<vec_int_2<T>>::byte_count;
+template<typename T> constexpr size_t vector_traits<vec_int_3<T>>::component_count;
+template<typename T> constexpr size_t vector_traits<vec_int_3<T>>::byte_count;
+template<typename T> constexpr size_t vector_traits<vec_int_4<T>>::component_count;
+template<typename T> constexpr size_t vector_traits<vec_int_4<T>>::byte_count;
+
 } // namespace math
 
 #endif // MATH_VECTOR_TRAITS_H_
@@ -89,28 +89,44 @@ struct float4x4 {
 
 	float4x4& operator+=(const float4x4& m) noexcept
 	{
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+		for (int i = 0; i < 16; i += 4)
+			simd::store(&m00 + i, _mm_add_ps(simd::load(&m00 + i), simd::load(&m.m00 + i)));
+#else
 		m00 += m.m00; m01 += m.m01; m02 += m.m02; m03 += m.m03;
 		m10 += m.m10; m11 += m.m11; m12 += m.m12; m13 += m.m13;
 		m20 += m.m20; m21 += m.m21; m22 += m.m22; m23 += m.m23;
 		m30 += m.m30; m31 += m.m31; m32 += m.m32; m33 += m.m33;
+#endif
 		return *this;
 	}
 
 	float4x4& operator-=(const float4x4& m) noexcept
 	{
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+		for (int i = 0; i < 16; i += 4)
+			simd::store(&m00 + i, _mm_sub_ps(simd::load(&m00 + i), simd::load(&m.m00 + i)));
+#else
 		m00 -= m.m00; m01 -= m.m01; m02 -= m.m02; m03 -= m.m03;
 		m10 -= m.m10; m11 -= m.m11; m12 -= m.m12; m13 -= m.m13;
 		m20 -= m.m20; m21 -= m.m21; m22 -= m.m22; m23 -= m.m23;
 		m30 -= m.m30; m31 -= m.m31; m32 -= m.m32; m33 -= m.m33;
+#endif
 		return *this;
 	}
 
 	float4x4& operator*=(float val) noexcept
 	{
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+		const __m128 v = _mm_set1_ps(val);
+		for (int i = 0; i < 16; i += 4)
+			simd::store(&m00 + i, _mm_mul_ps(simd::load(&m00 + i), v));
+#else
 		m00 *= val; m01 *= val; m02 *= val; m03 *= val;
 		m10 *= val; m11 *= val; m12 *= val; m13 *= val;
 		m20 *= val; m21 *= val; m22 *= val; m23 *= val;
 		m30 *= val; m31 *= val; m32 *= val; m33 *= val;
+#endif
 		return *this;
 	}
 
@@ -121,10 +137,16 @@ struct float4x4 {
 	{
 		assert(!approx_equal(val, 0.0f));
 
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+		const __m128 v = _mm_set1_ps(val);
+		for (int i = 0; i < 16; i += 4)
+			simd::store(&m00 + i, _mm_div_ps(simd::load(&m00 + i), v));
+#else
 		m00 /= val; m01 /= val; m02 /= val; m03 /= val;
 		m10 /= val; m11 /= val; m12 /= val; m13 /= val;
 		m20 /= val; m21 /= val; m22 /= val; m23 /= val;
 		m30 /= val; m31 /= val; m32 /= val; m33 /= val;
+#endif
 		return *this;
 	}
 
@@ -140,21 +162,236 @@ struct float4x4 {
 	float m30 = 0, m31 = 0, m32 = 0, m33 = 0;
 };
 
+// float3x4 is an affine transformation matrix. It is a float4x4 whose last row
+// is always (0, 0, 0, 1) and therefore is not stored.
+struct float3x4 {
+	static const float3x4 identity;
+	static const float3x4 zero;
 
-bool operator==(const float3x3& l, const float3x3& r) noexcept;
+
+	constexpr float3x4() noexcept = default;
+
+	constexpr float3x4(float m00, float m01, float m02, float m03,
+		float m10, float m11, float m12, float m13,
+		float m20, float m21, float m22, float m23) noexcept
+		: m00(m00), m01(m01), m02(m02), m03(m03),
+		m10(m10), m11(m11), m12(m12), m13(m13),
+		m20(m20), m21(m21), m22(m22), m23(m23)
+	{}
+
+	// Takes the first three rows of m. m is expected to be affine, its last row is ignored.
+	explicit constexpr float3x4(const float4x4& m) noexcept
+		: m00(m.m00), m01(m.m01), m02(m.m02), m03(m.m03),
+		m10(m.m10), m11(m.m11), m12(m.m12), m13(m.m13),
+		m20(m.m20), m21(m.m21), m22(m.m22), m23(m.m23)
+	{}
+
+
+	// Post-multiplies this matrix with the specified matrix.
+	float3x4& operator*=(const float3x4& m) noexcept;
+
+	explicit operator float3x3() const noexcept
+	{
+		return float3x3(m00, m01, m02, m10, m11, m12, m20, m21, m22);
+	}
+
+	explicit operator float4x4() const noexcept
+	{
+		return float4x4(
+			m00, m01, m02, m03,
+			m10, m11, m12, m13,
+			m20, m21, m22, m23,
+			0, 0, 0, 1);
+	}
+
+
+	float m00 = 0, m01 = 0, m02 = 0, m03 = 0;
+	float m10 = 0, m11 = 0, m12 = 0, m13 = 0;
+	float m20 = 0, m21 = 0, m22 = 0, m23 = 0;
+};
+
+
+inline float3x3& float3x3::operator*=(const float3x3& m) noexcept
+{
+	float mp00, mp01, mp02;
+	float mp10, mp11, mp12;
+	float mp20, mp21, mp22;
+
+	mp00 = m00 * m.m00 + m01 * m.m10 + m02 * m.m20;
+	mp01 = m00 * m.m01 + m01 * m.m11 + m02 * m.m21;
+	mp02 = m00 * m.m02 + m01 * m.m12 + m02 * m.m22;
+
+	mp10 = m10 * m.m00 + m11 * m.m10 + m12 * m.m20;
+	mp11 = m10 * m.m01 + m11 * m.m11 + m12 * m.m21;
+	mp12 = m10 * m.m02 + m11 * m.m12 + m12 * m.m22;
+
+	mp20 = m20 * m.m00 + m21 * m.m10 + m22 * m.m20;
+	mp21 = m20 * m.m01 + m21 * m.m11 + m22 * m.m21;
+	mp22 = m20 * m.m02 + m21 * m.m12 + m22 * m.m22;
+
+	m00 = mp00; m01 = mp01; m02 = mp02;
+	m10 = mp10; m11 = mp11; m12 = mp12;
+	m20 = mp20; m21 = mp21; m22 = mp22;
+	return *this;
+}
+
+inline float4x4& float4x4::operator*=(const float4x4& m) noexcept
+{
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	simd::mat4_mul(&m00, &m.m00, &m00);
+#else
+	float mp00, mp01, mp02, mp03;
+	float mp10, mp11, mp12, mp13;
+	float mp20, mp21, mp22, mp23;
+	float mp30, mp31, mp32, mp33;
+
+	mp00 = m00 * m.m00 + m01 * m.m10 + m02 * m.m20 + m03 * m.m30;
+	mp01 = m00 * m.m01 + m01 * m.m11 + m02 * m.m21 + m03 * m.m31;
+	mp02 = m00 * m.m02 + m01 * m.m12 + m02 * m.m22 + m03 * m.m32;
+	mp03 = m00 * m.m03 + m01 * m.m13 + m02 * m.m23 + m03 * m.m33;
+
+	mp10 = m10 * m.m00 + m11 * m.m10 + m12 * m.m20 + m13 * m.m30;
+	mp11 = m10 * m.m01 + m11 * m.m11 + m12 * m.m21 + m13 * m.m31;
+	mp12 = m10 * m.m02 + m11 * m.m12 + m12 * m.m22 + m13 * m.m32;
+	mp13 = m10 * m.m03 + m11 * m.m13 + m12 * m.m23 + m13 * m.m33;
+
+	mp20 = m20 * m.m00 + m21 * m.m10 + m22 * m.m20 + m23 * m.m30;
+	mp21 = m20 * m.m01 + m21 * m.m11 + m22 * m.m21 + m23 * m.m31;
+	mp22 = m20 * m.m02 + m21 * m.m12 + m22 * m.m22 + m23 * m.m32;
+	mp23 = m20 * m.m03 + m21 * m.m13 + m22 * m.m23 + m23 * m.m33;
+
+	mp30 = m30 * m.m00 + m31 * m.m10 + m32 * m.m20 + m33 * m.m30;
+	mp31 = m30 * m.m01 + m31 * m.m11 + m32 * m.m21 + m33 * m.m31;
+	mp32 = m30 * m.m02 + m31 * m.m12 + m32 * m.m22 + m33 * m.m32;
+	mp33 = m30 * m.m03 + m31 * m.m13 + m32 * m.m23 + m33 * m.m33;
+
+	m00 = mp00; m01 = mp01; m02 = mp02; m03 = mp03;
+	m10 = mp10; m11 = mp11; m12 = mp12; m13 = mp13;
+	m20 = mp20; m21 = mp21; m22 = mp22; m23 = mp23;
+	m30 = mp30; m31 = mp31; m32 = mp32; m33 = mp33;
+#endif
+
+	return *this;
+}
+
+inline float3x4& float3x4::operator*=(const float3x4& m) noexcept
+{
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	simd::affine_mul(&m00, &m.m00, &m00);
+#else
+	float mp00, mp01, mp02, mp03;
+	float mp10, mp11, mp12, mp13;
+	float mp20, mp21, mp22, mp23;
+
+	mp00 = m00 * m.m00 + m01 * m.m10 + m02 * m.m20;
+	mp01 = m00 * m.m01 + m01 * m.m11 + m02 * m.m21;
+	mp02 = m00 * m.m02 + m01 * m.m12 + m02 * m.m22;
+	mp03 = m00 * m.m03 + m01 * m.m13 + m02 * m.m23 + m03;
+
+	mp10 = m10 * m.m00 + m11 * m.m10 + m12 * m.m20;
+	mp11 = m10 * m.m01 + m11 * m.m11 + m12 * m.m21;
+	mp12 = m10 * m.m02 + m11 * m.m12 + m12 * m.m22;
+	mp13 = m10 * m.m03 + m11 * m.m13 + m12 * m.m23 + m13;
+
+	mp20 = m20 * m.m00 + m21 * m.m10 + m22 * m.m20;
+	mp21 = m20 * m.m01 + m21 * m.m11 + m22 * m.m21;
+	mp22 = m20 * m.m02 + m21 * m.m12 + m22 * m.m22;
+	mp23 = m20 * m.m03 + m21 * m.m13 + m22 * m.m23 + m23;
+
+	m00 = mp00; m01 = mp01; m02 = mp02; m03 = mp03;
+	m10 = mp10; m11 = mp11; m12 = mp12; m13 = mp13;
+	m20 = mp20; m21 = mp21; m22 = mp22; m23 = mp23;
+#endif
+
+	return *this;
+}
+
+
+inline bool operator==(const float3x3& l, const float3x3& r) noexcept
+{
+	return (l.m00 == r.m00)
+		&& (l.m10 == r.m10)
+		&& (l.m20 == r.m20)
+
+		&& (l.m01 == r.m01)
+		&& (l.m11 == r.m11)
+		&& (l.m21 == r.m21)
+
+		&& (l.m02 == r.m02)
+		&& (l.m12 == r.m12)
+		&& (l.m22 == r.m22);
+}
 
 inline bool operator!=(const float3x3& l, const float3x3& r) noexcept
 {
 	return !(l == r);
 }
 
-bool operator==(const float4x4& l, const float4x4& r) noexcept;
+inline bool operator==(const float4x4& l, const float4x4& r) noexcept
+{
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	return simd::all_equal(simd::load(&l.m00), simd::load(&r.m00))
+		&& simd::all_equal(simd::load(&l.m10), simd::load(&r.m10))
+		&& simd::all_equal(simd::load(&l.m20), simd::load(&r.m20))
+		&& simd::all_equal(simd::load(&l.m30), simd::load(&r.m30));
+#else
+	return (l.m00 == r.m00)
+		&& (l.m10 == r.m10)
+		&& (l.m20 == r.m20)
+		&& (l.m30 == r.m30)
+
+		&& (l.m01 == r.m01)
+		&& (l.m11 == r.m11)
+		&& (l.m21 == r.m21)
+		&& (l.m31 == r.m31)
+
+		&& (l.m02 == r.m02)
+		&& (l.m12 == r.m12)
+		&& (l.m22 == r.m22)
+		&& (l.m32 == r.m32)
+
+		&& (l.m03 == r.m03)
+		&& (l.m13 == r.m13)
+		&& (l.m23 == r.m23)
+		&& (l.m33 == r.m33);
+#endif
+}
 
 inline bool operator!=(const float4x4& l, const float4x4& r) noexcept
 {
 	return !(l == r);
 }
 
+inline bool operator==(const float3x4& l, const float3x4& r) noexcept
+{
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	return simd::all_equal(simd::load(&l.m00), simd::load(&r.m00))
+		&& simd::all_equal(simd::load(&l.m10), simd::load(&r.m10))
+		&& simd::all_equal(simd::load(&l.m20), simd::load(&r.m20));
+#else
+	return (l.m00 == r.m00)
+		&& (l.m10 == r.m10)
+		&& (l.m20 == r.m20)
+
+		&& (l.m01 == r.m01)
+		&& (l.m11 == r.m11)
+		&& (l.m21 == r.m21)
+
+		&& (l.m02 == r.m02)
+		&& (l.m12 == r.m12)
+		&& (l.m22 == r.m22)
+
+		&& (l.m03 == r.m03)
+		&& (l.m13 == r.m13)
+		&& (l.m23 == r.m23);
+#endif
+}
+
+inline bool operator!=(const float3x4& l, const float3x4& r) noexcept
+{
+	return !(l == r);
+}
+
 inline float3x3 operator+(const float3x3& l, const float3x3 r) noexcept
 {
 	return float3x3(
@@ -166,12 +403,20 @@ inline float3x3 operator+(const float3x3& l, const float3x3 r) noexcept
 
 inline float4x4 operator+(const float4x4& l, const float4x4 r) noexcept
 {
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	float4x4 res;
+	for (int i = 0; i < 16; i += 4)
+		simd::store(&res.m00 + i, _mm_add_ps(simd::load(&l.m00 + i), simd::load(&r.m00 + i)));
+
+	return res;
+#else
 	return float4x4(
 		l.m00 + r.m00, l.m01 + r.m01, l.m02 + r.m02, l.m03 + r.m03,
 		l.m10 + r.m10, l.m11 + r.m11, l.m12 + r.m12, l.m13 + r.m13,
 		l.m20 + r.m20, l.m21 + r.m21, l.m22 + r.m22, l.m23 + r.m23,
 		l.m30 + r.m30, l.m31 + r.m31, l.m32 + r.m32, l.m33 + r.m33
 	);
+#endif
 }
 
 inline float3x3 operator-(const float3x3& l, const float3x3 r)
@@ -185,12 +430,20 @@ inline float3x3 operator-(const float3x3& l, const float3x3 r)
 
 inline float4x4 operator-(const float4x4& l, const float4x4 r) noexcept
 {
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	float4x4 res;
+	for (int i = 0; i < 16; i += 4)
+		simd::store(&res.m00 + i, _mm_sub_ps(simd::load(&l.m00 + i), simd::load(&r.m00 + i)));
+
+	return res;
+#else
 	return float4x4(
 		l.m00 - r.m00, l.m01 - r.m01, l.m02 - r.m02, l.m03 - r.m03,
 		l.m10 - r.m10, l.m11 - r.m11, l.m12 - r.m12, l.m13 - r.m13,
 		l.m20 - r.m20, l.m21 - r.m21, l.m22 - r.m22, l.m23 - r.m23,
 		l.m30 - r.m30, l.m31 - r.m31, l.m32 - r.m32, l.m33 - r.m33
 	);
+#endif
 }
 
 inline float3x3 operator*(const float3x3& m, float val) noexcept
@@ -212,30 +465,118 @@ inline float3x3 operator*(float val, const float3x3& m) noexcept
 }
 
 // Post-multiplies lhs matrix with rhs.
-float3x3 operator*(const float3x3& l, const float3x3& r) noexcept;
+inline float3x3 operator*(const float3x3& l, const float3x3& r) noexcept
+{
+	float3x3 product;
+
+	product.m00 = l.m00 * r.m00 + l.m01 * r.m10 + l.m02 * r.m20;
+	product.m01 = l.m00 * r.m01 + l.m01 * r.m11 + l.m02 * r.m21;
+	product.m02 = l.m00 * r.m02 + l.m01 * r.m12 + l.m02 * r.m22;
+
+	product.m10 = l.m10 * r.m00 + l.m11 * r.m10 + l.m12 * r.m20;
+	product.m11 = l.m10 * r.m01 + l.m11 * r.m11 + l.m12 * r.m21;
+	product.m12 = l.m10 * r.m02 + l.m11 * r.m12 + l.m12 * r.m22;
+
+	product.m20 = l.m20 * r.m00 + l.m21 * r.m10 + l.m22 * r.m20;
+	product.m21 = l.m20 * r.m01 + l.m21 * r.m11 + l.m22 * r.m21;
+	product.m22 = l.m20 * r.m02 + l.m21 * r.m12 + l.m22 * r.m22;
+
+	return product;
+}
 
 inline float4x4 operator*(const float4x4& m, float val) noexcept
 {
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	const __m128 v = _mm_set1_ps(val);
+
+	float4x4 res;
+	for (int i = 0; i < 16; i += 4)
+		simd::store(&res.m00 + i, _mm_mul_ps(simd::load(&m.m00 + i), v));
+
+	return res;
+#else
 	return float4x4(
 		m.m00 * val, m.m01 * val, m.m02 * val, m.m03 * val,
 		m.m10 * val, m.m11 * val, m.m12 * val, m.m13 * val,
 		m.m20 * val, m.m21 * val, m.m22 * val, m.m23 * val,
 		m.m30 * val, m.m31 * val, m.m32 * val, m.m33 * val
 	);
+#endif
 }
 
 inline float4x4 operator*(float  val, const float4x4& m) noexcept
 {
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	const __m128 v = _mm_set1_ps(val);
+
+	float4x4 res;
+	for (int i = 0; i < 16; i += 4)
+		simd::store(&res.m00 + i, _mm_mul_ps(simd::load(&m.m00 + i), v));
+
+	return res;
+#else
 	return float4x4(
 		m.m00 * val, m.m01 * val, m.m02 * val, m.m03 * val,
 		m.m10 * val, m.m11 * val, m.m12 * val, m.m13 * val,
 		m.m20 * val, m.m21 * val, m.m22 * val, m.m23 * val,
 		m.m30 * val, m.m31 * val, m.m32 * val, m.m33 * val
 	);
+#endif
 }
 
 // Post-multiplies l matrix with r.
-float4x4 operator*(const float4x4& l, const float4x4& r) noexcept;
+inline float4x4 operator*(const float4x4& l, const float4x4& r) noexcept
+{
+	float4x4 product;
+
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	simd::mat4_mul(&l.m00, &r.m00, &product.m00);
+#else
+	product.m00 = l.m00 * r.m00 + l.m01 * r.m10 + l.m02 * r.m20 + l.m03 * r.m30;
+	product.m01 = l.m00 * r.m01 + l.m01 * r.m11 + l.m02 * r.m21 + l.m03 * r.m31;
+	product.m02 = l.m00 * r.m02 + l.m01 * r.m12 + l.m02 * r.m22 + l.m03 * r.m32;
+	product.m03 = l.m00 * r.m03 + l.m01 * r.m13 + l.m02 * r.m23 + l.m03 * r.m33;
+	product.m10 = l.m10 * r.m00 + l.m11 * r.m10 + l.m12 * r.m20 + l.m13 * r.m30;
+	product.m11 = l.m10 * r.m01 + l.m11 * r.m11 + l.m12 * r.m21 + l.m13 * r.m31;
+	product.m12 = l.m10 * r.m02 + l.m11 * r.m12 + l.m12 * r.m22 + l.m13 * r.m32;
+	product.m13 = l.m10 * r.m03 + l.m11 * r.m13 + l.m12 * r.m23 + l.m13 * r.m33;
+	product.m20 = l.m20 * r.m00 + l.m21 * r.m10 + l.m22 * r.m20 + l.m23 * r.m30;
+	product.m21 = l.m20 * r.m01 + l.m21 * r.m11 + l.m22 * r.m21 + l.m23 * r.m31;
+	product.m22 = l.m20 * r.m02 + l.m21 * r.m12 + l.m22 * r.m22 + l.m23 * r.m32;
+	product.m23 = l.m20 * r.m03 + l.m21 * r.m13 + l.m22 * r.m23 + l.m23 * r.m33;
+	product.m30 = l.m30 * r.m00 + l.m31 * r.m10 + l.m32 * r.m20 + l.m33 * r.m30;
+	product.m31 = l.m30 * r.m01 + l.m31 * r.m11 + l.m32 * r.m21 + l.m33 * r.m31;
+	product.m32 = l.m30 * r.m02 + l.m31 * r.m12 + l.m32 * r.m22 + l.m33 * r.m32;
+	product.m33 = l.m30 * r.m03 + l.m31 * r.m13 + l.m32 * r.m23 + l.m33 * r.m33;
+#endif
+
+	return product;
+}
+
+// Post-multiplies l matrix with r. The product of two affine matrices is affine.
+inline float3x4 operator*(const float3x4& l, const float3x4& r) noexcept
+{
+	float3x4 product;
+
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	simd::affine_mul(&l.m00, &r.m00, &product.m00);
+#else
+	product.m00 = l.m00 * r.m00 + l.m01 * r.m10 + l.m02 * r.m20;
+	product.m01 = l.m00 * r.m01 + l.m01 * r.m11 + l.m02 * r.m21;
+	product.m02 = l.m00 * r.m02 + l.m01 * r.m12 + l.m02 * r.m22;
+	product.m03 = l.m00 * r.m03 + l.m01 * r.m13 + l.m02 * r.m23 + l.m03;
+	product.m10 = l.m10 * r.m00 + l.m11 * r.m10 + l.m12 * r.m20;
+	product.m11 = l.m10 * r.m01 + l.m11 * r.m11 + l.m12 * r.m21;
+	product.m12 = l.m10 * r.m02 + l.m11 * r.m12 + l.m12 * r.m22;
+	product.m13 = l.m10 * r.m03 + l.m11 * r.m13 + l.m12 * r.m23 + l.m13;
+	product.m20 = l.m20 * r.m00 + l.m21 * r.m10 + l.m22 * r.m20;
+	product.m21 = l.m20 * r.m01 + l.m21 * r.m11 + l.m22 * r.m21;
+	product.m22 = l.m20 * r.m02 + l.m21 * r.m12 + l.m22 * r.m22;
+	product.m23 = l.m20 * r.m03 + l.m21 * r.m13 + l.m22 * r.m23 + l.m23;
+#endif
+
+	return product;
+}
 
 inline float3x3 operator/(const float3x3& m, float val) noexcept
 {
@@ -252,12 +593,22 @@ inline float4x4 operator/(const float4x4& m, float val) noexcept
 {
 	assert(!approx_equal(val, 0.0f));
 
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	const __m128 v = _mm_set1_ps(val);
+
+	float4x4 res;
+	for (int i = 0; i < 16; i += 4)
+		simd::store(&res.m00 + i, _mm_div_ps(simd::load(&m.m00 + i), v));
+
+	return res;
+#else
 	return float4x4(
 		m.m00 / val, m.m01 / val, m.m02 / val, m.m03 / val,
 		m.m10 / val, m.m11 / val, m.m12 / val, m.m13 / val,
 		m.m20 / val, m.m21 / val, m.m22 / val, m.m23 / val,
 		m.m30 / val, m.m31 / val, m.m32 / val, m.m33 / val
 	);
+#endif
 }
 
 std::ostream& operator<<(std::ostream& out, const float3x3& m);
@@ -268,9 +619,66 @@ std::ostream& operator<<(std::ostream& out, const float4x4& m);
 
 std::wostream& operator<<(std::wostream& out, const float4x4& m);
 
-bool approx_equal(const float3x3& l, const float3x3& r, float max_abs_diff = 1e-5f) noexcept;
+std::ostream& operator<<(std::ostream& out, const float3x4& m);
+
+std::wostream& operator<<(std::wostream& out, const float3x4& m);
+
+inline bool approx_equal(const float3x3& l, const float3x3& r, float max_abs_diff = 1e-5f) noexcept
+{
+	return approx_equal(l.m00, r.m00, max_abs_diff)
+		&& approx_equal(l.m10, r.m10, max_abs_diff)
+		&& approx_equal(l.m20, r.m20, max_abs_diff)
+
+		&& approx_equal(l.m01, r.m01, max_abs_diff)
+		&& approx_equal(l.m11, r.m11, max_abs_diff)
+		&& approx_equal(l.m21, r.m21, max_abs_diff)
+
+		&& approx_equal(l.m02, r.m02, max_abs_diff)
+		&& approx_equal(l.m12, r.m12, max_abs_diff)
+		&& approx_equal(l.m22, r.m22, max_abs_diff);
+}
+
+inline bool approx_equal(const float4x4& l, const float4x4& r, float max_abs_diff = 1e-5f) noexcept
+{
+	return approx_equal(l.m00, r.m00, max_abs_diff)
+		&& approx_equal(l.m10, r.m10, max_abs_diff)
+		&& approx_equal(l.m20, r.m20, max_abs_diff)
+		&& approx_equal(l.m30, r.m30, max_abs_diff)
+
+		&& approx_equal(l.m01, r.m01, max_abs_diff)
+		&& approx_equal(l.m11, r.m11, max_abs_diff)
+		&& approx_equal(l.m21, r.m21, max_abs_diff)
+		&& approx_equal(l.m31, r.m31, max_abs_diff)
+
+		&& approx_equal(l.m02, r.m02, max_abs_diff)
+		&& approx_equal(l.m12, r.m12, max_abs_diff)
+		&& approx_equal(l.m22, r.m22, max_abs_diff)
+		&& approx_equal(l.m32, r.m32, max_abs_diff)
+
+		&& approx_equal(l.m03, r.m03, max_abs_diff)
+		&& approx_equal(l.m13, r.m13, max_abs_diff)
+		&& approx_equal(l.m23, r.m23, max_abs_diff)
+		&& approx_equal(l.m33, r.m33, max_abs_diff);
+}
+
+inline bool approx_equal(const float3x4& l, const float3x4& r, float max_abs_diff = 1e-5f) noexcept
+{
+	return approx_equal(l.m00, r.m00, max_abs_diff)
+		&& approx_equal(l.m10, r.m10, max_abs_diff)
+		&& approx_equal(l.m20, r.m20, max_abs_diff)
+
+		&& approx_equal(l.m01, r.m01, max_abs_diff)
+		&& approx_equal(l.m11, r.m11, max_abs_diff)
+		&& approx_equal(l.m21, r.m21, max_abs_diff)
+
+		&& approx_equal(l.m02, r.m02, max_abs_diff)
+		&& approx_equal(l.m12, r.m12, max_abs_diff)
+		&& approx_equal(l.m22, r.m22, max_abs_diff)
 
-bool approx_equal(const float4x4& l, const float4x4& r, float max_abs_diff = 1e-5f) noexcept;
+		&& approx_equal(l.m03, r.m03, max_abs_diff)
+		&& approx_equal(l.m13, r.m13, max_abs_diff)
+		&& approx_equal(l.m23, r.m23, max_abs_diff);
+}
 
 //  Calculates the determinant of the matrix m.
 inline float det(const float3x3& m) noexcept
@@ -280,7 +688,28 @@ inline float det(const float3x3& m) noexcept
 }
 
 //  Calculates the determinant of the matrix m.
-float det(const float4x4& m) noexcept;
+inline float det(const float4x4& m) noexcept
+{
+	// find all the required first minors of m.
+	const float minor00 = m.m11*m.m22*m.m33 + m.m12*m.m23*m.m31 + m.m13*m.m21*m.m32
+		- m.m13*m.m22*m.m31 - m.m12*m.m21*m.m33 - m.m11*m.m23*m.m32;
+	const float minor01 = m.m10*m.m22*m.m33 + m.m12*m.m23*m.m30 + m.m13*m.m20*m.m32
+		- m.m13*m.m22*m.m30 - m.m12*m.m20*m.m33 - m.m10*m.m23*m.m32;
+	const float minor02 = m.m10*m.m21*m.m33 + m.m11*m.m23*m.m30 + m.m13*m.m20*m.m31
+		- m.m13*m.m21*m.m30 - m.m11*m.m20*m.m33 - m.m10*m.m23*m.m31;
+	const float minor03 = m.m10*m.m21*m.m32 + m.m11*m.m22*m.m30 + m.m12*m.m20*m.m31
+		- m.m12*m.m21*m.m30 - m.m11*m.m20*m.m32 - m.m10*m.m22*m.m31;
+
+	return m.m00 * minor00 - m.m01 * minor01 + m.m02 * minor02 - m.m03 * minor03;
+}
+
+//  Calculates the determinant of the matrix m.
+// The determinant of an affine matrix equals to the determinant of its upper-left 3x3 part.
+inline float det(const float3x4& m) noexcept
+{
+	return (m.m00 * m.m11 * m.m22) + (m.m01 * m.m12 * m.m20) + (m.m02 * m.m10 * m.m21)
+		- (m.m02 * m.m11 * m.m20) - (m.m01 * m.m10 * m.m22) - (m.m00 * m.m12 * m.m21);
+}
 
 // Computes the inverse of the matrix.
 float3x3 inverse(const float3x3& m);
@@ -288,6 +717,10 @@ float3x3 inverse(const float3x3& m);
 // Computes the inverse of the matrix.
 float4x4 inverse(const float4x4& m) noexcept;
 
+// Computes the inverse of the affine matrix.
+// Only the 3x3 part is inverted by Cramer's rule, which is much cheaper than inverse(float4x4).
+float3x4 inverse(const float3x4& m) noexcept;
+
 // Determines whether the specified matrix is orthogonal.
 inline bool is_orthogonal(const float3x3& m) noexcept
 {
@@ -302,6 +735,27 @@ inline bool is_orthogonal(const float4x4& m) noexcept
 	return approx_equal(abs_d, 1.0f);
 }
 
+// Determines whether the specified matrix is orthogonal.
+inline bool is_orthogonal(const float3x4& m) noexcept
+{
+	const float abs_d = std::abs(det(m));
+	return approx_equal(abs_d, 1.0f);
+}
+
+// Computes the inverse of the rigid transformation (rotation and translation only).
+// The rotation part is transposed, the translation is rotated back and negated.
+// The result is undefined if m contains a scale or a shear, use inverse() instead.
+inline float3x4 inverse_orthonormal(const float3x4& m) noexcept
+{
+	assert(is_orthogonal(m));
+
+	return float3x4(
+		m.m00, m.m10, m.m20, -(m.m00 * m.m03 + m.m10 * m.m13 + m.m20 * m.m23),
+		m.m01, m.m11, m.m21, -(m.m01 * m.m03 + m.m11 * m.m13 + m.m21 * m.m23),
+		m.m02, m.m12, m.m22, -(m.m02 * m.m03 + m.m12 * m.m13 + m.m22 * m.m23)
+	);
+}
+
 // Multiplies matrix by the column vector v. 
 inline float3 mul(const float3x3& m, const float3& v) noexcept
 {
@@ -321,12 +775,16 @@ inline float3 mul(const float3x3& m, const float2& v, float z = 0.0f) noexcept
 // Multiplies the given matrix by the column vector. 
 inline float4 mul(const float4x4& m, const float4& v) noexcept
 {
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	return simd::to<float4>(simd::mat4_mul(&m.m00, simd::load(&v.x)));
+#else
 	return float4(
 		(m.m00 * v.x) + (m.m01 * v.y) + (m.m02 * v.z) + (m.m03 * v.w),
 		(m.m10 * v.x) + (m.m11 * v.y) + (m.m12 * v.z) + (m.m13 * v.w),
 		(m.m20 * v.x) + (m.m21 * v.y) + (m.m22 * v.z) + (m.m23 * v.w),
 		(m.m30 * v.x) + (m.m31 * v.y) + (m.m32 * v.z) + (m.m33 * v.w)
 	);
+#endif
 }
 
 // Multiplies matrix by the column vector float4(v.x, v.y, z, w). 
@@ -341,6 +799,35 @@ inline float4 mul(const float4x4& m, const float3& v, float w = 1.0f) noexcept
 	return mul(m, float4(v.x, v.y, v.z, w));
 }
 
+// Transforms the point p by the affine matrix m: mul(float4x4(m), p, 1.0f).xyz.
+inline float3 transform_point(const float3x4& m, const float3& p) noexcept
+{
+	return float3(
+		(m.m00 * p.x) + (m.m01 * p.y) + (m.m02 * p.z) + m.m03,
+		(m.m10 * p.x) + (m.m11 * p.y) + (m.m12 * p.z) + m.m13,
+		(m.m20 * p.x) + (m.m21 * p.y) + (m.m22 * p.z) + m.m23
+	);
+}
+
+// Transforms the direction d by the affine matrix m: mul(float4x4(m), d, 0.0f).xyz.
+// The translation of m is ignored.
+inline float3 transform_direction(const float3x4& m, const float3& d) noexcept
+{
+	return float3(
+		(m.m00 * d.x) + (m.m01 * d.y) + (m.m02 * d.z),
+		(m.m10 * d.x) + (m.m11 * d.y) + (m.m12 * d.z),
+		(m.m20 * d.x) + (m.m21 * d.y) + (m.m22 * d.z)
+	);
+}
+
+// Multiplies the given matrix by count column vectors: out[i] = mul(m, v[i]).
+// out may be equal to v. The implementation is chosen at run time (see math/dispatch.h).
+void mul(const float4x4& m, const float4* v, float4* out, size_t count) noexcept;
+
+// Post-multiplies count pairs of matrices: out[i] = l[i] * r[i].
+// out may be equal to l or r. The implementation is chosen at run time (see math/dispatch.h).
+void mul(const float4x4* l, const float4x4* r, float4x4* out, size_t count) noexcept;
+
 // Returns the first column of the matrix.
 template<typename M>
 inline float3 ox(const M& matrix) noexcept
@@ -455,12 +942,18 @@ inline float3x3 transpose(const float3x3& m) noexcept
 // Reflects the matrix over its main diagonal to obtain transposed matrix.
 inline float4x4 transpose(const float4x4& m) noexcept
 {
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	float4x4 res;
+	simd::mat4_transpose(&m.m00, &res.m00);
+	return res;
+#else
 	return float4x4(
 		m.m00, m.m10, m.m20, m.m30,
 		m.m01, m.m11, m.m21, m.m31,
 		m.m02, m.m12, m.m22, m.m32,
 		m.m03, m.m13, m.m23, m.m33
 	);
+#endif
 }
 
 } // namespace math
@@ -0,0 +1,626 @@
+#ifndef MATH_MATRIX_DOUBLE_H_
+#define MATH_MATRIX_DOUBLE_H_
+
+#include <iostream>
+#include "math/matrix.h"
+#include "math/vector_double.h"
+
+
+// double3x3 and double4x4 mirror float3x3 and float4x4, see math/vector_double.h.
+
+namespace math {
+
+struct double3x3 final {
+	static const double3x3 identity;
+	static const double3x3 zero;
+
+
+	constexpr double3x3() noexcept = default;
+
+	constexpr double3x3(double m00, double m01, double m02,
+		double m10, double m11, double m12,
+		double m20, double m21, double m22) noexcept
+		: m00(m00), m01(m01), m02(m02),
+		m10(m10), m11(m11), m12(m12),
+		m20(m20), m21(m21), m22(m22)
+	{}
+
+	// Widens the float matrix m.
+	constexpr explicit double3x3(const float3x3& m) noexcept
+		: m00(m.m00), m01(m.m01), m02(m.m02),
+		m10(m.m10), m11(m.m11), m12(m.m12),
+		m20(m.m20), m21(m.m21), m22(m.m22)
+	{}
+
+
+	double3x3& operator+=(const double3x3& m) noexcept
+	{
+		m00 += m.m00; m01 += m.m01; m02 += m.m02;
+		m10 += m.m10; m11 += m.m11; m12 += m.m12;
+		m20 += m.m20; m21 += m.m21; m22 += m.m22;
+		return *this;
+	}
+
+	double3x3& operator-=(const double3x3& m) noexcept
+	{
+		m00 -= m.m00; m01 -= m.m01; m02 -= m.m02;
+		m10 -= m.m10; m11 -= m.m11; m12 -= m.m12;
+		m20 -= m.m20; m21 -= m.m21; m22 -= m.m22;
+		return *this;
+	}
+
+	double3x3& operator*=(double val) noexcept
+	{
+		m00 *= val; m01 *= val; m02 *= val;
+		m10 *= val; m11 *= val; m12 *= val;
+		m20 *= val; m21 *= val; m22 *= val;
+		return *this;
+	}
+
+	// Post-multiplies this matrix with the specified matrix.
+	double3x3& operator*=(const double3x3& m) noexcept;
+
+	double3x3& operator/=(double val) noexcept
+	{
+		assert(!approx_equal(val, 0.0));
+
+		m00 /= val; m01 /= val; m02 /= val;
+		m10 /= val; m11 /= val; m12 /= val;
+		m20 /= val; m21 /= val; m22 /= val;
+		return *this;
+	}
+
+	// Narrows the matrix to float.
+	explicit operator float3x3() const noexcept
+	{
+		return float3x3(
+			float(m00), float(m01), float(m02),
+			float(m10), float(m11), float(m12),
+			float(m20), float(m21), float(m22));
+	}
+
+
+	double m00 = 0, m01 = 0, m02 = 0;
+	double m10 = 0, m11 = 0, m12 = 0;
+	double m20 = 0, m21 = 0, m22 = 0;
+};
+
+struct double4x4 final {
+	static const double4x4 identity;
+	static const double4x4 zero;
+
+
+	constexpr double4x4() noexcept = default;
+
+	constexpr double4x4(double m00, double m01, double m02, double m03,
+		double m10, double m11, double m12, double m13,
+		double m20, double m21, double m22, double m23,
+		double m30, double m31, double m32, double m33) noexcept
+		: m00(m00), m01(m01), m02(m02), m03(m03),
+		m10(m10), m11(m11), m12(m12), m13(m13),
+		m20(m20), m21(m21), m22(m22), m23(m23),
+		m30(m30), m31(m31), m32(m32), m33(m33)
+	{}
+
+	// Widens the float matrix m.
+	constexpr explicit double4x4(const float4x4& m) noexcept
+		: m00(m.m00), m01(m.m01), m02(m.m02), m03(m.m03),
+		m10(m.m10), m11(m.m11), m12(m.m12), m13(m.m13),
+		m20(m.m20), m21(m.m21), m22(m.m22), m23(m.m23),
+		m30(m.m30), m31(m.m31), m32(m.m32), m33(m.m33)
+	{}
+
+
+	double4x4& operator+=(const double4x4& m) noexcept
+	{
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+		for (int i = 0; i < 16; i += 4)
+			simd::store(&m00 + i, simd::load(&m00 + i) + simd::load(&m.m00 + i));
+#else
+		m00 += m.m00; m01 += m.m01; m02 += m.m02; m03 += m.m03;
+		m10 += m.m10; m11 += m.m11; m12 += m.m12; m13 += m.m13;
+		m20 += m.m20; m21 += m.m21; m22 += m.m22; m23 += m.m23;
+		m30 += m.m30; m31 += m.m31; m32 += m.m32; m33 += m.m33;
+#endif
+		return *this;
+	}
+
+	double4x4& operator-=(const double4x4& m) noexcept
+	{
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+		for (int i = 0; i < 16; i += 4)
+			simd::store(&m00 + i, simd::load(&m00 + i) - simd::load(&m.m00 + i));
+#else
+		m00 -= m.m00; m01 -= m.m01; m02 -= m.m02; m03 -= m.m03;
+		m10 -= m.m10; m11 -= m.m11; m12 -= m.m12; m13 -= m.m13;
+		m20 -= m.m20; m21 -= m.m21; m22 -= m.m22; m23 -= m.m23;
+		m30 -= m.m30; m31 -= m.m31; m32 -= m.m32; m33 -= m.m33;
+#endif
+		return *this;
+	}
+
+	double4x4& operator*=(double val) noexcept
+	{
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+		const simd::vdouble4 v = simd::broadcast(val);
+		for (int i = 0; i < 16; i += 4)
+			simd::store(&m00 + i, simd::load(&m00 + i) * v);
+#else
+		m00 *= val; m01 *= val; m02 *= val; m03 *= val;
+		m10 *= val; m11 *= val; m12 *= val; m13 *= val;
+		m20 *= val; m21 *= val; m22 *= val; m23 *= val;
+		m30 *= val; m31 *= val; m32 *= val; m33 *= val;
+#endif
+		return *this;
+	}
+
+	// Post-multiplies this matrix with the specified matrix.
+	double4x4& operator*=(const double4x4& m) noexcept;
+
+	double4x4& operator/=(double val) noexcept
+	{
+		assert(!approx_equal(val, 0.0));
+
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+		const simd::vdouble4 v = simd::broadcast(val);
+		for (int i = 0; i < 16; i += 4)
+			simd::store(&m00 + i, simd::load(&m00 + i) / v);
+#else
+		m00 /= val; m01 /= val; m02 /= val; m03 /= val;
+		m10 /= val; m11 /= val; m12 /= val; m13 /= val;
+		m20 /= val; m21 /= val; m22 /= val; m23 /= val;
+		m30 /= val; m31 /= val; m32 /= val; m33 /= val;
+#endif
+		return *this;
+	}
+
+	explicit operator double3x3() const noexcept
+	{
+		return double3x3(m00, m01, m02, m10, m11, m12, m20, m21, m22);
+	}
+
+	// Narrows the matrix to float.
+	explicit operator float4x4() const noexcept
+	{
+		return float4x4(
+			float(m00), float(m01), float(m02), float(m03),
+			float(m10), float(m11), float(m12), float(m13),
+			float(m20), float(m21), float(m22), float(m23),
+			float(m30), float(m31), float(m32), float(m33));
+	}
+
+
+	double m00 = 0, m01 = 0, m02 = 0, m03 = 0;
+	double m10 = 0, m11 = 0, m12 = 0, m13 = 0;
+	double m20 = 0, m21 = 0, m22 = 0, m23 = 0;
+	double m30 = 0, m31 = 0, m32 = 0, m33 = 0;
+};
+
+
+inline double3x3& double3x3::operator*=(const double3x3& m) noexcept
+{
+	const double mp00 = m00 * m.m00 + m01 * m.m10 + m02 * m.m20,
+		mp01 = m00 * m.m01 + m01 * m.m11 + m02 * m.m21,
+		mp02 = m00 * m.m02 + m01 * m.m12 + m02 * m.m22;
+	const double mp10 = m10 * m.m00 + m11 * m.m10 + m12 * m.m20,
+		mp11 = m10 * m.m01 + m11 * m.m11 + m12 * m.m21,
+		mp12 = m10 * m.m02 + m11 * m.m12 + m12 * m.m22;
+	const double mp20 = m20 * m.m00 + m21 * m.m10 + m22 * m.m20,
+		mp21 = m20 * m.m01 + m21 * m.m11 + m22 * m.m21,
+		mp22 = m20 * m.m02 + m21 * m.m12 + m22 * m.m22;
+
+	m00 = mp00; m01 = mp01; m02 = mp02;
+	m10 = mp10; m11 = mp11; m12 = mp12;
+	m20 = mp20; m21 = mp21; m22 = mp22;
+	return *this;
+}
+
+inline double4x4& double4x4::operator*=(const double4x4& m) noexcept
+{
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	simd::dmat4_mul(&m00, &m.m00, &m00);
+#else
+	const double mp00 = m00 * m.m00 + m01 * m.m10 + m02 * m.m20 + m03 * m.m30,
+		mp01 = m00 * m.m01 + m01 * m.m11 + m02 * m.m21 + m03 * m.m31,
+		mp02 = m00 * m.m02 + m01 * m.m12 + m02 * m.m22 + m03 * m.m32,
+		mp03 = m00 * m.m03 + m01 * m.m13 + m02 * m.m23 + m03 * m.m33;
+	const double mp10 = m10 * m.m00 + m11 * m.m10 + m12 * m.m20 + m13 * m.m30,
+		mp11 = m10 * m.m01 + m11 * m.m11 + m12 * m.m21 + m13 * m.m31,
+		mp12 = m10 * m.m02 + m11 * m.m12 + m12 * m.m22 + m13 * m.m32,
+		mp13 = m10 * m.m03 + m11 * m.m13 + m12 * m.m23 + m13 * m.m33;
+	const double mp20 = m20 * m.m00 + m21 * m.m10 + m22 * m.m20 + m23 * m.m30,
+		mp21 = m20 * m.m01 + m21 * m.m11 + m22 * m.m21 + m23 * m.m31,
+		mp22 = m20 * m.m02 + m21 * m.m12 + m22 * m.m22 + m23 * m.m32,
+		mp23 = m20 * m.m03 + m21 * m.m13 + m22 * m.m23 + m23 * m.m33;
+	const double mp30 = m30 * m.m00 + m31 * m.m10 + m32 * m.m20 + m33 * m.m30,
+		mp31 = m30 * m.m01 + m31 * m.m11 + m32 * m.m21 + m33 * m.m31,
+		mp32 = m30 * m.m02 + m31 * m.m12 + m32 * m.m22 + m33 * m.m32,
+		mp33 = m30 * m.m03 + m31 * m.m13 + m32 * m.m23 + m33 * m.m33;
+
+	m00 = mp00; m01 = mp01; m02 = mp02; m03 = mp03;
+	m10 = mp10; m11 = mp11; m12 = mp12; m13 = mp13;
+	m20 = mp20; m21 = mp21; m22 = mp22; m23 = mp23;
+	m30 = mp30; m31 = mp31; m32 = mp32; m33 = mp33;
+#endif
+	return *this;
+}
+
+inline bool operator==(const double3x3& l, const double3x3& r) noexcept
+{
+	return (l.m00 == r.m00) && (l.m01 == r.m01) && (l.m02 == r.m02)
+		&& (l.m10 == r.m10) && (l.m11 == r.m11) && (l.m12 == r.m12)
+		&& (l.m20 == r.m20) && (l.m21 == r.m21) && (l.m22 == r.m22);
+}
+
+inline bool operator!=(const double3x3& l, const double3x3& r) noexcept
+{
+	return !(l == r);
+}
+
+inline bool operator==(const double4x4& l, const double4x4& r) noexcept
+{
+	return (l.m00 == r.m00) && (l.m01 == r.m01) && (l.m02 == r.m02) && (l.m03 == r.m03)
+		&& (l.m10 == r.m10) && (l.m11 == r.m11) && (l.m12 == r.m12) && (l.m13 == r.m13)
+		&& (l.m20 == r.m20) && (l.m21 == r.m21) && (l.m22 == r.m22) && (l.m23 == r.m23)
+		&& (l.m30 == r.m30) && (l.m31 == r.m31) && (l.m32 == r.m32) && (l.m33 == r.m33);
+}
+
+inline bool operator!=(const double4x4& l, const double4x4& r) noexcept
+{
+	return !(l == r);
+}
+
+inline double3x3 operator+(const double3x3& l, const double3x3& r) noexcept
+{
+	return double3x3(
+		l.m00 + r.m00, l.m01 + r.m01, l.m02 + r.m02,
+		l.m10 + r.m10, l.m11 + r.m11, l.m12 + r.m12,
+		l.m20 + r.m20, l.m21 + r.m21, l.m22 + r.m22
+	);
+}
+
+inline double4x4 operator+(const double4x4& l, const double4x4& r) noexcept
+{
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	double4x4 res;
+	for (int i = 0; i < 16; i += 4)
+		simd::store(&res.m00 + i, simd::load(&l.m00 + i) + simd::load(&r.m00 + i));
+
+	return res;
+#else
+	return double4x4(
+		l.m00 + r.m00, l.m01 + r.m01, l.m02 + r.m02, l.m03 + r.m03,
+		l.m10 + r.m10, l.m11 + r.m11, l.m12 + r.m12, l.m13 + r.m13,
+		l.m20 + r.m20, l.m21 + r.m21, l.m22 + r.m22, l.m23 + r.m23,
+		l.m30 + r.m30, l.m31 + r.m31, l.m32 + r.m32, l.m33 + r.m33
+	);
+#endif
+}
+
+inline double3x3 operator-(const double3x3& l, const double3x3& r) noexcept
+{
+	return double3x3(
+		l.m00 - r.m00, l.m01 - r.m01, l.m02 - r.m02,
+		l.m10 - r.m10, l.m11 - r.m11, l.m12 - r.m12,
+		l.m20 - r.m20, l.m21 - r.m21, l.m22 - r.m22
+	);
+}
+
+inline double4x4 operator-(const double4x4& l, const double4x4& r) noexcept
+{
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	double4x4 res;
+	for (int i = 0; i < 16; i += 4)
+		simd::store(&res.m00 + i, simd::load(&l.m00 + i) - simd::load(&r.m00 + i));
+
+	return res;
+#else
+	return double4x4(
+		l.m00 - r.m00, l.m01 - r.m01, l.m02 - r.m02, l.m03 - r.m03,
+		l.m10 - r.m10, l.m11 - r.m11, l.m12 - r.m12, l.m13 - r.m13,
+		l.m20 - r.m20, l.m21 - r.m21, l.m22 - r.m22, l.m23 - r.m23,
+		l.m30 - r.m30, l.m31 - r.m31, l.m32 - r.m32, l.m33 - r.m33
+	);
+#endif
+}
+
+inline double3x3 operator*(const double3x3& m, double val) noexcept
+{
+	return double3x3(
+		m.m00 * val, m.m01 * val, m.m02 * val,
+		m.m10 * val, m.m11 * val, m.m12 * val,
+		m.m20 * val, m.m21 * val, m.m22 * val
+	);
+}
+
+inline double3x3 operator*(double val, const double3x3& m) noexcept
+{
+	return double3x3(
+		m.m00 * val, m.m01 * val, m.m02 * val,
+		m.m10 * val, m.m11 * val, m.m12 * val,
+		m.m20 * val, m.m21 * val, m.m22 * val
+	);
+}
+
+// Post-multiplies l matrix with r.
+inline double3x3 operator*(const double3x3& l, const double3x3& r) noexcept
+{
+	double3x3 product;
+
+	product.m00 = l.m00 * r.m00 + l.m01 * r.m10 + l.m02 * r.m20;
+	product.m01 = l.m00 * r.m01 + l.m01 * r.m11 + l.m02 * r.m21;
+	product.m02 = l.m00 * r.m02 + l.m01 * r.m12 + l.m02 * r.m22;
+	product.m10 = l.m10 * r.m00 + l.m11 * r.m10 + l.m12 * r.m20;
+	product.m11 = l.m10 * r.m01 + l.m11 * r.m11 + l.m12 * r.m21;
+	product.m12 = l.m10 * r.m02 + l.m11 * r.m12 + l.m12 * r.m22;
+	product.m20 = l.m20 * r.m00 + l.m21 * r.m10 + l.m22 * r.m20;
+	product.m21 = l.m20 * r.m01 + l.m21 * r.m11 + l.m22 * r.m21;
+	product.m22 = l.m20 * r.m02 + l.m21 * r.m12 + l.m22 * r.m22;
+
+	return product;
+}
+
+inline double4x4 operator*(const double4x4& m, double val) noexcept
+{
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	const simd::vdouble4 v = simd::broadcast(val);
+
+	double4x4 res;
+	for (int i = 0; i < 16; i += 4)
+		simd::store(&res.m00 + i, simd::load(&m.m00 + i) * v);
+
+	return res;
+#else
+	return double4x4(
+		m.m00 * val, m.m01 * val, m.m02 * val, m.m03 * val,
+		m.m10 * val, m.m11 * val, m.m12 * val, m.m13 * val,
+		m.m20 * val, m.m21 * val, m.m22 * val, m.m23 * val,
+		m.m30 * val, m.m31 * val, m.m32 * val, m.m33 * val
+	);
+#endif
+}
+
+inline double4x4 operator*(double val, const double4x4& m) noexcept
+{
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	const simd::vdouble4 v = simd::broadcast(val);
+
+	double4x4 res;
+	for (int i = 0; i < 16; i += 4)
+		simd::store(&res.m00 + i, simd::load(&m.m00 + i) * v);
+
+	return res;
+#else
+	return double4x4(
+		m.m00 * val, m.m01 * val, m.m02 * val, m.m03 * val,
+		m.m10 * val, m.m11 * val, m.m12 * val, m.m13 * val,
+		m.m20 * val, m.m21 * val, m.m22 * val, m.m23 * val,
+		m.m30 * val, m.m31 * val, m.m32 * val, m.m33 * val
+	);
+#endif
+}
+
+// Post-multiplies l matrix with r.
+inline double4x4 operator*(const double4x4& l, const double4x4& r) noexcept
+{
+	double4x4 product;
+
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	simd::dmat4_mul(&l.m00, &r.m00, &product.m00);
+#else
+	product.m00 = l.m00 * r.m00 + l.m01 * r.m10 + l.m02 * r.m20 + l.m03 * r.m30;
+	product.m01 = l.m00 * r.m01 + l.m01 * r.m11 + l.m02 * r.m21 + l.m03 * r.m31;
+	product.m02 = l.m00 * r.m02 + l.m01 * r.m12 + l.m02 * r.m22 + l.m03 * r.m32;
+	product.m03 = l.m00 * r.m03 + l.m01 * r.m13 + l.m02 * r.m23 + l.m03 * r.m33;
+	product.m10 = l.m10 * r.m00 + l.m11 * r.m10 + l.m12 * r.m20 + l.m13 * r.m30;
+	product.m11 = l.m10 * r.m01 + l.m11 * r.m11 + l.m12 * r.m21 + l.m13 * r.m31;
+	product.m12 = l.m10 * r.m02 + l.m11 * r.m12 + l.m12 * r.m22 + l.m13 * r.m32;
+	product.m13 = l.m10 * r.m03 + l.m11 * r.m13 + l.m12 * r.m23 + l.m13 * r.m33;
+	product.m20 = l.m20 * r.m00 + l.m21 * r.m10 + l.m22 * r.m20 + l.m23 * r.m30;
+	product.m21 = l.m20 * r.m01 + l.m21 * r.m11 + l.m22 * r.m21 + l.m23 * r.m31;
+	product.m22 = l.m20 * r.m02 + l.m21 * r.m12 + l.m22 * r.m22 + l.m23 * r.m32;
+	product.m23 = l.m20 * r.m03 + l.m21 * r.m13 + l.m22 * r.m23 + l.m23 * r.m33;
+	product.m30 = l.m30 * r.m00 + l.m31 * r.m10 + l.m32 * r.m20 + l.m33 * r.m30;
+	product.m31 = l.m30 * r.m01 + l.m31 * r.m11 + l.m32 * r.m21 + l.m33 * r.m31;
+	product.m32 = l.m30 * r.m02 + l.m31 * r.m12 + l.m32 * r.m22 + l.m33 * r.m32;
+	product.m33 = l.m30 * r.m03 + l.m31 * r.m13 + l.m32 * r.m23 + l.m33 * r.m33;
+#endif
+
+	return product;
+}
+
+inline double3x3 operator/(const double3x3& m, double val) noexcept
+{
+	assert(!approx_equal(val, 0.0));
+
+	return double3x3(
+		m.m00 / val, m.m01 / val, m.m02 / val,
+		m.m10 / val, m.m11 / val, m.m12 / val,
+		m.m20 / val, m.m21 / val, m.m22 / val
+	);
+}
+
+inline double4x4 operator/(const double4x4& m, double val) noexcept
+{
+	assert(!approx_equal(val, 0.0));
+
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	const simd::vdouble4 v = simd::broadcast(val);
+
+	double4x4 res;
+	for (int i = 0; i < 16; i += 4)
+		simd::store(&res.m00 + i, simd::load(&m.m00 + i) / v);
+
+	return res;
+#else
+	return double4x4(
+		m.m00 / val, m.m01 / val, m.m02 / val, m.m03 / val,
+		m.m10 / val, m.m11 / val, m.m12 / val, m.m13 / val,
+		m.m20 / val, m.m21 / val, m.m22 / val, m.m23 / val,
+		m.m30 / val, m.m31 / val, m.m32 / val, m.m33 / val
+	);
+#endif
+}
+
+std::ostream& operator<<(std::ostream& out, const double3x3& m);
+
+std::wostream& operator<<(std::wostream& out, const double3x3& m);
+
+std::ostream& operator<<(std::ostream& out, const double4x4& m);
+
+std::wostream& operator<<(std::wostream& out, const double4x4& m);
+
+inline bool approx_equal(const double3x3& l, const double3x3& r, double max_abs_diff = 1e-5) noexcept
+{
+	return approx_equal(l.m00, r.m00, max_abs_diff)
+		&& approx_equal(l.m10, r.m10, max_abs_diff)
+		&& approx_equal(l.m20, r.m20, max_abs_diff)
+
+		&& approx_equal(l.m01, r.m01, max_abs_diff)
+		&& approx_equal(l.m11, r.m11, max_abs_diff)
+		&& approx_equal(l.m21, r.m21, max_abs_diff)
+
+		&& approx_equal(l.m02, r.m02, max_abs_diff)
+		&& approx_equal(l.m12, r.m12, max_abs_diff)
+		&& approx_equal(l.m22, r.m22, max_abs_diff);
+}
+
+inline bool approx_equal(const double4x4& l, const double4x4& r, double max_abs_diff = 1e-5) noexcept
+{
+	return approx_equal(l.m00, r.m00, max_abs_diff)
+		&& approx_equal(l.m10, r.m10, max_abs_diff)
+		&& approx_equal(l.m20, r.m20, max_abs_diff)
+		&& approx_equal(l.m30, r.m30, max_abs_diff)
+
+		&& approx_equal(l.m01, r.m01, max_abs_diff)
+		&& approx_equal(l.m11, r.m11, max_abs_diff)
+		&& approx_equal(l.m21, r.m21, max_abs_diff)
+		&& approx_equal(l.m31, r.m31, max_abs_diff)
+
+		&& approx_equal(l.m02, r.m02, max_abs_diff)
+		&& approx_equal(l.m12, r.m12, max_abs_diff)
+		&& approx_equal(l.m22, r.m22, max_abs_diff)
+		&& approx_equal(l.m32, r.m32, max_abs_diff)
+
+		&& approx_equal(l.m03, r.m03, max_abs_diff)
+		&& approx_equal(l.m13, r.m13, max_abs_diff)
+		&& approx_equal(l.m23, r.m23, max_abs_diff)
+		&& approx_equal(l.m33, r.m33, max_abs_diff);
+}
+
+//  Calculates the determinant of the matrix m.
+inline double det(const double3x3& m) noexcept
+{
+	return (m.m00 * m.m11 * m.m22) + (m.m01 * m.m12 * m.m20) + (m.m02 * m.m10 * m.m21)
+		- (m.m02 * m.m11 * m.m20) - (m.m01 * m.m10 * m.m22) - (m.m00 * m.m12 * m.m21);
+}
+
+//  Calculates the determinant of the matrix m.
+inline double det(const double4x4& m) noexcept
+{
+	// find all the required first minors of m.
+	const double minor00 = m.m11*m.m22*m.m33 + m.m12*m.m23*m.m31 + m.m13*m.m21*m.m32
+		- m.m13*m.m22*m.m31 - m.m12*m.m21*m.m33 - m.m11*m.m23*m.m32;
+	const double minor01 = m.m10*m.m22*m.m33 + m.m12*m.m23*m.m30 + m.m13*m.m20*m.m32
+		- m.m13*m.m22*m.m30 - m.m12*m.m20*m.m33 - m.m10*m.m23*m.m32;
+	const double minor02 = m.m10*m.m21*m.m33 + m.m11*m.m23*m.m30 + m.m13*m.m20*m.m31
+		- m.m13*m.m21*m.m30 - m.m11*m.m20*m.m33 - m.m10*m.m23*m.m31;
+	const double minor03 = m.m10*m.m21*m.m32 + m.m11*m.m22*m.m30 + m.m12*m.m20*m.m31
+		- m.m12*m.m21*m.m30 - m.m11*m.m20*m.m32 - m.m10*m.m22*m.m31;
+
+	return m.m00 * minor00 - m.m01 * minor01 + m.m02 * minor02 - m.m03 * minor03;
+}
+
+// Computes the inverse of the matrix.
+double3x3 inverse(const double3x3& m) noexcept;
+
+// Computes the inverse of the matrix.
+double4x4 inverse(const double4x4& m) noexcept;
+
+// Determines whether the specified matrix is orthogonal.
+inline bool is_orthogonal(const double3x3& m) noexcept
+{
+	const double abs_d = std::abs(det(m));
+	return approx_equal(abs_d, 1.0);
+}
+
+// Determines whether the specified matrix is orthogonal.
+inline bool is_orthogonal(const double4x4& m) noexcept
+{
+	const double abs_d = std::abs(det(m));
+	return approx_equal(abs_d, 1.0);
+}
+
+// Multiplies matrix by the column vector v. 
+inline double3 mul(const double3x3& m, const double3& v) noexcept
+{
+	return double3(
+		(m.m00 * v.x) + (m.m01 * v.y) + (m.m02 * v.z),
+		(m.m10 * v.x) + (m.m11 * v.y) + (m.m12 * v.z),
+		(m.m20 * v.x) + (m.m21 * v.y) + (m.m22 * v.z)
+	);
+}
+
+// Multiplies the given matrix by the column vector. 
+inline double4 mul(const double4x4& m, const double4& v) noexcept
+{
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	double4 res;
+	simd::store(&res.x, simd::dmat4_mul(&m.m00, simd::load(&v.x)));
+	return res;
+#else
+	return double4(
+		(m.m00 * v.x) + (m.m01 * v.y) + (m.m02 * v.z) + (m.m03 * v.w),
+		(m.m10 * v.x) + (m.m11 * v.y) + (m.m12 * v.z) + (m.m13 * v.w),
+		(m.m20 * v.x) + (m.m21 * v.y) + (m.m22 * v.z) + (m.m23 * v.w),
+		(m.m30 * v.x) + (m.m31 * v.y) + (m.m32 * v.z) + (m.m33 * v.w)
+	);
+#endif
+}
+
+// Multiplies matrix by the column vector double4(v.x, v.y, v.z, w). 
+inline double4 mul(const double4x4& m, const double3& v, double w = 1.0) noexcept
+{
+	return mul(m, double4(v.x, v.y, v.z, w));
+}
+
+// Multiplies the given matrix by count column vectors: out[i] = mul(m, v[i]).
+// out may be equal to v. The implementation is chosen at run time (see math/dispatch.h).
+void mul(const double4x4& m, const double4* v, double4* out, size_t count) noexcept;
+
+// Calculates the sum of the elements on the main diagonal. tr(M).
+inline double trace(const double3x3& m) noexcept
+{
+	return m.m00 + m.m11 + m.m22;
+}
+
+// Calculates the sum of the elements on the main diagonal. tr(M).
+inline double trace(const double4x4& m) noexcept
+{
+	return m.m00 + m.m11 + m.m22 + m.m33;
+}
+
+// Reflects the matrix over its main diagonal to obtain transposed matrix.
+inline double3x3 transpose(const double3x3& m) noexcept
+{
+	return double3x3(
+		m.m00, m.m10, m.m20,
+		m.m01, m.m11, m.m21,
+		m.m02, m.m12, m.m22
+	);
+}
+
+// Reflects the matrix over its main diagonal to obtain transposed matrix.
+inline double4x4 transpose(const double4x4& m) noexcept
+{
+	return double4x4(
+		m.m00, m.m10, m.m20, m.m30,
+		m.m01, m.m11, m.m21, m.m31,
+		m.m02, m.m12, m.m22, m.m32,
+		m.m03, m.m13, m.m23, m.m33
+	);
+}
+
+} // namespace math
+
+#endif // MATH_MATRIX_DOUBLE_H_
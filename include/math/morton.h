@@ -0,0 +1,265 @@
+#ifndef MATH_MORTON_H_
+#define MATH_MORTON_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include "math/aabb.h"
+#include "math/vector_float.h"
+#include "math/vector_int.h"
+
+// MATH_BMI2 is 1 if the compiler is allowed to use the BMI2 instructions (-mbmi2, -march=haswell
+// or /arch:AVX2), then the single value Morton functions are the pdep/pext instructions.
+// Otherwise (or if MATH_NO_BMI2 is defined) the bits are spread with shifts and masks.
+// Define MATH_NO_BMI2 for the AMD CPUs before Zen 3, their pdep and pext are microcoded and slow.
+#if !defined(MATH_NO_BMI2) && (defined(__x86_64__) || defined(_M_X64)) \
+	&& (defined(__BMI2__) || (defined(_MSC_VER) && defined(__AVX2__)))
+	#define MATH_BMI2 1
+	#include <immintrin.h>
+#else
+	#define MATH_BMI2 0
+#endif
+
+
+namespace math {
+
+// The Morton (Z-order) code of a point of an integer grid interleaves the bits of its coordinates:
+// bit i of x goes to bit 2 * i (3 * i) of the code, bit i of y to bit 2 * i + 1 (3 * i + 1) and so on.
+// The points which are close in the grid tend to have close codes, so sorting the points by their codes
+// (see radix_sort) makes the consecutive points close in space and in memory as well.
+//
+// The 2D codes use 16 (32) bits of every coordinate and fill the whole uint32_t (uint64_t).
+// The 3D codes use 10 (21) bits of every coordinate, the highest 2 (1) bits of the code are 0.
+
+namespace detail {
+
+// Inserts a zero bit before each of the lowest 16 bits of v.
+inline uint32_t morton_spread2(uint32_t v) noexcept
+{
+	v = (v | (v << 8)) & 0x00ff00ff;
+	v = (v | (v << 4)) & 0x0f0f0f0f;
+	v = (v | (v << 2)) & 0x33333333;
+	v = (v | (v << 1)) & 0x55555555;
+	return v;
+}
+
+// Inserts a zero bit before each of the lowest 32 bits of v.
+inline uint64_t morton_spread2(uint64_t v) noexcept
+{
+	v = (v | (v << 16)) & 0x0000ffff0000ffff;
+	v = (v | (v << 8)) & 0x00ff00ff00ff00ff;
+	v = (v | (v << 4)) & 0x0f0f0f0f0f0f0f0f;
+	v = (v | (v << 2)) & 0x3333333333333333;
+	v = (v | (v << 1)) & 0x5555555555555555;
+	return v;
+}
+
+// Inserts two zero bits before each of the lowest 10 bits of v.
+inline uint32_t morton_spread3(uint32_t v) noexcept
+{
+	v = (v | (v << 16)) & 0x030000ff;
+	v = (v | (v << 8)) & 0x0300f00f;
+	v = (v | (v << 4)) & 0x030c30c3;
+	v = (v | (v << 2)) & 0x09249249;
+	return v;
+}
+
+// Inserts two zero bits before each of the lowest 21 bits of v.
+inline uint64_t morton_spread3(uint64_t v) noexcept
+{
+	v = (v | (v << 32)) & 0x001f00000000ffff;
+	v = (v | (v << 16)) & 0x001f0000ff0000ff;
+	v = (v | (v << 8)) & 0x100f00f00f00f00f;
+	v = (v | (v << 4)) & 0x10c30c30c30c30c3;
+	v = (v | (v << 2)) & 0x1249249249249249;
+	return v;
+}
+
+// The inverse of morton_spread2: returns every second bit of v starting with bit 0.
+inline uint32_t morton_compact2(uint32_t v) noexcept
+{
+	v &= 0x55555555;
+	v = (v | (v >> 1)) & 0x33333333;
+	v = (v | (v >> 2)) & 0x0f0f0f0f;
+	v = (v | (v >> 4)) & 0x00ff00ff;
+	v = (v | (v >> 8)) & 0x0000ffff;
+	return v;
+}
+
+inline uint64_t morton_compact2(uint64_t v) noexcept
+{
+	v &= 0x5555555555555555;
+	v = (v | (v >> 1)) & 0x3333333333333333;
+	v = (v | (v >> 2)) & 0x0f0f0f0f0f0f0f0f;
+	v = (v | (v >> 4)) & 0x00ff00ff00ff00ff;
+	v = (v | (v >> 8)) & 0x0000ffff0000ffff;
+	v = (v | (v >> 16)) & 0x00000000ffffffff;
+	return v;
+}
+
+// The inverse of morton_spread3: returns every third bit of v starting with bit 0.
+inline uint32_t morton_compact3(uint32_t v) noexcept
+{
+	v &= 0x09249249;
+	v = (v | (v >> 2)) & 0x030c30c3;
+	v = (v | (v >> 4)) & 0x0300f00f;
+	v = (v | (v >> 8)) & 0x030000ff;
+	v = (v | (v >> 16)) & 0x000003ff;
+	return v;
+}
+
+inline uint64_t morton_compact3(uint64_t v) noexcept
+{
+	v &= 0x1249249249249249;
+	v = (v | (v >> 2)) & 0x10c30c30c30c30c3;
+	v = (v | (v >> 4)) & 0x100f00f00f00f00f;
+	v = (v | (v >> 8)) & 0x001f0000ff0000ff;
+	v = (v | (v >> 16)) & 0x001f00000000ffff;
+	v = (v | (v >> 32)) & 0x00000000001fffff;
+	return v;
+}
+
+// Returns the scale of quantize: the number of cells per unit of every axis of bounds.
+// The scale of an axis along which bounds has no extent is 0.
+inline float3 grid_scale(const aabb& bounds, uint32_t bits) noexcept
+{
+	const float cells = float(uint32_t(1) << bits);
+	const float3 e = bounds.max - bounds.min;
+	return float3(
+		(e.x > 0.0f) ? cells / e.x : 0.0f,
+		(e.y > 0.0f) ? cells / e.y : 0.0f,
+		(e.z > 0.0f) ? cells / e.z : 0.0f);
+}
+
+// Returns the cell of p in the grid of 2^bits cells per axis which starts at origin, see grid_scale.
+inline uint3 quantize(const float3& p, const float3& origin, const float3& scale, uint32_t bits) noexcept
+{
+	const float hi = float((uint32_t(1) << bits) - 1);
+	return uint3(
+		uint32_t(std::min(std::max(0.0f, (p.x - origin.x) * scale.x), hi)),
+		uint32_t(std::min(std::max(0.0f, (p.y - origin.y) * scale.y), hi)),
+		uint32_t(std::min(std::max(0.0f, (p.z - origin.z) * scale.z), hi)));
+}
+
+} // namespace detail
+
+
+// Returns the 32-bit code of v, v.x and v.y must be less than 2^16.
+inline uint32_t morton_encode32(const uint2& v) noexcept
+{
+	assert(v.x < (1u << 16) && v.y < (1u << 16));
+
+#if MATH_BMI2
+	return _pdep_u32(v.x, 0x55555555) | _pdep_u32(v.y, 0xaaaaaaaa);
+#else
+	return detail::morton_spread2(v.x) | (detail::morton_spread2(v.y) << 1);
+#endif
+}
+
+// Returns the 30-bit code of v, every component of v must be less than 2^10.
+inline uint32_t morton_encode32(const uint3& v) noexcept
+{
+	assert(v.x < (1u << 10) && v.y < (1u << 10) && v.z < (1u << 10));
+
+#if MATH_BMI2
+	return _pdep_u32(v.x, 0x09249249) | _pdep_u32(v.y, 0x12492492) | _pdep_u32(v.z, 0x24924924);
+#else
+	return detail::morton_spread3(v.x) | (detail::morton_spread3(v.y) << 1) | (detail::morton_spread3(v.z) << 2);
+#endif
+}
+
+// Returns the 64-bit code of v.
+inline uint64_t morton_encode64(const uint2& v) noexcept
+{
+#if MATH_BMI2
+	return _pdep_u64(v.x, 0x5555555555555555) | _pdep_u64(v.y, 0xaaaaaaaaaaaaaaaa);
+#else
+	return detail::morton_spread2(uint64_t(v.x)) | (detail::morton_spread2(uint64_t(v.y)) << 1);
+#endif
+}
+
+// Returns the 63-bit code of v, every component of v must be less than 2^21.
+inline uint64_t morton_encode64(const uint3& v) noexcept
+{
+	assert(v.x < (1u << 21) && v.y < (1u << 21) && v.z < (1u << 21));
+
+#if MATH_BMI2
+	return _pdep_u64(v.x, 0x1249249249249249) | _pdep_u64(v.y, 0x2492492492492492)
+		| _pdep_u64(v.z, 0x4924924924924924);
+#else
+	return detail::morton_spread3(uint64_t(v.x)) | (detail::morton_spread3(uint64_t(v.y)) << 1)
+		| (detail::morton_spread3(uint64_t(v.z)) << 2);
+#endif
+}
+
+// Returns v such that morton_encode32(v) = code.
+inline uint2 morton_decode2(uint32_t code) noexcept
+{
+#if MATH_BMI2
+	return uint2(_pext_u32(code, 0x55555555), _pext_u32(code, 0xaaaaaaaa));
+#else
+	return uint2(detail::morton_compact2(code), detail::morton_compact2(code >> 1));
+#endif
+}
+
+// Returns v such that morton_encode64(v) = code.
+inline uint2 morton_decode2(uint64_t code) noexcept
+{
+#if MATH_BMI2
+	return uint2(uint32_t(_pext_u64(code, 0x5555555555555555)), uint32_t(_pext_u64(code, 0xaaaaaaaaaaaaaaaa)));
+#else
+	return uint2(uint32_t(detail::morton_compact2(code)), uint32_t(detail::morton_compact2(code >> 1)));
+#endif
+}
+
+// Returns v such that morton_encode32(v) = code, the highest 2 bits of code are ignored.
+inline uint3 morton_decode3(uint32_t code) noexcept
+{
+#if MATH_BMI2
+	return uint3(_pext_u32(code, 0x09249249), _pext_u32(code, 0x12492492), _pext_u32(code, 0x24924924));
+#else
+	return uint3(detail::morton_compact3(code), detail::morton_compact3(code >> 1), detail::morton_compact3(code >> 2));
+#endif
+}
+
+// Returns v such that morton_encode64(v) = code, the highest bit of code is ignored.
+inline uint3 morton_decode3(uint64_t code) noexcept
+{
+#if MATH_BMI2
+	return uint3(uint32_t(_pext_u64(code, 0x1249249249249249)), uint32_t(_pext_u64(code, 0x2492492492492492)),
+		uint32_t(_pext_u64(code, 0x4924924924924924)));
+#else
+	return uint3(uint32_t(detail::morton_compact3(code)), uint32_t(detail::morton_compact3(code >> 1)),
+		uint32_t(detail::morton_compact3(code >> 2)));
+#endif
+}
+
+// Returns the cell of p in the grid which divides bounds into 2^bits equal cells along every axis.
+// The points outside of bounds go to the nearest border cell, NaN coordinates go to cell 0, 1 <= bits <= 21.
+inline uint3 quantize(const float3& p, const aabb& bounds, uint32_t bits) noexcept
+{
+	assert(0 < bits && bits <= 21);
+	return detail::quantize(p, bounds.min, detail::grid_scale(bounds, bits), bits);
+}
+
+// The batch Morton functions quantize count points p[i] to the grid over bounds and encode the cells:
+// out[i] = morton_encode32(quantize(p[i], bounds, 10)) and out[i] = morton_encode64(quantize(p[i], bounds, 21)).
+// bounds is usually bounds(p, count). The codes are exactly the same as the ones of the single value functions.
+// The implementation is chosen at run time (see math/dispatch.h).
+
+void morton_encode32(const float3* p, const aabb& bounds, uint32_t* out, size_t count) noexcept;
+
+void morton_encode64(const float3* p, const aabb& bounds, uint64_t* out, size_t count) noexcept;
+
+// Sorts count keys in ascending order with the LSD radix sort, equal keys keep their order.
+// order[i] is set to the original index of the key which ends up at i, so any data attached to the keys
+// can be permuted after them: sorted[i] = data[order[i]]. count must not exceed UINT32_MAX.
+// The sort allocates temporary copies of keys and order, it skips the digits every key has the same.
+void radix_sort(uint32_t* keys, uint32_t* order, size_t count);
+
+void radix_sort(uint64_t* keys, uint32_t* order, size_t count);
+
+} // namespace math
+
+#endif // MATH_MORTON_H_
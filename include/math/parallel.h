@@ -0,0 +1,55 @@
+#ifndef MATH_PARALLEL_H_
+#define MATH_PARALLEL_H_
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+
+
+namespace math {
+
+// thread_pool is the interface of a pool of worker threads provided by the caller.
+// The batch functions which accept a thread_pool* split their work across it, nullptr means the calling thread.
+class thread_pool {
+public:
+
+	virtual ~thread_pool() noexcept = default;
+
+
+	// Returns the number of threads the tasks run on, at least 1.
+	virtual size_t concurrency() const noexcept = 0;
+
+	// Calls task(i) for every i in [0, task_count) and returns when all the calls have returned.
+	// The calls may run concurrently and in any order, the calling thread may run some of them.
+	virtual void run(size_t task_count, const std::function<void(size_t)>& task) = 0;
+};
+
+// Splits [0, count) into ranges of at least grain elements (except for the last one) and calls func(begin, end)
+// for every range. The ranges are processed on the threads of pool, or on the calling thread
+// if pool is nullptr or there is a single range. The range boundaries are multiples of grain.
+template<typename Func>
+void parallel_for(thread_pool* pool, size_t count, size_t grain, Func func)
+{
+	assert(grain > 0);
+
+	const size_t range_count = (count + grain - 1) / grain;
+	if (pool == nullptr || range_count <= 1) {
+		if (count > 0) func(size_t(0), count);
+		return;
+	}
+
+	// a few tasks per thread balance the load when some of them finish earlier.
+	const size_t max_task_count = 4 * pool->concurrency();
+	const size_t task_count = (range_count < max_task_count) ? range_count : max_task_count;
+	const size_t task_size = ((range_count + task_count - 1) / task_count) * grain;
+
+	pool->run((count + task_size - 1) / task_size, [&](size_t t) {
+		const size_t begin = t * task_size;
+		const size_t end = (count - begin < task_size) ? count : begin + task_size;
+		func(begin, end);
+	});
+}
+
+} // namespace math
+
+#endif // MATH_PARALLEL_H_
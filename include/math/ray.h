@@ -0,0 +1,164 @@
+#ifndef MATH_RAY_H_
+#define MATH_RAY_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <ostream>
+#include "math/aabb.h"
+#include "math/vector_float.h"
+#include "math/vector_soa.h"
+
+
+namespace math {
+
+// ray is the set of points origin + t * direction, t >= 0.
+// The direction does not have to be a unit vector, the hit distances t are measured in its lengths.
+struct ray final {
+
+	constexpr ray() noexcept = default;
+
+	constexpr ray(const float3& origin, const float3& direction) noexcept : origin(origin), direction(direction) {}
+
+
+	float3 origin;
+	float3 direction;
+};
+
+
+inline bool operator==(const ray& l, const ray& r) noexcept
+{
+	return (l.origin == r.origin) && (l.direction == r.direction);
+}
+
+inline bool operator!=(const ray& l, const ray& r) noexcept
+{
+	return !(l == r);
+}
+
+std::ostream& operator<<(std::ostream& out, const ray& r);
+
+std::wostream& operator<<(std::wostream& out, const ray& r);
+
+// Returns true if the origins and the directions of l and r differ by no more than max_abs_diff in every component.
+inline bool approx_equal(const ray& l, const ray& r, float max_abs_diff = 1e-5f) noexcept
+{
+	return approx_equal(l.origin, r.origin, max_abs_diff) && approx_equal(l.direction, r.direction, max_abs_diff);
+}
+
+// Returns the point of the ray at the distance t.
+inline float3 point_at(const ray& r, float t) noexcept
+{
+	return r.origin + t * r.direction;
+}
+
+// The intersection functions below return true if the ray hits the primitive at a distance from [0, t_max]
+// and set t to the distance of the nearest such hit, t is not changed otherwise.
+
+// Tests the box with the slab method. If the origin is inside the box t is 0.
+// Zero direction components are allowed unless the origin lies exactly on a plane of the box
+// perpendicular to them.
+inline bool intersects(const ray& r, const aabb& b, float t_max, float& t) noexcept
+{
+	const float* o = &r.origin.x;
+	const float* d = &r.direction.x;
+	const float* lo = &b.min.x;
+	const float* hi = &b.max.x;
+
+	float t_near = 0.0f;
+	float t_far = t_max;
+	for (size_t k = 0; k < 3; ++k) {
+		const float inv_d = 1.0f / d[k];
+		const float t0 = (lo[k] - o[k]) * inv_d;
+		const float t1 = (hi[k] - o[k]) * inv_d;
+		t_near = std::max(t_near, std::min(t0, t1));
+		t_far = std::min(t_far, std::max(t0, t1));
+	}
+
+	if (t_near > t_far) return false;
+
+	t = t_near;
+	return true;
+}
+
+// Tests the sphere. If the origin is inside the sphere t is the distance of the exit point.
+inline bool intersects(const ray& r, const float3& center, float radius, float t_max, float& t) noexcept
+{
+	assert(radius >= 0.0f);
+
+	// |oc + t * d|^2 = radius^2 is a * t^2 + 2 * b * t + c = 0.
+	const float3 oc = r.origin - center;
+	const float a = dot(r.direction, r.direction);
+	const float b = dot(oc, r.direction);
+	const float c = dot(oc, oc) - radius * radius;
+	const float disc = b * b - a * c;
+	if (disc < 0.0f) return false;
+
+	const float sq = std::sqrt(disc);
+	const float t0 = (-b - sq) / a;
+	const float t1 = (-b + sq) / a;
+	const float th = (t0 >= 0.0f) ? t0 : t1;
+	if (!(th >= 0.0f && th <= t_max)) return false;
+
+	t = th;
+	return true;
+}
+
+// Tests the triangle (v0, v1, v2) with the Moller-Trumbore algorithm, both sides of the triangle are hit.
+// Rays parallel to the plane of the triangle miss it.
+inline bool intersects(const ray& r, const float3& v0, const float3& v1, const float3& v2,
+	float t_max, float& t) noexcept
+{
+	const float3 e1 = v1 - v0;
+	const float3 e2 = v2 - v0;
+	const float3 p = cross(r.direction, e2);
+	const float det = dot(e1, p);
+	if (det == 0.0f) return false;
+
+	// u and v are the barycentric coordinates of the hit point.
+	const float inv_det = 1.0f / det;
+	const float3 s = r.origin - v0;
+	const float u = dot(s, p) * inv_det;
+	const float3 q = cross(s, e1);
+	const float v = dot(r.direction, q) * inv_det;
+	const float th = dot(e2, q) * inv_det;
+	if (!(u >= 0.0f && v >= 0.0f && u + v <= 1.0f && th >= 0.0f && th <= t_max)) return false;
+
+	t = th;
+	return true;
+}
+
+
+// The batch functions below test either a single ray against many primitives or many rays
+// against a single primitive, whole SIMD registers (4, 8 or 16 lanes) of them at a time.
+// t[i] is set to the distance of the hit as the functions above do or to +infinity if there is no hit.
+// t must hold count values, where count is the size of the SoA arrays.
+// The implementation is chosen at run time (see math/dispatch.h).
+
+// Tests the ray against the axis-aligned boxes [min[i], max[i]].
+void intersects(const ray& r, const float3_soa& min, const float3_soa& max, float t_max, float* t) noexcept;
+
+// Tests the ray against the spheres whose centers are (x, y, z) and radii are w.
+void intersects(const ray& r, const float4_soa& spheres, float t_max, float* t) noexcept;
+
+// Tests the ray against the triangles (v0[i], v1[i], v2[i]).
+void intersects(const ray& r, const float3_soa& v0, const float3_soa& v1, const float3_soa& v2,
+	float t_max, float* t) noexcept;
+
+// Tests the rays (origins[i], directions[i]) against the box, t_max[i] is the maximum distance of ray i.
+void intersects(const float3_soa& origins, const float3_soa& directions, const float* t_max,
+	const aabb& b, float* t) noexcept;
+
+// Tests the rays against the sphere, see above.
+void intersects(const float3_soa& origins, const float3_soa& directions, const float* t_max,
+	const float3& center, float radius, float* t) noexcept;
+
+// Tests the rays against the triangle (v0, v1, v2), see above.
+void intersects(const float3_soa& origins, const float3_soa& directions, const float* t_max,
+	const float3& v0, const float3& v1, const float3& v2, float* t) noexcept;
+
+} // namespace math
+
+#endif // MATH_RAY_H_
@@ -0,0 +1,351 @@
+#ifndef MATH_SIMD_H_
+#define MATH_SIMD_H_
+
+// MATH_SIMD selects at compile time the instruction set which is used to implement
+// float4, quat, float3x4 and float4x4 arithmetic. Define it to one of the values below
+// (usually on the compiler's command line) and enable the same instruction set for the compiler
+// (-msse4.1, -mavx2 -mfma, -mavx512f or /arch:AVX2, /arch:AVX512).
+// -	MATH_SIMD_SCALAR:	plain C++ code. This is the default.
+// -	MATH_SIMD_SSE4_1:	SSE4.1 intrinsics, double4 and double4x4 use pairs of SSE2 registers.
+// -	MATH_SIMD_AVX2:		SSE4.1 intrinsics + FMA, 256-bit float4x4 multiplication, 256-bit double4.
+// -	MATH_SIMD_AVX512:	AVX2 + 512-bit float4x4 multiplication.
+// The results of SIMD and scalar code are approximately equal (see approx_equal).
+#define MATH_SIMD_SCALAR	0
+#define MATH_SIMD_SSE4_1	1
+#define MATH_SIMD_AVX2		2
+#define MATH_SIMD_AVX512	3
+
+#ifndef MATH_SIMD
+	#define MATH_SIMD MATH_SIMD_SCALAR
+#endif
+
+#if (MATH_SIMD < MATH_SIMD_SCALAR) || (MATH_SIMD > MATH_SIMD_AVX512)
+	#error MATH_SIMD must be one of MATH_SIMD_SCALAR, MATH_SIMD_SSE4_1, MATH_SIMD_AVX2 or MATH_SIMD_AVX512.
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+	#if (MATH_SIMD >= MATH_SIMD_SSE4_1) && !defined(__SSE4_1__)
+		#error MATH_SIMD requires SSE4.1 to be enabled (-msse4.1).
+	#endif
+	#if (MATH_SIMD >= MATH_SIMD_AVX2) && !(defined(__AVX2__) && defined(__FMA__))
+		#error MATH_SIMD requires AVX2 and FMA to be enabled (-mavx2 -mfma).
+	#endif
+	#if (MATH_SIMD >= MATH_SIMD_AVX512) && !defined(__AVX512F__)
+		#error MATH_SIMD requires AVX-512F to be enabled (-mavx512f).
+	#endif
+#endif
+
+#if (MATH_SIMD >= MATH_SIMD_AVX2)
+	#include <immintrin.h>
+#elif (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	#include <smmintrin.h>
+#endif
+
+
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+
+namespace math {
+namespace simd {
+
+// Loads 4 consecutive floats. p does not have to be aligned.
+inline __m128 load(const float* p) noexcept
+{
+	return _mm_loadu_ps(p);
+}
+
+// Stores 4 floats into the consecutive memory starting at p. p does not have to be aligned.
+inline void store(float* p, __m128 v) noexcept
+{
+	_mm_storeu_ps(p, v);
+}
+
+// Returns T (float4, quat) whose 4 components are taken from v.
+template<typename T>
+inline T to(__m128 v) noexcept
+{
+	static_assert(sizeof(T) == sizeof(__m128), "T must consist of 4 floats.");
+
+	T res;
+	_mm_storeu_ps(reinterpret_cast<float*>(&res), v);
+	return res;
+}
+
+// Returns the vector (v[x], v[y], v[z], v[w]).
+template<int x, int y, int z, int w>
+inline __m128 shuffle(__m128 v) noexcept
+{
+	return _mm_shuffle_ps(v, v, _MM_SHUFFLE(w, z, y, x));
+}
+
+// Returns a vector whose every component equals to the i-th component of v.
+template<int i>
+inline __m128 splat(__m128 v) noexcept
+{
+	return shuffle<i, i, i, i>(v);
+}
+
+// Returns (a * b) + c.
+inline __m128 mul_add(__m128 a, __m128 b, __m128 c) noexcept
+{
+#if (MATH_SIMD >= MATH_SIMD_AVX2)
+	return _mm_fmadd_ps(a, b, c);
+#else
+	return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+}
+
+// Returns a vector whose every component equals to the dot product of l and r.
+inline __m128 dot(__m128 l, __m128 r) noexcept
+{
+	return _mm_dp_ps(l, r, 0xff);
+}
+
+// Flips sign bits of the components that are marked in the mask (x = bit 0, ..., w = bit 3).
+template<int mask>
+inline __m128 negate(__m128 v) noexcept
+{
+	const __m128 sign = _mm_castsi128_ps(_mm_setr_epi32(
+		(mask & 1) ? int(0x80000000) : 0,
+		(mask & 2) ? int(0x80000000) : 0,
+		(mask & 4) ? int(0x80000000) : 0,
+		(mask & 8) ? int(0x80000000) : 0));
+
+	return _mm_xor_ps(v, sign);
+}
+
+// Returns the absolute value of each component of v.
+inline __m128 abs(__m128 v) noexcept
+{
+	return _mm_andnot_ps(_mm_set1_ps(-0.0f), v);
+}
+
+// Returns 1 / sqrt(v): the hardware estimate (relative error <= 1.5 * 2^-12) refined by one Newton-Raphson step.
+// The relative error of the result is below 5e-7. Zero components give NaN.
+inline __m128 rsqrt(__m128 v) noexcept
+{
+	const __m128 y = _mm_rsqrt_ps(v);
+	const __m128 half_vy = _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), v), y);
+	return _mm_mul_ps(y, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(half_vy, y)));
+}
+
+// Checks whether every component of l equals to the corresponding component of r.
+inline bool all_equal(__m128 l, __m128 r) noexcept
+{
+	return _mm_movemask_ps(_mm_cmpeq_ps(l, r)) == 0xf;
+}
+
+// Calculates the Hamilton product of l and r quaternions. Both are stored as (x, y, z, a).
+inline __m128 quat_mul(__m128 l, __m128 r) noexcept
+{
+	// x = (l.a * r.x) + (l.x * r.a) + (l.y * r.z) - (l.z * r.y)
+	// y = (l.a * r.y) + (l.y * r.a) + (l.z * r.x) - (l.x * r.z)
+	// z = (l.a * r.z) + (l.z * r.a) + (l.x * r.y) - (l.y * r.x)
+	// a = (l.a * r.a) - (l.x * r.x) - (l.y * r.y) - (l.z * r.z)
+	const __m128 t0 = _mm_mul_ps(splat<3>(l), r);
+	const __m128 t1 = _mm_mul_ps(shuffle<0, 1, 2, 0>(l), shuffle<3, 3, 3, 0>(r));
+	const __m128 t2 = _mm_mul_ps(shuffle<1, 2, 0, 1>(l), shuffle<2, 0, 1, 1>(r));
+	const __m128 t3 = _mm_mul_ps(shuffle<2, 0, 1, 2>(l), shuffle<1, 2, 0, 2>(r));
+
+	return _mm_sub_ps(_mm_add_ps(_mm_add_ps(t0, negate<8>(t1)), negate<8>(t2)), t3);
+}
+
+// Multiplies the row-major 4x4 matrix m by the column vector v.
+inline __m128 mat4_mul(const float* m, __m128 v) noexcept
+{
+	const __m128 p0 = _mm_mul_ps(load(m), v);
+	const __m128 p1 = _mm_mul_ps(load(m + 4), v);
+	const __m128 p2 = _mm_mul_ps(load(m + 8), v);
+	const __m128 p3 = _mm_mul_ps(load(m + 12), v);
+
+	return _mm_hadd_ps(_mm_hadd_ps(p0, p1), _mm_hadd_ps(p2, p3));
+}
+
+// Post-multiplies the row-major 4x4 matrix l with r and stores the product into out.
+// out may point to either l or r.
+inline void mat4_mul(const float* l, const float* r, float* out) noexcept
+{
+#if (MATH_SIMD >= MATH_SIMD_AVX512)
+	// every 128-bit lane of lm holds a row of l, every lane of r* holds the same row of r.
+	// The zero-masking forms with a full mask are the same instructions, the unmasked ones make GCC 12
+	// report its own _mm512_undefined_ps as uninitialized.
+	const __m512 lm = _mm512_loadu_ps(l);
+	const __m512 r0 = _mm512_maskz_broadcast_f32x4(0xffff, load(r));
+	const __m512 r1 = _mm512_maskz_broadcast_f32x4(0xffff, load(r + 4));
+	const __m512 r2 = _mm512_maskz_broadcast_f32x4(0xffff, load(r + 8));
+	const __m512 r3 = _mm512_maskz_broadcast_f32x4(0xffff, load(r + 12));
+
+	__m512 res = _mm512_mul_ps(_mm512_maskz_permute_ps(0xffff, lm, 0x00), r0);
+	res = _mm512_fmadd_ps(_mm512_maskz_permute_ps(0xffff, lm, 0x55), r1, res);
+	res = _mm512_fmadd_ps(_mm512_maskz_permute_ps(0xffff, lm, 0xaa), r2, res);
+	res = _mm512_fmadd_ps(_mm512_maskz_permute_ps(0xffff, lm, 0xff), r3, res);
+	_mm512_storeu_ps(out, res);
+
+#elif (MATH_SIMD >= MATH_SIMD_AVX2)
+	// two rows of l are processed at once, every 128-bit lane of r* holds the same row of r.
+	const __m256 r0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(r));
+	const __m256 r1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(r + 4));
+	const __m256 r2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(r + 8));
+	const __m256 r3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(r + 12));
+
+	for (int i = 0; i < 16; i += 8) {
+		const __m256 lm = _mm256_loadu_ps(l + i);
+
+		__m256 res = _mm256_mul_ps(_mm256_permute_ps(lm, 0x00), r0);
+		res = _mm256_fmadd_ps(_mm256_permute_ps(lm, 0x55), r1, res);
+		res = _mm256_fmadd_ps(_mm256_permute_ps(lm, 0xaa), r2, res);
+		res = _mm256_fmadd_ps(_mm256_permute_ps(lm, 0xff), r3, res);
+		_mm256_storeu_ps(out + i, res);
+	}
+
+#else
+	const __m128 r0 = load(r);
+	const __m128 r1 = load(r + 4);
+	const __m128 r2 = load(r + 8);
+	const __m128 r3 = load(r + 12);
+
+	for (int i = 0; i < 16; i += 4) {
+		const __m128 row = load(l + i);
+
+		__m128 res = _mm_mul_ps(splat<0>(row), r0);
+		res = mul_add(splat<1>(row), r1, res);
+		res = mul_add(splat<2>(row), r2, res);
+		res = mul_add(splat<3>(row), r3, res);
+		store(out + i, res);
+	}
+#endif
+}
+
+// Post-multiplies the row-major 3x4 affine matrix l with r and stores the product into out.
+// The implicit last row of both matrices is (0, 0, 0, 1). out may point to either l or r.
+inline void affine_mul(const float* l, const float* r, float* out) noexcept
+{
+	const __m128 r0 = load(r);
+	const __m128 r1 = load(r + 4);
+	const __m128 r2 = load(r + 8);
+
+	for (int i = 0; i < 12; i += 4) {
+		const __m128 row = load(l + i);
+
+		// the translation of l is added as is: row.w * (0, 0, 0, 1).
+		__m128 res = _mm_blend_ps(_mm_setzero_ps(), row, 0x8);
+		res = mul_add(splat<0>(row), r0, res);
+		res = mul_add(splat<1>(row), r1, res);
+		res = mul_add(splat<2>(row), r2, res);
+		store(out + i, res);
+	}
+}
+
+// Transposes the row-major 4x4 matrix m and stores the result into out. out may point to m.
+inline void mat4_transpose(const float* m, float* out) noexcept
+{
+	__m128 r0 = load(m);
+	__m128 r1 = load(m + 4);
+	__m128 r2 = load(m + 8);
+	__m128 r3 = load(m + 12);
+	_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+	store(out, r0);
+	store(out + 4, r1);
+	store(out + 8, r2);
+	store(out + 12, r3);
+}
+
+// ----- double -----
+
+#if (MATH_SIMD >= MATH_SIMD_AVX2)
+
+// Holds 4 doubles.
+struct vdouble4 { __m256d v; };
+
+inline vdouble4 load(const double* p) noexcept { return { _mm256_loadu_pd(p) }; }
+inline void store(double* p, vdouble4 a) noexcept { _mm256_storeu_pd(p, a.v); }
+inline vdouble4 broadcast(double d) noexcept { return { _mm256_set1_pd(d) }; }
+
+inline vdouble4 operator+(vdouble4 l, vdouble4 r) noexcept { return { _mm256_add_pd(l.v, r.v) }; }
+inline vdouble4 operator-(vdouble4 l, vdouble4 r) noexcept { return { _mm256_sub_pd(l.v, r.v) }; }
+inline vdouble4 operator*(vdouble4 l, vdouble4 r) noexcept { return { _mm256_mul_pd(l.v, r.v) }; }
+inline vdouble4 operator/(vdouble4 l, vdouble4 r) noexcept { return { _mm256_div_pd(l.v, r.v) }; }
+inline vdouble4 mul_add(vdouble4 a, vdouble4 b, vdouble4 c) noexcept { return { _mm256_fmadd_pd(a.v, b.v, c.v) }; }
+
+// Returns (a.x + a.y + a.z + a.w, b.x + ..., c.x + ..., d.x + ...).
+inline vdouble4 horizontal_sums(vdouble4 a, vdouble4 b, vdouble4 c, vdouble4 d) noexcept
+{
+	const __m256d ab = _mm256_hadd_pd(a.v, b.v);	// a0+a1 b0+b1 a2+a3 b2+b3
+	const __m256d cd = _mm256_hadd_pd(c.v, d.v);	// c0+c1 d0+d1 c2+c3 d2+d3
+	const __m256d lo = _mm256_permute2f128_pd(ab, cd, 0x20);
+	const __m256d hi = _mm256_permute2f128_pd(ab, cd, 0x31);
+	return { _mm256_add_pd(lo, hi) };
+}
+
+#else
+
+// Holds 4 doubles in a pair of SSE2 registers.
+struct vdouble4 { __m128d lo, hi; };
+
+inline vdouble4 load(const double* p) noexcept { return { _mm_loadu_pd(p), _mm_loadu_pd(p + 2) }; }
+
+inline void store(double* p, vdouble4 a) noexcept
+{
+	_mm_storeu_pd(p, a.lo);
+	_mm_storeu_pd(p + 2, a.hi);
+}
+
+inline vdouble4 broadcast(double d) noexcept { return { _mm_set1_pd(d), _mm_set1_pd(d) }; }
+
+inline vdouble4 operator+(vdouble4 l, vdouble4 r) noexcept { return { _mm_add_pd(l.lo, r.lo), _mm_add_pd(l.hi, r.hi) }; }
+inline vdouble4 operator-(vdouble4 l, vdouble4 r) noexcept { return { _mm_sub_pd(l.lo, r.lo), _mm_sub_pd(l.hi, r.hi) }; }
+inline vdouble4 operator*(vdouble4 l, vdouble4 r) noexcept { return { _mm_mul_pd(l.lo, r.lo), _mm_mul_pd(l.hi, r.hi) }; }
+inline vdouble4 operator/(vdouble4 l, vdouble4 r) noexcept { return { _mm_div_pd(l.lo, r.lo), _mm_div_pd(l.hi, r.hi) }; }
+inline vdouble4 mul_add(vdouble4 a, vdouble4 b, vdouble4 c) noexcept { return (a * b) + c; }
+
+// Returns (a.x + a.y + a.z + a.w, b.x + ..., c.x + ..., d.x + ...).
+inline vdouble4 horizontal_sums(vdouble4 a, vdouble4 b, vdouble4 c, vdouble4 d) noexcept
+{
+	const __m128d ab = _mm_hadd_pd(_mm_add_pd(a.lo, a.hi), _mm_add_pd(b.lo, b.hi));
+	const __m128d cd = _mm_hadd_pd(_mm_add_pd(c.lo, c.hi), _mm_add_pd(d.lo, d.hi));
+	return { ab, cd };
+}
+
+#endif // (MATH_SIMD >= MATH_SIMD_AVX2)
+
+// Returns the dot product of l and r.
+inline double dot(vdouble4 l, vdouble4 r) noexcept
+{
+	const vdouble4 p = l * r;
+	double tmp[4];
+	store(tmp, p);
+	return (tmp[0] + tmp[1]) + (tmp[2] + tmp[3]);
+}
+
+// Multiplies the row-major 4x4 matrix m by the column vector v.
+inline vdouble4 dmat4_mul(const double* m, vdouble4 v) noexcept
+{
+	return horizontal_sums(load(m) * v, load(m + 4) * v, load(m + 8) * v, load(m + 12) * v);
+}
+
+// Post-multiplies the row-major 4x4 matrix l with r and stores the product into out.
+// out may point to either l or r.
+inline void dmat4_mul(const double* l, const double* r, double* out) noexcept
+{
+	const vdouble4 r0 = load(r);
+	const vdouble4 r1 = load(r + 4);
+	const vdouble4 r2 = load(r + 8);
+	const vdouble4 r3 = load(r + 12);
+
+	for (int i = 0; i < 16; i += 4) {
+		const double l0 = l[i], l1 = l[i + 1], l2 = l[i + 2], l3 = l[i + 3];
+
+		vdouble4 res = broadcast(l0) * r0;
+		res = mul_add(broadcast(l1), r1, res);
+		res = mul_add(broadcast(l2), r2, res);
+		res = mul_add(broadcast(l3), r3, res);
+		store(out + i, res);
+	}
+}
+
+} // namespace simd
+} // namespace math
+
+#endif // (MATH_SIMD >= MATH_SIMD_SSE4_1)
+
+#endif // MATH_SIMD_H_
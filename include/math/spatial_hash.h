@@ -0,0 +1,181 @@
+#ifndef MATH_SPATIAL_HASH_H_
+#define MATH_SPATIAL_HASH_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "math/parallel.h"
+#include "math/vector_float.h"
+#include "math/vector_int.h"
+
+
+namespace math {
+
+// spatial_hash is a uniform grid of cubic cells over points, it finds the points within a radius
+// of a given position by testing only the points of the cells the sphere overlaps.
+// The cells are int3, the cell of p is floor(p / cell_size). The grid is unbounded: only the cells
+// which have points are stored, in an open addressing (linear probing) hash table.
+//
+// build sorts the point indices and copies the positions by cell, so the points of a cell are
+// contiguous and a query reads a few short arrays. The structure is meant to be rebuilt from scratch
+// every time the points move (every frame of a simulation), the memory is reused by the next build.
+//
+// The cell size is usually about the query radius: a query tests 8 to 27 cells then.
+class spatial_hash final {
+public:
+
+	// The cells are clamped to [-max_cell, max_cell] along every axis. The points further away are still
+	// found by the queries, they share the border cells.
+	static constexpr int32_t max_cell = (1 << 20) - 1;
+
+
+	spatial_hash() noexcept = default;
+
+	// cell_size must be positive.
+	explicit spatial_hash(float cell_size) noexcept;
+
+
+	// Returns the cell of p. The components are clamped before the conversion to int32_t,
+	// a NaN coordinate goes to the cell -max_cell.
+	int3 cell(const float3& p) const noexcept
+	{
+		const float m = float(max_cell);
+		return int3(
+			int32_t(std::min(std::max(-m, std::floor(p.x * inv_cell_size_)), m)),
+			int32_t(std::min(std::max(-m, std::floor(p.y * inv_cell_size_)), m)),
+			int32_t(std::min(std::max(-m, std::floor(p.z * inv_cell_size_)), m)));
+	}
+
+	float cell_size() const noexcept
+	{
+		return cell_size_;
+	}
+
+	// Replaces the points with count positions[i], i is the index of a point the queries report.
+	// If pool is not nullptr the points are hashed and sorted by cell on its threads,
+	// the order of the points within a cell (and so of the query results) is not deterministic then.
+	// count must not exceed UINT32_MAX.
+	void build(const float3* positions, size_t count, thread_pool* pool = nullptr);
+
+	// Returns the number of points of the cell c and sets indices to their indices (see point_indices).
+	size_t find(const int3& c, const uint32_t*& indices) const noexcept;
+
+	// Calls func(uint32_t index) for every point whose distance to center is not greater than radius.
+	template<typename Func>
+	void query(const float3& center, float radius, Func func) const;
+
+	// Finds the points within radius of every center[i] as the function above does: the indices of the points
+	// of center i are neighbors[offsets[i]], ..., neighbors[offsets[i + 1] - 1]. offsets gets count + 1 values.
+	// If pool is not nullptr the queries run on its threads, the results are the same.
+	void query(const float3* centers, size_t count, float radius,
+		std::vector<uint32_t>& offsets, std::vector<uint32_t>& neighbors, thread_pool* pool = nullptr) const;
+
+	// Returns the number of cells which have points.
+	size_t cell_count() const noexcept
+	{
+		return cell_count_;
+	}
+
+	// Returns the point indices sorted by cell.
+	const uint32_t* point_indices() const noexcept
+	{
+		return indices_.data();
+	}
+
+	// Returns the number of points.
+	size_t size() const noexcept
+	{
+		return indices_.size();
+	}
+
+private:
+
+	// The key of an empty slot, the keys of the cells (see cell_key) are less than 2^63.
+	static constexpr uint64_t empty_key = UINT64_MAX;
+
+	// A slot of the table: the points of the cell key are [begin, end) in indices_ and positions_.
+	// The fields are atomic for the threads of build, a query reads a single cache line per cell.
+	struct slot final {
+		std::atomic<uint64_t> key;
+		uint32_t begin;
+		std::atomic<uint32_t> end;
+	};
+
+	// Packs the components of c (21 bits each, offset by max_cell) into a key.
+	static uint64_t cell_key(const int3& c) noexcept
+	{
+		assert(-max_cell <= c.x && c.x <= max_cell);
+		assert(-max_cell <= c.y && c.y <= max_cell);
+		assert(-max_cell <= c.z && c.z <= max_cell);
+		return uint64_t(c.x + max_cell) | (uint64_t(c.y + max_cell) << 21) | (uint64_t(c.z + max_cell) << 42);
+	}
+
+	// Returns the first slot of the probe sequence of key. The runs of 4 cells along x are hashed together
+	// into consecutive slots, so their points are consecutive as well and a query reads fewer cache lines.
+	size_t home_slot(uint64_t key) const noexcept
+	{
+		return (size_t(((key >> 2) * 0x9e3779b97f4a7c15) >> hash_shift_) + size_t(key & 3)) & (slots_.size() - 1);
+	}
+
+	// Returns the slot of the cell key or nullptr if the cell has no points.
+	const slot* find_slot(uint64_t key) const noexcept
+	{
+		if (cell_count_ == 0) return nullptr;
+
+		const size_t mask = slots_.size() - 1;
+		for (size_t s = home_slot(key);; s = (s + 1) & mask) {
+			const uint64_t k = slots_[s].key.load(std::memory_order_relaxed);
+			if (k == key) return &slots_[s];
+			if (k == empty_key) return nullptr;
+		}
+	}
+
+	// Returns the slot of key inserting it if there is none, build makes sure there is a free slot.
+	size_t insert(uint64_t key) noexcept;
+
+
+	float cell_size_ = 1.0f;
+	float inv_cell_size_ = 1.0f;
+	// The table of the cells, its size is a power of 2 at least twice the number of points.
+	std::vector<slot> slots_;
+	size_t hash_shift_ = 64;
+	size_t cell_count_ = 0;
+	// The point indices and positions sorted by cell.
+	std::vector<uint32_t> indices_;
+	std::vector<float3> positions_;
+	// The slot of the cell of every point, used by build.
+	std::vector<uint32_t> point_slots_;
+};
+
+
+template<typename Func>
+void spatial_hash::query(const float3& center, float radius, Func func) const
+{
+	assert(radius >= 0.0f);
+	if (cell_count_ == 0) return;
+
+	const int3 lo = cell(center - float3(radius));
+	const int3 hi = cell(center + float3(radius));
+	const float r2 = radius * radius;
+	for (int32_t z = lo.z; z <= hi.z; ++z) {
+		for (int32_t y = lo.y; y <= hi.y; ++y) {
+			for (int32_t x = lo.x; x <= hi.x; ++x) {
+				const slot* s = find_slot(cell_key(int3(x, y, z)));
+				if (!s) continue;
+
+				const uint32_t end = s->end.load(std::memory_order_relaxed);
+				for (uint32_t j = s->begin; j < end; ++j) {
+					if (len_squared(positions_[j] - center) <= r2) func(indices_[j]);
+				}
+			}
+		}
+	}
+}
+
+} // namespace math
+
+#endif // MATH_SPATIAL_HASH_H_
@@ -1,18 +1,42 @@
 #ifndef MATH_TRANSFORM_H_
 #define MATH_TRANSFORM_H_
 
+#include <cstdint>
 #include "math/math_traits.h"
 #include "math/matrix.h"
+#include "math/matrix_double.h"
+#include "math/parallel.h"
+#include "math/vector_int.h"
 
 
 namespace math {
 
+// The precision of sincos and the batch rotation builders which use it.
+// Both precisions give NaN for NaN and infinite angles. The polynomials reduce the angle modulo pi / 2
+// in float, their error grows with |angle| beyond the bounds below.
+enum class sincos_precision : uint8_t {
+	// std::sin and std::cos. The SIMD implementations of the batch functions evaluate polynomials
+	// whose absolute error is below 2e-7 for |angle| <= 1e4.
+	full,
+
+	// Polynomials of a lower degree, the absolute error is below 2e-5 for |angle| <= 1e4.
+	fast
+};
+
 // Create a quaternion from the axis-angle respresentation.
 //	Params:
 //		axis:	a unit vector indicates direction of a rotation axis.
 //		angle:	(In radians) describes the magnitude of the rotation about the axis.
 quat from_axis_angle_rotation(const float3& axis, float angle) noexcept;
 
+// ditto
+dquat from_axis_angle_rotation(const double3& axis, double angle) noexcept;
+
+// Creates count quaternions: out[i] = from_axis_angle_rotation(axes[i], angles[i]).
+// The sines and cosines are computed by the batch sincos with the given precision.
+void from_axis_angle_rotation(const float3* axes, const float* angles, quat* out, size_t count,
+	sincos_precision precision = sincos_precision::full) noexcept;
+
 // Construct a unit quaternion from the specified rotation matrix.
 // In the case of M is mat4 translation and perspective components are ignored.
 template<typename M>
@@ -145,12 +169,32 @@ float4x4 perspective_matrix_opengl(float left, float right, float bottom, float
 float4x4 perspective_matrix_opengl(float vert_fov, float wh_ratio, float near_z, float far_z) noexcept;
 
 // Returns the position component of the specified matrix.
+inline float3 position(const float3x4& m) noexcept
+{
+	return float3(m.m03, m.m13, m.m23);
+}
+
+// ditto
 inline float3 position(const float4x4& m) noexcept
 {
 	return float3(m.m03, m.m13, m.m23);
 }
 
+// ditto
+inline double3 position(const double4x4& m) noexcept
+{
+	return double3(m.m03, m.m13, m.m23);
+}
+
 // Sets the position component of the specifiend matrix.
+inline void set_position(float3x4& m, const float3& p) noexcept
+{
+	m.m03 = p.x;
+	m.m13 = p.y;
+	m.m23 = p.z;
+}
+
+// ditto
 inline void set_position(float4x4& m, const float3& p) noexcept
 {
 	m.m03 = p.x;
@@ -158,6 +202,14 @@ inline void set_position(float4x4& m, const float3& p) noexcept
 	m.m23 = p.z;
 }
 
+// ditto
+inline void set_position(double4x4& m, const double3& p) noexcept
+{
+	m.m03 = p.x;
+	m.m13 = p.y;
+	m.m23 = p.z;
+}
+
 // Rotate position p by a quaternion q.
 // Usually rotation q is specified as a rotation around an arbitrary axis by some angle.
 inline float3 rotate(const quat& q, const float3& p) noexcept
@@ -169,10 +221,24 @@ inline float3 rotate(const quat& q, const float3& p) noexcept
 	return float3(res.x, res.y, res.z);
 }
 
+// ditto
+inline double3 rotate(const dquat& q, const double3& p) noexcept
+{
+	assert(is_normalized(q));
+
+	const dquat pq = dquat(p.x, p.y, p.z, 1.0);
+	const dquat res = q * pq * conjugate(q);
+	return double3(res.x, res.y, res.z);
+}
+
 // Constructs rotation matrix from (possibly non-unit) quaternion.
 template<typename M>
 M rotation_matrix(const quat& q) noexcept;
 
+// ditto
+template<typename M>
+M rotation_matrix(const dquat& q) noexcept;
+
 // Composes a rotatiom matrix that rotates a vector by angle about an arbitrary axis.
 // The rotation is conter-clockwise.
 //	Params:
@@ -181,6 +247,10 @@ M rotation_matrix(const quat& q) noexcept;
 template<typename M>
 M rotation_matrix(const float3& axis, float angle) noexcept;
 
+// ditto
+template<typename M>
+M rotation_matrix(const double3& axis, double angle) noexcept;
+
 // Composes a look at rotation matrix. Translation component is not set.
 // Use tr_matrix to consturct a look at rotation and translation to position chain.
 //	Params:
@@ -190,28 +260,75 @@ M rotation_matrix(const float3& axis, float angle) noexcept;
 template<typename M>
 M rotation_matrix(const float3& position, const float3& target, const float3& up = float3::unit_y) noexcept;
 
+// ditto
+template<typename M>
+M rotation_matrix(const double3& position, const double3& target, const double3& up = double3::unit_y) noexcept;
+
 // Composes a rotatiom matrix about ox axis.
 //	Params:
 //		angle:	describes the magnitude in radians of the rotation about ox.
 template<typename M>
 M rotation_matrix_ox(float angle) noexcept;
 
+// Composes count rotation matrices about ox axis: out[i] = rotation_matrix_ox<M>(angles[i]).
+// The sines and cosines are computed by the batch sincos with the given precision.
+template<typename M>
+void rotation_matrix_ox(const float* angles, M* out, size_t count,
+	sincos_precision precision = sincos_precision::full) noexcept;
+
 // Composes a rotatiom matrix about oy axis.
 //	Params:
 //		angle:	describes the magnitude in radians of the rotation about oy.
 template<typename M>
 M rotation_matrix_oy(float angle) noexcept;
 
+// Composes count rotation matrices about oy axis: out[i] = rotation_matrix_oy<M>(angles[i]).
+// The sines and cosines are computed by the batch sincos with the given precision.
+template<typename M>
+void rotation_matrix_oy(const float* angles, M* out, size_t count,
+	sincos_precision precision = sincos_precision::full) noexcept;
+
 // Composes a rotatiom matrix about oz axis.
 //	Params:
 //		angle:	describes the magnitude in radians of the rotation about oz.
 template<typename M>
 M rotation_matrix_oz(float angle) noexcept;
 
+// Composes count rotation matrices about oz axis: out[i] = rotation_matrix_oz<M>(angles[i]).
+// The sines and cosines are computed by the batch sincos with the given precision.
+template<typename M>
+void rotation_matrix_oz(const float* angles, M* out, size_t count,
+	sincos_precision precision = sincos_precision::full) noexcept;
+
 // Returns a matrix which can be used to scale vectors s.
 template<typename M>
 M scale_matrix(const float3& s) noexcept;
 
+// ditto
+template<typename M>
+M scale_matrix(const double3& s) noexcept;
+
+// Computes s = sin(angle) and c = cos(angle) with the given precision (see sincos_precision).
+void sincos(float angle, float& s, float& c, sincos_precision precision = sincos_precision::full) noexcept;
+
+// Computes s[i] = sin(angles[i]) and c[i] = cos(angles[i]) with the given precision (see sincos_precision).
+// s or c may be equal to angles. The implementation is chosen at run time (see math/dispatch.h).
+void sincos(const float* angles, float* s, float* c, size_t count,
+	sincos_precision precision = sincos_precision::full) noexcept;
+
+// Skins count vertices using linear blending of 4 joint matrices per vertex (linear blend skinning).
+// joints[i] are the indices of the joints in palette, weights[i] are their weights: joints[i].x has
+// the weight weights[i].x and so on. The palette matrices must be affine, their last rows are not read.
+//
+// out_positions[i] = mul(b, positions[i], 1.0f).xyz, out_normals[i] = normalize(mul(b, normals[i], 0.0f).xyz),
+// where b = weights[i].x * palette[joints[i].x] + ... + weights[i].w * palette[joints[i].w].
+// The normals are exact for the joints without non-uniform scale. normals and out_normals may be nullptr,
+// then the normals are not skinned. The output arrays may be equal to the input ones.
+// If pool is not nullptr the vertices are split into ranges which are skinned on its threads.
+// The implementation is chosen at run time (see math/dispatch.h).
+void skin(const float4x4* palette, const float3* positions, const float3* normals, const ubyte4* joints,
+	const float4* weights, float3* out_positions, float3* out_normals, size_t count, thread_pool* pool = nullptr);
+
 // Returns a matrix that is a concatenation of translation by p and rotation by q.
 // The result is equal to translation_matrix(p) * rotation_matrix(q).
 inline float4x4 tr_matrix(const float3& p, const quat& q) noexcept
@@ -221,6 +338,23 @@ inline float4x4 tr_matrix(const float3& p, const quat& q) noexcept
 	return m;
 }
 
+// ditto
+inline double4x4 tr_matrix(const double3& p, const dquat& q) noexcept
+{
+	double4x4 m = rotation_matrix<double4x4>(q);
+	set_position(m, p);
+	return m;
+}
+
+// Returns an affine matrix that is a concatenation of translation by p and rotation by q.
+// The result is equal to float3x4(tr_matrix(p, q)).
+inline float3x4 tr_affine_matrix(const float3& p, const quat& q) noexcept
+{
+	float3x4 m = rotation_matrix<float3x4>(q);
+	set_position(m, p);
+	return m;
+}
+
 // Returns a matrix that is a concatentation of traslation by p and a look at rotation.
 inline float4x4 tr_matrix(const float3& position, const float3& target, const float3& up = float3::unit_y) noexcept
 {
@@ -229,6 +363,38 @@ inline float4x4 tr_matrix(const float3& position, const float3& target, const fl
 	return m;
 }
 
+// ditto
+inline double4x4 tr_matrix(const double3& position, const double3& target, const double3& up = double3::unit_y) noexcept
+{
+	double4x4 m = rotation_matrix<double4x4>(position, target, up);
+	set_position(m, position);
+	return m;
+}
+
+// Transforms count directions: out[i] = mul(m, in[i], 0.0f).xyz, i.e. the translation of m is ignored.
+// out may be equal to in. The implementation is chosen at run time (see math/dispatch.h).
+void transform_directions(const float4x4& m, const float3* in, float3* out, size_t count) noexcept;
+
+// Transforms count directions of interleaved arrays (e.g. vertex buffers).
+// The i-th direction is read from in + i * in_stride and written to out + i * out_stride.
+// Strides are in bytes and must be multiples of sizeof(float). out may be equal to in.
+void transform_directions(const float4x4& m, const float3* in, size_t in_stride,
+	float3* out, size_t out_stride, size_t count) noexcept;
+
+// Transforms count points: out[i] = mul(m, in[i], 1.0f).xyz. The w component of the products is dropped,
+// which is exact for affine m. out may be equal to in.
+// The implementation is chosen at run time (see math/dispatch.h).
+void transform_points(const float4x4& m, const float3* in, float3* out, size_t count) noexcept;
+
+// Transforms count points into homogeneous coordinates: out[i] = mul(m, in[i], 1.0f).
+void transform_points(const float4x4& m, const float3* in, float4* out, size_t count) noexcept;
+
+// Transforms count points of interleaved arrays (e.g. vertex buffers).
+// The i-th point is read from in + i * in_stride and written to out + i * out_stride.
+// Strides are in bytes and must be multiples of sizeof(float). out may be equal to in.
+void transform_points(const float4x4& m, const float3* in, size_t in_stride,
+	float3* out, size_t out_stride, size_t count) noexcept;
+
 // Returns a matrix which can be used to translate vectors to the position p.
 inline float4x4 translation_matrix(const float3& p) noexcept
 {
@@ -237,6 +403,14 @@ inline float4x4 translation_matrix(const float3& p) noexcept
 	return m;
 }
 
+// ditto
+inline double4x4 translation_matrix(const double3& p) noexcept
+{
+	double4x4 m = double4x4::identity;
+	set_position(m, p);
+	return m;
+}
+
 // Return a matrix that is a concatenation of translation by p, rotation by q and scale by s.
 // The result is equal to translation_matrix(p) * rotation_matrix(q) * scale_matrix(s).
 inline float4x4 trs_matrix(const float3& p, const quat& q, const float3& s) noexcept
@@ -244,6 +418,25 @@ inline float4x4 trs_matrix(const float3& p, const quat& q, const float3& s) noex
 	return tr_matrix(p, q) * scale_matrix<float4x4>(s);
 }
 
+// ditto
+inline double4x4 trs_matrix(const double3& p, const dquat& q, const double3& s) noexcept
+{
+	return tr_matrix(p, q) * scale_matrix<double4x4>(s);
+}
+
+// Returns an affine matrix that is a concatenation of translation by p, rotation by q and scale by s.
+// The result is equal to float3x4(trs_matrix(p, q, s)). Scaling the columns of the rotation
+// is cheaper than the matrix product which trs_matrix performs.
+inline float3x4 trs_affine_matrix(const float3& p, const quat& q, const float3& s) noexcept
+{
+	float3x4 m = rotation_matrix<float3x4>(q);
+	set_ox(m, ox(m) * s.x);
+	set_oy(m, oy(m) * s.y);
+	set_oz(m, oz(m) * s.z);
+	set_position(m, p);
+	return m;
+}
+
 // Returns a matrix that is a concatentation of traslation by p and scale by s.
 inline float4x4 ts_matrix(const float3& p, const float3& s) noexcept
 {
@@ -252,6 +445,14 @@ inline float4x4 ts_matrix(const float3& p, const float3& s) noexcept
 	return m;
 }
 
+// ditto
+inline double4x4 ts_matrix(const double3& p, const double3& s) noexcept
+{
+	double4x4 m = scale_matrix<double4x4>(s);
+	set_position(m, p);
+	return m;
+}
+
 // Composes a matrix that cam be used to transform from world space to view space.
 //	Params:
 //		position:	an origin, where eye(camera) is situated.
@@ -259,6 +460,9 @@ inline float4x4 ts_matrix(const float3& p, const float3& s) noexcept
 //		up:			the direction that is considered to be upward.
 float4x4 view_matrix(const float3& position, const float3& target, const float3& up = float3::unit_y) noexcept;
 
+// ditto
+double4x4 view_matrix(const double3& position, const double3& target, const double3& up = double3::unit_y) noexcept;
+
 } // namespace math
 
 #endif // MATH_TRANSFORM_H_
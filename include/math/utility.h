@@ -3,6 +3,7 @@
 
 #include <cassert>
 #include <cmath>
+#include <cstdint>
 #include <algorithm>
 #include <type_traits>
 
@@ -20,46 +21,95 @@ constexpr float pi_64 = pi / 64.0f;
 constexpr float pi_128 = pi / 128.0f;
 
 
+namespace detail {
+
+// std::isfinite is not constexpr. Infinities and NaNs give NaN when subtracted from themselves.
+template<typename Numeric>
+constexpr bool is_finite(const Numeric& v) noexcept
+{
+	return std::is_integral<Numeric>::value || ((v - v) == (v - v));
+}
+
+} // namespace detail
+
 // Determines whether l is approximately equal to r admitting a maximum absolute difference max_abs_diff.
-// Numeric must be a floating point type.
+// Numeric must be an arithmetic type.
 template<typename Numeric>
-bool approx_equal(const Numeric& l, const Numeric& r, 
-	const Numeric& max_abs_diff = Numeric(1e-5)) noexcept;
+constexpr bool approx_equal(const Numeric& l, const Numeric& r,
+	const Numeric& max_abs_diff = Numeric(1e-5)) noexcept
+{
+	static_assert(std::is_arithmetic<Numeric>::value, "Numeric must be an arithmetic type.");
+	assert(detail::is_finite(l));
+	assert(detail::is_finite(r));
+	assert(detail::is_finite(max_abs_diff));
+
+	// l - r may overflow for unsigned types, the smaller value is subtracted from the greater one.
+	return ((l < r) ? (r - l) : (l - r)) <= max_abs_diff;
+}
 
 // Clamps v into the given bounds [lo, hi].
-// Numeric must be an integer or a floating point type.
+// Numeric must be an arithmetic type.
 template<typename Numeric>
-Numeric clamp(const Numeric& v, const Numeric& lo, const Numeric& hi) noexcept;
+constexpr Numeric clamp(const Numeric& v, const Numeric& lo, const Numeric& hi) noexcept
+{
+	static_assert(std::is_arithmetic<Numeric>::value, "Numeric must be an arithmetic type.");
+	assert(lo <= hi);
+
+	return std::min(hi, std::max(lo, v));
+}
 
 // Linearly interpolates between two values.
-// Numeric must be an integer or a floating point type.
+// Numeric must be an arithmetic type.
 // Params:
 // -	l:		The start of the range in which to interpolate.
 // -	rh:		The end of the range in which to interpolate.
 // -	factor:	The value to use to interpolate between lhs & rhs.
 //				Factor has to lie within the range [0 .. 1].
 template<typename Numeric>
-Numeric lerp(const Numeric& l, const Numeric& r, const Numeric& factor) noexcept;
+constexpr Numeric lerp(const Numeric& l, const Numeric& r, const Numeric& factor) noexcept
+{
+	static_assert(std::is_arithmetic<Numeric>::value, "Numeric must be an arithmetic type.");
+	assert(0 <= factor && factor <= 1);
+
+	return Numeric(l + factor * (r - l));
+}
 
 // Clamps v into the [0, 1] bounds.
-// Numeric must be an integer or a floating point type.
+// Numeric must be an arithmetic type.
 template<typename Numeric>
-Numeric saturate(const Numeric& val) noexcept;
+constexpr Numeric saturate(const Numeric& val) noexcept
+{
+	static_assert(std::is_arithmetic<Numeric>::value, "Numeric must be an arithmetic type.");
+
+	return std::min<Numeric>(1, std::max<Numeric>(0, val));
+}
 
 // The following formula is used to determine the return value (c) ? b : a;
-// Numeric must be an integer or a floating point type.
 template<typename Numeric>
-Numeric select(const Numeric& a, const Numeric& b, bool c) noexcept;
+constexpr Numeric select(const Numeric& a, const Numeric& b, bool c) noexcept
+{
+	return (c) ? b : a;
+}
 
 // Returns -1 if s is less than zero; 0 if s equals zero; and 1 if s is greater than zero.
-// Numeric must be a signed arithmetic type.
+// Numeric must be an arithmetic type.
 template<typename Numeric>
-Numeric sign(const Numeric& s) noexcept;
+constexpr Numeric sign(const Numeric& s) noexcept
+{
+	static_assert(std::is_arithmetic<Numeric>::value, "Numeric must be an arithmetic type.");
+
+	return Numeric((Numeric(0) < s) - (s < Numeric(0)));
+}
 
 // This function uses the following formula: (x >= y) ? 1 : 0.
-// Numeric must be an integer or a floating point type.
+// Numeric must be an arithmetic type.
 template<typename Numeric>
-Numeric step(const Numeric& edge, const Numeric& x) noexcept;
+constexpr Numeric step(const Numeric& edge, const Numeric& x) noexcept
+{
+	static_assert(std::is_arithmetic<Numeric>::value, "Numeric must be an arithmetic type.");
+
+	return (x >= edge) ? Numeric(1) : Numeric(0);
+}
 
 } // namespace math
 
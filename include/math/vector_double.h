@@ -0,0 +1,1158 @@
+#ifndef MATH_VECTOR_DOUBLE_H_
+#define MATH_VECTOR_DOUBLE_H_
+
+#include <cstddef>
+#include <ostream>
+#include "math/simd.h"
+#include "math/utility.h"
+#include "math/vector_float.h"
+
+
+// double2, double3, double4 and dquat mirror float2, float3, float4 and quat.
+// Use them where float runs out of precision, e.g. for world space positions far from the origin,
+// and convert to float (see to_float_relative) for the per-frame work.
+
+namespace math {
+
+struct double2 final {
+	static const double2 unit_x;
+	static const double2 unit_y;
+	static const double2 unit_xy;
+	static const double2 zero;
+
+
+	constexpr double2() noexcept : x(0), y(0) {}
+
+	constexpr explicit double2(double val) noexcept : x(val), y(val) {}
+
+	constexpr double2(double x, double y) noexcept : x(x), y(y) {}
+
+	// Widens the float vector v.
+	constexpr explicit double2(const float2& v) noexcept : x(v.x), y(v.y) {}
+
+
+	double2& operator+=(double val) noexcept
+	{
+		x += val;
+		y += val;
+		return *this;
+	}
+
+	double2& operator+=(const double2& v) noexcept
+	{
+		x += v.x;
+		y += v.y;
+		return *this;
+	}
+
+	double2& operator-=(double val) noexcept
+	{
+		x -= val;
+		y -= val;
+		return *this;
+	}
+
+	double2& operator-=(const double2& v) noexcept
+	{
+		x -= v.x;
+		y -= v.y;
+		return *this;
+	}
+
+	double2& operator*=(double val) noexcept
+	{
+		x *= val;
+		y *= val;
+		return *this;
+	}
+
+	double2& operator/=(double val) noexcept
+	{
+		assert(!approx_equal(val, 0.0));
+
+		x /= val;
+		y /= val;
+		return *this;
+	}
+
+	double2& operator/=(const double2& v) noexcept
+	{
+		assert(!approx_equal(v.x, 0.0));
+		assert(!approx_equal(v.y, 0.0));
+
+		x /= v.x;
+		y /= v.y;
+		return *this;
+	}
+
+	// Narrows the vector to float.
+	explicit operator float2() const noexcept
+	{
+		return float2(float(x), float(y));
+	}
+
+
+	double x;
+	double y;
+};
+
+struct double3 final {
+	static const double3 unit_x;
+	static const double3 unit_y;
+	static const double3 unit_z;
+	static const double3 unit_xy;
+	static const double3 unit_xyz;
+	static const double3 zero;
+
+
+	constexpr double3() noexcept : x(0), y(0), z(0) {}
+
+	constexpr explicit double3(double val) noexcept : x(val), y(val), z(val) {}
+
+	constexpr double3(const double2& v, double z) noexcept : x(v.x), y(v.y), z(z) {}
+
+	constexpr double3(double x, double y, double z) noexcept : x(x), y(y), z(z) {}
+
+	// Widens the float vector v.
+	constexpr explicit double3(const float3& v) noexcept : x(v.x), y(v.y), z(v.z) {}
+
+
+	double3& operator+=(double val) noexcept
+	{
+		x += val;
+		y += val;
+		z += val;
+		return *this;
+	}
+
+	double3& operator+=(const double3& v) noexcept
+	{
+		x += v.x;
+		y += v.y;
+		z += v.z;
+		return *this;
+	}
+
+	double3& operator-=(double val) noexcept
+	{
+		x -= val;
+		y -= val;
+		z -= val;
+		return *this;
+	}
+
+	double3& operator-=(const double3& v) noexcept
+	{
+		x -= v.x;
+		y -= v.y;
+		z -= v.z;
+		return *this;
+	}
+
+	double3& operator*=(double val) noexcept
+	{
+		x *= val;
+		y *= val;
+		z *= val;
+		return *this;
+	}
+
+	double3& operator/=(double val) noexcept
+	{
+		assert(!approx_equal(val, 0.0));
+
+		x /= val;
+		y /= val;
+		z /= val;
+		return *this;
+	}
+
+	double3& operator/=(const double3& v) noexcept
+	{
+		assert(!approx_equal(v.x, 0.0));
+		assert(!approx_equal(v.y, 0.0));
+		assert(!approx_equal(v.z, 0.0));
+
+		x /= v.x;
+		y /= v.y;
+		z /= v.z;
+		return *this;
+	}
+
+	explicit operator double2() const noexcept
+	{
+		return double2(x, y);
+	}
+
+	// Narrows the vector to float.
+	explicit operator float3() const noexcept
+	{
+		return float3(float(x), float(y), float(z));
+	}
+
+
+	double x;
+	double y;
+	double z;
+};
+
+struct double4 final {
+	static const double4 unit_x;
+	static const double4 unit_y;
+	static const double4 unit_z;
+	static const double4 unit_w;
+	static const double4 unit_xyzw;
+	static const double4 zero;
+
+
+	constexpr double4() noexcept : x(0), y(0), z(0), w(0) {}
+
+	constexpr explicit double4(double val) noexcept : x(val), y(val), z(val), w(val) {}
+
+	constexpr explicit double4(const double3& v3, double w = 1.0) noexcept : x(v3.x), y(v3.y), z(v3.z), w(w) {}
+
+	constexpr double4(double x, double y, double z, double w) noexcept : x(x), y(y), z(z), w(w) {}
+
+	// Widens the float vector v.
+	constexpr explicit double4(const float4& v) noexcept : x(v.x), y(v.y), z(v.z), w(v.w) {}
+
+
+	double4& operator+=(double val) noexcept
+	{
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+		simd::store(&x, simd::load(&x) + simd::broadcast(val));
+#else
+		x += val;
+		y += val;
+		z += val;
+		w += val;
+#endif
+		return *this;
+	}
+
+	double4& operator+=(const double4& v) noexcept
+	{
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+		simd::store(&x, simd::load(&x) + simd::load(&v.x));
+#else
+		x += v.x;
+		y += v.y;
+		z += v.z;
+		w += v.w;
+#endif
+		return *this;
+	}
+
+	double4& operator-=(double val) noexcept
+	{
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+		simd::store(&x, simd::load(&x) - simd::broadcast(val));
+#else
+		x -= val;
+		y -= val;
+		z -= val;
+		w -= val;
+#endif
+		return *this;
+	}
+
+	double4& operator-=(const double4& v) noexcept
+	{
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+		simd::store(&x, simd::load(&x) - simd::load(&v.x));
+#else
+		x -= v.x;
+		y -= v.y;
+		z -= v.z;
+		w -= v.w;
+#endif
+		return *this;
+	}
+
+	double4& operator*=(double val) noexcept
+	{
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+		simd::store(&x, simd::load(&x) * simd::broadcast(val));
+#else
+		x *= val;
+		y *= val;
+		z *= val;
+		w *= val;
+#endif
+		return *this;
+	}
+
+	double4& operator/=(double val) noexcept
+	{
+		assert(!approx_equal(val, 0.0));
+
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+		simd::store(&x, simd::load(&x) / simd::broadcast(val));
+#else
+		x /= val;
+		y /= val;
+		z /= val;
+		w /= val;
+#endif
+		return *this;
+	}
+
+	double4& operator/=(const double4& v) noexcept
+	{
+		assert(!approx_equal(v.x, 0.0));
+		assert(!approx_equal(v.y, 0.0));
+		assert(!approx_equal(v.z, 0.0));
+		assert(!approx_equal(v.w, 0.0));
+
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+		simd::store(&x, simd::load(&x) / simd::load(&v.x));
+#else
+		x /= v.x;
+		y /= v.y;
+		z /= v.z;
+		w /= v.w;
+#endif
+		return *this;
+	}
+
+	explicit operator double2() const noexcept
+	{
+		return double2(x, y);
+	}
+
+	explicit operator double3() const noexcept
+	{
+		return double3(x, y, z);
+	}
+
+	// Narrows the vector to float.
+	explicit operator float4() const noexcept
+	{
+		return float4(float(x), float(y), float(z), float(w));
+	}
+
+
+	double x;
+	double y;
+	double z;
+	double w;
+};
+
+// dquat is a quaternion of doubles, see quat.
+struct dquat final {
+	static const dquat i;
+	static const dquat j;
+	static const dquat k;
+	static const dquat identity;
+	static const dquat zero;
+
+
+	constexpr dquat() noexcept : x(0), y(0), z(0), a(0) {}
+
+	constexpr dquat(double x, double y, double z, double a) noexcept : x(x), y(y), z(z), a(a) {}
+
+	constexpr dquat(const double3& v, double a) noexcept : x(v.x), y(v.y), z(v.z), a(a) {}
+
+	// Widens the float quaternion q.
+	constexpr explicit dquat(const quat& q) noexcept : x(q.x), y(q.y), z(q.z), a(q.a) {}
+
+
+	dquat& operator+=(const dquat& q) noexcept
+	{
+		x += q.x;
+		y += q.y;
+		z += q.z;
+		a += q.a;
+		return *this;
+	}
+
+	dquat& operator-=(const dquat& q) noexcept
+	{
+		x -= q.x;
+		y -= q.y;
+		z -= q.z;
+		a -= q.a;
+		return *this;
+	}
+
+	dquat& operator*=(double val) noexcept
+	{
+		x *= val;
+		y *= val;
+		z *= val;
+		a *= val;
+		return *this;
+	}
+
+	// Calculates the Hamilton product of this and the specified quaterions.
+	// Stores the result in this quaternion.
+	dquat& operator*=(const dquat& q) noexcept
+	{
+		double xp = (a * q.x) + (x * q.a) + (y * q.z) - (z * q.y);
+		double yp = (a * q.y) + (y * q.a) + (z * q.x) - (x * q.z);
+		double zp = (a * q.z) + (z * q.a) + (x * q.y) - (y * q.x);
+		double ap = (a * q.a) - (x * q.x) - (y * q.y) - (z * q.z);
+
+		x = xp;
+		y = yp;
+		z = zp;
+		a = ap;
+		return *this;
+	}
+
+	dquat& operator/=(double val) noexcept
+	{
+		assert(!approx_equal(val, 0.0));
+
+		x /= val;
+		y /= val;
+		z /= val;
+		a /= val;
+		return *this;
+	}
+
+	// Narrows the quaternion to float.
+	explicit operator quat() const noexcept
+	{
+		return quat(float(x), float(y), float(z), float(a));
+	}
+
+
+	double x, y, z, a;
+};
+
+inline bool operator==(const double2& l, const double2& r) noexcept
+{
+	return (l.x == r.x)
+		&& (l.y == r.y);
+}
+
+inline bool operator!=(const double2& l, const double2& r) noexcept
+{
+	return !(l == r);
+}
+
+inline bool operator==(const double3& l, const double3& r) noexcept
+{
+	return (l.x == r.x)
+		&& (l.y == r.y)
+		&& (l.z == r.z);
+}
+
+inline bool operator!=(const double3& l, const double3& r) noexcept
+{
+	return !(l == r);
+}
+
+inline bool operator==(const double4& l, const double4& r) noexcept
+{
+	return (l.x == r.x)
+		&& (l.y == r.y)
+		&& (l.z == r.z)
+		&& (l.w == r.w);
+}
+
+inline bool operator!=(const double4& l, const double4& r) noexcept
+{
+	return !(l == r);
+}
+
+inline bool operator==(const dquat& l, const dquat& r) noexcept
+{
+	return (l.x == r.x)
+		&& (l.y == r.y)
+		&& (l.z == r.z)
+		&& (l.a == r.a);
+}
+
+inline bool operator!=(const dquat& l, const dquat& r) noexcept
+{
+	return !(l == r);
+}
+
+inline double2 operator+(const double2& v, double val) noexcept
+{
+	return double2(v.x + val, v.y + val);
+}
+
+inline double2 operator+(double val, const double2& v) noexcept
+{
+	return double2(val + v.x, val + v.y);
+}
+
+inline double2 operator+(const double2& l, const double2& r) noexcept
+{
+	return double2(l.x + r.x, l.y + r.y);
+}
+
+inline double3 operator+(const double3& v, double val) noexcept
+{
+	return double3(v.x + val, v.y + val, v.z + val);
+}
+
+inline double3 operator+(double val, const double3& v) noexcept
+{
+	return double3(val + v.x, val + v.y, val + v.z);
+}
+
+inline double3 operator+(const double3& l, const double3& r) noexcept
+{
+	return double3(l.x + r.x, l.y + r.y, l.z + r.z);
+}
+
+inline double4 operator+(const double4& v, double val) noexcept
+{
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	double4 res;
+	simd::store(&res.x, simd::load(&v.x) + simd::broadcast(val));
+	return res;
+#else
+	return double4(v.x + val, v.y + val, v.z + val, v.w + val);
+#endif
+}
+
+inline double4 operator+(double val, const double4& v) noexcept
+{
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	double4 res;
+	simd::store(&res.x, simd::broadcast(val) + simd::load(&v.x));
+	return res;
+#else
+	return double4(val + v.x, val + v.y, val + v.z, val + v.w);
+#endif
+}
+
+inline double4 operator+(const double4& l, const double4& r) noexcept
+{
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	double4 res;
+	simd::store(&res.x, simd::load(&l.x) + simd::load(&r.x));
+	return res;
+#else
+	return double4(l.x + r.x, l.y + r.y, l.z + r.z, l.w + r.w);
+#endif
+}
+
+inline dquat operator+(const dquat& l, const dquat& r) noexcept
+{
+	return dquat(l.x + r.x, l.y + r.y, l.z + r.z, l.a + r.a);
+}
+
+inline double2 operator-(const double2& v, double val) noexcept
+{
+	return double2(v.x - val, v.y - val);
+}
+
+inline double2 operator-(double val, const double2& v) noexcept
+{
+	return double2(val - v.x, val - v.y);
+}
+
+inline double2 operator-(const double2& l, const double2& r) noexcept
+{
+	return double2(l.x - r.x, l.y - r.y);
+}
+
+inline double2 operator-(const double2& v) noexcept
+{
+	return double2(-v.x, -v.y);
+}
+
+inline double3 operator-(const double3& v, double val) noexcept
+{
+	return double3(v.x - val, v.y - val, v.z - val);
+}
+
+inline double3 operator-(double val, const double3& v) noexcept
+{
+	return double3(val - v.x, val - v.y, val - v.z);
+}
+
+inline double3 operator-(const double3& l, const double3& r) noexcept
+{
+	return double3(l.x - r.x, l.y - r.y, l.z - r.z);
+}
+
+inline double3 operator-(const double3& v) noexcept
+{
+	return double3(-v.x, -v.y, -v.z);
+}
+
+inline double4 operator-(const double4& v, double val) noexcept
+{
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	double4 res;
+	simd::store(&res.x, simd::load(&v.x) - simd::broadcast(val));
+	return res;
+#else
+	return double4(v.x - val, v.y - val, v.z - val, v.w - val);
+#endif
+}
+
+inline double4 operator-(double val, const double4& v) noexcept
+{
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	double4 res;
+	simd::store(&res.x, simd::broadcast(val) - simd::load(&v.x));
+	return res;
+#else
+	return double4(val - v.x, val - v.y, val - v.z, val - v.w);
+#endif
+}
+
+inline double4 operator-(const double4& l, const double4& r) noexcept
+{
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	double4 res;
+	simd::store(&res.x, simd::load(&l.x) - simd::load(&r.x));
+	return res;
+#else
+	return double4(l.x - r.x, l.y - r.y, l.z - r.z, l.w - r.w);
+#endif
+}
+
+inline double4 operator-(const double4& v) noexcept
+{
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	double4 res;
+	simd::store(&res.x, simd::broadcast(0.0) - simd::load(&v.x));
+	return res;
+#else
+	return double4(-v.x, -v.y, -v.z, -v.w);
+#endif
+}
+
+inline dquat operator-(const dquat& l, const dquat& r) noexcept
+{
+	return dquat(l.x - r.x, l.y - r.y, l.z - r.z, l.a - r.a);
+}
+
+inline dquat operator-(const dquat& q) noexcept
+{
+	return dquat(-q.x, -q.y, -q.z, -q.a);
+}
+
+inline double2 operator*(const double2& v, double val) noexcept
+{
+	return double2(v.x * val, v.y * val);
+}
+
+inline double2 operator*(double val, const double2& v) noexcept
+{
+	return double2(val * v.x, val * v.y);
+}
+
+inline double2 operator*(const double2& l, const double2& r) noexcept
+{
+	return double2(l.x * r.x, l.y * r.y);
+}
+
+inline double3 operator*(const double3& v, double val) noexcept
+{
+	return double3(v.x * val, v.y * val, v.z * val);
+}
+
+inline double3 operator*(double val, const double3& v) noexcept
+{
+	return double3(val * v.x, val * v.y, val * v.z);
+}
+
+inline double3 operator*(const double3& l, const double3& r) noexcept
+{
+	return double3(l.x * r.x, l.y * r.y, l.z * r.z);
+}
+
+inline double4 operator*(const double4& v, double val) noexcept
+{
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	double4 res;
+	simd::store(&res.x, simd::load(&v.x) * simd::broadcast(val));
+	return res;
+#else
+	return double4(v.x * val, v.y * val, v.z * val, v.w * val);
+#endif
+}
+
+inline double4 operator*(double val, const double4& v) noexcept
+{
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	double4 res;
+	simd::store(&res.x, simd::broadcast(val) * simd::load(&v.x));
+	return res;
+#else
+	return double4(val * v.x, val * v.y, val * v.z, val * v.w);
+#endif
+}
+
+inline double4 operator*(const double4& l, const double4& r) noexcept
+{
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	double4 res;
+	simd::store(&res.x, simd::load(&l.x) * simd::load(&r.x));
+	return res;
+#else
+	return double4(l.x * r.x, l.y * r.y, l.z * r.z, l.w * r.w);
+#endif
+}
+
+inline dquat operator*(const dquat& q, double val) noexcept
+{
+	return dquat(q.x * val, q.y * val, q.z * val, q.a * val);
+}
+
+inline dquat operator*(double val, const dquat& q) noexcept
+{
+	return dquat(val * q.x, val * q.y, val * q.z, val * q.a);
+}
+
+// Calculates the Hamilton product of lsh and rhs quaternions.
+inline dquat operator*(const dquat& l, const dquat& r) noexcept
+{
+	return dquat(
+		(l.a * r.x) + (l.x * r.a) + (l.y * r.z) - (l.z * r.y),
+		(l.a * r.y) + (l.y * r.a) + (l.z * r.x) - (l.x * r.z),
+		(l.a * r.z) + (l.z * r.a) + (l.x * r.y) - (l.y * r.x),
+		(l.a * r.a) - (l.x * r.x) - (l.y * r.y) - (l.z * r.z)
+	);
+}
+
+inline double2 operator/(const double2& v, double val) noexcept
+{
+	assert(!approx_equal(val, 0.0));
+
+	return double2(v.x / val, v.y / val);
+}
+
+inline double2 operator/(double val, const double2& v) noexcept
+{
+	assert(!approx_equal(v.x, 0.0));
+	assert(!approx_equal(v.y, 0.0));
+
+	return double2(val / v.x, val / v.y);
+}
+
+inline double2 operator/(const double2& l, const double2& r) noexcept
+{
+	assert(!approx_equal(r.x, 0.0));
+	assert(!approx_equal(r.y, 0.0));
+
+	return double2(l.x / r.x, l.y / r.y);
+}
+
+inline double3 operator/(const double3& v, double val) noexcept
+{
+	assert(!approx_equal(val, 0.0));
+
+	return double3(v.x / val, v.y / val, v.z / val);
+}
+
+inline double3 operator/(double val, const double3& v) noexcept
+{
+	assert(!approx_equal(v.x, 0.0));
+	assert(!approx_equal(v.y, 0.0));
+	assert(!approx_equal(v.z, 0.0));
+
+	return double3(val / v.x, val / v.y, val / v.z);
+}
+
+inline double3 operator/(const double3& l, const double3& r) noexcept
+{
+	assert(!approx_equal(r.x, 0.0));
+	assert(!approx_equal(r.y, 0.0));
+	assert(!approx_equal(r.z, 0.0));
+
+	return double3(l.x / r.x, l.y / r.y, l.z / r.z);
+}
+
+inline double4 operator/(const double4& v, double val) noexcept
+{
+	assert(!approx_equal(val, 0.0));
+
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	double4 res;
+	simd::store(&res.x, simd::load(&v.x) / simd::broadcast(val));
+	return res;
+#else
+	return double4(v.x / val, v.y / val, v.z / val, v.w / val);
+#endif
+}
+
+inline double4 operator/(double val, const double4& v) noexcept
+{
+	assert(!approx_equal(v.x, 0.0));
+	assert(!approx_equal(v.y, 0.0));
+	assert(!approx_equal(v.z, 0.0));
+	assert(!approx_equal(v.w, 0.0));
+
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	double4 res;
+	simd::store(&res.x, simd::broadcast(val) / simd::load(&v.x));
+	return res;
+#else
+	return double4(val / v.x, val / v.y, val / v.z, val / v.w);
+#endif
+}
+
+inline double4 operator/(const double4& l, const double4& r) noexcept
+{
+	assert(!approx_equal(r.x, 0.0));
+	assert(!approx_equal(r.y, 0.0));
+	assert(!approx_equal(r.z, 0.0));
+	assert(!approx_equal(r.w, 0.0));
+
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	double4 res;
+	simd::store(&res.x, simd::load(&l.x) / simd::load(&r.x));
+	return res;
+#else
+	return double4(l.x / r.x, l.y / r.y, l.z / r.z, l.w / r.w);
+#endif
+}
+
+inline dquat operator/(const dquat& q, double val) noexcept
+{
+	assert(!approx_equal(val, 0.0));
+
+	return dquat(q.x / val, q.y / val, q.z / val, q.a / val);
+}
+
+std::ostream& operator<<(std::ostream& out, const double2& v);
+
+std::wostream& operator<<(std::wostream& out, const double2& v);
+
+std::ostream& operator<<(std::ostream& out, const double3& v);
+
+std::wostream& operator<<(std::wostream& out, const double3& v);
+
+std::ostream& operator<<(std::ostream& out, const double4& v);
+
+std::wostream& operator<<(std::wostream& out, const double4& v);
+
+std::ostream& operator<<(std::ostream& out, const dquat& q);
+
+std::wostream& operator<<(std::wostream& out, const dquat& q);
+
+// Returns the absolute value of the specified vactor.
+// The function processes each component of the vector separately.
+inline double2 abs(const double2& v) noexcept
+{
+	return double2(std::abs(v.x), std::abs(v.y));
+}
+
+// Returns the absolute value of the specified vactor.
+// The function processes each component of the vector separately.
+inline double3 abs(const double3& v) noexcept
+{
+	return double3(std::abs(v.x), std::abs(v.y), std::abs(v.z));
+}
+
+// Returns the absolute value of the specified vactor.
+// The function processes each component of the vector separately.
+inline double4 abs(const double4& v) noexcept
+{
+	return double4(std::abs(v.x), std::abs(v.y), std::abs(v.z), std::abs(v.w));
+}
+
+// Returns true if the (abs(l - r) <= max_abs_diff) condition is true for every component of l and r.
+inline bool approx_equal(const double2& l, const double2& r, double max_abs_diff = 1e-5) noexcept
+{
+	return approx_equal(l.x, r.x, max_abs_diff)
+		&& approx_equal(l.y, r.y, max_abs_diff);
+}
+
+// Returns true if the (abs(l - r) <= max_abs_diff) condition is true for every component of l and r.
+inline bool approx_equal(const double3& l, const double3& r, double max_abs_diff = 1e-5) noexcept
+{
+	return approx_equal(l.x, r.x, max_abs_diff)
+		&& approx_equal(l.y, r.y, max_abs_diff)
+		&& approx_equal(l.z, r.z, max_abs_diff);
+}
+
+// Returns true if the (abs(l - r) <= max_abs_diff) condition is true for every component of l and r.
+inline bool approx_equal(const double4& l, const double4& r, double max_abs_diff = 1e-5) noexcept
+{
+	return approx_equal(l.x, r.x, max_abs_diff)
+		&& approx_equal(l.y, r.y, max_abs_diff)
+		&& approx_equal(l.z, r.z, max_abs_diff)
+		&& approx_equal(l.w, r.w, max_abs_diff);
+}
+
+// Returns true if the (abs(l - r) <= max_abs_diff) condition is true for every component of l and r.
+inline bool approx_equal(const dquat& l, const dquat& r, double max_abs_diff = 1e-5) noexcept
+{
+	return approx_equal(l.x, r.x, max_abs_diff)
+		&& approx_equal(l.y, r.y, max_abs_diff)
+		&& approx_equal(l.z, r.z, max_abs_diff)
+		&& approx_equal(l.a, r.a, max_abs_diff);
+}
+
+// Constrains vector v to lie between two further vectors.
+// The function processes each component of the vector separately.
+inline double2 clamp(const double2& v, const double2& lo, const double2& hi) noexcept
+{
+	return double2(clamp(v.x, lo.x, hi.x), clamp(v.y, lo.y, hi.y));
+}
+
+// Constrains vector v to lie between two further vectors.
+// The function processes each component of the vector separately.
+inline double3 clamp(const double3& v, const double3& lo, const double3& hi) noexcept
+{
+	return double3(clamp(v.x, lo.x, hi.x), clamp(v.y, lo.y, hi.y), clamp(v.z, lo.z, hi.z));
+}
+
+// Constrains vector v to lie between two further vectors.
+// The function processes each component of the vector separately.
+inline double4 clamp(const double4& v, const double4& lo, const double4& hi) noexcept
+{
+	return double4(clamp(v.x, lo.x, hi.x), clamp(v.y, lo.y, hi.y), clamp(v.z, lo.z, hi.z), clamp(v.w, lo.w, hi.w));
+}
+
+// Gets the conjugation result of the given quaternion.
+inline dquat conjugate(const dquat& q) noexcept
+{
+	return dquat(-q.x, -q.y, -q.z, q.a);
+}
+
+// Calculates the cross product of of the given vectors.
+inline double3 cross(const double3& l, const double3& r) noexcept
+{
+	return double3(
+		(l.y * r.z) - (l.z * r.y),
+		(l.z * r.x) - (l.x * r.z),
+		(l.x * r.y) - (l.y * r.x)
+	);
+}
+
+// Calculates the dot product of the given vectors.
+inline double dot(const double2& l, const double2& r) noexcept
+{
+	return (l.x * r.x) + (l.y * r.y);
+}
+
+// Calculates the dot product of the given vectors.
+inline double dot(const double3& l, const double3& r) noexcept
+{
+	return (l.x * r.x) + (l.y * r.y) + (l.z * r.z);
+}
+
+// Calculates the dot product of the given vectors.
+inline double dot(const double4& l, const double4& r) noexcept
+{
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	return simd::dot(simd::load(&l.x), simd::load(&r.x));
+#else
+	return (l.x * r.x) + (l.y * r.y) + (l.z * r.z) + (l.w * r.w);
+#endif
+}
+
+// Calculates the squared length of v.
+inline double len_squared(const double2& v) noexcept
+{
+	return (v.x * v.x) + (v.y * v.y);
+}
+
+// Calculates the squared length of v.
+inline double len_squared(const double3& v) noexcept
+{
+	return (v.x * v.x) + (v.y * v.y) + (v.z * v.z);
+}
+
+// Calculates the squared length of v.
+inline double len_squared(const double4& v) noexcept
+{
+	return (v.x * v.x) + (v.y * v.y) + (v.z * v.z) + (v.w * v.w);
+}
+
+// Calculates the squared length of q.
+inline double len_squared(const dquat& q) noexcept
+{
+	return (q.x * q.x) + (q.y * q.y) + (q.z * q.z) + (q.a * q.a);
+}
+
+// Computes the inverse(reciprocal) of the given quaternion. q* / (|q|^2)
+inline dquat inverse(const dquat& q) noexcept
+{
+	const double l2 = len_squared(q);
+	assert(!approx_equal(l2, 0.0)); // A quaternion with len = 0 isn't invertible.
+
+	const double scalar = 1.0 / l2;
+	return conjugate(q) * scalar;
+}
+
+// Checks whether the specified vector is normalized.
+inline bool is_normalized(const double2& v, double max_abs_diff = 1e-2) noexcept
+{
+	return approx_equal(len_squared(v), 1.0, max_abs_diff);
+}
+
+// Checks whether the specified vector is normalized.
+inline bool is_normalized(const double3& v, double max_abs_diff = 1e-2) noexcept
+{
+	return approx_equal(len_squared(v), 1.0, max_abs_diff);
+}
+
+// Checks whether the specified vector is normalized.
+inline bool is_normalized(const double4& v, double max_abs_diff = 1e-2) noexcept
+{
+	return approx_equal(len_squared(v), 1.0, max_abs_diff);
+}
+
+// Checks whether the specified quaternion is normalized.
+inline bool is_normalized(const dquat& q, double max_abs_diff = 1e-2) noexcept
+{
+	return approx_equal(len_squared(q), 1.0, max_abs_diff);
+}
+
+// Calculates the length of v.
+inline double len(const double2& v) noexcept
+{
+	return std::sqrt(len_squared(v));
+}
+
+// Calculates the length of v.
+inline double len(const double3& v) noexcept
+{
+	return std::sqrt(len_squared(v));
+}
+
+// Calculates the length of v.
+inline double len(const double4& v) noexcept
+{
+	return std::sqrt(len_squared(v));
+}
+
+// Calculates the length of q.
+inline double len(const dquat& q) noexcept
+{
+	return std::sqrt(len_squared(q));
+}
+
+// Linearly interpolates between two values.
+// Params:
+// -	l:		The start of the range in which to interpolate.
+// -	r:		The end of the range in which to interpolate.
+// -	factor:	The value to use to interpolate between lhs & rhs.
+//				Factor has to lie within the range [0 .. 1].
+inline double2 lerp(const double2& l, const double2& r, double factor) noexcept
+{
+	assert(0.0 <= factor && factor <= 1.0);
+	return l + factor * (r - l);
+}
+
+// Linearly interpolates between two values.
+// Params:
+// -	l:		The start of the range in which to interpolate.
+// -	r:		The end of the range in which to interpolate.
+// -	factor:	The value to use to interpolate between lhs & rhs.
+//				Factor has to lie within the range [0 .. 1].
+inline double3 lerp(const double3& l, const double3& r, double factor) noexcept
+{
+	assert(0.0 <= factor && factor <= 1.0);
+	return l + factor * (r - l);
+}
+
+// Linearly interpolates between two values.
+// Params:
+// -	l:		The start of the range in which to interpolate.
+// -	r:		The end of the range in which to interpolate.
+// -	factor:	The value to use to interpolate between lhs & rhs.
+//				Factor has to lie within the range [0 .. 1].
+inline double4 lerp(const double4& l, const double4& r, double factor) noexcept
+{
+	assert(0.0 <= factor && factor <= 1.0);
+	return l + factor * (r - l);
+}
+
+// Returns new vector which is normalized(unit length) copy of the given one.
+inline double2 normalize(const double2& v) noexcept
+{
+	const double l2 = len_squared(v);
+	if (approx_equal(l2, 0.0) || approx_equal(l2, 1.0)) return v;
+
+	const double factor = 1.0 / std::sqrt(l2);
+	return v * factor;
+}
+
+// Returns new vector which is normalized(unit length) copy of the given one.
+inline double3 normalize(const double3& v) noexcept
+{
+	const double l2 = len_squared(v);
+	if (approx_equal(l2, 0.0) || approx_equal(l2, 1.0)) return v;
+
+	const double factor = 1.0 / std::sqrt(l2);
+	return v * factor;
+}
+
+// Returns new vector which is normalized(unit length) copy of the given one.
+inline double4 normalize(const double4& v) noexcept
+{
+	const double l2 = len_squared(v);
+	if (approx_equal(l2, 0.0) || approx_equal(l2, 1.0)) return v;
+
+	const double factor = 1.0 / std::sqrt(l2);
+	return v * factor;
+}
+
+// Returns a new quaternion which is normalized(unit length) copy of the given quaternion.
+inline dquat normalize(const dquat& q) noexcept
+{
+	const double l2 = len_squared(q);
+	if (approx_equal(l2, 0.0) || approx_equal(l2, 1.0)) return q;
+
+	const double factor = 1.0 / std::sqrt(l2);
+	return q * factor;
+}
+
+// Constrains vector v to lie  within the range of 0 to 1.
+// The function processes each component of the vector separately.
+inline double2 saturate(const double2& v) noexcept
+{
+	return double2(saturate(v.x), saturate(v.y));
+}
+
+// Constrains vector v to lie  within the range of 0 to 1.
+// The function processes each component of the vector separately.
+inline double3 saturate(const double3& v) noexcept
+{
+	return double3(saturate(v.x), saturate(v.y), saturate(v.z));
+}
+
+// Constrains vector v to lie  within the range of 0 to 1.
+// The function processes each component of the vector separately.
+inline double4 saturate(const double4& v) noexcept
+{
+	return double4(saturate(v.x), saturate(v.y), saturate(v.z), saturate(v.w));
+}
+
+// Performs spherical-interpolation between unit quaternions (geometrical slerp).
+dquat slerp(const dquat& q, const dquat& r, double factor);
+
+// Returns float3(p - origin). The difference is computed in double, so the result keeps
+// the float precision near origin no matter how far from the world's origin p and origin are.
+inline float3 to_float_relative(const double3& p, const double3& origin) noexcept
+{
+	return float3(float(p.x - origin.x), float(p.y - origin.y), float(p.z - origin.z));
+}
+
+// Converts count positions: out[i] = to_float_relative(p[i], origin).
+// The implementation is chosen at run time (see math/dispatch.h).
+void to_float_relative(const double3* p, const double3& origin, float3* out, size_t count) noexcept;
+
+inline double2 xy(const double3& v) noexcept
+{
+	return double2(v.x, v.y);
+}
+
+inline double2 xy(const double4& v) noexcept
+{
+	return double2(v.x, v.y);
+}
+
+inline double3 xyz(const double4& v) noexcept
+{
+	return double3(v.x, v.y, v.z);
+}
+
+} // namespace math
+
+#endif // MATH_VECTOR_DOUBLE_H_
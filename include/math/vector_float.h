@@ -1,7 +1,9 @@
 #ifndef MATH_VECTOR_FLOAT_H_
 #define MATH_VECTOR_FLOAT_H_
 
+#include <cstddef>
 #include <ostream>
+#include "math/simd.h"
 #include "math/utility.h"
 
 
@@ -195,46 +197,66 @@ struct float4 final {
 
 	float4& operator+=(float val) noexcept
 	{
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+		simd::store(&x, _mm_add_ps(simd::load(&x), _mm_set1_ps(val)));
+#else
 		x += val;
 		y += val;
 		z += val;
 		w += val;
+#endif
 		return *this;
 	}
 
 	float4& operator+=(const float4& v) noexcept
 	{
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+		simd::store(&x, _mm_add_ps(simd::load(&x), simd::load(&v.x)));
+#else
 		x += v.x;
 		y += v.y;
 		z += v.z;
 		w += v.w;
+#endif
 		return *this;
 	}
 
 	float4& operator-=(float val) noexcept
 	{
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+		simd::store(&x, _mm_sub_ps(simd::load(&x), _mm_set1_ps(val)));
+#else
 		x -= val;
 		y -= val;
 		z -= val;
 		w -= val;
+#endif
 		return *this;
 	}
 
 	float4& operator-=(const float4& v) noexcept
 	{
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+		simd::store(&x, _mm_sub_ps(simd::load(&x), simd::load(&v.x)));
+#else
 		x -= v.x;
 		y -= v.y;
 		z -= v.z;
 		w -= v.w;
+#endif
 		return *this;
 	}
 
 	float4& operator*=(float val) noexcept
 	{
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+		simd::store(&x, _mm_mul_ps(simd::load(&x), _mm_set1_ps(val)));
+#else
 		x *= val;
 		y *= val;
 		z *= val;
 		w *= val;
+#endif
 		return *this;
 	}
 
@@ -242,10 +264,14 @@ struct float4 final {
 	{
 		assert(!approx_equal(val, 0.0f));
 
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+		simd::store(&x, _mm_div_ps(simd::load(&x), _mm_set1_ps(val)));
+#else
 		x /= val;
 		y /= val;
 		z /= val;
 		w /= val;
+#endif
 		return *this;
 	}
 
@@ -256,10 +282,14 @@ struct float4 final {
         assert(!approx_equal(v.z, 0.0f));
         assert(!approx_equal(v.w, 0.0f));
         
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+        simd::store(&x, _mm_div_ps(simd::load(&x), simd::load(&v.x)));
+#else
         x /= v.x;
         y /= v.y;
         z /= v.z;
         w /= v.w;
+#endif
         return *this;
     }
 
@@ -302,28 +332,40 @@ struct quat final {
 
 	quat& operator+=(const quat& q) noexcept
 	{
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+		simd::store(&x, _mm_add_ps(simd::load(&x), simd::load(&q.x)));
+#else
 		x += q.x;
 		y += q.y;
 		z += q.z;
 		a += q.a;
+#endif
 		return *this;
 	}
 
 	quat& operator-=(const quat& q) noexcept
 	{
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+		simd::store(&x, _mm_sub_ps(simd::load(&x), simd::load(&q.x)));
+#else
 		x -= q.x;
 		y -= q.y;
 		z -= q.z;
 		a -= q.a;
+#endif
 		return *this;
 	}
 
 	quat& operator*=(float val) noexcept
 	{
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+		simd::store(&x, _mm_mul_ps(simd::load(&x), _mm_set1_ps(val)));
+#else
 		x *= val;
 		y *= val;
 		z *= val;
 		a *= val;
+#endif
 
 		return *this;
 	}
@@ -332,6 +374,9 @@ struct quat final {
 	// Stores the result in this quaternion.
 	quat& operator*=(const quat& q) noexcept
 	{
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+		simd::store(&x, simd::quat_mul(simd::load(&x), simd::load(&q.x)));
+#else
 		float xp = (a * q.x) + (x * q.a) + (y * q.z) - (z * q.y);
 		float yp = (a * q.y) + (y * q.a) + (z * q.x) - (x * q.z);
 		float zp = (a * q.z) + (z * q.a) + (x * q.y) - (y * q.x);
@@ -341,6 +386,7 @@ struct quat final {
 		y = yp;
 		z = zp;
 		a = ap;
+#endif
 		return *this;
 	}
 
@@ -348,10 +394,14 @@ struct quat final {
 	{
 		assert(!approx_equal(val, 0.0f));
 
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+		simd::store(&x, _mm_div_ps(simd::load(&x), _mm_set1_ps(val)));
+#else
 		x /= val;
 		y /= val;
 		z /= val;
 		a /= val;
+#endif
 		return *this;
 	}
 
@@ -383,10 +433,14 @@ inline bool operator!=(const float3& l, const float3& r) noexcept
 
 inline bool operator==(const float4& l, const float4& r) noexcept
 {
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	return simd::all_equal(simd::load(&l.x), simd::load(&r.x));
+#else
 	return (l.x == r.x)
 		&& (l.y == r.y)
 		&& (l.z == r.z)
 		&& (l.w == r.w);
+#endif
 }
 
 inline bool operator!=(const float4& l, const float4& r) noexcept
@@ -396,10 +450,14 @@ inline bool operator!=(const float4& l, const float4& r) noexcept
 
 inline bool operator==(const quat& l, const quat& r)
 {
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	return simd::all_equal(simd::load(&l.x), simd::load(&r.x));
+#else
 	return (l.x == r.x)
 		&& (l.y == r.y)
 		&& (l.z == r.z)
 		&& (l.a == r.a);
+#endif
 }
 
 inline bool operator!=(const quat& lhs, const quat& rhs)
@@ -449,22 +507,38 @@ inline bool operator>=(const float3& v, float val) noexcept
 
 inline bool operator<(const float4& v, float val) noexcept
 {
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	return _mm_movemask_ps(_mm_cmplt_ps(simd::load(&v.x), _mm_set1_ps(val))) == 0xf;
+#else
 	return (v.x < val) && (v.y < val) && (v.z < val) && (v.w < val);
+#endif
 }
 
 inline bool operator>(const float4& v, float val) noexcept
 {
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	return _mm_movemask_ps(_mm_cmpgt_ps(simd::load(&v.x), _mm_set1_ps(val))) == 0xf;
+#else
 	return (v.x > val) && (v.y > val) && (v.z > val) && (v.w > val);
+#endif
 }
 
 inline bool operator<=(const float4& v, float val) noexcept
 {
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	return _mm_movemask_ps(_mm_cmple_ps(simd::load(&v.x), _mm_set1_ps(val))) == 0xf;
+#else
 	return (v.x <= val) && (v.y <= val) && (v.z <= val) && (v.w <= val);
+#endif
 }
 
 inline bool operator>=(const float4& v, float val) noexcept
 {
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	return _mm_movemask_ps(_mm_cmpge_ps(simd::load(&v.x), _mm_set1_ps(val))) == 0xf;
+#else
 	return (v.x >= val) && (v.y >= val) && (v.z >= val) && (v.w >= val);
+#endif
 }
 
 inline float2 operator+(const float2& v, float val) noexcept
@@ -499,22 +573,38 @@ inline float3 operator+(const float3& l, const float3& r) noexcept
 
 inline float4 operator+(const float4& v, float val) noexcept
 {
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	return simd::to<float4>(_mm_add_ps(simd::load(&v.x), _mm_set1_ps(val)));
+#else
 	return float4(v.x + val, v.y + val, v.z + val, v.w + val);
+#endif
 }
 
 inline float4 operator+(float val, const float4& v) noexcept
 {
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	return simd::to<float4>(_mm_add_ps(simd::load(&v.x), _mm_set1_ps(val)));
+#else
 	return float4(v.x + val, v.y + val, v.z + val, v.w + val);
+#endif
 }
 
 inline float4 operator+(const float4& l, const float4& r) noexcept
 {
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	return simd::to<float4>(_mm_add_ps(simd::load(&l.x), simd::load(&r.x)));
+#else
 	return float4(l.x + r.x, l.y + r.y, l.z + r.z, l.w + r.w);
+#endif
 }
 
 inline quat operator+(const quat& l, const quat& r) noexcept
 {
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	return simd::to<quat>(_mm_add_ps(simd::load(&l.x), simd::load(&r.x)));
+#else
 	return quat(l.x + r.x, l.y + r.y, l.z + r.z, l.a + r.a);
+#endif
 }
 
 inline float2 operator-(const float2& v, float val) noexcept
@@ -559,32 +649,56 @@ inline float3 operator-(const float3& v) noexcept
 
 inline float4 operator-(const float4& v, float val) noexcept
 {
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	return simd::to<float4>(_mm_sub_ps(simd::load(&v.x), _mm_set1_ps(val)));
+#else
 	return float4(v.x - val, v.y - val, v.z - val, v.w - val);
+#endif
 }
 
 inline float4 operator-(float val, const float4& v) noexcept
 {
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	return simd::to<float4>(_mm_sub_ps(_mm_set1_ps(val), simd::load(&v.x)));
+#else
 	return float4(val - v.x, val - v.y, val - v.z, val - v.w);
+#endif
 }
 
 inline float4 operator-(const float4& l, const float4& r) noexcept
 {
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	return simd::to<float4>(_mm_sub_ps(simd::load(&l.x), simd::load(&r.x)));
+#else
 	return float4(l.x - r.x, l.y - r.y, l.z - r.z, l.w - r.w);
+#endif
 }
 
 inline float4 operator-(const float4& v) noexcept
 {
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	return simd::to<float4>(simd::negate<0xf>(simd::load(&v.x)));
+#else
 	return float4(-v.x, -v.y, -v.z, -v.w);
+#endif
 }
 
 inline quat operator-(const quat& l, const quat& r) noexcept
 {
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	return simd::to<quat>(_mm_sub_ps(simd::load(&l.x), simd::load(&r.x)));
+#else
 	return quat(l.x - r.x, l.y - r.y, l.z - r.z, l.a - r.a);
+#endif
 }
 
 inline quat operator-(const quat& q) noexcept
 {
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	return simd::to<quat>(simd::negate<0xf>(simd::load(&q.x)));
+#else
 	return quat(-q.x, -q.y, -q.z, -q.a);
+#endif
 }
 
 inline float2 operator*(const float2& v, float val) noexcept
@@ -619,38 +733,62 @@ inline float3 operator*(const float3& l, const float3& r) noexcept
 
 inline float4 operator*(const float4& v, float val) noexcept
 {
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	return simd::to<float4>(_mm_mul_ps(simd::load(&v.x), _mm_set1_ps(val)));
+#else
 	return float4(v.x * val, v.y * val, v.z * val, v.w * val);
+#endif
 }
 
 inline float4 operator*(float val, const float4& v) noexcept
 {
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	return simd::to<float4>(_mm_mul_ps(simd::load(&v.x), _mm_set1_ps(val)));
+#else
 	return float4(v.x * val, v.y * val, v.z * val, v.w * val);
+#endif
 }
 
 inline float4 operator*(const float4& l, const float4& r) noexcept
 {
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	return simd::to<float4>(_mm_mul_ps(simd::load(&l.x), simd::load(&r.x)));
+#else
 	return float4(l.x * r.x, l.y * r.y, l.z * r.z, l.w * r.w);
+#endif
 }
 
 inline quat operator*(const quat& q, float val) noexcept
 {
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	return simd::to<quat>(_mm_mul_ps(simd::load(&q.x), _mm_set1_ps(val)));
+#else
 	return quat(q.x * val, q.y * val, q.z * val, q.a * val);
+#endif
 }
 
 inline quat operator*(float val, const quat& q) noexcept
 {
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	return simd::to<quat>(_mm_mul_ps(simd::load(&q.x), _mm_set1_ps(val)));
+#else
 	return quat(q.x * val, q.y * val, q.z * val, q.a * val);
+#endif
 }
 
 // Calculates the Hamilton product of lsh and rhs quaternions.
 inline quat operator*(const quat& l, const quat& r) noexcept
 {
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	return simd::to<quat>(simd::quat_mul(simd::load(&l.x), simd::load(&r.x)));
+#else
 	return quat(
 		(l.a * r.x) + (l.x * r.a) + (l.y * r.z) - (l.z * r.y),
 		(l.a * r.y) + (l.y * r.a) + (l.z * r.x) - (l.x * r.z),
 		(l.a * r.z) + (l.z * r.a) + (l.x * r.y) - (l.y * r.x),
 		(l.a * r.a) - (l.x * r.x) - (l.y * r.y) - (l.z * r.z)
 	);
+#endif
 }
 
 inline float2 operator/(const float2& v, float val) noexcept
@@ -705,7 +843,11 @@ inline float4 operator/(const float4& v, float val) noexcept
 {
 	assert(!approx_equal(val, 0.0f));
 
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	return simd::to<float4>(_mm_div_ps(simd::load(&v.x), _mm_set1_ps(val)));
+#else
 	return float4(v.x / val, v.y / val, v.z / val, v.w / val);
+#endif
 }
 
 inline float4 operator/(float val, const float4& v) noexcept
@@ -715,7 +857,11 @@ inline float4 operator/(float val, const float4& v) noexcept
 	assert(!approx_equal(v.z, 0.0f));
 	assert(!approx_equal(v.w, 0.0f));
 
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	return simd::to<float4>(_mm_div_ps(_mm_set1_ps(val), simd::load(&v.x)));
+#else
 	return float4(val / v.x, val / v.y, val / v.z, val / v.w);
+#endif
 }
 
 inline float4 operator/(const float4& l, const float4& r) noexcept
@@ -725,14 +871,22 @@ inline float4 operator/(const float4& l, const float4& r) noexcept
 	assert(!approx_equal(r.z, 0.0f));
 	assert(!approx_equal(r.w, 0.0f));
 
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	return simd::to<float4>(_mm_div_ps(simd::load(&l.x), simd::load(&r.x)));
+#else
 	return float4(l.x / r.x, l.y / r.y, l.z / r.z, l.w / r.w);
+#endif
 }
 
 inline quat operator/(const quat& q, float val) noexcept
 {
 	assert(!approx_equal(val, 0.0f));
 
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	return simd::to<quat>(_mm_div_ps(simd::load(&q.x), _mm_set1_ps(val)));
+#else
 	return quat(q.x / val, q.y / val, q.z / val, q.a / val);
+#endif
 }
 
 inline quat operator/(float val, const quat& q) noexcept
@@ -742,7 +896,11 @@ inline quat operator/(float val, const quat& q) noexcept
 	assert(!approx_equal(q.z, 0.0f));
 	assert(!approx_equal(q.a, 0.0f));
 
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	return simd::to<quat>(_mm_div_ps(_mm_set1_ps(val), simd::load(&q.x)));
+#else
 	return quat(val / q.x, val / q.y, val / q.z, val / q.a);
+#endif
 }
 
 std::ostream& operator<<(std::ostream& out, const float2& v);
@@ -779,7 +937,11 @@ inline float3 abs(const float3& v)
 // The function processes each component of the vector separately.
 inline float4 abs(const float4& v)
 {
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	return simd::to<float4>(simd::abs(simd::load(&v.x)));
+#else
 	return float4(std::abs(v.x), std::abs(v.y), std::abs(v.z), std::abs(v.w));
+#endif
 }
 
 // Returns true if the (abs(l - r) <= max_abs_diff) condition is true for every comopnent of l and r.
@@ -858,18 +1020,29 @@ inline float3 clamp(const float3& v, const float3& lo, const float3& hi)  noexce
 //		hi =	The upper end of the range into which to constrain v.
 inline float4 clamp(const float4& v, const float4& lo, const float4& hi) noexcept
 {
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	assert(lo.x <= hi.x && lo.y <= hi.y && lo.z <= hi.z && lo.w <= hi.w);
+
+	const __m128 c = _mm_max_ps(simd::load(&v.x), simd::load(&lo.x));
+	return simd::to<float4>(_mm_min_ps(c, simd::load(&hi.x)));
+#else
 	return float4(
 		clamp(v.x, lo.x, hi.x),
 		clamp(v.y, lo.y, hi.y),
 		clamp(v.z, lo.z, hi.z),
 		clamp(v.w, lo.w, hi.w)
 	);
+#endif
 }
 
 // Gets the conjugation result of the given quaternion.
 inline quat conjugate(const quat& q) noexcept
 {
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	return simd::to<quat>(simd::negate<0x7>(simd::load(&q.x)));
+#else
 	return quat(-q.x, -q.y, -q.z, q.a);
+#endif
 }
 
 // Calculates the cross product of of the given vectors.
@@ -897,7 +1070,11 @@ inline float dot(const float3& l, const float3& r) noexcept
 // Calculates the dot product of the given vectors.
 inline float dot(const float4& l, const float4& r) noexcept
 {
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	return _mm_cvtss_f32(simd::dot(simd::load(&l.x), simd::load(&r.x)));
+#else
 	return (l.x * r.x) + (l.y * r.y) + (l.z * r.z) + (l.w * r.w);
+#endif
 }
 
 // Calculates the squared length of v.
@@ -915,15 +1092,84 @@ inline float len_squared(const float3& v) noexcept
 // Calculates the squared length of v.
 inline float len_squared(const float4& v) noexcept
 {
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	const __m128 m = simd::load(&v.x);
+	return _mm_cvtss_f32(simd::dot(m, m));
+#else
 	return (v.x * v.x) + (v.y * v.y) + (v.z * v.z) + (v.w * v.w);
+#endif
 }
 
 // Calculates the squared length of q.
 inline float len_squared(const quat& q) noexcept
 {
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	const __m128 m = simd::load(&q.x);
+	return _mm_cvtss_f32(simd::dot(m, m));
+#else
 	return (q.x * q.x) + (q.y * q.y) + (q.z * q.z) + (q.a * q.a);
+#endif
+}
+
+// Returns an approximation of 1 / sqrt(x). The relative error is below 5e-7:
+// the hardware estimate refined by one Newton-Raphson step (see simd::rsqrt),
+// MATH_SIMD_SCALAR computes 1 / std::sqrt(x).
+// x must be a positive normal number: the hardware estimate of a denormal is inf, the result is inf or NaN then.
+inline float rsqrt(float x) noexcept
+{
+	assert(x > 0.0f && std::isnormal(x));
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	return _mm_cvtss_f32(simd::rsqrt(_mm_set_ss(x)));
+#else
+	return 1.0f / std::sqrt(x);
+#endif
+}
+
+// Returns a normalized copy of v computed with rsqrt, which is faster and less accurate than normalize:
+// the length of the result differs from 1 by at most 1e-6. Zero vectors are returned unchanged,
+// the squared length of any other vector must be a normal number (see rsqrt).
+inline float2 fast_normalize(const float2& v) noexcept
+{
+	const float l2 = len_squared(v);
+	return (l2 > 0.0f) ? v * rsqrt(l2) : v;
+}
+
+// ditto
+inline float3 fast_normalize(const float3& v) noexcept
+{
+	const float l2 = len_squared(v);
+	return (l2 > 0.0f) ? v * rsqrt(l2) : v;
+}
+
+// ditto
+inline float4 fast_normalize(const float4& v) noexcept
+{
+	const float l2 = len_squared(v);
+	return (l2 > 0.0f) ? v * rsqrt(l2) : v;
 }
 
+// ditto
+inline quat fast_normalize(const quat& q) noexcept
+{
+	const float l2 = len_squared(q);
+	return (l2 > 0.0f) ? q * rsqrt(l2) : q;
+}
+
+// Normalizes count vectors: out[i] = fast_normalize(v[i]). out may be equal to v.
+// The squared length of every vector must be either 0 or a normal number (see rsqrt).
+// The implementation is chosen at run time (see math/dispatch.h), the results of the implementations
+// may differ within the error bound of fast_normalize.
+void fast_normalize(const float2* v, float2* out, size_t count) noexcept;
+
+// ditto
+void fast_normalize(const float3* v, float3* out, size_t count) noexcept;
+
+// ditto
+void fast_normalize(const float4* v, float4* out, size_t count) noexcept;
+
+// ditto
+void fast_normalize(const quat* q, quat* out, size_t count) noexcept;
+
 // Computes the inverse(reciprocal) of the given quaternion. q* / (|q|^2)
 inline quat inverse(const quat& q) noexcept
 {
@@ -1048,6 +1294,14 @@ inline float4 normalize(const float4& v) noexcept
 	return v * factor;
 }
 
+// Normalizes count vectors: out[i] = normalize(v[i]). out may be equal to v.
+// The implementation is chosen at run time (see math/dispatch.h).
+void normalize(const float3* v, float3* out, size_t count) noexcept;
+
+// Normalizes count vectors: out[i] = normalize(v[i]). out may be equal to v.
+// The implementation is chosen at run time (see math/dispatch.h).
+void normalize(const float4* v, float4* out, size_t count) noexcept;
+
 // Returns a new quaternion which is normalized(unit length) copy of the given quaternion.
 inline quat normalize(const quat& q) noexcept
 {
@@ -1089,17 +1343,47 @@ inline float3 saturate(const float3& v) noexcept
 // The function processes each component of the vector separately.
 inline float4 saturate(const float4& v) noexcept
 {
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+	const __m128 c = _mm_max_ps(simd::load(&v.x), _mm_setzero_ps());
+	return simd::to<float4>(_mm_min_ps(c, _mm_set1_ps(1.0f)));
+#else
 	return float4(
 		saturate(v.x),
 		saturate(v.y),
 		saturate(v.z),
 		saturate(v.w)
 	);
+#endif
 }
 
 // Performs spherical-interpolation between unit quaternions (geometrical slerp).
 quat slerp(const quat& q, const quat& r, float factor);
 
+// Approximates slerp(q, r, factor) with polynomials, no trigonometric functions, divisions or branches
+// are involved (D. Eberly, "A Fast and Accurate Algorithm for Computing SLERP").
+// Every component of the result differs from slerp's by at most 5e-5 and the result is not normalized:
+// its length differs from 1 by at most 5e-5 too.
+quat slerp_fast(const quat& q, const quat& r, float factor) noexcept;
+
+// Performs normalized linear interpolation between unit quaternions along the shortest arc.
+// nlerp is cheaper than slerp but does not keep the angular velocity constant.
+inline quat nlerp(const quat& q, const quat& r, float factor) noexcept
+{
+	assert(0.0f <= factor && factor <= 1.0f);
+
+	const float cos_omega = (q.x * r.x) + (q.y * r.y) + (q.z * r.z) + (q.a * r.a);
+	const float f1 = (cos_omega < 0.0f) ? -factor : factor;
+	return normalize((1.0f - factor) * q + f1 * r);
+}
+
+// Interpolates count pairs of unit quaternions: out[i] = nlerp(q[i], r[i], factor[i]).
+// out may be equal to q or r. The implementation is chosen at run time (see math/dispatch.h).
+void nlerp(const quat* q, const quat* r, const float* factor, quat* out, size_t count) noexcept;
+
+// Interpolates count pairs of unit quaternions: out[i] = slerp_fast(q[i], r[i], factor[i]).
+// out may be equal to q or r. The implementation is chosen at run time (see math/dispatch.h).
+void slerp_fast(const quat* q, const quat* r, const float* factor, quat* out, size_t count) noexcept;
+
 inline float2 xy(const float3& v) noexcept
 {
 	return float2(v.x, v.y);
@@ -0,0 +1,232 @@
+#ifndef MATH_VECTOR_SOA_H_
+#define MATH_VECTOR_SOA_H_
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include "math/vector_float.h"
+
+
+namespace math {
+
+// Every component array of float3_soa and float4_soa is aligned to soa_alignment bytes
+// and padded up to a multiple of soa_block_size floats.
+// The values of the padding are unspecified: the batch functions process whole SIMD registers
+// and may write into it.
+constexpr size_t soa_alignment = 64;
+constexpr size_t soa_block_size = soa_alignment / sizeof(float);
+
+namespace detail {
+
+// Owns the memory of component_count arrays of size floats each.
+class soa_buffer final {
+public:
+
+	explicit soa_buffer(size_t component_count) noexcept;
+
+	soa_buffer(size_t component_count, size_t size);
+
+	soa_buffer(const soa_buffer& b);
+
+	soa_buffer(soa_buffer&& b) noexcept;
+
+	~soa_buffer() noexcept = default;
+
+
+	soa_buffer& operator=(const soa_buffer& b);
+
+	soa_buffer& operator=(soa_buffer&& b) noexcept;
+
+
+	float* const* components() noexcept
+	{
+		return components_;
+	}
+
+	const float* const* components() const noexcept
+	{
+		return components_;
+	}
+
+	// Changes the number of elements. The values of the first min(size(), size) elements are kept,
+	// the new ones are zeros.
+	void resize(size_t size);
+
+	size_t size() const noexcept
+	{
+		return size_;
+	}
+
+private:
+
+	std::unique_ptr<float[]> memory_;
+	float* components_[4] = {};
+	size_t component_count_ = 0;
+	size_t size_ = 0;
+	size_t padded_size_ = 0;
+};
+
+} // namespace detail
+
+// float3_soa stores float3 values as a structure of arrays: x[], y[] and z[].
+class float3_soa final {
+public:
+
+	float3_soa() noexcept : buffer_(3) {}
+
+	// Creates size zero vectors.
+	explicit float3_soa(size_t size) : buffer_(3, size) {}
+
+	// Creates a copy of count values of the AoS array v.
+	float3_soa(const float3* v, size_t count);
+
+
+	float3 get(size_t i) const noexcept
+	{
+		assert(i < size());
+		return float3(x()[i], y()[i], z()[i]);
+	}
+
+	void set(size_t i, const float3& v) noexcept
+	{
+		assert(i < size());
+		x()[i] = v.x;
+		y()[i] = v.y;
+		z()[i] = v.z;
+	}
+
+	// Returns the pointers to x, y and z arrays.
+	float* const* components() noexcept { return buffer_.components(); }
+	const float* const* components() const noexcept { return buffer_.components(); }
+
+	float* x() noexcept { return components()[0]; }
+	const float* x() const noexcept { return components()[0]; }
+
+	float* y() noexcept { return components()[1]; }
+	const float* y() const noexcept { return components()[1]; }
+
+	float* z() noexcept { return components()[2]; }
+	const float* z() const noexcept { return components()[2]; }
+
+	void resize(size_t size) { buffer_.resize(size); }
+
+	size_t size() const noexcept { return buffer_.size(); }
+
+private:
+
+	detail::soa_buffer buffer_;
+};
+
+// float4_soa stores float4 values as a structure of arrays: x[], y[], z[] and w[].
+class float4_soa final {
+public:
+
+	float4_soa() noexcept : buffer_(4) {}
+
+	// Creates size zero vectors.
+	explicit float4_soa(size_t size) : buffer_(4, size) {}
+
+	// Creates a copy of count values of the AoS array v.
+	float4_soa(const float4* v, size_t count);
+
+
+	float4 get(size_t i) const noexcept
+	{
+		assert(i < size());
+		return float4(x()[i], y()[i], z()[i], w()[i]);
+	}
+
+	void set(size_t i, const float4& v) noexcept
+	{
+		assert(i < size());
+		x()[i] = v.x;
+		y()[i] = v.y;
+		z()[i] = v.z;
+		w()[i] = v.w;
+	}
+
+	// Returns the pointers to x, y, z and w arrays.
+	float* const* components() noexcept { return buffer_.components(); }
+	const float* const* components() const noexcept { return buffer_.components(); }
+
+	float* x() noexcept { return components()[0]; }
+	const float* x() const noexcept { return components()[0]; }
+
+	float* y() noexcept { return components()[1]; }
+	const float* y() const noexcept { return components()[1]; }
+
+	float* z() noexcept { return components()[2]; }
+	const float* z() const noexcept { return components()[2]; }
+
+	float* w() noexcept { return components()[3]; }
+	const float* w() const noexcept { return components()[3]; }
+
+	void resize(size_t size) { buffer_.resize(size); }
+
+	size_t size() const noexcept { return buffer_.size(); }
+
+private:
+
+	detail::soa_buffer buffer_;
+};
+
+
+// The batch functions below mirror the corresponding functions from vector_float.h.
+// They process every element of their arguments, which must be of the same size.
+// out may be the same object as any of the arguments.
+// The implementation is chosen at run time (see math/dispatch.h).
+
+// Copies out.size() values of the AoS array v into out.
+void aos_to_soa(const float3* v, float3_soa& out) noexcept;
+
+// Copies out.size() values of the AoS array v into out.
+void aos_to_soa(const float4* v, float4_soa& out) noexcept;
+
+// Copies all the values of v into the AoS array out, which must hold at least v.size() values.
+void soa_to_aos(const float3_soa& v, float3* out) noexcept;
+
+// Copies all the values of v into the AoS array out, which must hold at least v.size() values.
+void soa_to_aos(const float4_soa& v, float4* out) noexcept;
+
+// out[i] = clamp(v[i], lo, hi).
+void clamp(const float3_soa& v, const float3& lo, const float3& hi, float3_soa& out) noexcept;
+
+// out[i] = clamp(v[i], lo, hi).
+void clamp(const float4_soa& v, const float4& lo, const float4& hi, float4_soa& out) noexcept;
+
+// out[i] = cross(l[i], r[i]).
+void cross(const float3_soa& l, const float3_soa& r, float3_soa& out) noexcept;
+
+// out[i] = dot(l[i], r[i]). out must hold at least l.size() values.
+void dot(const float3_soa& l, const float3_soa& r, float* out) noexcept;
+
+// out[i] = dot(l[i], r[i]). out must hold at least l.size() values.
+void dot(const float4_soa& l, const float4_soa& r, float* out) noexcept;
+
+// out[i] = len(v[i]). out must hold at least v.size() values.
+void len(const float3_soa& v, float* out) noexcept;
+
+// out[i] = len(v[i]). out must hold at least v.size() values.
+void len(const float4_soa& v, float* out) noexcept;
+
+// out[i] = lerp(l[i], r[i], factor).
+void lerp(const float3_soa& l, const float3_soa& r, float factor, float3_soa& out) noexcept;
+
+// out[i] = lerp(l[i], r[i], factor).
+void lerp(const float4_soa& l, const float4_soa& r, float factor, float4_soa& out) noexcept;
+
+// out[i] = normalize(v[i]).
+void normalize(const float3_soa& v, float3_soa& out) noexcept;
+
+// out[i] = normalize(v[i]).
+void normalize(const float4_soa& v, float4_soa& out) noexcept;
+
+// out[i] = saturate(v[i]).
+void saturate(const float3_soa& v, float3_soa& out) noexcept;
+
+// out[i] = saturate(v[i]).
+void saturate(const float4_soa& v, float4_soa& out) noexcept;
+
+} // namespace math
+
+#endif // MATH_VECTOR_SOA_H_
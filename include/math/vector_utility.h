@@ -2,12 +2,161 @@
 #define MATH_VECTOR_UTILITY_H_
 
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
 #include "math/vector_float.h"
 #include "math/vector_int.h"
 
 
 namespace math {
 
+// half is an IEEE 754 binary16 value (1 sign, 5 exponent and 10 mantissa bits), a storage format
+// with the range of +-65504 and 11 significant bits. pack_half/unpack_half convert it from/to float.
+struct half final {
+	constexpr half() noexcept = default;
+
+	constexpr explicit half(uint16_t bits) noexcept : bits(bits) {}
+
+
+	uint16_t bits = 0;
+};
+
+struct half2 final {
+	constexpr half2() noexcept = default;
+
+	constexpr half2(half x, half y) noexcept : x(x), y(y) {}
+
+
+	half x;
+	half y;
+};
+
+struct half3 final {
+	constexpr half3() noexcept = default;
+
+	constexpr half3(half x, half y, half z) noexcept : x(x), y(y), z(z) {}
+
+
+	half x;
+	half y;
+	half z;
+};
+
+struct half4 final {
+	constexpr half4() noexcept = default;
+
+	constexpr half4(half x, half y, half z, half w) noexcept : x(x), y(y), z(z), w(w) {}
+
+
+	half x;
+	half y;
+	half z;
+	half w;
+};
+
+// The batch functions treat the arrays of half2/3/4 as the arrays of their components.
+static_assert(sizeof(half2) == 2 * sizeof(half), "half2 must not be padded.");
+static_assert(sizeof(half3) == 3 * sizeof(half), "half3 must not be padded.");
+static_assert(sizeof(half4) == 4 * sizeof(half), "half4 must not be padded.");
+
+inline bool operator==(const half& l, const half& r) noexcept
+{
+	return l.bits == r.bits;
+}
+
+inline bool operator!=(const half& l, const half& r) noexcept
+{
+	return !(l == r);
+}
+
+inline bool operator==(const half2& l, const half2& r) noexcept
+{
+	return (l.x == r.x) && (l.y == r.y);
+}
+
+inline bool operator!=(const half2& l, const half2& r) noexcept
+{
+	return !(l == r);
+}
+
+inline bool operator==(const half3& l, const half3& r) noexcept
+{
+	return (l.x == r.x) && (l.y == r.y) && (l.z == r.z);
+}
+
+inline bool operator!=(const half3& l, const half3& r) noexcept
+{
+	return !(l == r);
+}
+
+inline bool operator==(const half4& l, const half4& r) noexcept
+{
+	return (l.x == r.x) && (l.y == r.y) && (l.z == r.z) && (l.w == r.w);
+}
+
+inline bool operator!=(const half4& l, const half4& r) noexcept
+{
+	return !(l == r);
+}
+
+// Converts f to half rounding to the nearest even value. The values beyond the half range
+// become infinities, NaNs stay NaNs (quiet ones, the high bits of the payload are kept).
+// The bits are the same as the ones of the F16C instruction vcvtps2ph.
+half pack_half(float f) noexcept;
+
+inline half2 pack_half(const float2& v) noexcept
+{
+	return half2(pack_half(v.x), pack_half(v.y));
+}
+
+inline half3 pack_half(const float3& v) noexcept
+{
+	return half3(pack_half(v.x), pack_half(v.y), pack_half(v.z));
+}
+
+inline half4 pack_half(const float4& v) noexcept
+{
+	return half4(pack_half(v.x), pack_half(v.y), pack_half(v.z), pack_half(v.w));
+}
+
+// Converts h to float, the conversion is exact. Signaling NaNs become quiet ones as in vcvtph2ps.
+float unpack_half(half h) noexcept;
+
+inline float2 unpack_half(const half2& v) noexcept
+{
+	return float2(unpack_half(v.x), unpack_half(v.y));
+}
+
+inline float3 unpack_half(const half3& v) noexcept
+{
+	return float3(unpack_half(v.x), unpack_half(v.y), unpack_half(v.z));
+}
+
+inline float4 unpack_half(const half4& v) noexcept
+{
+	return float4(unpack_half(v.x), unpack_half(v.y), unpack_half(v.z), unpack_half(v.w));
+}
+
+// The batch conversions: out[i] = pack_half(v[i]), out[i] = unpack_half(v[i]).
+// They use F16C (or AVX-512) when the CPU supports it (see math/dispatch.h) and a software conversion otherwise,
+// the results are exactly the same as the ones of the single value functions.
+
+void pack_half(const float* v, half* out, size_t count) noexcept;
+
+void pack_half(const float2* v, half2* out, size_t count) noexcept;
+
+void pack_half(const float3* v, half3* out, size_t count) noexcept;
+
+void pack_half(const float4* v, half4* out, size_t count) noexcept;
+
+void unpack_half(const half* v, float* out, size_t count) noexcept;
+
+void unpack_half(const half2* v, float2* out, size_t count) noexcept;
+
+void unpack_half(const half3* v, float3* out, size_t count) noexcept;
+
+void unpack_half(const half4* v, float4* out, size_t count) noexcept;
+
 template<typename V>
 inline uint32_t pack_into_8_8_8_8(const V& v)
 {
@@ -44,14 +193,28 @@ inline uint32_t pack_unorm_8_8_8_8(const float4& v) noexcept
 		| uint32_t(v.w * 255.0f);
 }
 
+// The batch pack functions pack count values: out[i] = pack_xxx(v[i]).
+// Their implementation is chosen at run time (see math/dispatch.h), the results are exactly
+// the same as the ones of the single value functions.
+
+void pack_snorm_10_10_10_2(const float4* v, uint32_t* out, size_t count) noexcept;
+
+void pack_unorm_10_10_10_2(const float4* v, uint32_t* out, size_t count) noexcept;
+
+void pack_unorm_16_16(const float2* v, uint32_t* out, size_t count) noexcept;
+
+void pack_unorm_8_8_8(const float3* v, uint32_t* out, size_t count) noexcept;
+
+void pack_unorm_8_8_8_8(const float4* v, uint32_t* out, size_t count) noexcept;
+
 template<typename V>
 inline V unpack_8_8_8_8_into(uint32_t val) noexcept
 {
 	return V(
-		V::component_type((val >> 24) & 0xFF),
-		V::component_type((val >> 16) & 0xFF),
-		V::component_type((val >> 8) & 0xFF),
-		V::component_type(val & 0xFF)
+		typename V::component_type((val >> 24) & 0xFF),
+		typename V::component_type((val >> 16) & 0xFF),
+		typename V::component_type((val >> 8) & 0xFF),
+		typename V::component_type(val & 0xFF)
 	);
 }
 
@@ -86,6 +249,89 @@ inline float4 unpack_unorm_8_8_8_8(uint32_t val) noexcept
 	);
 }
 
+// The batch unpack functions unpack count values: out[i] = unpack_xxx(p[i]).
+// As the batch pack functions, they are chosen at run time and give exactly the same results
+// as the single value functions.
+
+void unpack_snorm_10_10_10_2(const uint32_t* p, float4* out, size_t count) noexcept;
+
+void unpack_unorm_10_10_10_2(const uint32_t* p, float4* out, size_t count) noexcept;
+
+void unpack_unorm_16_16(const uint32_t* p, float2* out, size_t count) noexcept;
+
+void unpack_unorm_8_8_8(const uint32_t* p, float3* out, size_t count) noexcept;
+
+void unpack_unorm_8_8_8_8(const uint32_t* p, float4* out, size_t count) noexcept;
+
+// Octahedral encoding maps the unit sphere onto the octahedron |x| + |y| + |z| = 1 and unfolds
+// the octahedron onto the square [-1, 1]^2: the upper half (z >= 0) is the inner diamond |x| + |y| <= 1,
+// the lower half is folded over its edges into the corners. The samples of the square are distributed
+// over the sphere nearly uniformly, so 2 quantized components represent unit vectors (e.g. normals)
+// better than 3 of the same precision.
+//
+// encode_octahedral returns the point of the square for a non-zero vector n (it does not have to be normalized),
+// decode_octahedral returns the unit vector for a point of the square.
+// The packed forms quantize the point: the maximum angular error of the round trip is
+// 0.004 degrees for snorm_16_16 and 0.96 degrees for unorm_8_8.
+
+float2 encode_octahedral(const float3& n) noexcept;
+
+float3 decode_octahedral(const float2& e) noexcept;
+
+// x is stored in the high 16 bits as pack_unorm_16_16 does.
+uint32_t pack_octahedral_snorm_16_16(const float3& n) noexcept;
+
+float3 unpack_octahedral_snorm_16_16(uint32_t p) noexcept;
+
+// x is stored in the high 8 bits.
+uint16_t pack_octahedral_unorm_8_8(const float3& n) noexcept;
+
+float3 unpack_octahedral_unorm_8_8(uint16_t p) noexcept;
+
+// The batch octahedral functions process count values: out[i] = xxx_octahedral(v[i]).
+// They are chosen at run time, the encoded and packed values are exactly the same as the ones of
+// the single value functions, the decoded vectors may differ in the last bits.
+
+void encode_octahedral(const float3* n, float2* out, size_t count) noexcept;
+
+void decode_octahedral(const float2* e, float3* out, size_t count) noexcept;
+
+void pack_octahedral_snorm_16_16(const float3* n, uint32_t* out, size_t count) noexcept;
+
+void unpack_octahedral_snorm_16_16(const uint32_t* p, float3* out, size_t count) noexcept;
+
+void pack_octahedral_unorm_8_8(const float3* n, uint16_t* out, size_t count) noexcept;
+
+void unpack_octahedral_unorm_8_8(const uint16_t* p, float3* out, size_t count) noexcept;
+
+// The smallest three encoding of unit quaternions. q and -q are the same rotation, so the largest
+// (by magnitude) component is made positive and dropped, its index takes 2 bits. The other three
+// components are within [-1 / sqrt(2), 1 / sqrt(2)], each of them is quantized to bits bits.
+// The encoding takes 2 + 3 * bits low bits of the result, the index is the highest ones followed by
+// the x, y, z, a components except the largest one: 32 bits with bits = 10 and 47 bits with bits = 15.
+// 2 <= bits <= 20.
+//
+// unpack_smallest_three restores the largest component and normalizes the result with normalize(quat).
+// The maximum angle between the rotations of q and of its round trip is about 0.26 degrees with bits = 10
+// and 0.008 degrees with bits = 15, every extra bit halves it.
+
+uint64_t pack_smallest_three(const quat& q, uint32_t bits) noexcept;
+
+quat unpack_smallest_three(uint64_t p, uint32_t bits) noexcept;
+
+// The batch smallest three functions process count values: out[i] = pack_smallest_three(q[i], bits) and
+// out[i] = unpack_smallest_three(p[i], bits). The uint32_t overloads require bits <= 10.
+// They are chosen at run time, the packed values are exactly the same as the ones of the single value functions,
+// the unpacked quaternions may differ in the last bits.
+
+void pack_smallest_three(const quat* q, uint32_t bits, uint32_t* out, size_t count) noexcept;
+
+void pack_smallest_three(const quat* q, uint32_t bits, uint64_t* out, size_t count) noexcept;
+
+void unpack_smallest_three(const uint32_t* p, uint32_t bits, quat* out, size_t count) noexcept;
+
+void unpack_smallest_three(const uint64_t* p, uint32_t bits, quat* out, size_t count) noexcept;
+
 } // namespace math
 
 #endif // MATH_VECTOR_UTILITY_H_
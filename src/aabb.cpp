@@ -0,0 +1,52 @@
+#include "math/aabb.h"
+
+#include <limits>
+#include <mutex>
+#include "kernels.h"
+
+
+namespace {
+
+// A range is large enough to hide the cost of a task and of merging its result.
+constexpr size_t grain = 16 * 1024;
+
+} // namespace
+
+
+namespace math {
+
+const aabb aabb::empty(float3(std::numeric_limits<float>::max()), float3(-std::numeric_limits<float>::max()));
+
+
+std::ostream& operator<<(std::ostream& o, const aabb& b)
+{
+	o << "aabb(" << b.min << ", " << b.max << ")";
+	return o;
+}
+
+std::wostream& operator<<(std::wostream& o, const aabb& b)
+{
+	o << "aabb(" << b.min << ", " << b.max << ")";
+	return o;
+}
+
+aabb bounds(const float3* points, size_t count, thread_pool* pool)
+{
+	assert(count == 0 || points);
+
+	const kernel_table& kernels = active_kernels();
+	aabb res = aabb::empty;
+	std::mutex mutex;
+
+	parallel_for(pool, count, grain, [&](size_t begin, size_t end) {
+		aabb b = aabb::empty;
+		kernels.bounds_float3(points + begin, end - begin, b.min, b.max);
+
+		std::lock_guard<std::mutex> lock(mutex);
+		res = merge(res, b);
+	});
+
+	return res;
+}
+
+} // namespace math
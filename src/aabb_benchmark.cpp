@@ -0,0 +1,48 @@
+#include "math/aabb.h"
+
+#include <vector>
+#include "benchmark.h"
+
+using math::aabb;
+using math::float3;
+using math::float3x4;
+
+
+namespace benchmark {
+
+// The boxes are not empty.
+template<>
+inline std::vector<aabb> inputs<aabb>(size_t count, float lo, float hi, uint32_t seed)
+{
+	const std::vector<float3> c = random_values<float3>(count, lo, hi, seed);
+	const std::vector<float3> e = random_values<float3>(count, 0.0f, 0.1f * (hi - lo), seed + 1);
+	std::vector<aabb> v(count);
+	for (size_t i = 0; i < count; ++i)
+		v[i] = aabb(c[i] - e[i], c[i] + e[i]);
+
+	return v;
+}
+
+} // namespace benchmark
+
+
+namespace {
+
+BENCHMARK_MAP2(intersection_aabb, aabb, aabb, aabb, -10.0f, 10.0f, math::intersection(a, b));
+BENCHMARK_MAP2(merge_aabb, aabb, aabb, aabb, -10.0f, 10.0f, math::merge(a, b));
+BENCHMARK_MAP2(transform_aabb, aabb, float3x4, aabb, -10.0f, 10.0f, math::transform(a, b));
+
+// ----- batch functions -----
+
+void bounds_batch(benchmark::state& state)
+{
+	const std::vector<float3> points = benchmark::random_values<float3>(state.size(), -10.0f, 10.0f, 1);
+
+	while (state.keep_running()) {
+		benchmark::do_not_optimize(math::bounds(points.data(), state.size()));
+		benchmark::clobber_memory();
+	}
+}
+BENCHMARK(bounds_batch);
+
+} // namespace
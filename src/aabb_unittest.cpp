@@ -0,0 +1,241 @@
+#include "math/aabb.h"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+#include "math/transform.h"
+#include "CppUnitTest.h"
+#include "test_utility.h"
+
+
+using math::aabb;
+using math::float3;
+using math::float3x4;
+using math::float4x4;
+using math::quat;
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+
+namespace Microsoft { namespace VisualStudio { namespace CppUnitTestFramework {
+
+template<> inline std::wstring ToString<math::aabb>(const math::aabb& t) { RETURN_WIDE_STRING(t); }
+template<> inline std::wstring ToString<math::float3>(const math::float3& t) { RETURN_WIDE_STRING(t); }
+
+}}} // namespace Microsoft::VisualStudio::CppUnitTestFramework
+
+
+namespace {
+
+// Returns the bounds of the points computed one point at a time.
+aabb reference_bounds(const float3* p, size_t count) noexcept
+{
+	aabb b = aabb::empty;
+	for (size_t i = 0; i < count; ++i)
+		b = math::merge(b, p[i]);
+
+	return b;
+}
+
+} // namespace
+
+
+namespace unittest {
+
+TEST_CLASS(math_aabb) {
+public:
+
+	TEST_METHOD(bounds)
+	{
+		std::vector<float3> points(max_test_count);
+		for (size_t i = 0; i < max_test_count; ++i)
+			points[i] = test_float3(i, 1, 100.0f);
+
+		for_each_isa_level([&] {
+			for (size_t count : test_counts)
+				Assert::AreEqual(reference_bounds(points.data(), count), math::bounds(points.data(), count));
+		});
+
+		// the extremes are found in any position.
+		std::vector<float3> p(max_test_count, float3::zero);
+		for (size_t i = 0; i < max_test_count; ++i) {
+			std::fill(p.begin(), p.end(), float3::zero);
+			p[i] = float3(-1, 2, -3);
+			p[max_test_count - 1 - i] = float3(4, -5, 6);
+			const aabb expected = (i == max_test_count - 1 - i)
+				? aabb(float3(0, -5, 0), float3(4, 0, 6)) : aabb(float3(-1, -5, -3), float3(4, 2, 6));
+
+			for_each_isa_level([&] {
+				Assert::AreEqual(expected, math::bounds(p.data(), max_test_count));
+			});
+		}
+	}
+
+	TEST_METHOD(bounds_parallel)
+	{
+		const size_t count = 100000;
+		std::vector<float3> points(count);
+		for (size_t i = 0; i < count; ++i)
+			points[i] = test_float3(i, 4, 1000.0f);
+
+		points[12345] = float3(2000, -3000, 0);
+		points[count - 1] = float3(-2000, 0, 4000);
+
+		const aabb expected = reference_bounds(points.data(), count);
+		Assert::AreEqual(aabb(float3(-2000, -3000, -1000), float3(2000, 1000, 4000)), expected);
+
+		for_each_isa_level([&] {
+			test_thread_pool pool;
+			Assert::AreEqual(expected, math::bounds(points.data(), count, &pool));
+			Assert::AreEqual<size_t>(1, pool.run_count);
+
+			// a single range is processed on the calling thread.
+			Assert::AreEqual(reference_bounds(points.data(), 100), math::bounds(points.data(), 100, &pool));
+			Assert::AreEqual<size_t>(1, pool.run_count);
+
+			Assert::AreEqual(aabb::empty, math::bounds(nullptr, 0, &pool));
+		});
+	}
+
+	TEST_METHOD(center_extent)
+	{
+		const aabb b(float3(-1, 2, 3), float3(5, 4, 3));
+		Assert::AreEqual(float3(2, 3, 3), math::center(b));
+		Assert::AreEqual(float3(3, 1, 0), math::extent(b));
+	}
+
+	TEST_METHOD(contains)
+	{
+		const aabb b(float3(-1, 2, 3), float3(5, 4, 6));
+		Assert::IsTrue(math::contains(b, float3(0, 3, 4)));
+		Assert::IsTrue(math::contains(b, b.min));
+		Assert::IsTrue(math::contains(b, b.max));
+		Assert::IsFalse(math::contains(b, float3(-1.5f, 3, 4)));
+		Assert::IsFalse(math::contains(b, float3(0, 4.5f, 4)));
+		Assert::IsFalse(math::contains(b, float3(0, 3, 2)));
+		Assert::IsFalse(math::contains(aabb::empty, float3::zero));
+	}
+
+	TEST_METHOD(ctors)
+	{
+		const aabb b(float3(1, 2, 3), float3(4, 5, 6));
+		Assert::AreEqual(float3(1, 2, 3), b.min);
+		Assert::AreEqual(float3(4, 5, 6), b.max);
+
+		const aabb z;
+		Assert::AreEqual(float3::zero, z.min);
+		Assert::AreEqual(float3::zero, z.max);
+	}
+
+	TEST_METHOD(equal_operator)
+	{
+		const aabb b(float3(1, 2, 3), float3(4, 5, 6));
+		Assert::AreEqual(b, aabb(float3(1, 2, 3), float3(4, 5, 6)));
+		Assert::AreNotEqual(b, aabb(float3(1, 2, 0), float3(4, 5, 6)));
+		Assert::AreNotEqual(b, aabb(float3(1, 2, 3), float3(4, 0, 6)));
+	}
+
+	TEST_METHOD(intersection)
+	{
+		const aabb a(float3(0, 0, 0), float3(4, 4, 4));
+		const aabb b(float3(2, -1, 3), float3(6, 1, 5));
+		Assert::AreEqual(aabb(float3(2, 0, 3), float3(4, 1, 4)), math::intersection(a, b));
+		Assert::AreEqual(math::intersection(a, b), math::intersection(b, a));
+		Assert::AreEqual(a, math::intersection(a, a));
+
+		Assert::IsTrue(math::is_empty(math::intersection(a, aabb(float3(5), float3(6)))));
+		Assert::IsTrue(math::is_empty(math::intersection(a, aabb::empty)));
+	}
+
+	TEST_METHOD(intersects)
+	{
+		const aabb a(float3(0, 0, 0), float3(4, 4, 4));
+		Assert::IsTrue(math::intersects(a, aabb(float3(2, -1, 3), float3(6, 1, 5))));
+		Assert::IsTrue(math::intersects(a, aabb(float3(1), float3(2))));
+		Assert::IsTrue(math::intersects(a, aabb(float3(4, 4, 4), float3(5, 5, 5))));
+		Assert::IsFalse(math::intersects(a, aabb(float3(5, 0, 0), float3(6, 4, 4))));
+		Assert::IsFalse(math::intersects(a, aabb(float3(0, -2, 0), float3(4, -1, 4))));
+		Assert::IsFalse(math::intersects(a, aabb(float3(0, 0, 4.5f), float3(4, 4, 5))));
+		Assert::IsFalse(math::intersects(a, aabb::empty));
+	}
+
+	TEST_METHOD(intersects_frustum)
+	{
+		const float4x4 proj = math::perspective_matrix_directx(math::pi / 3.0f, 1.5f, 1.0f, 50.0f);
+		const float4x4 view = math::view_matrix(float3(1, 2, 3), float3(1, 2, 0));
+		const math::frustum f = math::frustum_directx(proj * view);
+
+		const aabb inside(float3(0, 1, -10), float3(2, 3, -8));
+		const aabb behind(float3(0, 1, 5), float3(2, 3, 8));
+		Assert::IsTrue(math::intersects(f, inside));
+		Assert::IsFalse(math::intersects(f, behind));
+		Assert::AreEqual(math::intersects(f, inside.min, inside.max), math::intersects(f, inside));
+	}
+
+	TEST_METHOD(is_empty)
+	{
+		Assert::IsTrue(math::is_empty(aabb::empty));
+		Assert::IsTrue(math::is_empty(aabb(float3(0, 0, 1), float3(1, 1, 0))));
+		Assert::IsFalse(math::is_empty(aabb(float3(1, 2, 3), float3(1, 2, 3))));
+		Assert::IsFalse(math::is_empty(aabb(float3(-1), float3(1))));
+	}
+
+	TEST_METHOD(merge)
+	{
+		const aabb a(float3(0, 0, 0), float3(4, 4, 4));
+		const aabb b(float3(2, -1, 3), float3(6, 1, 5));
+		Assert::AreEqual(aabb(float3(0, -1, 0), float3(6, 4, 5)), math::merge(a, b));
+		Assert::AreEqual(math::merge(a, b), math::merge(b, a));
+		Assert::AreEqual(a, math::merge(a, aabb::empty));
+		Assert::AreEqual(a, math::merge(aabb::empty, a));
+
+		Assert::AreEqual(aabb(float3(0, 0, -2), float3(5, 4, 4)), math::merge(a, float3(5, 1, -2)));
+		Assert::AreEqual(a, math::merge(a, float3(1, 2, 3)));
+		Assert::AreEqual(aabb(float3(1, 2, 3), float3(1, 2, 3)), math::merge(aabb::empty, float3(1, 2, 3)));
+	}
+
+	TEST_METHOD(static_members)
+	{
+		const float m = std::numeric_limits<float>::max();
+		Assert::AreEqual(aabb(float3(m), float3(-m)), aabb::empty);
+	}
+
+	TEST_METHOD(surface_area)
+	{
+		Assert::AreEqual(2.0f * (6.0f + 12.0f + 8.0f), math::surface_area(aabb(float3(-1, 2, 3), float3(1, 5, 7))));
+		Assert::AreEqual(0.0f, math::surface_area(aabb(float3(1, 2, 3), float3(1, 2, 3))));
+		Assert::AreEqual(4.0f, math::surface_area(aabb(float3(0, 0, 0), float3(1, 2, 0))));
+	}
+
+	TEST_METHOD(transform)
+	{
+		using math::approx_equal;
+
+		const aabb b(float3(-1, 2, 3), float3(5, 4, 6));
+		const float3 corners[8] = {
+			float3(b.min.x, b.min.y, b.min.z), float3(b.max.x, b.min.y, b.min.z),
+			float3(b.min.x, b.max.y, b.min.z), float3(b.max.x, b.max.y, b.min.z),
+			float3(b.min.x, b.min.y, b.max.z), float3(b.max.x, b.min.y, b.max.z),
+			float3(b.min.x, b.max.y, b.max.z), float3(b.max.x, b.max.y, b.max.z),
+		};
+
+		for (size_t i = 0; i < 10; ++i) {
+			const quat q = math::normalize(quat(test_value(i, 1) + 0.1f, test_value(i, 2), test_value(i, 3), test_value(i, 4)));
+			const float3x4 m = math::trs_affine_matrix(test_float3(i, 5, 10.0f), q, float3(0.5f, 2.0f, -3.0f));
+
+			// the bounds of the transformed corners.
+			aabb expected = aabb::empty;
+			for (const float3& c : corners)
+				expected = math::merge(expected, math::transform_point(m, c));
+
+			Assert::IsTrue(approx_equal(expected, math::transform(m, b), 1e-4f));
+			Assert::IsTrue(approx_equal(expected, math::transform(float4x4(m), b), 1e-4f));
+		}
+
+		Assert::AreEqual(b, math::transform(float3x4::identity, b));
+		Assert::AreEqual(aabb(float3(0, 2, 3), float3(6, 4, 6)),
+			math::transform(math::translation_matrix(float3(1, 0, 0)), b));
+		Assert::AreEqual(aabb::empty, math::transform(float3x4::identity, aabb::empty));
+	}
+};
+
+} // namespace unittest
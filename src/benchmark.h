@@ -0,0 +1,253 @@
+#ifndef MATH_SRC_BENCHMARK_H_
+#define MATH_SRC_BENCHMARK_H_
+
+// A minimal micro-benchmark harness in the spirit of Google Benchmark.
+// Every benchmark is a function which processes state.size() items per iteration:
+//
+//	void mul_float4x4(benchmark::state& state)
+//	{
+//		... prepare state.size() inputs ...
+//		while (state.keep_running()) {
+//			... process state.size() items ...
+//		}
+//	}
+//	BENCHMARK(mul_float4x4);
+//
+// The benchmark is run once for every size in benchmark::default_sizes, which range
+// from L1-resident to DRAM-resident data. benchmark_main.cpp runs the benchmarks
+// and reports ns per item and items per second as a console table or JSON.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <random>
+#include <string>
+#include <vector>
+#include "math/matrix_double.h"
+#include "math/vector_float.h"
+
+#if defined(_MSC_VER)
+	#include <intrin.h>
+#endif
+
+
+namespace benchmark {
+
+// The number of items, e.g. 256 float4 values (4 KiB) fit in L1, 1M float4 values (16 MiB) do not fit in LLC.
+constexpr size_t default_sizes[] = { 256, 4096, 65536, 1048576 };
+
+class state final {
+public:
+
+	state(size_t size, size_t iterations) noexcept
+		: size_(size), iterations_(iterations), remaining_(iterations)
+	{}
+
+
+	// Returns true while the benchmark has to run one more iteration. The first call starts the timer.
+	bool keep_running() noexcept
+	{
+		if (remaining_ == iterations_)
+			start_ = std::chrono::steady_clock::now();
+
+		if (remaining_ == 0) {
+			finish_ = std::chrono::steady_clock::now();
+			return false;
+		}
+
+		--remaining_;
+		return true;
+	}
+
+	// Returns the time spent between the first and the last keep_running() calls.
+	double elapsed_seconds() const noexcept
+	{
+		return std::chrono::duration<double>(finish_ - start_).count();
+	}
+
+	size_t iterations() const noexcept
+	{
+		return iterations_;
+	}
+
+	// The number of items which are processed per iteration. Equals to size() by default.
+	size_t items_per_iteration() const noexcept
+	{
+		return items_per_iteration_ ? items_per_iteration_ : size_;
+	}
+
+	void set_items_per_iteration(size_t items) noexcept
+	{
+		items_per_iteration_ = items;
+	}
+
+	size_t size() const noexcept
+	{
+		return size_;
+	}
+
+private:
+
+	size_t size_;
+	size_t iterations_;
+	size_t remaining_;
+	size_t items_per_iteration_ = 0;
+	std::chrono::steady_clock::time_point start_;
+	std::chrono::steady_clock::time_point finish_;
+};
+
+using benchmark_func = void (*)(state&);
+
+// Registers a benchmark, see BENCHMARK and BENCHMARK_SIZES.
+struct registrar final {
+	// The benchmark runs for every size of default_sizes.
+	registrar(const char* name, benchmark_func func);
+
+	registrar(const char* name, benchmark_func func, std::initializer_list<size_t> sizes);
+};
+
+#define BENCHMARK(func) \
+	static const ::benchmark::registrar func##_registrar_(#func, func)
+
+#define BENCHMARK_SIZES(func, ...) \
+	static const ::benchmark::registrar func##_registrar_(#func, func, { __VA_ARGS__ })
+
+// Prevents the compiler from optimizing away the computation of value.
+template<typename T>
+inline void do_not_optimize(const T& value) noexcept
+{
+#if defined(_MSC_VER)
+	const volatile char* p = reinterpret_cast<const volatile char*>(&value);
+	(void)*p;
+	_ReadWriteBarrier();
+#else
+	asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+// Forces the compiler to perform all the pending memory writes.
+inline void clobber_memory() noexcept
+{
+#if defined(_MSC_VER)
+	_ReadWriteBarrier();
+#else
+	asm volatile("" : : : "memory");
+#endif
+}
+
+
+// ----- input data -----
+
+// The type of the values random_values fills T with. T consists of floats by default.
+template<typename T> struct component_of { using type = float; };
+template<> struct component_of<double> { using type = double; };
+template<> struct component_of<math::double2> { using type = double; };
+template<> struct component_of<math::double3> { using type = double; };
+template<> struct component_of<math::double4> { using type = double; };
+template<> struct component_of<math::dquat> { using type = double; };
+template<> struct component_of<math::double3x3> { using type = double; };
+template<> struct component_of<math::double4x4> { using type = double; };
+
+// Fills count objects which consist of floats only (float3, float4x4, ...) or doubles only
+// (double3, double4x4, ...) with uniformly distributed values from [lo, hi].
+template<typename T>
+std::vector<T> random_values(size_t count, float lo, float hi, uint32_t seed)
+{
+	using C = typename component_of<T>::type;
+	static_assert(sizeof(T) % sizeof(C) == 0, "T must consist of floats or doubles.");
+
+	std::mt19937 gen(seed);
+	std::uniform_real_distribution<C> dist(lo, hi);
+
+	std::vector<T> v(count);
+	C* p = reinterpret_cast<C*>(v.data());
+	for (size_t i = 0; i < count * sizeof(T) / sizeof(C); ++i)
+		p[i] = dist(gen);
+
+	return v;
+}
+
+// Returns count unit vectors.
+std::vector<math::float3> random_unit_float3(size_t count, uint32_t seed);
+
+// Returns count unit quaternions.
+std::vector<math::quat> random_unit_quat(size_t count, uint32_t seed);
+
+// Returns the inputs of BENCHMARK_MAP and BENCHMARK_MAP2.
+template<typename T>
+inline std::vector<T> inputs(size_t count, float lo, float hi, uint32_t seed)
+{
+	return random_values<T>(count, lo, hi, seed);
+}
+
+// Quaternions are always unit ones, most of the functions expect so.
+template<>
+inline std::vector<math::quat> inputs<math::quat>(size_t count, float, float, uint32_t seed)
+{
+	return random_unit_quat(count, seed);
+}
+
+// ditto
+template<>
+inline std::vector<math::dquat> inputs<math::dquat>(size_t count, float, float, uint32_t seed)
+{
+	const std::vector<math::quat> q = random_unit_quat(count, seed);
+	return std::vector<math::dquat>(q.begin(), q.end());
+}
+
+
+// ----- helpers -----
+
+// Measures out[i] = func(a[i]) for state.size() items.
+template<typename R, typename A, typename Func>
+void map(state& state, const std::vector<A>& a, std::vector<R>& out, Func func)
+{
+	const size_t n = state.size();
+	while (state.keep_running()) {
+		for (size_t i = 0; i < n; ++i)
+			out[i] = func(a[i]);
+
+		clobber_memory();
+	}
+}
+
+// Measures out[i] = func(a[i], b[i]) for state.size() items.
+template<typename R, typename A, typename B, typename Func>
+void map(state& state, const std::vector<A>& a, const std::vector<B>& b, std::vector<R>& out, Func func)
+{
+	const size_t n = state.size();
+	while (state.keep_running()) {
+		for (size_t i = 0; i < n; ++i)
+			out[i] = func(a[i], b[i]);
+
+		clobber_memory();
+	}
+}
+
+// Defines and registers the benchmark name of the expression expr of a,
+// which is evaluated for every a[i] of type A from [lo, hi] and is stored into R out[i].
+#define BENCHMARK_MAP(name, R, A, lo, hi, expr)										\
+	void name(::benchmark::state& state)											\
+	{																				\
+		const std::vector<A> in_a = ::benchmark::inputs<A>(state.size(), lo, hi, 1);	\
+		std::vector<R> out(state.size());											\
+		::benchmark::map(state, in_a, out, [](const A& a) { return (expr); });		\
+	}																				\
+	BENCHMARK(name)
+
+// Same as BENCHMARK_MAP but for the expression of a and b.
+#define BENCHMARK_MAP2(name, R, A, B, lo, hi, expr)									\
+	void name(::benchmark::state& state)											\
+	{																				\
+		const std::vector<A> in_a = ::benchmark::inputs<A>(state.size(), lo, hi, 1);	\
+		const std::vector<B> in_b = ::benchmark::inputs<B>(state.size(), lo, hi, 2);	\
+		std::vector<R> out(state.size());											\
+		::benchmark::map(state, in_a, in_b, out,									\
+			[](const A& a, const B& b) { return (expr); });							\
+	}																				\
+	BENCHMARK(name)
+
+} // namespace benchmark
+
+#endif // MATH_SRC_BENCHMARK_H_
@@ -0,0 +1,274 @@
+#include "benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "math/dispatch.h"
+
+
+namespace {
+
+struct benchmark_info final {
+	std::string name;
+	benchmark::benchmark_func func;
+	std::vector<size_t> sizes;
+};
+
+struct result final {
+	std::string name;
+	size_t size;
+	size_t iterations;
+	double ns_per_item;
+	double items_per_second;
+};
+
+struct options final {
+	std::string filter;
+	std::string out_path;
+	double min_time = 0.2;
+	bool json = false;
+};
+
+std::vector<benchmark_info>& registry()
+{
+	static std::vector<benchmark_info> r;
+	return r;
+}
+
+std::string to_string(math::isa_level level)
+{
+	std::ostringstream s;
+	s << level;
+	return s.str();
+}
+
+bool parse_isa_level(const char* name, math::isa_level& level)
+{
+	for (uint8_t l = 0; l <= uint8_t(math::isa_level::avx512); ++l) {
+		if (to_string(math::isa_level(l)) == name) {
+			level = math::isa_level(l);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// Runs the benchmark with more and more iterations until it takes at least min_time seconds.
+result run(const benchmark_info& info, size_t size, double min_time)
+{
+	constexpr size_t max_iterations = 1000000000;
+
+	size_t iterations = 1;
+	for (;;) {
+		benchmark::state state(size, iterations);
+		info.func(state);
+
+		const double elapsed = state.elapsed_seconds();
+		if (elapsed >= min_time || iterations >= max_iterations) {
+			const double items = double(iterations) * double(state.items_per_iteration());
+			return { info.name, size, iterations, elapsed * 1e9 / items, items / elapsed };
+		}
+
+		// predict the number of iterations with some margin, but do not grow too fast.
+		const double multiplier = (elapsed > 0.0) ? std::min(10.0, 1.4 * min_time / elapsed) : 10.0;
+		iterations = std::max(iterations + 1, size_t(std::ceil(double(iterations) * multiplier)));
+		iterations = std::min(iterations, max_iterations);
+	}
+}
+
+void print_console_header(FILE* f)
+{
+	std::fprintf(f, "%-40s %10s %12s %14s %12s\n", "benchmark", "size", "ns/item", "items/s", "iterations");
+	std::fprintf(f, "%s\n", std::string(92, '-').c_str());
+}
+
+void print_console(FILE* f, const result& r)
+{
+	std::fprintf(f, "%-40s %10zu %12.3f %14.4g %12zu\n",
+		r.name.c_str(), r.size, r.ns_per_item, r.items_per_second, r.iterations);
+	std::fflush(f);
+}
+
+void print_json(FILE* f, const std::vector<result>& results, const options& opts)
+{
+	char date[32] = {};
+	const std::time_t now = std::time(nullptr);
+	std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+	std::fprintf(f, "{\n");
+	std::fprintf(f, "  \"context\": {\n");
+	std::fprintf(f, "    \"date\": \"%s\",\n", date);
+	std::fprintf(f, "    \"isa_level\": \"%s\",\n", to_string(math::active_isa_level()).c_str());
+	std::fprintf(f, "    \"supported_isa_level\": \"%s\",\n", to_string(math::supported_isa_level()).c_str());
+	std::fprintf(f, "    \"min_time\": %g\n", opts.min_time);
+	std::fprintf(f, "  },\n");
+	std::fprintf(f, "  \"benchmarks\": [\n");
+
+	for (size_t i = 0; i < results.size(); ++i) {
+		const result& r = results[i];
+		std::fprintf(f, "    {\n");
+		std::fprintf(f, "      \"name\": \"%s/%zu\",\n", r.name.c_str(), r.size);
+		std::fprintf(f, "      \"function\": \"%s\",\n", r.name.c_str());
+		std::fprintf(f, "      \"size\": %zu,\n", r.size);
+		std::fprintf(f, "      \"iterations\": %zu,\n", r.iterations);
+		std::fprintf(f, "      \"ns_per_item\": %.6g,\n", r.ns_per_item);
+		std::fprintf(f, "      \"items_per_second\": %.6g\n", r.items_per_second);
+		std::fprintf(f, "    }%s\n", (i + 1 < results.size()) ? "," : "");
+	}
+
+	std::fprintf(f, "  ]\n");
+	std::fprintf(f, "}\n");
+}
+
+void print_usage()
+{
+	std::printf(
+		"usage: benchmark [options]\n"
+		"  --filter=<text>     run the benchmarks whose names contain text\n"
+		"  --format=<format>   console (default) or json\n"
+		"  --out=<path>        write the results into the file instead of stdout\n"
+		"  --min_time=<sec>    minimal time of every run, 0.2 by default\n"
+		"  --isa=<level>       scalar, sse4.1, avx2 or avx512, the best supported one by default\n"
+		"  --list              print the names of the benchmarks\n");
+}
+
+bool starts_with(const char* s, const char* prefix, const char*& value)
+{
+	const size_t n = std::strlen(prefix);
+	if (std::strncmp(s, prefix, n) != 0) return false;
+
+	value = s + n;
+	return true;
+}
+
+} // namespace
+
+
+namespace benchmark {
+
+registrar::registrar(const char* name, benchmark_func func)
+{
+	registry().push_back({ name, func, { std::begin(default_sizes), std::end(default_sizes) } });
+}
+
+registrar::registrar(const char* name, benchmark_func func, std::initializer_list<size_t> sizes)
+{
+	registry().push_back({ name, func, sizes });
+}
+
+std::vector<math::float3> random_unit_float3(size_t count, uint32_t seed)
+{
+	std::vector<math::float3> v = random_values<math::float3>(count, -1.0f, 1.0f, seed);
+	for (math::float3& u : v) {
+		if (math::len_squared(u) < 1e-4f) u = math::float3::unit_x;
+		u = math::normalize(u);
+	}
+
+	return v;
+}
+
+std::vector<math::quat> random_unit_quat(size_t count, uint32_t seed)
+{
+	std::vector<math::quat> v = random_values<math::quat>(count, -1.0f, 1.0f, seed);
+	for (math::quat& q : v) {
+		if (math::len_squared(q) < 1e-4f) q = math::quat::identity;
+		q = math::normalize(q);
+	}
+
+	return v;
+}
+
+} // namespace benchmark
+
+
+int main(int argc, char* argv[])
+{
+	options opts;
+	bool list = false;
+
+	for (int i = 1; i < argc; ++i) {
+		const char* value = nullptr;
+		math::isa_level level;
+
+		if (starts_with(argv[i], "--filter=", value)) {
+			opts.filter = value;
+		}
+		else if (starts_with(argv[i], "--format=", value) && (std::strcmp(value, "json") == 0 || std::strcmp(value, "console") == 0)) {
+			opts.json = (std::strcmp(value, "json") == 0);
+		}
+		else if (starts_with(argv[i], "--out=", value)) {
+			opts.out_path = value;
+		}
+		else if (starts_with(argv[i], "--min_time=", value) && std::atof(value) > 0.0) {
+			opts.min_time = std::atof(value);
+		}
+		else if (starts_with(argv[i], "--isa=", value) && parse_isa_level(value, level)) {
+			if (level > math::supported_isa_level()) {
+				std::fprintf(stderr, "%s is not supported by the CPU.\n", value);
+				return 1;
+			}
+
+			math::force_isa_level(level);
+		}
+		else if (std::strcmp(argv[i], "--list") == 0) {
+			list = true;
+		}
+		else {
+			print_usage();
+			return (std::strcmp(argv[i], "--help") == 0) ? 0 : 1;
+		}
+	}
+
+	std::vector<benchmark_info> benchmarks;
+	for (const benchmark_info& info : registry()) {
+		if (info.name.find(opts.filter) != std::string::npos)
+			benchmarks.push_back(info);
+	}
+
+	std::sort(benchmarks.begin(), benchmarks.end(),
+		[](const benchmark_info& l, const benchmark_info& r) { return l.name < r.name; });
+
+	if (list) {
+		for (const benchmark_info& info : benchmarks)
+			std::printf("%s\n", info.name.c_str());
+
+		return 0;
+	}
+
+	FILE* f = stdout;
+	if (!opts.out_path.empty()) {
+		f = std::fopen(opts.out_path.c_str(), "w");
+		if (!f) {
+			std::fprintf(stderr, "Failed to open %s.\n", opts.out_path.c_str());
+			return 1;
+		}
+	}
+
+	// The console table is printed row by row, JSON is printed when all the benchmarks are done
+	// while the progress goes to stderr.
+	print_console_header(opts.json ? stderr : f);
+
+	std::vector<result> results;
+	for (const benchmark_info& info : benchmarks) {
+		for (size_t size : info.sizes) {
+			results.push_back(run(info, size, opts.min_time));
+			print_console(opts.json ? stderr : f, results.back());
+		}
+	}
+
+	if (opts.json)
+		print_json(f, results, opts);
+
+	if (f != stdout)
+		std::fclose(f);
+
+	return 0;
+}
@@ -0,0 +1,344 @@
+#include "math/bvh.h"
+
+#include <algorithm>
+#include <mutex>
+
+
+namespace {
+
+using math::aabb;
+using math::bvh;
+using math::float3;
+using math::thread_pool;
+
+// The number of the bins of the surface area heuristic.
+constexpr size_t bin_count = 16;
+
+// The minimum number of primitives binned by a single task.
+constexpr size_t grain = 16 * 1024;
+
+// The bounds of the primitives and of their centroids of a range.
+struct range_bounds final {
+	aabb bounds = aabb::empty;
+	aabb centroids = aabb::empty;
+};
+
+inline range_bounds merge(const range_bounds& l, const range_bounds& r) noexcept
+{
+	range_bounds res;
+	res.bounds = math::merge(l.bounds, r.bounds);
+	res.centroids = math::merge(l.centroids, r.centroids);
+	return res;
+}
+
+// A range of the primitives [begin, end) which becomes the child of a node.
+struct child_range final {
+	size_t begin;
+	size_t end;
+	range_bounds rb;
+};
+
+// A subtree which is built by a separate task and appended to the nodes afterwards.
+struct subtree_task final {
+	uint32_t parent;
+	size_t slot;
+	size_t depth;
+	child_range range;
+	std::vector<bvh::node> nodes;
+};
+
+void set_slot(bvh::node& n, size_t k, const aabb& b, uint32_t child, uint32_t count) noexcept
+{
+	n.min_x[k] = b.min.x;
+	n.min_y[k] = b.min.y;
+	n.min_z[k] = b.min.z;
+	n.max_x[k] = b.max.x;
+	n.max_y[k] = b.max.y;
+	n.max_z[k] = b.max.z;
+	n.children[k] = child;
+	n.counts[k] = count;
+}
+
+bvh::node empty_node() noexcept
+{
+	bvh::node n;
+	for (size_t k = 0; k < bvh::width; ++k)
+		set_slot(n, k, aabb(float3::zero, float3::zero), bvh::empty_slot, 0);
+
+	return n;
+}
+
+// Returns the union of the bounds of the children of n.
+aabb node_bounds(const bvh::node& n) noexcept
+{
+	aabb b = aabb::empty;
+	for (size_t k = 0; k < bvh::width; ++k) {
+		if (n.children[k] != bvh::empty_slot)
+			b = math::merge(b, math::detail::child_bounds(n, k));
+	}
+
+	return b;
+}
+
+// Builds the nodes of the ranges of indices, the task of a single thread or the top of the hierarchy.
+class builder final {
+public:
+
+	// If tasks is not nullptr the subtrees of at most subtree_size primitives are not built
+	// but appended to tasks, pool (if any) speeds up the binning of the ranges.
+	builder(const aabb* bounds, const float3* centroids, uint32_t* indices, std::vector<bvh::node>& nodes,
+		thread_pool* pool, std::vector<subtree_task>* tasks, size_t subtree_size) noexcept
+		: bounds_(bounds), centroids_(centroids), indices_(indices), nodes_(nodes),
+		pool_(pool), tasks_(tasks), subtree_size_(subtree_size)
+	{}
+
+
+	range_bounds compute_bounds(size_t begin, size_t end) const noexcept
+	{
+		range_bounds res;
+		std::mutex mutex;
+		parallel_for(pool_, end - begin, grain, [&](size_t b, size_t e) {
+			range_bounds rb;
+			for (size_t i = begin + b; i < begin + e; ++i) {
+				const uint32_t p = indices_[i];
+				rb.bounds = math::merge(rb.bounds, bounds_[p]);
+				rb.centroids = math::merge(rb.centroids, centroids_[p]);
+			}
+
+			std::lock_guard<std::mutex> lock(mutex);
+			res = merge(res, rb);
+		});
+
+		return res;
+	}
+
+	// Fills the node (already allocated) with the children of the range r at the given depth.
+	void build_node(uint32_t node_index, const child_range& r, size_t depth)
+	{
+		// the child of the largest area is split until there are width children or all of them are leaves.
+		child_range children[bvh::width] = { r };
+		size_t child_count = 1;
+		while (child_count < bvh::width) {
+			size_t best = bvh::width;
+			float best_area = -1.0f;
+			for (size_t k = 0; k < child_count; ++k) {
+				const float area = math::surface_area(children[k].rb.bounds);
+				if (children[k].end - children[k].begin > bvh::max_leaf_size && area > best_area) {
+					best = k;
+					best_area = area;
+				}
+			}
+
+			if (best == bvh::width) break;
+
+			const child_range c = children[best];
+			const size_t mid = split(c, depth);
+			children[best] = { c.begin, mid, compute_bounds(c.begin, mid) };
+			children[child_count++] = { mid, c.end, compute_bounds(mid, c.end) };
+		}
+
+		for (size_t k = 0; k < child_count; ++k) {
+			const child_range& c = children[k];
+			const size_t count = c.end - c.begin;
+			if (count <= bvh::max_leaf_size) {
+				set_slot(nodes_[node_index], k, c.rb.bounds, uint32_t(c.begin), uint32_t(count));
+				continue;
+			}
+
+			if (tasks_ && count <= subtree_size_) {
+				set_slot(nodes_[node_index], k, c.rb.bounds, bvh::empty_slot, 0);
+				tasks_->push_back({ node_index, k, depth + 1, c, {} });
+				continue;
+			}
+
+			// nodes_ may be reallocated, the node is referred to by its index.
+			const uint32_t child = uint32_t(nodes_.size());
+			nodes_.push_back(empty_node());
+			set_slot(nodes_[node_index], k, c.rb.bounds, child, 0);
+			build_node(child, c, depth + 1);
+		}
+	}
+
+private:
+
+	// Partitions the range into two non-empty ones and returns the beginning of the second one.
+	size_t split(const child_range& r, size_t depth) const
+	{
+		const aabb& cb = r.rb.centroids;
+		const float3 extent = cb.max - cb.min;
+		const size_t axis = (extent.x >= extent.y && extent.x >= extent.z) ? 0 : ((extent.y >= extent.z) ? 1 : 2);
+		const float lo = (&cb.min.x)[axis];
+		const float size = (&extent.x)[axis];
+
+		uint32_t* first = indices_ + r.begin;
+		uint32_t* last = indices_ + r.end;
+		const auto key = [&](uint32_t p) { return (&centroids_[p].x)[axis]; };
+
+		// all the centroids coincide: any partition is as good as the other.
+		if (size <= 0.0f) return (r.begin + r.end) / 2;
+
+		if (depth >= bvh::max_sah_depth) {
+			uint32_t* mid = first + (last - first) / 2;
+			std::nth_element(first, mid, last, [&](uint32_t a, uint32_t b) { return key(a) < key(b); });
+			return r.begin + (mid - first);
+		}
+
+		// the bin of the largest centroid is bin_count - 1.
+		const float scale = float(bin_count) * (1.0f - 1e-6f) / size;
+		const auto bin_of = [&](uint32_t p) {
+			return std::min(bin_count - 1, size_t((key(p) - lo) * scale));
+		};
+
+		aabb bin_bounds[bin_count];
+		size_t bin_counts[bin_count] = {};
+		std::fill(bin_bounds, bin_bounds + bin_count, aabb::empty);
+
+		std::mutex mutex;
+		parallel_for(pool_, r.end - r.begin, grain, [&](size_t b, size_t e) {
+			aabb bb[bin_count];
+			size_t bc[bin_count] = {};
+			std::fill(bb, bb + bin_count, aabb::empty);
+			for (const uint32_t* p = first + b; p != first + e; ++p) {
+				const size_t i = bin_of(*p);
+				bb[i] = math::merge(bb[i], bounds_[*p]);
+				++bc[i];
+			}
+
+			std::lock_guard<std::mutex> lock(mutex);
+			for (size_t i = 0; i < bin_count; ++i) {
+				bin_bounds[i] = math::merge(bin_bounds[i], bb[i]);
+				bin_counts[i] += bc[i];
+			}
+		});
+
+		// the cost of the split before bin i: area(left) * count(left) + area(right) * count(right).
+		float right_cost[bin_count];
+		aabb acc = aabb::empty;
+		size_t count = 0;
+		for (size_t i = bin_count - 1; i > 0; --i) {
+			acc = math::merge(acc, bin_bounds[i]);
+			count += bin_counts[i];
+			right_cost[i] = (count > 0) ? math::surface_area(acc) * float(count) : 0.0f;
+		}
+
+		size_t best_bin = 0;
+		float best_cost = 0.0f;
+		acc = aabb::empty;
+		count = 0;
+		for (size_t i = 1; i < bin_count; ++i) {
+			acc = math::merge(acc, bin_bounds[i - 1]);
+			count += bin_counts[i - 1];
+			if (count == 0 || count == r.end - r.begin) continue;
+
+			const float cost = math::surface_area(acc) * float(count) + right_cost[i];
+			if (best_bin == 0 || cost < best_cost) {
+				best_bin = i;
+				best_cost = cost;
+			}
+		}
+
+		// the first and the last bins are never empty, there is a split.
+		assert(best_bin > 0);
+		uint32_t* mid = std::partition(first, last, [&](uint32_t p) { return bin_of(p) < best_bin; });
+		return r.begin + (mid - first);
+	}
+
+
+	const aabb* bounds_;
+	const float3* centroids_;
+	uint32_t* indices_;
+	std::vector<bvh::node>& nodes_;
+	thread_pool* pool_;
+	std::vector<subtree_task>* tasks_;
+	size_t subtree_size_;
+};
+
+} // namespace
+
+
+namespace math {
+
+constexpr size_t bvh::width;
+constexpr size_t bvh::max_leaf_size;
+constexpr size_t bvh::max_sah_depth;
+constexpr uint32_t bvh::empty_slot;
+constexpr size_t bvh::stack_size;
+
+
+bvh::bvh(const aabb* bounds, size_t count, thread_pool* pool)
+	: indices_(count)
+{
+	assert(count == 0 || bounds);
+	assert(count <= UINT32_MAX);
+	if (count == 0) return;
+
+	std::vector<float3> centroids(count);
+	parallel_for(pool, count, grain, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			assert(!is_empty(bounds[i]));
+			centroids[i] = center(bounds[i]);
+			indices_[i] = uint32_t(i);
+		}
+	});
+
+	// the top of the hierarchy is built on the calling thread with the binning spread across the pool,
+	// the subtrees below it are built by the tasks, a few per thread.
+	std::vector<subtree_task> tasks;
+	const size_t subtree_size = pool ? std::max(grain, count / (4 * pool->concurrency())) : count;
+	builder top(bounds, centroids.data(), indices_.data(), nodes_, pool, pool ? &tasks : nullptr, subtree_size);
+
+	const range_bounds rb = top.compute_bounds(0, count);
+	bounds_ = rb.bounds;
+	nodes_.push_back(empty_node());
+	top.build_node(0, { 0, count, rb }, 0);
+
+	parallel_for(pool, tasks.size(), 1, [&](size_t begin, size_t end) {
+		for (size_t t = begin; t < end; ++t) {
+			subtree_task& task = tasks[t];
+			builder b(bounds, centroids.data(), indices_.data(), task.nodes, nullptr, nullptr, 0);
+			task.nodes.push_back(empty_node());
+			b.build_node(0, task.range, task.depth);
+		}
+	});
+
+	// the nodes of every subtree refer to each other by the indices relative to its root.
+	for (subtree_task& task : tasks) {
+		const uint32_t base = uint32_t(nodes_.size());
+		for (node& n : task.nodes) {
+			for (size_t k = 0; k < width; ++k) {
+				if (n.children[k] != empty_slot && n.counts[k] == 0) n.children[k] += base;
+			}
+		}
+
+		nodes_[task.parent].children[task.slot] = base;
+		nodes_.insert(nodes_.end(), task.nodes.begin(), task.nodes.end());
+	}
+}
+
+void bvh::refit(const aabb* bounds) noexcept
+{
+	assert(size() == 0 || bounds);
+
+	// the children follow their parents: the nodes are updated from the last one to the root.
+	for (size_t i = nodes_.size(); i-- > 0;) {
+		node& n = nodes_[i];
+		for (size_t k = 0; k < width; ++k) {
+			if (n.children[k] == empty_slot) continue;
+
+			aabb b = aabb::empty;
+			if (n.counts[k] == 0) {
+				b = node_bounds(nodes_[n.children[k]]);
+			}
+			else {
+				for (uint32_t j = 0; j < n.counts[k]; ++j)
+					b = merge(b, bounds[indices_[n.children[k] + j]]);
+			}
+
+			set_slot(n, k, b, n.children[k], n.counts[k]);
+		}
+	}
+
+	bounds_ = nodes_.empty() ? aabb::empty : node_bounds(nodes_[0]);
+}
+
+} // namespace math
@@ -0,0 +1,117 @@
+#include "math/bvh.h"
+
+#include <limits>
+#include <vector>
+#include "benchmark.h"
+
+using math::aabb;
+using math::bvh;
+using math::float3;
+using math::ray;
+
+
+namespace {
+
+// A soup of count small triangles scattered over the [-10, 10] cube.
+struct bench_mesh final {
+	explicit bench_mesh(size_t count)
+		: v0(benchmark::random_values<float3>(count, -10.0f, 10.0f, 1)), v1(count), v2(count), bounds(count)
+	{
+		const std::vector<float3> a = benchmark::random_values<float3>(count, -0.5f, 0.5f, 2);
+		const std::vector<float3> b = benchmark::random_values<float3>(count, -0.5f, 0.5f, 3);
+		for (size_t i = 0; i < count; ++i) {
+			v1[i] = v0[i] + a[i];
+			v2[i] = v0[i] + b[i];
+			bounds[i] = math::merge(math::merge(aabb(v0[i], v0[i]), v1[i]), v2[i]);
+		}
+	}
+
+	std::vector<float3> v0, v1, v2;
+	std::vector<aabb> bounds;
+};
+
+// The rays start outside of the [-10, 10] cube and point into it.
+std::vector<ray> bench_rays(size_t count)
+{
+	const std::vector<float3> o = benchmark::random_unit_float3(count, 4);
+	const std::vector<float3> target = benchmark::random_values<float3>(count, -5.0f, 5.0f, 5);
+	std::vector<ray> rays(count);
+	for (size_t i = 0; i < count; ++i)
+		rays[i] = ray(20.0f * o[i], target[i] - 20.0f * o[i]);
+
+	return rays;
+}
+
+// The number of the triangles of the scene the rays are cast against.
+constexpr size_t scene_size = 64 * 1024;
+
+// ----- batch functions -----
+
+void build_bvh_batch(benchmark::state& state)
+{
+	const bench_mesh mesh(state.size());
+
+	while (state.keep_running()) {
+		const bvh h(mesh.bounds.data(), state.size());
+		benchmark::do_not_optimize(h.node_count());
+	}
+}
+BENCHMARK(build_bvh_batch);
+
+void refit_bvh_batch(benchmark::state& state)
+{
+	const bench_mesh mesh(state.size());
+	bvh h(mesh.bounds.data(), state.size());
+
+	while (state.keep_running()) {
+		h.refit(mesh.bounds.data());
+		benchmark::clobber_memory();
+	}
+}
+BENCHMARK(refit_bvh_batch);
+
+// state.size() rays are cast against the scene of scene_size triangles.
+void closest_hit_bvh_batch(benchmark::state& state)
+{
+	static const bench_mesh mesh(scene_size);
+	static const bvh h(mesh.bounds.data(), scene_size);
+	const std::vector<ray> rays = bench_rays(state.size());
+	std::vector<float> out(state.size());
+
+	while (state.keep_running()) {
+		for (size_t i = 0; i < state.size(); ++i) {
+			const ray& r = rays[i];
+			uint32_t p = 0;
+			float t = std::numeric_limits<float>::infinity();
+			h.closest_hit(r, t, [&](uint32_t j, float t_max, float& tj) {
+				return math::intersects(r, mesh.v0[j], mesh.v1[j], mesh.v2[j], t_max, tj);
+			}, p, t);
+			out[i] = t;
+		}
+
+		benchmark::clobber_memory();
+	}
+}
+BENCHMARK(closest_hit_bvh_batch);
+
+void any_hit_bvh_batch(benchmark::state& state)
+{
+	static const bench_mesh mesh(scene_size);
+	static const bvh h(mesh.bounds.data(), scene_size);
+	const std::vector<ray> rays = bench_rays(state.size());
+	std::vector<uint8_t> out(state.size());
+
+	while (state.keep_running()) {
+		for (size_t i = 0; i < state.size(); ++i) {
+			const ray& r = rays[i];
+			out[i] = h.any_hit(r, std::numeric_limits<float>::infinity(), [&](uint32_t j, float t_max, float& tj) {
+				return math::intersects(r, mesh.v0[j], mesh.v1[j], mesh.v2[j], t_max, tj);
+			});
+		}
+
+		benchmark::clobber_memory();
+	}
+}
+BENCHMARK(any_hit_bvh_batch);
+
+} // namespace
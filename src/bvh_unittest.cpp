@@ -0,0 +1,281 @@
+#include "math/bvh.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include "CppUnitTest.h"
+#include "test_utility.h"
+
+
+using math::aabb;
+using math::bvh;
+using math::float3;
+using math::ray;
+using unittest::test_float3;
+using unittest::test_value;
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+
+namespace Microsoft { namespace VisualStudio { namespace CppUnitTestFramework {
+
+template<> inline std::wstring ToString<math::aabb>(const math::aabb& t) { RETURN_WIDE_STRING(t); }
+
+}}} // namespace Microsoft::VisualStudio::CppUnitTestFramework
+
+
+namespace {
+
+constexpr float inf = std::numeric_limits<float>::infinity();
+
+// A soup of small triangles scattered over the [-10, 10] cube.
+struct test_mesh final {
+	explicit test_mesh(size_t count)
+		: v0(count), v1(count), v2(count), bounds(count)
+	{
+		for (size_t i = 0; i < count; ++i) {
+			// test_value repeats every 2001 values, the offsets make the triangles unique.
+			const float3 c = test_float3(i, 1, 10.0f) + float3(float(i / 2001) * 0.01f);
+			v0[i] = c;
+			v1[i] = c + float3(0.5f, test_value(i, 4, 0.25f), test_value(i, 5, 0.25f));
+			v2[i] = c + float3(test_value(i, 6, 0.25f), 0.5f, test_value(i, 7, 0.25f));
+			update_bounds(i);
+		}
+	}
+
+	void update_bounds(size_t i) noexcept
+	{
+		bounds[i] = math::merge(math::merge(aabb(v0[i], v0[i]), v1[i]), v2[i]);
+	}
+
+	bool intersect(const ray& r, uint32_t p, float t_max, float& t) const noexcept
+	{
+		return math::intersects(r, v0[p], v1[p], v2[p], t_max, t);
+	}
+
+	// Finds the closest hit testing every triangle.
+	bool closest_hit(const ray& r, float t_max, uint32_t& primitive, float& t) const noexcept
+	{
+		bool hit = false;
+		for (uint32_t p = 0; p < bounds.size(); ++p) {
+			if (intersect(r, p, t_max, t_max)) {
+				primitive = p;
+				hit = true;
+			}
+		}
+
+		if (hit) t = t_max;
+		return hit;
+	}
+
+	std::vector<float3> v0, v1, v2;
+	std::vector<aabb> bounds;
+};
+
+// Returns a ray from the outside of the [-10, 10] cube into it.
+ray test_ray(size_t i) noexcept
+{
+	const float3 o = math::normalize(test_float3(i, 20, 1.0f) + float3(0.01f)) * 20.0f;
+	return ray(o, test_float3(i, 23, 5.0f) - o);
+}
+
+// Checks the invariants of the hierarchy: every primitive is referred to by a single leaf,
+// the leaves are not larger than bvh::max_leaf_size, the children follow their parents
+// and the bounds of every child contain its primitives.
+void check_structure(const bvh& h, const std::vector<aabb>& bounds)
+{
+	Assert::AreEqual(bounds.size(), h.size());
+
+	std::vector<uint32_t> sorted(h.primitive_indices(), h.primitive_indices() + h.size());
+	std::sort(sorted.begin(), sorted.end());
+	for (size_t i = 0; i < sorted.size(); ++i)
+		Assert::AreEqual<uint32_t>(uint32_t(i), sorted[i]);
+
+	std::vector<size_t> refs(h.size(), 0);
+	aabb all = aabb::empty;
+	for (size_t i = 0; i < h.node_count(); ++i) {
+		const bvh::node& n = h.nodes()[i];
+		for (size_t k = 0; k < bvh::width; ++k) {
+			if (n.children[k] == bvh::empty_slot) continue;
+
+			const aabb cb = math::detail::child_bounds(n, k);
+			if (i == 0) all = math::merge(all, cb);
+
+			if (n.counts[k] == 0) {
+				Assert::IsTrue(n.children[k] > i && n.children[k] < h.node_count());
+				const bvh::node& c = h.nodes()[n.children[k]];
+				for (size_t j = 0; j < bvh::width; ++j) {
+					if (c.children[j] != bvh::empty_slot)
+						Assert::IsTrue(math::merge(cb, math::detail::child_bounds(c, j)) == cb);
+				}
+				continue;
+			}
+
+			Assert::IsTrue(n.counts[k] <= bvh::max_leaf_size);
+			for (uint32_t j = 0; j < n.counts[k]; ++j) {
+				const uint32_t p = h.primitive_indices()[n.children[k] + j];
+				++refs[n.children[k] + j];
+				Assert::IsTrue(math::merge(cb, bounds[p]) == cb);
+			}
+		}
+	}
+
+	for (size_t r : refs)
+		Assert::AreEqual<size_t>(1, r);
+
+	Assert::AreEqual(all, h.bounds());
+}
+
+// Casts the rays with the hierarchy and compares the hits with the ones of the linear scan.
+// Returns the number of the hits.
+size_t check_hits(const bvh& h, const test_mesh& mesh, size_t ray_count)
+{
+	size_t hit_count = 0;
+	for (size_t i = 0; i < ray_count; ++i) {
+		const ray r = test_ray(i);
+		const float t_max = (i % 4 == 0) ? 0.5f : inf;
+		const auto intersect = [&](uint32_t p, float tm, float& t) { return mesh.intersect(r, p, tm, t); };
+
+		uint32_t expected_p = 7, p = 7;
+		float expected_t = 7.0f, t = 7.0f;
+		const bool expected = mesh.closest_hit(r, t_max, expected_p, expected_t);
+		Assert::AreEqual(expected, h.closest_hit(r, t_max, intersect, p, t));
+		Assert::AreEqual(expected, h.any_hit(r, t_max, intersect));
+		Assert::AreEqual(expected_p, p);
+		Assert::AreEqual(expected_t, t);
+
+		if (expected) ++hit_count;
+	}
+
+	return hit_count;
+}
+
+} // namespace
+
+
+namespace unittest {
+
+TEST_CLASS(math_bvh) {
+public:
+
+	TEST_METHOD(build)
+	{
+		for (size_t count : { 1, 3, 4, 5, 17, 100, 1000, 5000 }) {
+			const test_mesh mesh(count);
+			const bvh h(mesh.bounds.data(), count);
+			check_structure(h, mesh.bounds);
+		}
+
+		// the coincident primitives are split as well.
+		const std::vector<aabb> same(100, aabb(float3(1, 2, 3), float3(4, 5, 6)));
+		const bvh hs(same.data(), same.size());
+		check_structure(hs, same);
+	}
+
+	TEST_METHOD(build_parallel)
+	{
+		const size_t count = 100000;
+		const test_mesh mesh(count);
+
+		test_thread_pool pool;
+		const bvh h(mesh.bounds.data(), count, &pool);
+		Assert::IsTrue(pool.run_count > 0);
+		check_structure(h, mesh.bounds);
+		Assert::IsTrue(check_hits(h, mesh, 200) > 20);
+	}
+
+	TEST_METHOD(closest_hit)
+	{
+		for (size_t count : { 1, 5, 100, 3000 }) {
+			const test_mesh mesh(count);
+			const bvh h(mesh.bounds.data(), count);
+
+			// the rays are not all hits or all misses.
+			if (count > 1) {
+				const size_t hit_count = check_hits(h, mesh, 300);
+				Assert::IsTrue((count < 100 || hit_count > 30) && hit_count < 300);
+				continue;
+			}
+
+			const ray r(float3(mesh.v0[0] + float3(0, 0, -5)), float3(0, 0, 1));
+			const auto intersect = [&](uint32_t p, float tm, float& t) { return mesh.intersect(r, p, tm, t); };
+			uint32_t p = 7;
+			float t = 7.0f;
+			Assert::IsTrue(h.closest_hit(r, inf, intersect, p, t));
+			Assert::AreEqual<uint32_t>(0, p);
+			Assert::IsTrue(math::approx_equal(5.0f, t, 1e-5f));
+			Assert::IsFalse(h.closest_hit(r, 4.0f, intersect, p, t));
+		}
+	}
+
+	TEST_METHOD(empty)
+	{
+		const bvh h;
+		Assert::AreEqual<size_t>(0, h.size());
+		Assert::AreEqual<size_t>(0, h.node_count());
+		Assert::AreEqual(aabb::empty, h.bounds());
+
+		const bvh h0(nullptr, 0);
+		Assert::AreEqual<size_t>(0, h0.node_count());
+
+		const ray r(float3::zero, float3(0, 0, 1));
+		const auto intersect = [](uint32_t, float, float&) { return true; };
+		uint32_t p = 7;
+		float t = 7.0f;
+		Assert::IsFalse(h.closest_hit(r, inf, intersect, p, t));
+		Assert::IsFalse(h.any_hit(r, inf, intersect));
+		Assert::AreEqual<uint32_t>(7, p);
+
+		size_t calls = 0;
+		h.query(aabb(float3(-1), float3(1)), [&](uint32_t) { ++calls; });
+		Assert::AreEqual<size_t>(0, calls);
+	}
+
+	TEST_METHOD(query)
+	{
+		const test_mesh mesh(2000);
+		const bvh h(mesh.bounds.data(), mesh.bounds.size());
+
+		for (size_t i = 0; i < 20; ++i) {
+			const float3 c = test_float3(i, 30, 10.0f);
+			const aabb b(c - float3(1.5f), c + float3(1.5f));
+
+			std::vector<uint32_t> candidates;
+			h.query(b, [&](uint32_t p) { candidates.push_back(p); });
+			std::sort(candidates.begin(), candidates.end());
+			Assert::IsTrue(std::adjacent_find(candidates.begin(), candidates.end()) == candidates.end());
+
+			// every overlapping primitive is a candidate, a few of the others may be as well.
+			size_t overlaps = 0;
+			for (uint32_t p = 0; p < mesh.bounds.size(); ++p) {
+				if (!math::intersects(mesh.bounds[p], b)) continue;
+
+				++overlaps;
+				Assert::IsTrue(std::binary_search(candidates.begin(), candidates.end(), p));
+			}
+
+			Assert::IsTrue(candidates.size() < 4 * overlaps + 4 * bvh::max_leaf_size);
+		}
+	}
+
+	TEST_METHOD(refit)
+	{
+		test_mesh mesh(3000);
+		bvh h(mesh.bounds.data(), mesh.bounds.size());
+
+		// the triangles move and rotate a little.
+		for (size_t i = 0; i < mesh.bounds.size(); ++i) {
+			const float3 d = test_float3(i, 40, 0.3f);
+			mesh.v0[i] += d;
+			mesh.v1[i] += d + test_float3(i, 43, 0.1f);
+			mesh.v2[i] -= d;
+			mesh.update_bounds(i);
+		}
+
+		h.refit(mesh.bounds.data());
+		check_structure(h, mesh.bounds);
+		Assert::IsTrue(check_hits(h, mesh, 300) > 30);
+	}
+};
+
+} // namespace unittest
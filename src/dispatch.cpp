@@ -0,0 +1,180 @@
+#include "math/dispatch.h"
+
+#include <atomic>
+#include <cassert>
+#include "kernels.h"
+
+#if MATH_X86
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+	#else
+		#include <cpuid.h>
+	#endif
+#endif
+
+
+namespace {
+
+using math::isa_level;
+using math::kernel_table;
+
+#if MATH_X86
+
+struct cpuid_regs final {
+	uint32_t eax = 0;
+	uint32_t ebx = 0;
+	uint32_t ecx = 0;
+	uint32_t edx = 0;
+};
+
+cpuid_regs cpuid(uint32_t leaf, uint32_t subleaf) noexcept
+{
+	cpuid_regs r;
+
+#if defined(_MSC_VER)
+	int regs[4];
+	__cpuidex(regs, int(leaf), int(subleaf));
+	r.eax = uint32_t(regs[0]);
+	r.ebx = uint32_t(regs[1]);
+	r.ecx = uint32_t(regs[2]);
+	r.edx = uint32_t(regs[3]);
+#else
+	__cpuid_count(leaf, subleaf, r.eax, r.ebx, r.ecx, r.edx);
+#endif
+
+	return r;
+}
+
+// Returns XCR0, the register state components the OS saves and restores on context switches.
+uint64_t xgetbv0() noexcept
+{
+#if defined(_MSC_VER)
+	return _xgetbv(0);
+#else
+	uint32_t lo, hi;
+	__asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+	return (uint64_t(hi) << 32) | lo;
+#endif
+}
+
+isa_level probe_isa_level() noexcept
+{
+	const uint32_t max_leaf = cpuid(0, 0).eax;
+	if (max_leaf < 1) return isa_level::scalar;
+
+	const cpuid_regs r1 = cpuid(1, 0);
+	const bool sse4_1 = (r1.ecx & (1u << 19)) != 0;
+	if (!sse4_1) return isa_level::scalar;
+
+	const bool fma = (r1.ecx & (1u << 12)) != 0;
+	const bool osxsave = (r1.ecx & (1u << 27)) != 0;
+	// the avx2 kernels convert half precision values with F16C.
+	const bool f16c = (r1.ecx & (1u << 29)) != 0;
+	if (!fma || !osxsave || !f16c || max_leaf < 7) return isa_level::sse4_1;
+
+	// the OS has to save xmm and ymm registers (XCR0 bits 1, 2) to make AVX usable.
+	const uint64_t xcr0 = xgetbv0();
+	if ((xcr0 & 0x6) != 0x6) return isa_level::sse4_1;
+
+	const cpuid_regs r7 = cpuid(7, 0);
+	const bool avx2 = (r7.ebx & (1u << 5)) != 0;
+	if (!avx2) return isa_level::sse4_1;
+
+	// AVX-512 also requires opmask and zmm registers state (XCR0 bits 5, 6, 7).
+	const bool avx512f = (r7.ebx & (1u << 16)) != 0;
+	if (!avx512f || (xcr0 & 0xe6) != 0xe6) return isa_level::avx2;
+
+	return isa_level::avx512;
+}
+
+#else
+
+isa_level probe_isa_level() noexcept
+{
+	return isa_level::scalar;
+}
+
+#endif // MATH_X86
+
+const kernel_table& kernels_of(isa_level level) noexcept
+{
+	switch (level) {
+#if MATH_X86
+		case isa_level::sse4_1:	return math::sse4_1_kernels;
+		case isa_level::avx2:	return math::avx2_kernels;
+		case isa_level::avx512:	return math::avx512_kernels;
+#endif
+		default:				return math::scalar_kernels;
+	}
+}
+
+struct dispatch_state final {
+	dispatch_state() noexcept
+		: supported(probe_isa_level()), active(supported), kernels(&kernels_of(supported))
+	{}
+
+	const isa_level supported;
+	std::atomic<isa_level> active;
+	std::atomic<const kernel_table*> kernels;
+};
+
+dispatch_state& state() noexcept
+{
+	static dispatch_state s;
+	return s;
+}
+
+const char* name_of(isa_level level) noexcept
+{
+	switch (level) {
+		case isa_level::scalar:	return "scalar";
+		case isa_level::sse4_1:	return "sse4.1";
+		case isa_level::avx2:	return "avx2";
+		case isa_level::avx512:	return "avx512";
+		default:				return "unknown";
+	}
+}
+
+} // namespace
+
+
+namespace math {
+
+std::ostream& operator<<(std::ostream& o, isa_level level)
+{
+	o << name_of(level);
+	return o;
+}
+
+std::wostream& operator<<(std::wostream& o, isa_level level)
+{
+	o << name_of(level);
+	return o;
+}
+
+const kernel_table& active_kernels() noexcept
+{
+	return *state().kernels.load(std::memory_order_acquire);
+}
+
+isa_level active_isa_level() noexcept
+{
+	return state().active.load(std::memory_order_acquire);
+}
+
+void force_isa_level(isa_level level) noexcept
+{
+	dispatch_state& s = state();
+	assert(level <= s.supported);
+	if (level > s.supported) level = s.supported;
+
+	s.active.store(level, std::memory_order_release);
+	s.kernels.store(&kernels_of(level), std::memory_order_release);
+}
+
+isa_level supported_isa_level() noexcept
+{
+	return state().supported;
+}
+
+} // namespace math
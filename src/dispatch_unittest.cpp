@@ -0,0 +1,675 @@
+#include "math/dispatch.h"
+
+#include <cstring>
+#include <limits>
+#include <vector>
+#include "math/matrix.h"
+#include "math/matrix_double.h"
+#include "math/vector_utility.h"
+#include "CppUnitTest.h"
+#include "test_utility.h"
+
+
+using math::double3;
+using math::double4;
+using math::double4x4;
+using math::float2;
+using math::float3;
+using math::float4;
+using math::float4x4;
+using math::isa_level;
+using math::quat;
+using unittest::test_value;
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+
+namespace Microsoft { namespace VisualStudio { namespace CppUnitTestFramework {
+
+template<> inline std::wstring ToString<math::isa_level>(const math::isa_level& t) { RETURN_WIDE_STRING(t); }
+
+}}} // namespace Microsoft::VisualStudio::CppUnitTestFramework
+
+
+namespace {
+
+bool near(const float4& l, const float4& r) noexcept
+{
+	return math::approx_equal(l.x, r.x, 1e-4f) && math::approx_equal(l.y, r.y, 1e-4f)
+		&& math::approx_equal(l.z, r.z, 1e-4f) && math::approx_equal(l.w, r.w, 1e-4f);
+}
+
+bool near(const float3& l, const float3& r) noexcept
+{
+	return near(float4(l.x, l.y, l.z, 0.0f), float4(r.x, r.y, r.z, 0.0f));
+}
+
+bool near(const quat& l, const quat& r) noexcept
+{
+	return near(float4(l.x, l.y, l.z, l.a), float4(r.x, r.y, r.z, r.a));
+}
+
+// Returns a value from [0, 1] which depends on i and seed.
+float test_unorm_value(size_t i, size_t seed) noexcept
+{
+	return 0.5f * (test_value(i, seed) + 1.0f);
+}
+
+// Returns count unit quaternions which depend on seed.
+std::vector<quat> test_quats(size_t count, size_t seed)
+{
+	std::vector<quat> q(count);
+	for (size_t i = 0; i < count; ++i) {
+		q[i] = math::normalize(quat(test_value(i, seed) + 0.1f, test_value(i, seed + 1),
+			test_value(i, seed + 2), test_value(i, seed + 3)));
+	}
+
+	return q;
+}
+
+} // namespace
+
+
+namespace unittest {
+
+TEST_CLASS(math_dispatch) {
+public:
+
+	TEST_METHOD(isa_levels)
+	{
+		using math::active_isa_level;
+		using math::force_isa_level;
+		using math::supported_isa_level;
+
+		const isa_level supported = supported_isa_level();
+		Assert::AreEqual(supported, active_isa_level());
+
+		force_isa_level(isa_level::scalar);
+		Assert::AreEqual(isa_level::scalar, active_isa_level());
+		Assert::AreEqual(supported, supported_isa_level());
+
+		force_isa_level(supported);
+		Assert::AreEqual(supported, active_isa_level());
+
+		Assert::AreEqual(std::wstring(L"scalar"), ToString(isa_level::scalar));
+		Assert::AreEqual(std::wstring(L"sse4.1"), ToString(isa_level::sse4_1));
+		Assert::AreEqual(std::wstring(L"avx2"), ToString(isa_level::avx2));
+		Assert::AreEqual(std::wstring(L"avx512"), ToString(isa_level::avx512));
+	}
+
+	TEST_METHOD(mul_float4x4_float4)
+	{
+		float4x4 m;
+		for (size_t i = 0; i < 16; ++i) (&m.m00)[i] = test_value(i, 1, 2.0f);
+
+		std::vector<float4> v(max_test_count);
+		for (size_t i = 0; i < max_test_count; ++i)
+			v[i] = float4(test_value(i, 2), test_value(i, 3), test_value(i, 4), test_value(i, 5));
+
+		for_each_isa_level([&] {
+			for (size_t count : test_counts) {
+				std::vector<float4> out(max_test_count, float4::zero);
+				math::mul(m, v.data(), out.data(), count);
+
+				for (size_t i = 0; i < count; ++i)
+					Assert::IsTrue(near(math::mul(m, v[i]), out[i]));
+
+				for (size_t i = count; i < max_test_count; ++i)
+					Assert::IsTrue(float4::zero == out[i]);
+			}
+
+			// in place
+			std::vector<float4> inout = v;
+			math::mul(m, inout.data(), inout.data(), max_test_count);
+			for (size_t i = 0; i < max_test_count; ++i)
+				Assert::IsTrue(near(math::mul(m, v[i]), inout[i]));
+		});
+	}
+
+	TEST_METHOD(mul_float4x4_float4x4)
+	{
+		std::vector<float4x4> l(max_test_count);
+		std::vector<float4x4> r(max_test_count);
+		for (size_t i = 0; i < max_test_count; ++i) {
+			for (size_t k = 0; k < 16; ++k) {
+				(&l[i].m00)[k] = test_value(16 * i + k, 6, 2.0f);
+				(&r[i].m00)[k] = test_value(16 * i + k, 7, 2.0f);
+			}
+		}
+
+		for_each_isa_level([&] {
+			for (size_t count : test_counts) {
+				std::vector<float4x4> out(max_test_count, float4x4::zero);
+				math::mul(l.data(), r.data(), out.data(), count);
+
+				for (size_t i = 0; i < count; ++i)
+					Assert::IsTrue(math::approx_equal(l[i] * r[i], out[i], 1e-4f));
+
+				for (size_t i = count; i < max_test_count; ++i)
+					Assert::IsTrue(float4x4::zero == out[i]);
+			}
+
+			// out == l, out == r
+			std::vector<float4x4> lo = l;
+			math::mul(lo.data(), r.data(), lo.data(), max_test_count);
+			std::vector<float4x4> ro = r;
+			math::mul(l.data(), ro.data(), ro.data(), max_test_count);
+
+			for (size_t i = 0; i < max_test_count; ++i) {
+				Assert::IsTrue(math::approx_equal(l[i] * r[i], lo[i], 1e-4f));
+				Assert::IsTrue(math::approx_equal(l[i] * r[i], ro[i], 1e-4f));
+			}
+		});
+	}
+
+	TEST_METHOD(mul_double4x4_double4)
+	{
+		double4x4 m;
+		for (size_t i = 0; i < 16; ++i) (&m.m00)[i] = test_value(i, 1, 2.0f);
+
+		std::vector<double4> v(max_test_count);
+		for (size_t i = 0; i < max_test_count; ++i)
+			v[i] = double4(test_value(i, 2), test_value(i, 3), test_value(i, 4), test_value(i, 5));
+
+		for_each_isa_level([&] {
+			for (size_t count : test_counts) {
+				std::vector<double4> out(max_test_count, double4::zero);
+				math::mul(m, v.data(), out.data(), count);
+
+				for (size_t i = 0; i < count; ++i)
+					Assert::IsTrue(math::approx_equal(math::mul(m, v[i]), out[i], 1e-12));
+
+				for (size_t i = count; i < max_test_count; ++i)
+					Assert::IsTrue(double4::zero == out[i]);
+			}
+
+			// in place
+			std::vector<double4> inout = v;
+			math::mul(m, inout.data(), inout.data(), max_test_count);
+			for (size_t i = 0; i < max_test_count; ++i)
+				Assert::IsTrue(math::approx_equal(math::mul(m, v[i]), inout[i], 1e-12));
+		});
+	}
+
+	TEST_METHOD(nlerp_quat)
+	{
+		const std::vector<quat> q = test_quats(max_test_count, 21);
+		const std::vector<quat> r = test_quats(max_test_count, 25);
+		std::vector<float> factor(max_test_count);
+		for (size_t i = 0; i < max_test_count; ++i) factor[i] = test_unorm_value(i, 29);
+		factor[2] = 0.0f;
+		factor[5] = 1.0f;
+
+		for_each_isa_level([&] {
+			for (size_t count : test_counts) {
+				std::vector<quat> out(max_test_count, quat(7, 7, 7, 7));
+				math::nlerp(q.data(), r.data(), factor.data(), out.data(), count);
+
+				for (size_t i = 0; i < count; ++i)
+					Assert::IsTrue(near(math::nlerp(q[i], r[i], factor[i]), out[i]));
+
+				for (size_t i = count; i < max_test_count; ++i)
+					Assert::IsTrue(quat(7, 7, 7, 7) == out[i]);
+			}
+
+			std::vector<quat> inout = q;
+			math::nlerp(inout.data(), r.data(), factor.data(), inout.data(), max_test_count);
+			for (size_t i = 0; i < max_test_count; ++i)
+				Assert::IsTrue(near(math::nlerp(q[i], r[i], factor[i]), inout[i]));
+		});
+	}
+
+	TEST_METHOD(slerp_fast_quat)
+	{
+		const std::vector<quat> q = test_quats(max_test_count, 31);
+		const std::vector<quat> r = test_quats(max_test_count, 35);
+		std::vector<float> factor(max_test_count);
+		for (size_t i = 0; i < max_test_count; ++i) factor[i] = test_unorm_value(i, 39);
+		factor[2] = 0.0f;
+		factor[5] = 1.0f;
+
+		for_each_isa_level([&] {
+			for (size_t count : test_counts) {
+				std::vector<quat> out(max_test_count, quat(7, 7, 7, 7));
+				math::slerp_fast(q.data(), r.data(), factor.data(), out.data(), count);
+
+				for (size_t i = 0; i < count; ++i) {
+					Assert::IsTrue(near(math::slerp_fast(q[i], r[i], factor[i]), out[i]));
+					Assert::IsTrue(math::approx_equal(math::slerp(q[i], r[i], factor[i]), out[i], 5e-5f));
+				}
+
+				for (size_t i = count; i < max_test_count; ++i)
+					Assert::IsTrue(quat(7, 7, 7, 7) == out[i]);
+			}
+
+			std::vector<quat> inout = r;
+			math::slerp_fast(q.data(), inout.data(), factor.data(), inout.data(), max_test_count);
+			for (size_t i = 0; i < max_test_count; ++i)
+				Assert::IsTrue(near(math::slerp_fast(q[i], r[i], factor[i]), inout[i]));
+		});
+	}
+
+	TEST_METHOD(fast_normalize)
+	{
+		std::vector<float2> v2(max_test_count);
+		std::vector<float3> v3(max_test_count);
+		std::vector<float4> v4(max_test_count);
+		for (size_t i = 0; i < max_test_count; ++i) {
+			v4[i] = float4(test_value(i, 8, 5.0f), test_value(i, 9, 5.0f), test_value(i, 10, 5.0f), test_value(i, 11, 5.0f));
+			v3[i] = float3(v4[i].x, v4[i].y, v4[i].z);
+			v2[i] = float2(v4[i].x, v4[i].y);
+		}
+		v2[2] = float2::zero;
+		v3[2] = float3::zero;
+		v4[2] = float4::zero;
+		const std::vector<quat> q = test_quats(max_test_count, 12);
+
+		for_each_isa_level([&] {
+			for (size_t count : test_counts) {
+				std::vector<float2> out2(max_test_count, float2(7.0f));
+				std::vector<float3> out3(max_test_count, float3(7.0f));
+				std::vector<float4> out4(max_test_count, float4(7.0f));
+				std::vector<quat> outq(max_test_count, quat(7, 7, 7, 7));
+				math::fast_normalize(v2.data(), out2.data(), count);
+				math::fast_normalize(v3.data(), out3.data(), count);
+				math::fast_normalize(v4.data(), out4.data(), count);
+				math::fast_normalize(q.data(), outq.data(), count);
+
+				for (size_t i = 0; i < count; ++i) {
+					Assert::IsTrue(math::approx_equal(math::normalize(v2[i]), out2[i], 1e-6f));
+					Assert::IsTrue(math::approx_equal(math::normalize(v3[i]), out3[i], 1e-6f));
+					Assert::IsTrue(math::approx_equal(math::normalize(v4[i]), out4[i], 1e-6f));
+					Assert::IsTrue(math::approx_equal(q[i], outq[i], 1e-6f));
+				}
+
+				for (size_t i = count; i < max_test_count; ++i) {
+					Assert::IsTrue(float2(7.0f) == out2[i]);
+					Assert::IsTrue(float3(7.0f) == out3[i]);
+					Assert::IsTrue(float4(7.0f) == out4[i]);
+					Assert::IsTrue(quat(7, 7, 7, 7) == outq[i]);
+				}
+			}
+
+			std::vector<float3> inout = v3;
+			math::fast_normalize(inout.data(), inout.data(), max_test_count);
+			for (size_t i = 0; i < max_test_count; ++i)
+				Assert::IsTrue(math::approx_equal(math::normalize(v3[i]), inout[i], 1e-6f));
+		});
+	}
+
+	TEST_METHOD(normalize_float3)
+	{
+		std::vector<float3> v(max_test_count);
+		for (size_t i = 0; i < max_test_count; ++i)
+			v[i] = float3(test_value(i, 8, 5.0f), test_value(i, 9, 5.0f), test_value(i, 10, 5.0f));
+		v[2] = float3::zero;
+		v[6] = float3::unit_y;
+		v[11] = float3(1e-4f, 0.0f, 0.0f);
+
+		for_each_isa_level([&] {
+			for (size_t count : test_counts) {
+				std::vector<float3> out(max_test_count, float3(7.0f));
+				math::normalize(v.data(), out.data(), count);
+
+				for (size_t i = 0; i < count; ++i)
+					Assert::IsTrue(near(math::normalize(v[i]), out[i]));
+
+				for (size_t i = count; i < max_test_count; ++i)
+					Assert::IsTrue(float3(7.0f) == out[i]);
+			}
+
+			std::vector<float3> inout = v;
+			math::normalize(inout.data(), inout.data(), max_test_count);
+			for (size_t i = 0; i < max_test_count; ++i)
+				Assert::IsTrue(near(math::normalize(v[i]), inout[i]));
+		});
+	}
+
+	TEST_METHOD(normalize_float4)
+	{
+		std::vector<float4> v(max_test_count);
+		for (size_t i = 0; i < max_test_count; ++i) {
+			v[i] = float4(test_value(i, 11, 5.0f), test_value(i, 12, 5.0f),
+				test_value(i, 13, 5.0f), test_value(i, 14, 5.0f));
+		}
+		v[1] = float4::zero;
+		v[9] = float4::unit_w;
+		v[16] = float4(0.0f, 1e-4f, 0.0f, 0.0f);
+
+		for_each_isa_level([&] {
+			for (size_t count : test_counts) {
+				std::vector<float4> out(max_test_count, float4(7.0f));
+				math::normalize(v.data(), out.data(), count);
+
+				for (size_t i = 0; i < count; ++i)
+					Assert::IsTrue(near(math::normalize(v[i]), out[i]));
+
+				for (size_t i = count; i < max_test_count; ++i)
+					Assert::IsTrue(float4(7.0f) == out[i]);
+			}
+
+			std::vector<float4> inout = v;
+			math::normalize(inout.data(), inout.data(), max_test_count);
+			for (size_t i = 0; i < max_test_count; ++i)
+				Assert::IsTrue(near(math::normalize(v[i]), inout[i]));
+		});
+	}
+
+	TEST_METHOD(to_float_relative)
+	{
+		const double3 origin(6.4e6, -1.2e7, 3.0e5);
+
+		std::vector<double3> p(max_test_count);
+		for (size_t i = 0; i < max_test_count; ++i)
+			p[i] = origin + double3(test_value(i, 30, 100.0f), test_value(i, 31, 100.0f), test_value(i, 32, 100.0f));
+
+		for_each_isa_level([&] {
+			for (size_t count : test_counts) {
+				std::vector<float3> out(max_test_count, float3(7.0f));
+				math::to_float_relative(p.data(), origin, out.data(), count);
+
+				// the difference is computed in double and rounded once, every level gets the same result.
+				for (size_t i = 0; i < count; ++i)
+					Assert::IsTrue(math::to_float_relative(p[i], origin) == out[i]);
+
+				for (size_t i = count; i < max_test_count; ++i)
+					Assert::IsTrue(float3(7.0f) == out[i]);
+			}
+		});
+	}
+
+	TEST_METHOD(pack)
+	{
+		std::vector<float2> v2(max_test_count);
+		std::vector<float3> v3(max_test_count);
+		std::vector<float4> v4(max_test_count);
+		std::vector<float4> snorm(max_test_count);
+		for (size_t i = 0; i < max_test_count; ++i) {
+			v2[i] = float2(test_unorm_value(i, 15), test_unorm_value(i, 16));
+			v3[i] = float3(test_unorm_value(i, 17), test_unorm_value(i, 18), test_unorm_value(i, 19));
+			v4[i] = float4(test_unorm_value(i, 20), test_unorm_value(i, 21),
+				test_unorm_value(i, 22), test_unorm_value(i, 23));
+			// out of [-1, 1] values test clamping.
+			snorm[i] = float4(test_value(i, 24, 1.2f), test_value(i, 25, 1.2f),
+				test_value(i, 26, 1.2f), test_value(i, 27, 1.2f));
+		}
+		// halfway cases are rounded away from zero.
+		snorm[3] = float4(0.5f / 511.0f, -0.5f / 511.0f, 1.5f / 511.0f, -0.5f);
+		v4[5] = float4(0.5f / 1023.0f, 1.5f / 1023.0f, 2.5f / 1023.0f, 0.5f);
+
+		for_each_isa_level([&] {
+			for (size_t count : test_counts) {
+				std::vector<uint32_t> out(max_test_count, 0);
+
+				math::pack_snorm_10_10_10_2(snorm.data(), out.data(), count);
+				for (size_t i = 0; i < count; ++i)
+					Assert::AreEqual(math::pack_snorm_10_10_10_2(snorm[i]), out[i]);
+
+				math::pack_unorm_10_10_10_2(v4.data(), out.data(), count);
+				for (size_t i = 0; i < count; ++i)
+					Assert::AreEqual(math::pack_unorm_10_10_10_2(v4[i]), out[i]);
+
+				math::pack_unorm_16_16(v2.data(), out.data(), count);
+				for (size_t i = 0; i < count; ++i)
+					Assert::AreEqual(math::pack_unorm_16_16(v2[i]), out[i]);
+
+				math::pack_unorm_8_8_8(v3.data(), out.data(), count);
+				for (size_t i = 0; i < count; ++i)
+					Assert::AreEqual(math::pack_unorm_8_8_8(v3[i]), out[i]);
+
+				math::pack_unorm_8_8_8_8(v4.data(), out.data(), count);
+				for (size_t i = 0; i < count; ++i)
+					Assert::AreEqual(math::pack_unorm_8_8_8_8(v4[i]), out[i]);
+
+				for (size_t i = count; i < max_test_count; ++i)
+					Assert::AreEqual(uint32_t(0), out[i]);
+			}
+		});
+	}
+
+	TEST_METHOD(unpack)
+	{
+		// all the bit patterns are valid, the extreme ones are at the beginning.
+		std::vector<uint32_t> p(max_test_count);
+		for (size_t i = 0; i < max_test_count; ++i)
+			p[i] = uint32_t(i * 2654435761u);
+		p[1] = 0xffffffff;
+		p[2] = 0x80000000;
+		// the snorm extremes: -512, 511, -512, 1.
+		p[3] = 0x6007fe00;
+
+		for_each_isa_level([&] {
+			for (size_t count : test_counts) {
+				std::vector<float2> out2(max_test_count, float2(7.0f));
+				std::vector<float3> out3(max_test_count, float3(7.0f));
+				std::vector<float4> out4(max_test_count, float4(7.0f));
+
+				math::unpack_snorm_10_10_10_2(p.data(), out4.data(), count);
+				for (size_t i = 0; i < count; ++i)
+					Assert::IsTrue(math::unpack_snorm_10_10_10_2(p[i]) == out4[i]);
+
+				math::unpack_unorm_10_10_10_2(p.data(), out4.data(), count);
+				for (size_t i = 0; i < count; ++i)
+					Assert::IsTrue(math::unpack_unorm_10_10_10_2(p[i]) == out4[i]);
+
+				math::unpack_unorm_8_8_8_8(p.data(), out4.data(), count);
+				for (size_t i = 0; i < count; ++i)
+					Assert::IsTrue(math::unpack_unorm_8_8_8_8(p[i]) == out4[i]);
+
+				math::unpack_unorm_16_16(p.data(), out2.data(), count);
+				for (size_t i = 0; i < count; ++i)
+					Assert::IsTrue(math::unpack_unorm_16_16(p[i]) == out2[i]);
+
+				math::unpack_unorm_8_8_8(p.data(), out3.data(), count);
+				for (size_t i = 0; i < count; ++i)
+					Assert::IsTrue(math::unpack_unorm_8_8_8(p[i]) == out3[i]);
+
+				for (size_t i = count; i < max_test_count; ++i) {
+					Assert::IsTrue(float2(7.0f) == out2[i]);
+					Assert::IsTrue(float3(7.0f) == out3[i]);
+					Assert::IsTrue(float4(7.0f) == out4[i]);
+				}
+			}
+		});
+
+		Assert::IsTrue(float4(-512.0f / 511.0f, 1.0f, -512.0f / 511.0f, 1.0f) == math::unpack_snorm_10_10_10_2(p[3]));
+	}
+
+	TEST_METHOD(octahedral)
+	{
+		std::vector<float3> n(max_test_count);
+		std::vector<uint32_t> p32(max_test_count);
+		std::vector<uint16_t> p16(max_test_count);
+		for (size_t i = 0; i < max_test_count; ++i) {
+			n[i] = math::normalize(float3(test_value(i, 33), test_value(i, 34), test_value(i, 35)) + float3(0.01f));
+			p32[i] = uint32_t(i * 2654435761u);
+			p16[i] = uint16_t(p32[i]);
+		}
+		// the axes and the diagonals of the octants.
+		n[0] = -float3::unit_z;
+		n[1] = float3::unit_y;
+		n[2] = math::normalize(float3(-1, 1, -1));
+		p32[3] = 0x8000'7fff;
+
+		// the encodings are the points of the square, i.e. all the float2 values in [-1, 1]^2.
+		std::vector<float2> e(max_test_count);
+		for (size_t i = 0; i < max_test_count; ++i)
+			e[i] = float2(test_value(i, 36), test_value(i, 37));
+
+		for_each_isa_level([&] {
+			for (size_t count : test_counts) {
+				std::vector<float2> out_e(max_test_count, float2(7.0f));
+				std::vector<float3> out_n(max_test_count, float3(7.0f));
+				std::vector<uint32_t> out_32(max_test_count, 7);
+				std::vector<uint16_t> out_16(max_test_count, 7);
+
+				math::encode_octahedral(n.data(), out_e.data(), count);
+				for (size_t i = 0; i < count; ++i)
+					Assert::IsTrue(math::encode_octahedral(n[i]) == out_e[i]);
+
+				math::pack_octahedral_snorm_16_16(n.data(), out_32.data(), count);
+				for (size_t i = 0; i < count; ++i)
+					Assert::AreEqual(math::pack_octahedral_snorm_16_16(n[i]), out_32[i]);
+
+				math::pack_octahedral_unorm_8_8(n.data(), out_16.data(), count);
+				for (size_t i = 0; i < count; ++i)
+					Assert::AreEqual(math::pack_octahedral_unorm_8_8(n[i]), out_16[i]);
+
+				for (size_t i = count; i < max_test_count; ++i) {
+					Assert::IsTrue(float2(7.0f) == out_e[i]);
+					Assert::AreEqual(uint32_t(7), out_32[i]);
+					Assert::AreEqual(uint16_t(7), out_16[i]);
+				}
+
+				math::decode_octahedral(e.data(), out_n.data(), count);
+				for (size_t i = 0; i < count; ++i)
+					Assert::IsTrue(near(math::decode_octahedral(e[i]), out_n[i]));
+
+				math::unpack_octahedral_snorm_16_16(p32.data(), out_n.data(), count);
+				for (size_t i = 0; i < count; ++i)
+					Assert::IsTrue(near(math::unpack_octahedral_snorm_16_16(p32[i]), out_n[i]));
+
+				math::unpack_octahedral_unorm_8_8(p16.data(), out_n.data(), count);
+				for (size_t i = 0; i < count; ++i)
+					Assert::IsTrue(near(math::unpack_octahedral_unorm_8_8(p16[i]), out_n[i]));
+
+				for (size_t i = count; i < max_test_count; ++i)
+					Assert::IsTrue(float3(7.0f) == out_n[i]);
+			}
+		});
+	}
+
+	TEST_METHOD(smallest_three)
+	{
+		const std::vector<quat> q = test_quats(max_test_count, 38);
+		std::vector<quat> special = q;
+		special[0] = quat::identity;
+		special[1] = quat(-0.5f, 0.5f, -0.5f, 0.5f);
+		special[2] = quat(0.0f, -1.0f, 0.0f, 0.0f);
+
+		for_each_isa_level([&] {
+			for (uint32_t bits : { 2u, 10u, 15u, 20u }) {
+				std::vector<uint64_t> p64(max_test_count);
+				for (size_t i = 0; i < max_test_count; ++i)
+					p64[i] = math::pack_smallest_three(q[i], bits);
+
+				for (size_t count : test_counts) {
+					std::vector<uint64_t> out_64(max_test_count, 7);
+					math::pack_smallest_three(special.data(), bits, out_64.data(), count);
+					for (size_t i = 0; i < count; ++i)
+						Assert::AreEqual(math::pack_smallest_three(special[i], bits), out_64[i]);
+					for (size_t i = count; i < max_test_count; ++i)
+						Assert::AreEqual(uint64_t(7), out_64[i]);
+
+					std::vector<quat> out_q(max_test_count, quat(7, 7, 7, 7));
+					math::unpack_smallest_three(p64.data(), bits, out_q.data(), count);
+					for (size_t i = 0; i < count; ++i)
+						Assert::IsTrue(near(math::unpack_smallest_three(p64[i], bits), out_q[i]));
+					for (size_t i = count; i < max_test_count; ++i)
+						Assert::IsTrue(quat(7, 7, 7, 7) == out_q[i]);
+
+					if (bits > 10) continue;
+
+					std::vector<uint32_t> out_32(max_test_count, 7);
+					math::pack_smallest_three(special.data(), bits, out_32.data(), count);
+					for (size_t i = 0; i < count; ++i)
+						Assert::AreEqual(uint32_t(math::pack_smallest_three(special[i], bits)), out_32[i]);
+					for (size_t i = count; i < max_test_count; ++i)
+						Assert::AreEqual(uint32_t(7), out_32[i]);
+
+					const std::vector<uint32_t> p32(p64.begin(), p64.end());
+					math::unpack_smallest_three(p32.data(), bits, out_q.data(), count);
+					for (size_t i = 0; i < count; ++i)
+						Assert::IsTrue(near(math::unpack_smallest_three(p64[i], bits), out_q[i]));
+				}
+			}
+		});
+	}
+
+	TEST_METHOD(pack_half)
+	{
+		using math::half;
+		using math::half4;
+
+		// normal, subnormal, halfway, overflowing and special values, 4 float4s.
+		const float special[] = { 0.0f, -0.0f, 1.00048828125f, 1.00146484375f, 65519.0f, 65520.0f, -1e10f,
+			8.94069671630859375e-8f, 2.98023223876953125e-8f, -3.0e-6f, 1e-30f,
+			std::numeric_limits<float>::infinity(), std::numeric_limits<float>::quiet_NaN(),
+			std::numeric_limits<float>::signaling_NaN(), -65504.0f, 6.103515625e-5f };
+
+		std::vector<float4> v(max_test_count);
+		for (size_t i = 0; i < max_test_count; ++i) {
+			v[i] = float4(test_value(i, 28, 70000.0f), test_value(i, 29), test_value(i, 30, 1e-4f), test_value(i, 31, 100.0f));
+		}
+		for (size_t k = 0; k < 4; ++k)
+			v[3 + k] = float4(special[4 * k], special[4 * k + 1], special[4 * k + 2], special[4 * k + 3]);
+
+		// all the half values including NaNs.
+		std::vector<half4> h(max_test_count);
+		for (size_t i = 0; i < max_test_count; ++i) {
+			const uint32_t b = uint32_t(i * 4 * 1777);
+			h[i] = half4(half(uint16_t(b)), half(uint16_t(b + 1777)), half(uint16_t(b + 2 * 1777)), half(uint16_t(b + 3 * 1777)));
+		}
+		h[2] = half4(half(0x7c00), half(0x7c01), half(0xfe01), half(0x0001));
+
+		const auto same_bits = [](float l, float r) { return std::memcmp(&l, &r, sizeof(l)) == 0; };
+
+		for_each_isa_level([&] {
+			for (size_t count : test_counts) {
+				// float4 arrays check 4 * count values.
+				std::vector<half4> out_h(max_test_count, half4(half(7), half(7), half(7), half(7)));
+				math::pack_half(v.data(), out_h.data(), count);
+				for (size_t i = 0; i < count; ++i)
+					Assert::IsTrue(math::pack_half(v[i]) == out_h[i]);
+				for (size_t i = count; i < max_test_count; ++i)
+					Assert::IsTrue(half4(half(7), half(7), half(7), half(7)) == out_h[i]);
+
+				std::vector<float4> out_f(max_test_count, float4(7.0f));
+				math::unpack_half(h.data(), out_f.data(), count);
+				for (size_t i = 0; i < count; ++i) {
+					const float4 e = math::unpack_half(h[i]);
+					Assert::IsTrue(same_bits(e.x, out_f[i].x) && same_bits(e.y, out_f[i].y)
+						&& same_bits(e.z, out_f[i].z) && same_bits(e.w, out_f[i].w));
+				}
+				for (size_t i = count; i < max_test_count; ++i)
+					Assert::IsTrue(float4(7.0f) == out_f[i]);
+
+				// the single values.
+				std::vector<half> out_1(max_test_count, half(7));
+				math::pack_half(&v[0].x, out_1.data(), count);
+				for (size_t i = 0; i < count; ++i)
+					Assert::IsTrue(math::pack_half((&v[0].x)[i]) == out_1[i]);
+				for (size_t i = count; i < max_test_count; ++i)
+					Assert::IsTrue(half(7) == out_1[i]);
+			}
+
+			// float2 and float3 arrays round trip, 2^-10 is the relative error of the half precision.
+			std::vector<float2> v2(max_test_count);
+			std::vector<float3> v3(max_test_count);
+			for (size_t i = 0; i < max_test_count; ++i) {
+				v2[i] = float2(test_value(i, 29), test_value(i, 31, 100.0f));
+				v3[i] = float3(test_value(i, 29), test_value(i, 31, 100.0f), test_value(i, 32, 1000.0f));
+			}
+			v2[3] = float2(1, -2);
+			v3[3] = float3(1, -2, 3);
+
+			std::vector<math::half2> h2(max_test_count);
+			std::vector<math::half3> h3(max_test_count);
+			std::vector<float2> r2(max_test_count);
+			std::vector<float3> r3(max_test_count);
+			math::pack_half(v2.data(), h2.data(), max_test_count);
+			math::pack_half(v3.data(), h3.data(), max_test_count);
+			math::unpack_half(h2.data(), r2.data(), max_test_count);
+			math::unpack_half(h3.data(), r3.data(), max_test_count);
+			for (size_t i = 0; i < max_test_count; ++i) {
+				Assert::IsTrue(math::pack_half(v2[i]) == h2[i]);
+				Assert::IsTrue(math::pack_half(v3[i]) == h3[i]);
+				Assert::IsTrue(math::approx_equal(v2[i], r2[i], 1e-3f * math::len(v2[i])));
+				Assert::IsTrue(math::approx_equal(v3[i], r3[i], 1e-3f * math::len(v3[i])));
+			}
+			Assert::IsTrue(float2(1, -2) == r2[3]);
+			Assert::IsTrue(float3(1, -2, 3) == r3[3]);
+		});
+	}
+};
+
+} // namespace unittest
@@ -0,0 +1,47 @@
+#include "math/dual_quat.h"
+
+#include "kernels.h"
+
+
+namespace math {
+
+const dual_quat dual_quat::identity(quat(0, 0, 0, 1), quat(0, 0, 0, 0));
+const dual_quat dual_quat::zero(quat(0, 0, 0, 0), quat(0, 0, 0, 0));
+
+
+std::ostream& operator<<(std::ostream& o, const dual_quat& dq)
+{
+	o << "dual_quat(" << dq.real << ", " << dq.dual << ")";
+	return o;
+}
+
+std::wostream& operator<<(std::wostream& o, const dual_quat& dq)
+{
+	o << "dual_quat(" << dq.real << ", " << dq.dual << ")";
+	return o;
+}
+
+dual_quat blend(const dual_quat* dq, const float* weights, size_t count) noexcept
+{
+	assert(count > 0 && dq && weights);
+
+	const quat& r0 = dq[0].real;
+	dual_quat res = weights[0] * dq[0];
+	for (size_t i = 1; i < count; ++i) {
+		const quat& r = dq[i].real;
+		const float d = (r0.x * r.x) + (r0.y * r.y) + (r0.z * r.z) + (r0.a * r.a);
+		res += ((d < 0.0f) ? -weights[i] : weights[i]) * dq[i];
+	}
+
+	return normalize(res);
+}
+
+void skin(const dual_quat* palette, const float3* positions, const float3* normals,
+	const ubyte4* joints, const uint32_t* weights, float3* out_positions, float3* out_normals, size_t count) noexcept
+{
+	assert(count == 0 || (palette && positions && joints && weights && out_positions));
+	assert((normals == nullptr) == (out_normals == nullptr));
+	active_kernels().skin_dual_quat(palette, positions, normals, joints, weights, out_positions, out_normals, count);
+}
+
+} // namespace math
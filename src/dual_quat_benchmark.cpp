@@ -0,0 +1,87 @@
+#include "math/dual_quat.h"
+
+#include <random>
+#include <vector>
+#include "math/vector_utility.h"
+#include "benchmark.h"
+
+using math::dual_quat;
+using math::float3;
+using math::float4;
+using math::float4x4;
+using math::quat;
+using math::ubyte4;
+
+
+namespace benchmark {
+
+// Dual quaternions are unit ones.
+template<>
+inline std::vector<dual_quat> inputs<dual_quat>(size_t count, float lo, float hi, uint32_t seed)
+{
+	const std::vector<float3> p = random_values<float3>(count, lo, hi, seed);
+	const std::vector<quat> q = random_unit_quat(count, seed + 1);
+	std::vector<dual_quat> v(count);
+	for (size_t i = 0; i < count; ++i)
+		v[i] = math::tr_dual_quat(p[i], q[i]);
+
+	return v;
+}
+
+} // namespace benchmark
+
+
+namespace {
+
+// The skinning inputs: a palette of joint_count joints and state.size() vertices
+// bound to 4 random joints with random weights.
+struct skin_inputs final {
+	static constexpr size_t joint_count = 64;
+
+	explicit skin_inputs(size_t count)
+		: palette(benchmark::inputs<dual_quat>(joint_count, -1.0f, 1.0f, 1)),
+		positions(benchmark::random_values<float3>(count, -1.0f, 1.0f, 3)),
+		normals(benchmark::random_unit_float3(count, 4)),
+		joints(count),
+		weights(count)
+	{
+		std::mt19937 gen(5);
+		std::uniform_int_distribution<int> joint(0, joint_count - 1);
+		const std::vector<float4> w = benchmark::random_values<float4>(count, 0.0f, 1.0f, 6);
+		for (size_t i = 0; i < count; ++i) {
+			joints[i] = ubyte4(uint8_t(joint(gen)), uint8_t(joint(gen)), uint8_t(joint(gen)), uint8_t(joint(gen)));
+			weights[i] = math::pack_unorm_8_8_8_8(w[i] / (w[i].x + w[i].y + w[i].z + w[i].w));
+		}
+	}
+
+	std::vector<dual_quat> palette;
+	std::vector<float3> positions;
+	std::vector<float3> normals;
+	std::vector<ubyte4> joints;
+	std::vector<uint32_t> weights;
+};
+
+
+BENCHMARK_MAP2(mul_dual_quat, dual_quat, dual_quat, dual_quat, -10.0f, 10.0f, a * b);
+BENCHMARK_MAP(normalize_dual_quat, dual_quat, dual_quat, -10.0f, 10.0f, math::normalize(2.0f * a));
+BENCHMARK_MAP2(tr_dual_quat, dual_quat, float3, quat, -10.0f, 10.0f, math::tr_dual_quat(a, b));
+BENCHMARK_MAP(tr_matrix_dual_quat, float4x4, dual_quat, -10.0f, 10.0f, math::tr_matrix(a));
+BENCHMARK_MAP2(transform_point_dual_quat, float3, dual_quat, float3, -10.0f, 10.0f, math::transform_point(a, b));
+
+// ----- batch functions -----
+
+void skin_dual_quat_batch(benchmark::state& state)
+{
+	const skin_inputs in(state.size());
+	std::vector<float3> out_p(state.size());
+	std::vector<float3> out_n(state.size());
+
+	while (state.keep_running()) {
+		math::skin(in.palette.data(), in.positions.data(), in.normals.data(), in.joints.data(), in.weights.data(),
+			out_p.data(), out_n.data(), state.size());
+		benchmark::clobber_memory();
+	}
+}
+BENCHMARK(skin_dual_quat_batch);
+
+} // namespace
@@ -0,0 +1,254 @@
+#include "math/dual_quat.h"
+
+#include <cstdint>
+#include <vector>
+#include "math/vector_utility.h"
+#include "CppUnitTest.h"
+#include "test_utility.h"
+
+
+using math::dual_quat;
+using math::float3;
+using math::float4;
+using math::float4x4;
+using math::quat;
+using math::ubyte4;
+using unittest::test_value;
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+
+namespace Microsoft { namespace VisualStudio { namespace CppUnitTestFramework {
+
+template<> inline std::wstring ToString<math::dual_quat>(const math::dual_quat& t) { RETURN_WIDE_STRING(t); }
+template<> inline std::wstring ToString<math::float3>(const math::float3& t) { RETURN_WIDE_STRING(t); }
+template<> inline std::wstring ToString<math::quat>(const math::quat& t) { RETURN_WIDE_STRING(t); }
+
+}}} // namespace Microsoft::VisualStudio::CppUnitTestFramework
+
+
+namespace {
+
+quat test_quat(size_t i, size_t seed) noexcept
+{
+	return math::normalize(quat(test_value(i, seed) + 0.1f, test_value(i, seed + 1),
+		test_value(i, seed + 2), test_value(i, seed + 3)));
+}
+
+bool near(const float3& l, const float3& r) noexcept
+{
+	return math::approx_equal(l, r, 1e-4f);
+}
+
+} // namespace
+
+
+namespace unittest {
+
+TEST_CLASS(math_dual_quat) {
+public:
+
+	TEST_METHOD(blend)
+	{
+		using math::approx_equal;
+		using math::tr_dual_quat;
+
+		const quat q = test_quat(0, 1);
+		const dual_quat a = tr_dual_quat(float3(1, 2, 3), q);
+		const dual_quat b = tr_dual_quat(float3(3, 4, 5), q);
+
+		const float w1[] = { 1.0f };
+		Assert::IsTrue(approx_equal(a, math::blend(&a, w1, 1)));
+
+		// the same rotation, the translations are interpolated.
+		const dual_quat ab[] = { a, b };
+		const float w2[] = { 0.5f, 0.5f };
+		const dual_quat m = math::blend(ab, w2, 2);
+		Assert::IsTrue(approx_equal(q, math::rotation(m)));
+		Assert::IsTrue(approx_equal(float3(2, 3, 4), math::translation(m), 1e-5f));
+
+		// -b is the same transformation as b.
+		const dual_quat a_neg_b[] = { a, -1.0f * b };
+		Assert::IsTrue(approx_equal(m, math::blend(a_neg_b, w2, 2)));
+
+		// the weights do not need to be normalized.
+		const float w3[] = { 2.0f, 2.0f };
+		Assert::IsTrue(approx_equal(m, math::blend(ab, w3, 2)));
+	}
+
+	TEST_METHOD(conjugate)
+	{
+		using math::approx_equal;
+
+		const dual_quat dq = math::tr_dual_quat(float3(1, -2, 3), test_quat(3, 1));
+		Assert::IsTrue(approx_equal(dual_quat::identity, dq * math::conjugate(dq)));
+		Assert::IsTrue(approx_equal(dual_quat::identity, math::conjugate(dq) * dq));
+
+		const float3 p(4, 5, -6);
+		Assert::IsTrue(near(p, math::transform_point(math::conjugate(dq), math::transform_point(dq, p))));
+	}
+
+	TEST_METHOD(ctors)
+	{
+		const dual_quat dq(quat(1, 2, 3, 4), quat(5, 6, 7, 8));
+		Assert::AreEqual(quat(1, 2, 3, 4), dq.real);
+		Assert::AreEqual(quat(5, 6, 7, 8), dq.dual);
+	}
+
+	TEST_METHOD(equal_operator)
+	{
+		const dual_quat dq(quat(1, 2, 3, 4), quat(5, 6, 7, 8));
+		Assert::AreEqual(dq, dual_quat(quat(1, 2, 3, 4), quat(5, 6, 7, 8)));
+		Assert::AreNotEqual(dq, dual_quat(quat(1, 2, 3, 4), quat(5, 6, 7, 9)));
+		Assert::AreNotEqual(dq, dual_quat(quat(0, 2, 3, 4), quat(5, 6, 7, 8)));
+	}
+
+	TEST_METHOD(mul)
+	{
+		using math::approx_equal;
+		using math::tr_dual_quat;
+		using math::tr_matrix;
+
+		const dual_quat a = tr_dual_quat(float3(1, 2, 3), test_quat(1, 1));
+		const dual_quat b = tr_dual_quat(float3(-4, 5, 0.5f), test_quat(2, 1));
+
+		// the concatenation agrees with the matrices.
+		Assert::IsTrue(approx_equal(tr_matrix(a) * tr_matrix(b), tr_matrix(a * b), 1e-4f));
+
+		dual_quat c = a;
+		c *= b;
+		Assert::IsTrue(approx_equal(a * b, c));
+
+		Assert::IsTrue(approx_equal(a, a * dual_quat::identity));
+		Assert::IsTrue(approx_equal(a, dual_quat::identity * a));
+
+		Assert::AreEqual(dual_quat(quat(2, 4, 6, 8), quat(10, 12, 14, 16)),
+			dual_quat(quat(1, 2, 3, 4), quat(5, 6, 7, 8)) * 2.0f);
+		Assert::AreEqual(dual_quat(quat(2, 4, 6, 8), quat(10, 12, 14, 16)),
+			2.0f * dual_quat(quat(1, 2, 3, 4), quat(5, 6, 7, 8)));
+	}
+
+	TEST_METHOD(normalize)
+	{
+		using math::approx_equal;
+
+		const dual_quat dq = math::tr_dual_quat(float3(1, 2, 3), test_quat(4, 1));
+		const dual_quat n = math::normalize(3.0f * dq);
+		Assert::IsTrue(math::is_normalized(n));
+		Assert::IsTrue(approx_equal(dq, n));
+		Assert::IsFalse(math::is_normalized(3.0f * dq));
+	}
+
+	TEST_METHOD(static_members)
+	{
+		Assert::AreEqual(dual_quat(quat(0, 0, 0, 1), quat(0, 0, 0, 0)), dual_quat::identity);
+		Assert::AreEqual(dual_quat(quat(0, 0, 0, 0), quat(0, 0, 0, 0)), dual_quat::zero);
+	}
+
+	TEST_METHOD(tr_dual_quat)
+	{
+		using math::approx_equal;
+		using math::tr_dual_quat;
+		using math::tr_matrix;
+
+		const float3 p(1, -2, 3);
+		const quat q = test_quat(5, 1);
+		const dual_quat dq = tr_dual_quat(p, q);
+		Assert::IsTrue(math::is_normalized(dq));
+		Assert::IsTrue(approx_equal(q, math::rotation(dq)));
+		Assert::IsTrue(approx_equal(p, math::translation(dq), 1e-5f));
+
+		// float4x4 conversions
+		const float4x4 m = tr_matrix(p, q);
+		Assert::IsTrue(approx_equal(m, tr_matrix(dq), 1e-5f));
+
+		const dual_quat dm = tr_dual_quat(m);
+		// q and -q are the same rotation.
+		Assert::IsTrue(approx_equal(dq, dm, 1e-4f) || approx_equal(dq, -1.0f * dm, 1e-4f));
+		Assert::IsTrue(approx_equal(m, tr_matrix(dm), 1e-4f));
+
+		Assert::AreEqual(dual_quat::identity, tr_dual_quat(float3::zero, quat::identity));
+	}
+
+	TEST_METHOD(transform_point)
+	{
+		const float3 p(1, -2, 3);
+		const quat q = test_quat(6, 1);
+		const dual_quat dq = math::tr_dual_quat(p, q);
+		const float4x4 m = math::tr_matrix(p, q);
+
+		for (size_t i = 0; i < 10; ++i) {
+			const float3 v = test_float3(i, 2, 5.0f);
+			const float4 mp = math::mul(m, v);
+			const float4 md = math::mul(m, v, 0.0f);
+			Assert::IsTrue(near(float3(mp.x, mp.y, mp.z), math::transform_point(dq, v)));
+			Assert::IsTrue(near(float3(md.x, md.y, md.z), math::transform_direction(dq, v)));
+			Assert::IsTrue(near(math::rotate(q, v), math::transform_direction(dq, v)));
+		}
+	}
+
+	TEST_METHOD(skin)
+	{
+		std::vector<dual_quat> palette(11);
+		for (size_t i = 0; i < palette.size(); ++i)
+			palette[i] = math::tr_dual_quat(test_float3(i, 1, 3.0f), test_quat(i, 4));
+
+		std::vector<float3> positions(max_test_count);
+		std::vector<float3> normals(max_test_count);
+		std::vector<ubyte4> joints(max_test_count);
+		std::vector<uint32_t> weights(max_test_count);
+		for (size_t i = 0; i < max_test_count; ++i) {
+			positions[i] = test_float3(i, 8, 10.0f);
+			normals[i] = math::normalize(test_float3(i, 11, 1.0f) + float3(0.1f));
+			joints[i] = ubyte4(uint8_t(i % 11), uint8_t((i * 3) % 11), uint8_t((i * 7 + 1) % 11), uint8_t((i + 5) % 11));
+
+			// the weights sum to 1 (255), a few vertices are bound to a single joint.
+			const uint32_t w0 = 255 - (i * 37) % 200;
+			const uint32_t w1 = (i % 4 == 0) ? 0 : (255 - w0) / 2;
+			const uint32_t w2 = (255 - w0 - w1) / 3;
+			weights[i] = (w0 << 24) | (w1 << 16) | (w2 << 8) | (255 - w0 - w1 - w2);
+		}
+
+		// the reference: blended dual quaternion of every vertex.
+		std::vector<float3> expected_p(max_test_count);
+		std::vector<float3> expected_n(max_test_count);
+		for (size_t i = 0; i < max_test_count; ++i) {
+			const ubyte4& j = joints[i];
+			const dual_quat dq[] = { palette[j.x], palette[j.y], palette[j.z], palette[j.w] };
+			const float4 w = math::unpack_unorm_8_8_8_8(weights[i]);
+			const dual_quat b = math::blend(dq, &w.x, 4);
+			expected_p[i] = math::transform_point(b, positions[i]);
+			expected_n[i] = math::transform_direction(b, normals[i]);
+		}
+
+		// a single joint moves a vertex as its dual quaternion does.
+		Assert::IsTrue(near(math::transform_point(palette[joints[0].x], positions[0]), expected_p[0]));
+
+		for_each_isa_level([&] {
+			for (size_t count : test_counts) {
+				std::vector<float3> out_p(max_test_count, float3(7.0f));
+				std::vector<float3> out_n(max_test_count, float3(7.0f));
+				math::skin(palette.data(), positions.data(), normals.data(), joints.data(), weights.data(),
+					out_p.data(), out_n.data(), count);
+
+				for (size_t i = 0; i < count; ++i) {
+					Assert::IsTrue(near(expected_p[i], out_p[i]));
+					Assert::IsTrue(near(expected_n[i], out_n[i]));
+				}
+
+				for (size_t i = count; i < max_test_count; ++i) {
+					Assert::AreEqual(float3(7.0f), out_p[i]);
+					Assert::AreEqual(float3(7.0f), out_n[i]);
+				}
+			}
+
+			// positions only, in place.
+			std::vector<float3> inout = positions;
+			math::skin(palette.data(), inout.data(), nullptr, joints.data(), weights.data(),
+				inout.data(), nullptr, max_test_count);
+			for (size_t i = 0; i < max_test_count; ++i)
+				Assert::IsTrue(near(expected_p[i], inout[i]));
+		});
+	}
+};
+
+} // namespace unittest
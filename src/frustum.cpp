@@ -0,0 +1,81 @@
+#include "math/frustum.h"
+
+#include "kernels.h"
+
+
+namespace {
+
+using math::float4;
+using math::float4x4;
+using math::frustum;
+using math::plane;
+
+// Extracts the planes as described in Gribb & Hartmann, "Fast Extraction of Viewing Frustum Planes
+// from the World-View-Projection Matrix". The point p is inside if its clip space coordinates
+// mul(m, float4(p, 1)) satisfy -w <= x, y <= w and 0 <= z <= w (zero_to_one) or -w <= z <= w.
+frustum extract_frustum(const float4x4& m, bool zero_to_one) noexcept
+{
+	const float4 r0(m.m00, m.m01, m.m02, m.m03);
+	const float4 r1(m.m10, m.m11, m.m12, m.m13);
+	const float4 r2(m.m20, m.m21, m.m22, m.m23);
+	const float4 r3(m.m30, m.m31, m.m32, m.m33);
+
+	frustum f;
+	f.planes[frustum::left] = normalize(plane(r3 + r0));
+	f.planes[frustum::right] = normalize(plane(r3 - r0));
+	f.planes[frustum::bottom] = normalize(plane(r3 + r1));
+	f.planes[frustum::top] = normalize(plane(r3 - r1));
+	f.planes[frustum::near_plane] = normalize(plane(zero_to_one ? r2 : r3 + r2));
+	f.planes[frustum::far_plane] = normalize(plane(r3 - r2));
+	return f;
+}
+
+} // namespace
+
+
+namespace math {
+
+constexpr size_t frustum::left;
+constexpr size_t frustum::right;
+constexpr size_t frustum::bottom;
+constexpr size_t frustum::top;
+constexpr size_t frustum::near_plane;
+constexpr size_t frustum::far_plane;
+
+
+std::ostream& operator<<(std::ostream& o, const plane& p)
+{
+	o << "plane(" << p.normal << ", " << p.distance << ")";
+	return o;
+}
+
+std::wostream& operator<<(std::wostream& o, const plane& p)
+{
+	o << "plane(" << p.normal << ", " << p.distance << ")";
+	return o;
+}
+
+frustum frustum_directx(const float4x4& view_projection) noexcept
+{
+	return extract_frustum(view_projection, true);
+}
+
+frustum frustum_opengl(const float4x4& view_projection) noexcept
+{
+	return extract_frustum(view_projection, false);
+}
+
+void intersects(const frustum& f, const float4_soa& spheres, uint32_t* visible) noexcept
+{
+	assert(spheres.size() == 0 || visible);
+	active_kernels().intersects_spheres_soa(f, spheres.components(), visible, spheres.size());
+}
+
+void intersects(const frustum& f, const float3_soa& min, const float3_soa& max, uint32_t* visible) noexcept
+{
+	assert(min.size() == max.size());
+	assert(min.size() == 0 || visible);
+	active_kernels().intersects_aabbs_soa(f, min.components(), max.components(), visible, min.size());
+}
+
+} // namespace math
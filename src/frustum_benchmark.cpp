@@ -0,0 +1,65 @@
+#include "math/frustum.h"
+
+#include <vector>
+#include "math/transform.h"
+#include "benchmark.h"
+
+using math::float3;
+using math::float3_soa;
+using math::float4;
+using math::float4_soa;
+using math::frustum;
+
+
+namespace {
+
+// The frustum sees roughly a half of the [-10, 10] cube the test objects are placed in.
+frustum bench_frustum() noexcept
+{
+	const math::float4x4 proj = math::perspective_matrix_directx(math::pi / 2.0f, 1.0f, 0.1f, 20.0f);
+	return math::frustum_directx(proj * math::view_matrix(float3(0, 0, 10), float3::zero));
+}
+
+
+const frustum bench_f = bench_frustum();
+
+// uint8_t avoids std::vector<bool>.
+BENCHMARK_MAP2(intersects_aabb, uint8_t, float3, float3, -10.0f, 10.0f,
+	math::intersects(bench_f, a - 0.1f * math::abs(b), a + 0.1f * math::abs(b)));
+BENCHMARK_MAP(intersects_sphere, uint8_t, float4, -10.0f, 10.0f,
+	math::intersects(bench_f, float3(a.x, a.y, a.z), 0.05f * (a.w + 10.0f)));
+
+void intersects_aabb_batch(benchmark::state& state)
+{
+	const std::vector<float3> c = benchmark::random_values<float3>(state.size(), -10.0f, 10.0f, 1);
+	const std::vector<float3> e = benchmark::random_values<float3>(state.size(), 0.0f, 1.0f, 2);
+	float3_soa lo(state.size());
+	float3_soa hi(state.size());
+	for (size_t i = 0; i < state.size(); ++i) {
+		lo.set(i, c[i] - e[i]);
+		hi.set(i, c[i] + e[i]);
+	}
+
+	std::vector<uint32_t> visible((state.size() + 31) / 32);
+	while (state.keep_running()) {
+		math::intersects(bench_f, lo, hi, visible.data());
+		benchmark::clobber_memory();
+	}
+}
+BENCHMARK(intersects_aabb_batch);
+
+void intersects_sphere_batch(benchmark::state& state)
+{
+	std::vector<float4> v = benchmark::random_values<float4>(state.size(), -10.0f, 10.0f, 1);
+	for (float4& s : v) s.w = 0.05f * (s.w + 10.0f);
+	const float4_soa spheres(v.data(), v.size());
+
+	std::vector<uint32_t> visible((state.size() + 31) / 32);
+	while (state.keep_running()) {
+		math::intersects(bench_f, spheres, visible.data());
+		benchmark::clobber_memory();
+	}
+}
+BENCHMARK(intersects_sphere_batch);
+
+} // namespace
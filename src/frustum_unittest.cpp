@@ -0,0 +1,234 @@
+#include "math/frustum.h"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include "math/transform.h"
+#include "CppUnitTest.h"
+#include "test_utility.h"
+
+
+using math::float3;
+using math::float3_soa;
+using math::float4;
+using math::float4_soa;
+using math::float4x4;
+using math::frustum;
+using math::plane;
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+
+namespace Microsoft { namespace VisualStudio { namespace CppUnitTestFramework {
+
+template<> inline std::wstring ToString<math::plane>(const math::plane& t) { RETURN_WIDE_STRING(t); }
+
+}}} // namespace Microsoft::VisualStudio::CppUnitTestFramework
+
+
+namespace {
+
+// The sizes cover the empty stream, a stream shorter than a SIMD register,
+// streams with tails and streams longer than a single visibility value.
+constexpr size_t test_sizes[] = { 0, 1, 5, 16, 17, 32, 43, 100 };
+
+// Returns the frustum of the camera at (1, 2, 3) looking along -z.
+frustum test_frustum() noexcept
+{
+	const float4x4 proj = math::perspective_matrix_directx(math::pi / 3.0f, 1.5f, 1.0f, 50.0f);
+	const float4x4 view = math::view_matrix(float3(1, 2, 3), float3(1, 2, 0));
+	return math::frustum_directx(proj * view);
+}
+
+bool is_set(const std::vector<uint32_t>& visible, size_t i) noexcept
+{
+	return (visible[i / 32] & (uint32_t(1) << (i % 32))) != 0;
+}
+
+} // namespace
+
+
+namespace unittest {
+
+TEST_CLASS(math_frustum) {
+public:
+
+	TEST_METHOD(intersects_aabb)
+	{
+		const frustum f = test_frustum();
+
+		// inside, straddling a plane and completely outside.
+		Assert::IsTrue(math::intersects(f, float3(0, 1, -10), float3(2, 3, -8)));
+		Assert::IsTrue(math::intersects(f, float3(0, 1, 1), float3(2, 3, 3)));
+		Assert::IsTrue(math::intersects(f, float3(-100, -100, -100), float3(100, 100, 100)));
+		Assert::IsFalse(math::intersects(f, float3(0, 1, 2.5f), float3(2, 3, 2.9f)));
+		Assert::IsFalse(math::intersects(f, float3(0, 1, -100), float3(2, 3, -60)));
+		Assert::IsFalse(math::intersects(f, float3(50, 1, -10), float3(52, 3, -8)));
+		Assert::IsFalse(math::intersects(f, float3(0, -50, -10), float3(2, -48, -8)));
+	}
+
+	TEST_METHOD(intersects_sphere)
+	{
+		const frustum f = test_frustum();
+
+		Assert::IsTrue(math::intersects(f, float3(1, 2, -10), 1.0f));
+		Assert::IsTrue(math::intersects(f, float3(1, 2, 2.5f), 1.0f));
+		Assert::IsTrue(math::intersects(f, float3(1, 2, -47), 5.0f));
+		Assert::IsFalse(math::intersects(f, float3(1, 2, 2.5f), 0.25f));
+		Assert::IsFalse(math::intersects(f, float3(1, 2, -60), 5.0f));
+		Assert::IsFalse(math::intersects(f, float3(30, 2, -10), 1.0f));
+	}
+
+	TEST_METHOD(intersects_aabb_batch)
+	{
+		const frustum f = test_frustum();
+
+		for_each_isa_level([&] {
+			for (size_t size : test_sizes) {
+				float3_soa lo(size);
+				float3_soa hi(size);
+				for (size_t i = 0; i < size; ++i) {
+					const float3 c(1.0f + test_value(i, 1, 30.0f), 2.0f + test_value(i, 2, 30.0f), test_value(i, 3, 60.0f));
+					const float3 e(0.1f + std::abs(test_value(i, 4, 5.0f)));
+					lo.set(i, c - e);
+					hi.set(i, c + e);
+				}
+
+				std::vector<uint32_t> visible((size + 31) / 32 + 1, 0xffffffff);
+				math::intersects(f, lo, hi, visible.data());
+
+				for (size_t i = 0; i < size; ++i)
+					Assert::AreEqual(math::intersects(f, lo.get(i), hi.get(i)), is_set(visible, i));
+
+				// the rest of the bits are cleared, the values after them are untouched.
+				for (size_t i = size; i < 32 * ((size + 31) / 32); ++i)
+					Assert::IsFalse(is_set(visible, i));
+
+				Assert::AreEqual(uint32_t(0xffffffff), visible.back());
+			}
+		});
+	}
+
+	TEST_METHOD(intersects_sphere_batch)
+	{
+		const frustum f = test_frustum();
+
+		for_each_isa_level([&] {
+			for (size_t size : test_sizes) {
+				float4_soa spheres(size);
+				for (size_t i = 0; i < size; ++i) {
+					spheres.set(i, float4(1.0f + test_value(i, 1, 30.0f), 2.0f + test_value(i, 2, 30.0f),
+						test_value(i, 3, 60.0f), std::abs(test_value(i, 4, 5.0f))));
+				}
+
+				std::vector<uint32_t> visible((size + 31) / 32 + 1, 0xffffffff);
+				math::intersects(f, spheres, visible.data());
+
+				size_t visible_count = 0;
+				for (size_t i = 0; i < size; ++i) {
+					const float4 s = spheres.get(i);
+					Assert::AreEqual(math::intersects(f, float3(s.x, s.y, s.z), s.w), is_set(visible, i));
+					if (is_set(visible, i)) ++visible_count;
+				}
+
+				for (size_t i = size; i < 32 * ((size + 31) / 32); ++i)
+					Assert::IsFalse(is_set(visible, i));
+
+				Assert::AreEqual(uint32_t(0xffffffff), visible.back());
+				// the test data exercises both outcomes.
+				if (size >= 32) Assert::IsTrue(0 < visible_count && visible_count < size);
+			}
+		});
+	}
+
+	TEST_METHOD(frustum_directx)
+	{
+		// the planes of an orthographic projection are the faces of its box.
+		const frustum f = math::frustum_directx(math::orthographic_matrix_directx(4.0f, 2.0f, 1.0f, 10.0f));
+		Assert::IsTrue(math::approx_equal(plane(float3::unit_x, 2.0f), f.planes[frustum::left]));
+		Assert::IsTrue(math::approx_equal(plane(-float3::unit_x, 2.0f), f.planes[frustum::right]));
+		Assert::IsTrue(math::approx_equal(plane(float3::unit_y, 1.0f), f.planes[frustum::bottom]));
+		Assert::IsTrue(math::approx_equal(plane(-float3::unit_y, 1.0f), f.planes[frustum::top]));
+		Assert::IsTrue(math::approx_equal(plane(-float3::unit_z, -1.0f), f.planes[frustum::near_plane]));
+		Assert::IsTrue(math::approx_equal(plane(float3::unit_z, 10.0f), f.planes[frustum::far_plane]));
+
+		// the corners of the perspective frustum lie on its planes.
+		const float4x4 proj = math::perspective_matrix_directx(-1.0f, 2.0f, -0.5f, 1.0f, 1.0f, 10.0f);
+		const frustum fp = math::frustum_directx(proj);
+		Assert::IsTrue(math::approx_equal(0.0f, math::distance(fp.planes[frustum::left], float3(-1, 0, -1)), 1e-5f));
+		Assert::IsTrue(math::approx_equal(0.0f, math::distance(fp.planes[frustum::right], float3(20, 0, -10)), 1e-4f));
+		Assert::IsTrue(math::approx_equal(0.0f, math::distance(fp.planes[frustum::bottom], float3(0, -0.5f, -1)), 1e-5f));
+		Assert::IsTrue(math::approx_equal(0.0f, math::distance(fp.planes[frustum::top], float3(0, 10, -10)), 1e-4f));
+		Assert::IsTrue(math::approx_equal(0.0f, math::distance(fp.planes[frustum::near_plane], float3(0, 0, -1)), 1e-5f));
+		Assert::IsTrue(math::approx_equal(0.0f, math::distance(fp.planes[frustum::far_plane], float3(0, 0, -10)), 1e-4f));
+
+		for (const plane& pl : fp.planes) {
+			Assert::IsTrue(math::is_normalized(pl.normal));
+			Assert::IsTrue(math::distance(pl, float3(0, 0, -5)) > 0.0f);
+		}
+	}
+
+	TEST_METHOD(frustum_opengl)
+	{
+		const frustum f = math::frustum_opengl(math::orthographic_matrix_opengl(4.0f, 2.0f, 1.0f, 10.0f));
+		Assert::IsTrue(math::approx_equal(plane(float3::unit_x, 2.0f), f.planes[frustum::left]));
+		Assert::IsTrue(math::approx_equal(plane(-float3::unit_x, 2.0f), f.planes[frustum::right]));
+		Assert::IsTrue(math::approx_equal(plane(float3::unit_y, 1.0f), f.planes[frustum::bottom]));
+		Assert::IsTrue(math::approx_equal(plane(-float3::unit_y, 1.0f), f.planes[frustum::top]));
+		Assert::IsTrue(math::approx_equal(plane(-float3::unit_z, -1.0f), f.planes[frustum::near_plane]));
+		Assert::IsTrue(math::approx_equal(plane(float3::unit_z, 10.0f), f.planes[frustum::far_plane]));
+
+		const float4x4 proj = math::perspective_matrix_opengl(-1.0f, 2.0f, -0.5f, 1.0f, 1.0f, 10.0f);
+		const frustum fp = math::frustum_opengl(proj);
+		Assert::IsTrue(math::approx_equal(0.0f, math::distance(fp.planes[frustum::near_plane], float3(0, 0, -1)), 1e-4f));
+		Assert::IsTrue(math::approx_equal(0.0f, math::distance(fp.planes[frustum::far_plane], float3(0, 0, -10)), 1e-4f));
+		Assert::IsTrue(math::approx_equal(0.0f, math::distance(fp.planes[frustum::right], float3(20, 0, -10)), 1e-4f));
+
+		for (const plane& pl : fp.planes) {
+			Assert::IsTrue(math::is_normalized(pl.normal));
+			Assert::IsTrue(math::distance(pl, float3(0, 0, -5)) > 0.0f);
+		}
+	}
+};
+
+TEST_CLASS(math_plane) {
+public:
+
+	TEST_METHOD(ctors)
+	{
+		const plane p0;
+		Assert::AreEqual(float3::zero, p0.normal);
+		Assert::AreEqual(0.0f, p0.distance);
+
+		const plane p1(float3(1, 2, 3), 4.0f);
+		Assert::AreEqual(float3(1, 2, 3), p1.normal);
+		Assert::AreEqual(4.0f, p1.distance);
+
+		const plane p2(float4(1, 2, 3, 4));
+		Assert::AreEqual(p1, p2);
+	}
+
+	TEST_METHOD(distance)
+	{
+		const plane p(float3::unit_y, -2.0f);
+		Assert::AreEqual(0.0f, math::distance(p, float3(5, 2, -7)));
+		Assert::AreEqual(3.0f, math::distance(p, float3(1, 5, 1)));
+		Assert::AreEqual(-2.0f, math::distance(p, float3(1, 0, 1)));
+	}
+
+	TEST_METHOD(equal_operator)
+	{
+		const plane p(float3(1, 2, 3), 4.0f);
+		Assert::AreEqual(p, plane(float3(1, 2, 3), 4.0f));
+		Assert::AreNotEqual(p, plane(float3(1, 2, 3), 5.0f));
+		Assert::AreNotEqual(p, plane(float3(1, 2, 4), 4.0f));
+	}
+
+	TEST_METHOD(normalize)
+	{
+		const plane p = math::normalize(plane(float3(0, 3, 4), 10.0f));
+		Assert::IsTrue(math::approx_equal(plane(float3(0, 0.6f, 0.8f), 2.0f), p));
+		Assert::IsTrue(math::approx_equal(7.0f, math::distance(p, float3(0, 3, 4))));
+	}
+};
+
+} // namespace unittest
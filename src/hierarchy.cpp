@@ -0,0 +1,99 @@
+#include "math/hierarchy.h"
+
+#include <algorithm>
+#include "math/transform.h"
+
+
+namespace math {
+namespace {
+
+// The dirty nodes of a range are gathered into blocks of the parent world and local matrices
+// which are multiplied by the batch mul.
+constexpr size_t block_size = 32;
+
+// The minimum number of nodes of a level processed by a single task.
+constexpr size_t grain = 256;
+
+} // namespace
+
+
+constexpr uint32_t hierarchy::no_parent;
+
+hierarchy::hierarchy(const uint32_t* parents, size_t count)
+	: parents_(parents, parents + count),
+	positions_(count, float3::zero),
+	rotations_(count, quat::identity),
+	scales_(count, float3::unit_xyz),
+	worlds_(count, float4x4::identity),
+	dirty_(count, 1),
+	has_dirty_(count > 0)
+{
+	assert(count == 0 || parents);
+
+	std::vector<size_t> depth(count);
+	for (size_t i = 0; i < count; ++i) {
+		const uint32_t p = parents[i];
+		assert(p == no_parent || p < i);
+
+		depth[i] = (p == no_parent) ? 0 : depth[p] + 1;
+		assert(i == 0 || depth[i - 1] <= depth[i]); // breadth-first order
+
+		if (i == 0 || depth[i - 1] != depth[i])
+			level_offsets_.push_back(i);
+	}
+
+	if (count > 0) level_offsets_.push_back(count);
+}
+
+void hierarchy::update(thread_pool* pool)
+{
+	if (!has_dirty_) return;
+
+	for (size_t l = 0; l < level_count(); ++l) {
+		const size_t first = level_offsets_[l];
+		parallel_for(pool, level_offsets_[l + 1] - first, grain, [&](size_t begin, size_t end) {
+			update_range(first + begin, first + end);
+		});
+	}
+
+	std::fill(dirty_.begin(), dirty_.end(), uint8_t(0));
+	has_dirty_ = false;
+}
+
+void hierarchy::update_range(size_t begin, size_t end) noexcept
+{
+	float4x4 parent_worlds[block_size];
+	float4x4 locals[block_size];
+	size_t nodes[block_size];
+	size_t n = 0;
+
+	auto flush = [&] {
+		mul(parent_worlds, locals, locals, n);
+		for (size_t k = 0; k < n; ++k)
+			worlds_[nodes[k]] = locals[k];
+		n = 0;
+	};
+
+	for (size_t i = begin; i < end; ++i) {
+		const uint32_t p = parents_[i];
+
+		// the flags of the previous level are final, a node is dirty if its parent is.
+		if (p != no_parent && dirty_[p]) dirty_[i] = 1;
+		if (!dirty_[i]) continue;
+
+		const float4x4 local = trs_matrix(positions_[i], rotations_[i], scales_[i]);
+		if (p == no_parent) {
+			worlds_[i] = local;
+			continue;
+		}
+
+		parent_worlds[n] = worlds_[p];
+		locals[n] = local;
+		nodes[n] = i;
+		if (++n == block_size) flush();
+	}
+
+	if (n > 0) flush();
+}
+
+} // namespace math
@@ -0,0 +1,63 @@
+#include "math/hierarchy.h"
+
+#include <vector>
+#include "benchmark.h"
+
+using math::float3;
+using math::hierarchy;
+using math::quat;
+
+
+namespace {
+
+// Returns a breadth-first tree of state.size() nodes, every node has 4 children,
+// the local transformations are random.
+hierarchy bench_hierarchy(size_t count)
+{
+	std::vector<uint32_t> parents(count);
+	for (size_t i = 0; i < count; ++i)
+		parents[i] = (i == 0) ? hierarchy::no_parent : uint32_t((i - 1) / 4);
+
+	const std::vector<float3> p = benchmark::random_values<float3>(count, -1.0f, 1.0f, 1);
+	const std::vector<quat> q = benchmark::random_unit_quat(count, 2);
+	const std::vector<float3> s = benchmark::random_values<float3>(count, 0.9f, 1.1f, 3);
+
+	hierarchy h(parents.data(), count);
+	for (size_t i = 0; i < count; ++i)
+		h.set_local(i, p[i], q[i], s[i]);
+
+	return h;
+}
+
+// Every node is dirty.
+void hierarchy_update_batch(benchmark::state& state)
+{
+	hierarchy h = bench_hierarchy(state.size());
+
+	while (state.keep_running()) {
+		for (size_t i = 0; i < h.size(); ++i)
+			h.set_local(i, h.position(i), h.rotation(i), h.scale(i));
+
+		h.update();
+		benchmark::clobber_memory();
+	}
+}
+BENCHMARK(hierarchy_update_batch);
+
+// Every 64th node is dirty.
+void hierarchy_update_dirty_batch(benchmark::state& state)
+{
+	hierarchy h = bench_hierarchy(state.size());
+	h.update();
+
+	while (state.keep_running()) {
+		for (size_t i = 0; i < h.size(); i += 64)
+			h.set_local(i, h.position(i), h.rotation(i), h.scale(i));
+
+		h.update();
+		benchmark::clobber_memory();
+	}
+}
+BENCHMARK(hierarchy_update_dirty_batch);
+
+} // namespace
@@ -0,0 +1,176 @@
+#include "math/hierarchy.h"
+
+#include <cstdint>
+#include <vector>
+#include "math/transform.h"
+#include "CppUnitTest.h"
+#include "test_utility.h"
+
+
+using math::float3;
+using math::float4x4;
+using math::hierarchy;
+using math::quat;
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+
+namespace Microsoft { namespace VisualStudio { namespace CppUnitTestFramework {
+
+template<> inline std::wstring ToString<math::float4x4>(const math::float4x4& t) { RETURN_WIDE_STRING(t); }
+
+}}} // namespace Microsoft::VisualStudio::CppUnitTestFramework
+
+
+namespace {
+
+constexpr uint32_t no_parent = hierarchy::no_parent;
+
+// Returns the parents of a breadth-first forest of 2 trees where every node has up to branching children.
+std::vector<uint32_t> test_parents(size_t count, size_t branching)
+{
+	std::vector<uint32_t> parents(count);
+	for (size_t i = 0; i < count; ++i)
+		parents[i] = (i < 2) ? no_parent : uint32_t((i - 2) / branching);
+
+	return parents;
+}
+
+// Sets a local transformation of every node which depends on seed.
+void set_test_locals(hierarchy& h, size_t seed)
+{
+	for (size_t i = 0; i < h.size(); ++i) {
+		const float f = float((i + seed) % 17);
+		h.set_local(i, float3(0.1f * f, -0.2f, 0.05f * f),
+			math::from_axis_angle_rotation(math::normalize(float3(1, f, 2)), 0.1f * f),
+			float3(1.0f + 0.01f * f, 1.0f, 1.0f - 0.01f * f));
+	}
+}
+
+// Returns the world matrices computed node by node with float4x4 operator*.
+std::vector<float4x4> expected_worlds(const hierarchy& h)
+{
+	std::vector<float4x4> w(h.size());
+	for (size_t i = 0; i < h.size(); ++i) {
+		const float4x4 local = math::trs_matrix(h.position(i), h.rotation(i), h.scale(i));
+		w[i] = (h.parent(i) == no_parent) ? local : w[h.parent(i)] * local;
+	}
+
+	return w;
+}
+
+bool near(const std::vector<float4x4>& expected, const hierarchy& h)
+{
+	for (size_t i = 0; i < h.size(); ++i) {
+		if (!math::approx_equal(expected[i], h.world(i), 1e-3f)) return false;
+	}
+
+	return true;
+}
+
+} // namespace
+
+
+namespace unittest {
+
+TEST_CLASS(math_hierarchy) {
+public:
+
+	TEST_METHOD(ctors)
+	{
+		const hierarchy e;
+		Assert::AreEqual<size_t>(0, e.size());
+		Assert::AreEqual<size_t>(0, e.level_count());
+
+		//     0     1
+		//   2   3   4
+		//  5 6      7
+		const uint32_t parents[] = { no_parent, no_parent, 0, 0, 1, 2, 2, 4 };
+		hierarchy h(parents, 8);
+		Assert::AreEqual<size_t>(8, h.size());
+		Assert::AreEqual<size_t>(3, h.level_count());
+		Assert::AreEqual<size_t>(0, h.level_offset(0));
+		Assert::AreEqual<size_t>(2, h.level_offset(1));
+		Assert::AreEqual<size_t>(5, h.level_offset(2));
+		Assert::AreEqual<size_t>(8, h.level_offset(3));
+		Assert::AreEqual(no_parent, h.parent(1));
+		Assert::AreEqual<uint32_t>(4, h.parent(7));
+
+		// the local transformations are identities.
+		h.update();
+		for (size_t i = 0; i < h.size(); ++i)
+			Assert::AreEqual(float4x4::identity, h.world(i));
+	}
+
+	TEST_METHOD(update)
+	{
+		const uint32_t parents[] = { no_parent, no_parent, 0, 0, 1, 2, 2, 4 };
+		hierarchy h(parents, 8);
+		set_test_locals(h, 0);
+		h.update();
+		Assert::IsTrue(near(expected_worlds(h), h));
+		Assert::AreEqual(h.world(7), h.worlds()[7]);
+
+		const float4x4 expected_7 = math::trs_matrix(h.position(1), h.rotation(1), h.scale(1))
+			* math::trs_matrix(h.position(4), h.rotation(4), h.scale(4))
+			* math::trs_matrix(h.position(7), h.rotation(7), h.scale(7));
+		Assert::IsTrue(math::approx_equal(expected_7, h.world(7), 1e-5f));
+	}
+
+	TEST_METHOD(update_dirty)
+	{
+		const uint32_t parents[] = { no_parent, no_parent, 0, 0, 1, 2, 2, 4 };
+		hierarchy h(parents, 8);
+		set_test_locals(h, 0);
+		h.update();
+		const std::vector<float4x4> prev(h.worlds(), h.worlds() + h.size());
+
+		// node 2 and its children 5 and 6 change, the rest keep their matrices.
+		h.set_local(2, float3(5, 6, 7), quat::identity, float3(2.0f));
+		h.update();
+		Assert::IsTrue(near(expected_worlds(h), h));
+		for (size_t i : { 0, 1, 3, 4, 7 })
+			Assert::AreEqual(prev[i], h.world(i));
+		for (size_t i : { 2, 5, 6 })
+			Assert::AreNotEqual(prev[i], h.world(i));
+
+		// nothing is dirty.
+		h.update();
+		Assert::IsTrue(near(expected_worlds(h), h));
+
+		// a root moves the whole tree.
+		h.set_local(1, float3(1, 1, 1), quat::identity, float3(1.0f));
+		h.update();
+		Assert::IsTrue(near(expected_worlds(h), h));
+	}
+
+	TEST_METHOD(update_threads)
+	{
+		constexpr size_t count = 5000;
+		const std::vector<uint32_t> parents = test_parents(count, 3);
+
+		for_each_isa_level([&] {
+			test_thread_pool pool;
+			hierarchy h(parents.data(), count);
+			set_test_locals(h, 1);
+			h.update(&pool);
+			Assert::IsTrue(near(expected_worlds(h), h));
+
+			// a subtree and a few scattered nodes.
+			for (size_t i : { size_t(3), size_t(100), size_t(2000), count - 1 })
+				h.set_local(i, float3(1, 2, 3), quat::identity, float3(0.5f));
+			h.update(&pool);
+			Assert::IsTrue(near(expected_worlds(h), h));
+
+			// the same as a single thread computes.
+			hierarchy st(parents.data(), count);
+			set_test_locals(st, 2);
+			set_test_locals(h, 2);
+			st.update();
+			h.update(&pool);
+			for (size_t i = 0; i < count; ++i)
+				Assert::AreEqual(st.world(i), h.world(i));
+		});
+	}
+};
+
+} // namespace unittest
@@ -0,0 +1,270 @@
+#ifndef MATH_SRC_KERNELS_H_
+#define MATH_SRC_KERNELS_H_
+
+// Kernels are the implementations of the batch functions.
+// Every instruction set level (see math/dispatch.h) has its own kernel_table,
+// the batch functions call the kernels of the active level via active_kernels().
+//
+// kernels_scalar.cpp implements the reference kernels in plain C++.
+// kernels_impl.h implements the SIMD kernels once in terms of the vfloat/vint/vmask/vdouble types,
+// kernels_sse4_1.cpp, kernels_avx2.cpp and kernels_avx512.cpp define those types
+// for their instruction set and compile kernels_impl.h for it.
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include "math/aabb.h"
+#include "math/dispatch.h"
+#include "math/dual_quat.h"
+#include "math/frustum.h"
+#include "math/matrix.h"
+#include "math/matrix_double.h"
+#include "math/morton.h"
+#include "math/ray.h"
+#include "math/vector_float.h"
+#include "math/vector_int.h"
+#include "math/vector_soa.h"
+
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+	#define MATH_X86 1
+#else
+	#define MATH_X86 0
+#endif
+
+// MATH_BEGIN_TARGET(isa)/MATH_END_TARGET enable an instruction set for every function
+// defined in between. MSVC does not need it: the intrinsics are always available.
+#if defined(__clang__)
+	#define MATH_PRAGMA(x) _Pragma(#x)
+	#define MATH_BEGIN_TARGET(isa) MATH_PRAGMA(clang attribute push(__attribute__((target(isa))), apply_to = function))
+	#define MATH_END_TARGET MATH_PRAGMA(clang attribute pop)
+#elif defined(__GNUC__)
+	#define MATH_PRAGMA(x) _Pragma(#x)
+	#define MATH_BEGIN_TARGET(isa) MATH_PRAGMA(GCC push_options) MATH_PRAGMA(GCC target(isa))
+	#define MATH_END_TARGET MATH_PRAGMA(GCC pop_options)
+#else
+	#define MATH_BEGIN_TARGET(isa)
+	#define MATH_END_TARGET
+#endif
+
+
+namespace math {
+
+struct kernel_table final {
+	// Every kernel processes count elements. out may be equal to the input array.
+
+	void (*mul_float4x4_float4)(const float4x4& m, const float4* v, float4* out, size_t count) noexcept;
+
+	void (*mul_float4x4_float4x4)(const float4x4* l, const float4x4* r, float4x4* out, size_t count) noexcept;
+
+	// out[i] = fast_normalize(v[i]) for the arrays of vectors of n (2, 3 or 4) floats.
+	void (*fast_normalize_aos)(const float* v, size_t n, float* out, size_t count) noexcept;
+
+	void (*normalize_float3)(const float3* v, float3* out, size_t count) noexcept;
+
+	void (*normalize_float4)(const float4* v, float4* out, size_t count) noexcept;
+
+	void (*nlerp_quat)(const quat* q, const quat* r, const float* factor, quat* out, size_t count) noexcept;
+
+	void (*slerp_fast_quat)(const quat* q, const quat* r, const float* factor, quat* out, size_t count) noexcept;
+
+	void (*pack_snorm_10_10_10_2)(const float4* v, uint32_t* out, size_t count) noexcept;
+
+	void (*pack_unorm_10_10_10_2)(const float4* v, uint32_t* out, size_t count) noexcept;
+
+	void (*pack_unorm_16_16)(const float2* v, uint32_t* out, size_t count) noexcept;
+
+	void (*pack_unorm_8_8_8)(const float3* v, uint32_t* out, size_t count) noexcept;
+
+	void (*pack_unorm_8_8_8_8)(const float4* v, uint32_t* out, size_t count) noexcept;
+
+	void (*unpack_snorm_10_10_10_2)(const uint32_t* p, float4* out, size_t count) noexcept;
+
+	void (*unpack_unorm_10_10_10_2)(const uint32_t* p, float4* out, size_t count) noexcept;
+
+	void (*unpack_unorm_16_16)(const uint32_t* p, float2* out, size_t count) noexcept;
+
+	void (*unpack_unorm_8_8_8)(const uint32_t* p, float3* out, size_t count) noexcept;
+
+	void (*unpack_unorm_8_8_8_8)(const uint32_t* p, float4* out, size_t count) noexcept;
+
+	void (*encode_octahedral)(const float3* n, float2* out, size_t count) noexcept;
+
+	void (*decode_octahedral)(const float2* e, float3* out, size_t count) noexcept;
+
+	void (*pack_octahedral_snorm_16_16)(const float3* n, uint32_t* out, size_t count) noexcept;
+
+	void (*unpack_octahedral_snorm_16_16)(const uint32_t* p, float3* out, size_t count) noexcept;
+
+	void (*pack_octahedral_unorm_8_8)(const float3* n, uint16_t* out, size_t count) noexcept;
+
+	void (*unpack_octahedral_unorm_8_8)(const uint16_t* p, float3* out, size_t count) noexcept;
+
+	// out[i] = pack_smallest_three(q[i], bits), out is the array of uint32_t (out_size = 4) or uint64_t (8).
+	void (*pack_smallest_three)(const quat* q, uint32_t bits, void* out, size_t out_size, size_t count) noexcept;
+
+	// out[i] = unpack_smallest_three(p[i], bits), p is the array of uint32_t (p_size = 4) or uint64_t (8).
+	void (*unpack_smallest_three)(const void* p, size_t p_size, uint32_t bits, quat* out, size_t count) noexcept;
+
+	// out[i] = pack_half(v[i]).bits and out[i] = unpack_half(half(v[i])) for the arrays of floats.
+	void (*pack_half)(const float* v, uint16_t* out, size_t count) noexcept;
+
+	void (*unpack_half)(const uint16_t* v, float* out, size_t count) noexcept;
+
+	// SoA kernels (see math/vector_soa.h) take arrays of n (3 or 4) component pointers.
+	// The component arrays must be padded up to a multiple of soa_block_size floats,
+	// the kernels may read and write the padding. Plain float and AoS arrays are not padded.
+
+	void (*aos_to_soa)(const float* v, size_t n, float* const* out, size_t count) noexcept;
+
+	void (*soa_to_aos)(const float* const* v, size_t n, float* out, size_t count) noexcept;
+
+	// out[i] = clamp(v[i], lo, hi) for a single component array.
+	void (*clamp_soa)(const float* v, float lo, float hi, float* out, size_t count) noexcept;
+
+	void (*cross_soa)(const float* const* l, const float* const* r, float* const* out, size_t count) noexcept;
+
+	void (*dot_soa)(const float* const* l, const float* const* r, size_t n, float* out, size_t count) noexcept;
+
+	void (*len_soa)(const float* const* v, size_t n, float* out, size_t count) noexcept;
+
+	// out[i] = lerp(l[i], r[i], factor) for a single component array.
+	void (*lerp_soa)(const float* l, const float* r, float factor, float* out, size_t count) noexcept;
+
+	void (*normalize_soa)(const float* const* v, size_t n, float* const* out, size_t count) noexcept;
+
+	// Sets bit (i % 32) of visible[i / 32] if the sphere i (center x, y, z and radius w) intersects f.
+	// The rest of the bits of the (count + 31) / 32 values are cleared.
+	void (*intersects_spheres_soa)(const frustum& f, const float* const* spheres, uint32_t* visible, size_t count) noexcept;
+
+	// As above for the axis-aligned boxes [min[i], max[i]].
+	void (*intersects_aabbs_soa)(const frustum& f, const float* const* min, const float* const* max,
+		uint32_t* visible, size_t count) noexcept;
+
+	// s[i] = sin(angles[i]), c[i] = cos(angles[i]), see sincos.
+	void (*sincos)(const float* angles, float* s, float* c, size_t count, bool fast) noexcept;
+
+	// out[i] = mul(m, float4(in[i], w)), the first n (3 or 4) components are stored.
+	// in[i] and out[i] are located at in + i * in_stride and out + i * out_stride bytes.
+	void (*transform_float3)(const float4x4& m, float w, const void* in, size_t in_stride,
+		void* out, size_t out_stride, size_t n, size_t count) noexcept;
+
+	void (*mul_double4x4_double4)(const double4x4& m, const double4* v, double4* out, size_t count) noexcept;
+
+	// out[i] = float3(p[i] - origin).
+	void (*to_float_relative)(const double3* p, const double3& origin, float3* out, size_t count) noexcept;
+
+	// See skin(const dual_quat*, ...). normals and out_normals may be nullptr.
+	void (*skin_dual_quat)(const dual_quat* palette, const float3* positions, const float3* normals,
+		const ubyte4* joints, const uint32_t* weights, float3* out_positions, float3* out_normals, size_t count) noexcept;
+
+	// See skin(const float4x4*, ...). normals and out_normals may be nullptr.
+	void (*skin_float4x4)(const float4x4* palette, const float3* positions, const float3* normals,
+		const ubyte4* joints, const float4* weights, float3* out_positions, float3* out_normals, size_t count) noexcept;
+
+	// Extends [min, max] to contain p[i]: min = min(min, p[i]), max = max(max, p[i]) for every component.
+	void (*bounds_float3)(const float3* p, size_t count, float3& min, float3& max) noexcept;
+
+	// t[i] is the distance of the hit of the ray r and the primitive i or +infinity,
+	// see intersects(const ray&, ...). The primitives are SoA arrays padded up to a multiple of the SIMD width.
+	void (*intersects_ray_aabbs_soa)(const ray& r, const float* const* min, const float* const* max,
+		float t_max, float* t, size_t count) noexcept;
+	void (*intersects_ray_spheres_soa)(const ray& r, const float* const* spheres,
+		float t_max, float* t, size_t count) noexcept;
+	void (*intersects_ray_triangles_soa)(const ray& r, const float* const* v0, const float* const* v1,
+		const float* const* v2, float t_max, float* t, size_t count) noexcept;
+
+	// t[i] is the distance of the hit of the ray i and the primitive or +infinity.
+	// The rays are SoA arrays padded up to a multiple of the SIMD width.
+	void (*intersects_rays_aabb_soa)(const float* const* origins, const float* const* directions,
+		const float* t_max, const aabb& b, float* t, size_t count) noexcept;
+	void (*intersects_rays_sphere_soa)(const float* const* origins, const float* const* directions,
+		const float* t_max, const float3& center, float radius, float* t, size_t count) noexcept;
+	void (*intersects_rays_triangle_soa)(const float* const* origins, const float* const* directions,
+		const float* t_max, const float3& v0, const float3& v1, const float3& v2, float* t, size_t count) noexcept;
+
+	// out[i] = morton_encode32/64(detail::quantize(p[i], origin, scale, bits)), out is the array of uint32_t
+	// (out_size = 4, bits = 10) or uint64_t (out_size = 8, bits = 21).
+	void (*morton_encode_float3)(const float3* p, const float3& origin, const float3& scale,
+		void* out, size_t out_size, size_t count) noexcept;
+};
+
+// slerp_fast evaluates the coefficients of q and r as
+// c(t) = t * (1 + b[0] * (1 + b[1] * (... (1 + b[n - 1])))), b[i] = (u[i] * t^2 - v[i]) * (cos_omega - 1).
+// u[i] = 1 / ((i + 1) * (2i + 3)), v[i] = (i + 1) / (2i + 3), the last ones are multiplied by
+// 1 + mu = 1.85298109 which minimizes the error for 0 <= omega <= pi / 2.
+constexpr size_t slerp_fast_terms = 8;
+
+constexpr float slerp_fast_u[slerp_fast_terms] = {
+	1.0f / (1 * 3), 1.0f / (2 * 5), 1.0f / (3 * 7), 1.0f / (4 * 9),
+	1.0f / (5 * 11), 1.0f / (6 * 13), 1.0f / (7 * 15), 1.85298109240830f / (8 * 17)
+};
+
+constexpr float slerp_fast_v[slerp_fast_terms] = {
+	1.0f / 3, 2.0f / 5, 3.0f / 7, 4.0f / 9,
+	5.0f / 11, 6.0f / 13, 7.0f / 15, 1.85298109240830f * 8 / 17
+};
+
+// sincos reduces the angle to r = angle - j * pi / 2, |r| <= pi / 4 (j is the nearest integer).
+// pi / 2 is subtracted in 3 parts (Cody-Waite), the first two have few significant bits
+// so that j * sincos_pi_2[0] and j * sincos_pi_2[1] are exact.
+constexpr float sincos_2_pi = 0.636619772367581343f;
+constexpr float sincos_pi_2[3] = { 1.5703125f, 4.837512969970703125e-4f, 7.54978995489188216e-8f };
+
+// sin(r) = r + r^3 * p(r^2), cos(r) = 1 + r^2 * q(r^2) on [-pi / 4, pi / 4].
+// The full polynomials are the ones of Cephes sinf/cosf, the fast ones are minimax of a lower degree
+// with the maximum error 9.4e-7 (sin) and 1.23e-5 (cos).
+constexpr float sincos_sin_full[3] = { -1.6666654611e-1f, 8.3321608736e-3f, -1.9515295891e-4f };
+constexpr float sincos_cos_full[4] = { -0.5f, 4.166664568298827e-2f, -1.388731625493765e-3f, 2.443315711809948e-5f };
+constexpr float sincos_sin_fast[2] = { -0.166628338f, 0.00815299234f };
+constexpr float sincos_cos_fast[2] = { -0.499776307f, 0.0404889358f };
+
+// Computes s = sin(angle) and c = cos(angle) with the polynomials above, see sincos.
+// NaN and infinite angles give NaN as std::sin and std::cos do.
+inline void sincos_poly(float angle, bool fast, float& s, float& c) noexcept
+{
+	if (!std::isfinite(angle)) {
+		s = c = angle - angle;
+		return;
+	}
+
+	const float j = std::round(angle * sincos_2_pi);
+	const float r = ((angle - j * sincos_pi_2[0]) - j * sincos_pi_2[1]) - j * sincos_pi_2[2];
+	const float r2 = r * r;
+
+	float ps, pc;
+	if (fast) {
+		ps = r + r * r2 * (sincos_sin_fast[0] + r2 * sincos_sin_fast[1]);
+		pc = 1.0f + r2 * (sincos_cos_fast[0] + r2 * sincos_cos_fast[1]);
+	}
+	else {
+		ps = r + r * r2 * (sincos_sin_full[0] + r2 * (sincos_sin_full[1] + r2 * sincos_sin_full[2]));
+		pc = 1.0f + r2 * (sincos_cos_full[0] + r2 * (sincos_cos_full[1]
+			+ r2 * (sincos_cos_full[2] + r2 * sincos_cos_full[3])));
+	}
+
+	// the quadrant j mod 4: sin(r + q * pi / 2) is sin r, cos r, -sin r, -cos r.
+	// It is computed exactly in float, j may exceed the range of int.
+	const int q = int(j - 4.0f * std::floor(0.25f * j));
+	s = (q & 1) ? pc : ps;
+	c = (q & 1) ? ps : pc;
+	if (q & 2) s = -s;
+	if (q == 1 || q == 2) c = -c;
+}
+
+extern const kernel_table scalar_kernels;
+
+#if MATH_X86
+extern const kernel_table sse4_1_kernels;
+extern const kernel_table avx2_kernels;
+extern const kernel_table avx512_kernels;
+#endif
+
+// Returns the kernels of the active instruction set level.
+const kernel_table& active_kernels() noexcept;
+
+} // namespace math
+
+#endif // MATH_SRC_KERNELS_H_
@@ -0,0 +1,121 @@
+#include "kernels.h"
+
+#if MATH_X86
+
+#include <immintrin.h>
+
+
+MATH_BEGIN_TARGET("avx2,fma,f16c")
+
+namespace math {
+namespace avx2 {
+
+constexpr size_t width = 8;
+
+struct vfloat { __m256 v; };
+struct vint { __m256i v; };
+struct vmask { __m256 v; };
+
+inline vfloat broadcast(float f) noexcept { return { _mm256_set1_ps(f) }; }
+inline vint broadcast_int(int32_t i) noexcept { return { _mm256_set1_epi32(i) }; }
+
+inline vfloat load(const float* p) noexcept { return { _mm256_loadu_ps(p) }; }
+inline void store(float* p, vfloat a) noexcept { _mm256_storeu_ps(p, a.v); }
+inline void store(uint32_t* p, vint a) noexcept { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), a.v); }
+
+inline vfloat load_lanes(const float* p, size_t stride) noexcept
+{
+	return { _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p)), _mm_loadu_ps(p + stride), 1) };
+}
+
+inline void store_lanes(float* p, size_t stride, vfloat a) noexcept
+{
+	_mm_storeu_ps(p, _mm256_castps256_ps128(a.v));
+	_mm_storeu_ps(p + stride, _mm256_extractf128_ps(a.v, 1));
+}
+
+template<int a, int b, int c, int d>
+inline vfloat shuffle(vfloat l, vfloat r) noexcept { return { _mm256_shuffle_ps(l.v, r.v, _MM_SHUFFLE(d, c, b, a)) }; }
+inline vfloat unpack_lo(vfloat l, vfloat r) noexcept { return { _mm256_unpacklo_ps(l.v, r.v) }; }
+inline vfloat unpack_hi(vfloat l, vfloat r) noexcept { return { _mm256_unpackhi_ps(l.v, r.v) }; }
+
+inline vfloat operator+(vfloat l, vfloat r) noexcept { return { _mm256_add_ps(l.v, r.v) }; }
+inline vfloat operator-(vfloat l, vfloat r) noexcept { return { _mm256_sub_ps(l.v, r.v) }; }
+inline vfloat operator*(vfloat l, vfloat r) noexcept { return { _mm256_mul_ps(l.v, r.v) }; }
+inline vfloat operator/(vfloat l, vfloat r) noexcept { return { _mm256_div_ps(l.v, r.v) }; }
+inline vfloat mul_add(vfloat a, vfloat b, vfloat c) noexcept { return { _mm256_fmadd_ps(a.v, b.v, c.v) }; }
+inline vfloat min(vfloat l, vfloat r) noexcept { return { _mm256_min_ps(l.v, r.v) }; }
+inline vfloat max(vfloat l, vfloat r) noexcept { return { _mm256_max_ps(l.v, r.v) }; }
+inline vfloat sqrt(vfloat a) noexcept { return { _mm256_sqrt_ps(a.v) }; }
+inline vfloat rsqrt(vfloat a) noexcept { return { _mm256_rsqrt_ps(a.v) }; }
+inline vfloat abs(vfloat a) noexcept { return { _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v) }; }
+inline vfloat trunc(vfloat a) noexcept { return { _mm256_round_ps(a.v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC) }; }
+
+inline vfloat copy_sign(vfloat mag, vfloat sgn) noexcept
+{
+	const __m256 sign_mask = _mm256_set1_ps(-0.0f);
+	return { _mm256_or_ps(_mm256_andnot_ps(sign_mask, mag.v), _mm256_and_ps(sign_mask, sgn.v)) };
+}
+
+inline vmask operator<(vfloat l, vfloat r) noexcept { return { _mm256_cmp_ps(l.v, r.v, _CMP_LT_OQ) }; }
+inline vmask operator>(vfloat l, vfloat r) noexcept { return { _mm256_cmp_ps(l.v, r.v, _CMP_GT_OQ) }; }
+inline vmask operator<=(vfloat l, vfloat r) noexcept { return { _mm256_cmp_ps(l.v, r.v, _CMP_LE_OQ) }; }
+inline vmask operator>=(vfloat l, vfloat r) noexcept { return { _mm256_cmp_ps(l.v, r.v, _CMP_GE_OQ) }; }
+inline vmask operator|(vmask l, vmask r) noexcept { return { _mm256_or_ps(l.v, r.v) }; }
+inline vmask operator&(vmask l, vmask r) noexcept { return { _mm256_and_ps(l.v, r.v) }; }
+inline vfloat select(vmask m, vfloat a, vfloat b) noexcept { return { _mm256_blendv_ps(b.v, a.v, m.v) }; }
+inline uint32_t to_bits(vmask m) noexcept { return uint32_t(_mm256_movemask_ps(m.v)); }
+
+inline vint to_int(vfloat a) noexcept { return { _mm256_cvttps_epi32(a.v) }; }
+inline vint operator|(vint l, vint r) noexcept { return { _mm256_or_si256(l.v, r.v) }; }
+inline vint operator&(vint l, vint r) noexcept { return { _mm256_and_si256(l.v, r.v) }; }
+
+template<int n>
+inline vint shift_left(vint a) noexcept { return { _mm256_slli_epi32(a.v, n) }; }
+
+template<int n>
+inline vint shift_right(vint a) noexcept { return { _mm256_srli_epi32(a.v, n) }; }
+
+inline vint load(const uint32_t* p) noexcept { return { _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)) }; }
+inline vfloat to_float(vint a) noexcept { return { _mm256_cvtepi32_ps(a.v) }; }
+inline vfloat gather(const float* p, vint idx) noexcept { return { _mm256_i32gather_ps(p, idx.v, 4) }; }
+
+inline void store_half(uint16_t* p, vfloat a) noexcept
+{
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm256_cvtps_ph(a.v, _MM_FROUND_TO_NEAREST_INT));
+}
+
+inline vfloat load_half(const uint16_t* p) noexcept
+{
+	return { _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))) };
+}
+
+constexpr size_t dwidth = 4;
+
+struct vdouble { __m256d v; };
+
+inline vdouble broadcast_double(double d) noexcept { return { _mm256_set1_pd(d) }; }
+inline vdouble load(const double* p) noexcept { return { _mm256_loadu_pd(p) }; }
+inline void store(double* p, vdouble a) noexcept { _mm256_storeu_pd(p, a.v); }
+
+// Converts a to float and stores dwidth floats.
+inline void store_float(float* p, vdouble a) noexcept { _mm_storeu_ps(p, _mm256_cvtpd_ps(a.v)); }
+
+inline vdouble operator-(vdouble l, vdouble r) noexcept { return { _mm256_sub_pd(l.v, r.v) }; }
+inline vdouble operator*(vdouble l, vdouble r) noexcept { return { _mm256_mul_pd(l.v, r.v) }; }
+inline vdouble mul_add(vdouble a, vdouble b, vdouble c) noexcept { return { _mm256_fmadd_pd(a.v, b.v, c.v) }; }
+
+template<int i>
+inline vdouble splat4(vdouble v) noexcept { return { _mm256_permute4x64_pd(v.v, i * 0x55) }; }
+
+#include "kernels_impl.h"
+
+} // namespace avx2
+
+const kernel_table avx2_kernels = avx2::table;
+
+} // namespace math
+
+MATH_END_TARGET
+
+#endif // MATH_X86
@@ -0,0 +1,134 @@
+#include "kernels.h"
+
+#if MATH_X86
+
+#include <immintrin.h>
+
+
+MATH_BEGIN_TARGET("avx512f,avx2,fma")
+
+namespace math {
+namespace avx512 {
+
+constexpr size_t width = 16;
+
+struct vfloat { __m512 v; };
+struct vint { __m512i v; };
+struct vmask { __mmask16 v; };
+
+inline vfloat broadcast(float f) noexcept { return { _mm512_set1_ps(f) }; }
+inline vint broadcast_int(int32_t i) noexcept { return { _mm512_set1_epi32(i) }; }
+
+inline vfloat load(const float* p) noexcept { return { _mm512_loadu_ps(p) }; }
+inline void store(float* p, vfloat a) noexcept { _mm512_storeu_ps(p, a.v); }
+inline void store(uint32_t* p, vint a) noexcept { _mm512_storeu_si512(p, a.v); }
+
+inline vfloat load_lanes(const float* p, size_t stride) noexcept
+{
+	__m512 res = _mm512_castps128_ps512(_mm_loadu_ps(p));
+	res = _mm512_insertf32x4(res, _mm_loadu_ps(p + stride), 1);
+	res = _mm512_insertf32x4(res, _mm_loadu_ps(p + 2 * stride), 2);
+	res = _mm512_insertf32x4(res, _mm_loadu_ps(p + 3 * stride), 3);
+	return { res };
+}
+
+inline void store_lanes(float* p, size_t stride, vfloat a) noexcept
+{
+	_mm_storeu_ps(p, _mm512_castps512_ps128(a.v));
+	_mm_storeu_ps(p + stride, _mm512_extractf32x4_ps(a.v, 1));
+	_mm_storeu_ps(p + 2 * stride, _mm512_extractf32x4_ps(a.v, 2));
+	_mm_storeu_ps(p + 3 * stride, _mm512_extractf32x4_ps(a.v, 3));
+}
+
+template<int a, int b, int c, int d>
+inline vfloat shuffle(vfloat l, vfloat r) noexcept { return { _mm512_shuffle_ps(l.v, r.v, _MM_SHUFFLE(d, c, b, a)) }; }
+inline vfloat unpack_lo(vfloat l, vfloat r) noexcept { return { _mm512_unpacklo_ps(l.v, r.v) }; }
+inline vfloat unpack_hi(vfloat l, vfloat r) noexcept { return { _mm512_unpackhi_ps(l.v, r.v) }; }
+
+inline vfloat operator+(vfloat l, vfloat r) noexcept { return { _mm512_add_ps(l.v, r.v) }; }
+inline vfloat operator-(vfloat l, vfloat r) noexcept { return { _mm512_sub_ps(l.v, r.v) }; }
+inline vfloat operator*(vfloat l, vfloat r) noexcept { return { _mm512_mul_ps(l.v, r.v) }; }
+inline vfloat operator/(vfloat l, vfloat r) noexcept { return { _mm512_div_ps(l.v, r.v) }; }
+inline vfloat mul_add(vfloat a, vfloat b, vfloat c) noexcept { return { _mm512_fmadd_ps(a.v, b.v, c.v) }; }
+inline vfloat min(vfloat l, vfloat r) noexcept { return { _mm512_min_ps(l.v, r.v) }; }
+inline vfloat max(vfloat l, vfloat r) noexcept { return { _mm512_max_ps(l.v, r.v) }; }
+inline vfloat sqrt(vfloat a) noexcept { return { _mm512_sqrt_ps(a.v) }; }
+inline vfloat rsqrt(vfloat a) noexcept { return { _mm512_rsqrt14_ps(a.v) }; }
+inline vfloat trunc(vfloat a) noexcept { return { _mm512_roundscale_ps(a.v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC) }; }
+
+// AVX-512F lacks the float logical instructions, they are emulated with the integer ones.
+inline vfloat abs(vfloat a) noexcept
+{
+	return { _mm512_castsi512_ps(_mm512_and_si512(_mm512_castps_si512(a.v), _mm512_set1_epi32(0x7fffffff))) };
+}
+
+inline vfloat copy_sign(vfloat mag, vfloat sgn) noexcept
+{
+	const __m512i sign_mask = _mm512_set1_epi32(int32_t(0x80000000));
+	return { _mm512_castsi512_ps(_mm512_or_si512(
+		_mm512_andnot_si512(sign_mask, _mm512_castps_si512(mag.v)),
+		_mm512_and_si512(sign_mask, _mm512_castps_si512(sgn.v)))) };
+}
+
+inline vmask operator<(vfloat l, vfloat r) noexcept { return { _mm512_cmp_ps_mask(l.v, r.v, _CMP_LT_OQ) }; }
+inline vmask operator>(vfloat l, vfloat r) noexcept { return { _mm512_cmp_ps_mask(l.v, r.v, _CMP_GT_OQ) }; }
+inline vmask operator<=(vfloat l, vfloat r) noexcept { return { _mm512_cmp_ps_mask(l.v, r.v, _CMP_LE_OQ) }; }
+inline vmask operator>=(vfloat l, vfloat r) noexcept { return { _mm512_cmp_ps_mask(l.v, r.v, _CMP_GE_OQ) }; }
+inline vmask operator|(vmask l, vmask r) noexcept { return { __mmask16(l.v | r.v) }; }
+inline vmask operator&(vmask l, vmask r) noexcept { return { __mmask16(l.v & r.v) }; }
+inline vfloat select(vmask m, vfloat a, vfloat b) noexcept { return { _mm512_mask_blend_ps(m.v, b.v, a.v) }; }
+inline uint32_t to_bits(vmask m) noexcept { return uint32_t(m.v); }
+
+inline vint to_int(vfloat a) noexcept { return { _mm512_cvttps_epi32(a.v) }; }
+inline vint operator|(vint l, vint r) noexcept { return { _mm512_or_si512(l.v, r.v) }; }
+inline vint operator&(vint l, vint r) noexcept { return { _mm512_and_si512(l.v, r.v) }; }
+
+template<int n>
+inline vint shift_left(vint a) noexcept { return { _mm512_slli_epi32(a.v, n) }; }
+
+template<int n>
+inline vint shift_right(vint a) noexcept { return { _mm512_srli_epi32(a.v, n) }; }
+
+inline vint load(const uint32_t* p) noexcept { return { _mm512_loadu_si512(p) }; }
+inline vfloat to_float(vint a) noexcept { return { _mm512_cvtepi32_ps(a.v) }; }
+inline vfloat gather(const float* p, vint idx) noexcept { return { _mm512_i32gather_ps(idx.v, p, 4) }; }
+
+inline void store_half(uint16_t* p, vfloat a) noexcept
+{
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(p), _mm512_cvtps_ph(a.v, _MM_FROUND_TO_NEAREST_INT));
+}
+
+inline vfloat load_half(const uint16_t* p) noexcept
+{
+	return { _mm512_cvtph_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p))) };
+}
+
+constexpr size_t dwidth = 8;
+
+struct vdouble { __m512d v; };
+
+inline vdouble broadcast_double(double d) noexcept { return { _mm512_set1_pd(d) }; }
+inline vdouble load(const double* p) noexcept { return { _mm512_loadu_pd(p) }; }
+inline void store(double* p, vdouble a) noexcept { _mm512_storeu_pd(p, a.v); }
+
+// Converts a to float and stores dwidth floats.
+inline void store_float(float* p, vdouble a) noexcept { _mm256_storeu_ps(p, _mm512_cvtpd_ps(a.v)); }
+
+inline vdouble operator-(vdouble l, vdouble r) noexcept { return { _mm512_sub_pd(l.v, r.v) }; }
+inline vdouble operator*(vdouble l, vdouble r) noexcept { return { _mm512_mul_pd(l.v, r.v) }; }
+inline vdouble mul_add(vdouble a, vdouble b, vdouble c) noexcept { return { _mm512_fmadd_pd(a.v, b.v, c.v) }; }
+
+template<int i>
+inline vdouble splat4(vdouble v) noexcept { return { _mm512_permutex_pd(v.v, i * 0x55) }; }
+
+#include "kernels_impl.h"
+
+} // namespace avx512
+
+const kernel_table avx512_kernels = avx512::table;
+
+} // namespace math
+
+MATH_END_TARGET
+
+#endif // MATH_X86
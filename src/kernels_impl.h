@@ -0,0 +1,1648 @@
+// Implements the SIMD kernels (see kernels.h) in terms of the vfloat, vint and vmask types.
+// The file is included by kernels_sse4_1.cpp, kernels_avx2.cpp and kernels_avx512.cpp
+// inside their own namespace, after the following has been defined there:
+//
+// -	width:							the number of float lanes in vfloat.
+// -	vfloat, vint, vmask:			float, int32 and mask vectors of the width lanes.
+// -	broadcast, broadcast_int:		vectors whose every lane equals to the given value.
+// -	load, store:					unaligned load/store of width consecutive values.
+// -	load_lanes, store_lanes:		load/store of every 4-lane group (128 bits) of a vfloat.
+//									The group i is located at p + i * stride.
+// -	shuffle<a, b, c, d>(l, r):		returns (l[a], l[b], r[c], r[d]) for every 4-lane group.
+// -	unpack_lo, unpack_hi:			interleave the low/high halves of every 4-lane group.
+// -	+, -, *, /, mul_add, min, max, sqrt, abs, trunc, copy_sign
+// -	rsqrt:							the estimate of 1 / sqrt, relative error <= 1.5 * 2^-12.
+// -	<, >, <=, >= (vfloat), |, & (vmask), select(m, a, b) = m ? a : b
+// -	to_bits:						returns the mask lanes as the lowest width bits of uint32_t.
+// -	to_int (truncation), |, & (vint), shift_left<n>, shift_right<n> (logical)
+// -	load (const uint32_t*):			unaligned load of width uint32 values into a vint.
+// -	to_float:						converts every int32 lane of a vint to float.
+// -	gather(p, idx):					returns the vfloat of p[idx[0]], p[idx[1]] and so on.
+// -	store_half, load_half:			convert width floats to/from IEEE half precision as pack_half/unpack_half do
+//									(see math/vector_utility.h) and store/load them.
+// -	dwidth, vdouble:				the number of lanes and the vector of doubles, dwidth is a multiple of 4.
+// -	broadcast_double, load, store:	as above for vdouble.
+// -	store_float:					converts a vdouble to float and stores dwidth floats.
+// -	-, *, mul_add, splat4<i> (vdouble)
+
+// ----- helpers -----
+
+// Loads width float2 values and splits them into the vectors of their components.
+inline void load_soa(const float2* p, vfloat& x, vfloat& y) noexcept
+{
+	const float* f = &p->x;
+	const vfloat a = load_lanes(f, 8);		// x0 y0 x1 y1
+	const vfloat b = load_lanes(f + 4, 8);	// x2 y2 x3 y3
+
+	x = shuffle<0, 2, 0, 2>(a, b);
+	y = shuffle<1, 3, 1, 3>(a, b);
+}
+
+// Loads width float3 values and splits them into the vectors of their components.
+inline void load_soa(const float3* p, vfloat& x, vfloat& y, vfloat& z) noexcept
+{
+	const float* f = &p->x;
+	const vfloat m03 = load_lanes(f, 12);		// x0 y0 z0 x1
+	const vfloat m14 = load_lanes(f + 4, 12);	// y1 z1 x2 y2
+	const vfloat m25 = load_lanes(f + 8, 12);	// z2 x3 y3 z3
+
+	const vfloat xy = shuffle<2, 3, 1, 2>(m14, m25);	// x2 y2 x3 y3
+	const vfloat yz = shuffle<1, 2, 0, 1>(m03, m14);	// y0 z0 y1 z1
+	x = shuffle<0, 3, 0, 2>(m03, xy);
+	y = shuffle<0, 2, 1, 3>(yz, xy);
+	z = shuffle<1, 3, 0, 3>(yz, m25);
+}
+
+// Stores the vectors of components as width consecutive float2 values.
+inline void store_soa(float2* p, vfloat x, vfloat y) noexcept
+{
+	float* f = &p->x;
+	store_lanes(f, 8, unpack_lo(x, y));
+	store_lanes(f + 4, 8, unpack_hi(x, y));
+}
+
+// Stores the vectors of components as width consecutive float3 values.
+inline void store_soa(float3* p, vfloat x, vfloat y, vfloat z) noexcept
+{
+	const vfloat xy = shuffle<0, 2, 0, 2>(x, y);	// x0 x2 y0 y2
+	const vfloat yz = shuffle<1, 3, 1, 3>(y, z);	// y1 y3 z1 z3
+	const vfloat zx = shuffle<0, 2, 1, 3>(z, x);	// z0 z2 x1 x3
+
+	float* f = &p->x;
+	store_lanes(f, 12, shuffle<0, 2, 0, 2>(xy, zx));
+	store_lanes(f + 4, 12, shuffle<0, 2, 1, 3>(yz, xy));
+	store_lanes(f + 8, 12, shuffle<1, 3, 1, 3>(zx, yz));
+}
+
+// Transposes every 4x4 block formed by the corresponding 4-lane groups of r0, r1, r2 and r3.
+inline void transpose4(vfloat& r0, vfloat& r1, vfloat& r2, vfloat& r3) noexcept
+{
+	const vfloat t0 = unpack_lo(r0, r1);	// x0 x1 y0 y1
+	const vfloat t1 = unpack_hi(r0, r1);	// z0 z1 w0 w1
+	const vfloat t2 = unpack_lo(r2, r3);	// x2 x3 y2 y3
+	const vfloat t3 = unpack_hi(r2, r3);	// z2 z3 w2 w3
+
+	r0 = shuffle<0, 1, 0, 1>(t0, t2);
+	r1 = shuffle<2, 3, 2, 3>(t0, t2);
+	r2 = shuffle<0, 1, 0, 1>(t1, t3);
+	r3 = shuffle<2, 3, 2, 3>(t1, t3);
+}
+
+// Loads width float4 values and splits them into the vectors of their components.
+inline void load_soa(const float4* p, vfloat& x, vfloat& y, vfloat& z, vfloat& w) noexcept
+{
+	const float* f = &p->x;
+	x = load_lanes(f, 16);
+	y = load_lanes(f + 4, 16);
+	z = load_lanes(f + 8, 16);
+	w = load_lanes(f + 12, 16);
+	transpose4(x, y, z, w);
+}
+
+// Stores the vectors of components as width consecutive float4 values.
+inline void store_soa(float4* p, vfloat x, vfloat y, vfloat z, vfloat w) noexcept
+{
+	transpose4(x, y, z, w);
+
+	float* f = &p->x;
+	store_lanes(f, 16, x);
+	store_lanes(f + 4, 16, y);
+	store_lanes(f + 8, 16, z);
+	store_lanes(f + 12, 16, w);
+}
+
+// Rounds halfway cases away from zero as std::round does.
+inline vfloat round(vfloat v) noexcept
+{
+	const vfloat t = trunc(v);
+	const vmask away = abs(v - t) >= broadcast(0.5f);
+	return t + select(away, copy_sign(broadcast(1.0f), v), broadcast(0.0f));
+}
+
+// Stores the first min(n, width) components of v.
+inline void store_first(float* p, vfloat v, size_t n) noexcept
+{
+	if (n >= width) {
+		store(p, v);
+		return;
+	}
+
+	float tmp[width];
+	store(tmp, v);
+	for (size_t i = 0; i < n; ++i) p[i] = tmp[i];
+}
+
+// Loads the first min(n, width) values of p, the rest of the lanes are zeros.
+inline vfloat load_first(const float* p, size_t n) noexcept
+{
+	if (n >= width) return load(p);
+
+	float tmp[width] = {};
+	for (size_t i = 0; i < n; ++i) tmp[i] = p[i];
+	return load(tmp);
+}
+
+// Returns the vector whose every 4-lane group equals to the i-th component of the group of v.
+template<int i>
+inline vfloat splat4(vfloat v) noexcept
+{
+	return shuffle<i, i, i, i>(v, v);
+}
+
+
+// ----- kernels -----
+
+void mul_float4x4_float4(const float4x4& m, const float4* v, float4* out, size_t count) noexcept
+{
+	const vfloat m00 = broadcast(m.m00), m01 = broadcast(m.m01), m02 = broadcast(m.m02), m03 = broadcast(m.m03);
+	const vfloat m10 = broadcast(m.m10), m11 = broadcast(m.m11), m12 = broadcast(m.m12), m13 = broadcast(m.m13);
+	const vfloat m20 = broadcast(m.m20), m21 = broadcast(m.m21), m22 = broadcast(m.m22), m23 = broadcast(m.m23);
+	const vfloat m30 = broadcast(m.m30), m31 = broadcast(m.m31), m32 = broadcast(m.m32), m33 = broadcast(m.m33);
+
+	size_t i = 0;
+	for (; i + width <= count; i += width) {
+		vfloat x, y, z, w;
+		load_soa(v + i, x, y, z, w);
+
+		store_soa(out + i,
+			mul_add(m03, w, mul_add(m02, z, mul_add(m01, y, m00 * x))),
+			mul_add(m13, w, mul_add(m12, z, mul_add(m11, y, m10 * x))),
+			mul_add(m23, w, mul_add(m22, z, mul_add(m21, y, m20 * x))),
+			mul_add(m33, w, mul_add(m32, z, mul_add(m31, y, m30 * x))));
+	}
+
+	scalar_kernels.mul_float4x4_float4(m, v + i, out + i, count - i);
+}
+
+void mul_float4x4_float4x4(const float4x4* l, const float4x4* r, float4x4* out, size_t count) noexcept
+{
+	for (size_t i = 0; i < count; ++i) {
+		// every 4-lane group of r* holds the same row of r.
+		const float* rp = &r[i].m00;
+		const vfloat r0 = load_lanes(rp, 0);
+		const vfloat r1 = load_lanes(rp + 4, 0);
+		const vfloat r2 = load_lanes(rp + 8, 0);
+		const vfloat r3 = load_lanes(rp + 12, 0);
+
+		// width / 4 rows of l are processed at once.
+		const float* lp = &l[i].m00;
+		float* op = &out[i].m00;
+		for (size_t k = 0; k < 16; k += width) {
+			const vfloat lm = load(lp + k);
+
+			vfloat res = splat4<0>(lm) * r0;
+			res = mul_add(splat4<1>(lm), r1, res);
+			res = mul_add(splat4<2>(lm), r2, res);
+			res = mul_add(splat4<3>(lm), r3, res);
+			store(op + k, res);
+		}
+	}
+}
+
+void fast_normalize_aos(const float* v, size_t n, float* out, size_t count) noexcept
+{
+	assert(2 <= n && n <= 4);
+
+	const vfloat zero = broadcast(0.0f);
+	const vfloat half = broadcast(0.5f);
+	const vfloat three_halves = broadcast(1.5f);
+
+	// rsqrt refined by one Newton-Raphson step as math::rsqrt does, zero vectors are multiplied by 0.
+	auto factor = [&](vfloat l2) {
+		const vfloat y = rsqrt(l2);
+		const vfloat r = y * (three_halves - (half * l2 * y) * y);
+		return select(l2 > zero, r, zero);
+	};
+
+	size_t i = 0;
+	if (n == 2) {
+		const float2* v2 = reinterpret_cast<const float2*>(v);
+		float2* out2 = reinterpret_cast<float2*>(out);
+		for (; i + width <= count; i += width) {
+			vfloat x, y;
+			load_soa(v2 + i, x, y);
+			const vfloat f = factor(mul_add(y, y, x * x));
+			store_soa(out2 + i, x * f, y * f);
+		}
+	}
+	else if (n == 3) {
+		const float3* v3 = reinterpret_cast<const float3*>(v);
+		float3* out3 = reinterpret_cast<float3*>(out);
+		for (; i + width <= count; i += width) {
+			vfloat x, y, z;
+			load_soa(v3 + i, x, y, z);
+			const vfloat f = factor(mul_add(z, z, mul_add(y, y, x * x)));
+			store_soa(out3 + i, x * f, y * f, z * f);
+		}
+	}
+	else {
+		const float4* v4 = reinterpret_cast<const float4*>(v);
+		float4* out4 = reinterpret_cast<float4*>(out);
+		for (; i + width <= count; i += width) {
+			vfloat x, y, z, w;
+			load_soa(v4 + i, x, y, z, w);
+			const vfloat f = factor(mul_add(w, w, mul_add(z, z, mul_add(y, y, x * x))));
+			store_soa(out4 + i, x * f, y * f, z * f, w * f);
+		}
+	}
+
+	scalar_kernels.fast_normalize_aos(v + i * n, n, out + i * n, count - i);
+}
+
+void normalize_float3(const float3* v, float3* out, size_t count) noexcept
+{
+	const vfloat zero = broadcast(0.0f);
+	const vfloat one = broadcast(1.0f);
+	const vfloat eps = broadcast(1e-5f);
+
+	size_t i = 0;
+	for (; i + width <= count; i += width) {
+		vfloat x, y, z;
+		load_soa(v + i, x, y, z);
+
+		// as normalize(float3) does, zero and unit vectors are returned unchanged.
+		const vfloat l2 = mul_add(z, z, mul_add(y, y, x * x));
+		const vmask keep = (abs(l2 - zero) <= eps) | (abs(l2 - one) <= eps);
+		const vfloat factor = select(keep, one, one / sqrt(l2));
+		store_soa(out + i, x * factor, y * factor, z * factor);
+	}
+
+	scalar_kernels.normalize_float3(v + i, out + i, count - i);
+}
+
+void normalize_float4(const float4* v, float4* out, size_t count) noexcept
+{
+	const vfloat zero = broadcast(0.0f);
+	const vfloat one = broadcast(1.0f);
+	const vfloat eps = broadcast(1e-5f);
+
+	size_t i = 0;
+	for (; i + width <= count; i += width) {
+		vfloat x, y, z, w;
+		load_soa(v + i, x, y, z, w);
+
+		// as normalize(float4) does, zero and unit vectors are returned unchanged.
+		const vfloat l2 = mul_add(w, w, mul_add(z, z, mul_add(y, y, x * x)));
+		const vmask keep = (abs(l2 - zero) <= eps) | (abs(l2 - one) <= eps);
+		const vfloat factor = select(keep, one, one / sqrt(l2));
+		store_soa(out + i, x * factor, y * factor, z * factor, w * factor);
+	}
+
+	scalar_kernels.normalize_float4(v + i, out + i, count - i);
+}
+
+void nlerp_quat(const quat* q, const quat* r, const float* factor, quat* out, size_t count) noexcept
+{
+	const vfloat zero = broadcast(0.0f);
+	const vfloat one = broadcast(1.0f);
+	const vfloat eps = broadcast(1e-5f);
+
+	size_t i = 0;
+	for (; i + width <= count; i += width) {
+		vfloat qx, qy, qz, qa, rx, ry, rz, ra;
+		load_soa(reinterpret_cast<const float4*>(q + i), qx, qy, qz, qa);
+		load_soa(reinterpret_cast<const float4*>(r + i), rx, ry, rz, ra);
+		const vfloat t = load(factor + i);
+
+		const vfloat cos_omega = mul_add(qa, ra, mul_add(qz, rz, mul_add(qy, ry, qx * rx)));
+		const vfloat f0 = one - t;
+		const vfloat f1 = select(cos_omega < zero, zero - t, t);
+		const vfloat x = mul_add(f1, rx, f0 * qx);
+		const vfloat y = mul_add(f1, ry, f0 * qy);
+		const vfloat z = mul_add(f1, rz, f0 * qz);
+		const vfloat a = mul_add(f1, ra, f0 * qa);
+
+		// as normalize(quat) does, unit quaternions are returned unchanged.
+		const vfloat l2 = mul_add(a, a, mul_add(z, z, mul_add(y, y, x * x)));
+		const vmask keep = (abs(l2 - zero) <= eps) | (abs(l2 - one) <= eps);
+		const vfloat s = select(keep, one, one / sqrt(l2));
+		store_soa(reinterpret_cast<float4*>(out + i), x * s, y * s, z * s, a * s);
+	}
+
+	scalar_kernels.nlerp_quat(q + i, r + i, factor + i, out + i, count - i);
+}
+
+void slerp_fast_quat(const quat* q, const quat* r, const float* factor, quat* out, size_t count) noexcept
+{
+	vfloat u[slerp_fast_terms], v[slerp_fast_terms];
+	for (size_t k = 0; k < slerp_fast_terms; ++k) {
+		u[k] = broadcast(slerp_fast_u[k]);
+		v[k] = broadcast(slerp_fast_v[k]);
+	}
+
+	const vfloat zero = broadcast(0.0f);
+	const vfloat one = broadcast(1.0f);
+
+	size_t i = 0;
+	for (; i + width <= count; i += width) {
+		vfloat qx, qy, qz, qa, rx, ry, rz, ra;
+		load_soa(reinterpret_cast<const float4*>(q + i), qx, qy, qz, qa);
+		load_soa(reinterpret_cast<const float4*>(r + i), rx, ry, rz, ra);
+		const vfloat t = load(factor + i);
+
+		const vfloat dot = mul_add(qa, ra, mul_add(qz, rz, mul_add(qy, ry, qx * rx)));
+		const vfloat sign = select(dot < zero, zero - one, one);
+		const vfloat cos_omega_m1 = sign * dot - one;
+
+		const vfloat d = one - t;
+		const vfloat t2 = t * t;
+		const vfloat d2 = d * d;
+
+		vfloat ct = one;
+		vfloat cd = one;
+		for (size_t k = slerp_fast_terms; k-- > 0;) {
+			ct = mul_add((u[k] * t2 - v[k]) * cos_omega_m1, ct, one);
+			cd = mul_add((u[k] * d2 - v[k]) * cos_omega_m1, cd, one);
+		}
+
+		const vfloat f0 = d * cd;
+		const vfloat f1 = sign * t * ct;
+		store_soa(reinterpret_cast<float4*>(out + i), mul_add(f1, rx, f0 * qx), mul_add(f1, ry, f0 * qy),
+			mul_add(f1, rz, f0 * qz), mul_add(f1, ra, f0 * qa));
+	}
+
+	scalar_kernels.slerp_fast_quat(q + i, r + i, factor + i, out + i, count - i);
+}
+
+// The pack kernels produce exactly the same bits as their scalar counterparts from vector_utility.h.
+
+void pack_snorm_10_10_10_2(const float4* v, uint32_t* out, size_t count) noexcept
+{
+	const vfloat lo = broadcast(-1.0f);
+	const vfloat hi = broadcast(1.0f);
+	const vfloat s = broadcast(511.0f);
+	const vint mask = broadcast_int(0x3ff);
+
+	size_t i = 0;
+	for (; i + width <= count; i += width) {
+		vfloat x, y, z, w;
+		load_soa(v + i, x, y, z, w);
+
+		const vint xi = to_int(round(min(max(x, lo), hi) * s));
+		const vint yi = to_int(round(min(max(y, lo), hi) * s));
+		const vint zi = to_int(round(min(max(z, lo), hi) * s));
+		const vint wi = to_int(round(min(max(w, lo), hi)));
+		store(out + i, (xi & mask) | shift_left<10>(yi & mask) | shift_left<20>(zi & mask) | shift_left<30>(wi));
+	}
+
+	scalar_kernels.pack_snorm_10_10_10_2(v + i, out + i, count - i);
+}
+
+void pack_unorm_10_10_10_2(const float4* v, uint32_t* out, size_t count) noexcept
+{
+	const vfloat lo = broadcast(0.0f);
+	const vfloat hi = broadcast(1.0f);
+	const vfloat s = broadcast(1023.0f);
+	const vfloat sw = broadcast(3.0f);
+
+	size_t i = 0;
+	for (; i + width <= count; i += width) {
+		vfloat x, y, z, w;
+		load_soa(v + i, x, y, z, w);
+
+		const vint xi = to_int(round(min(max(x, lo), hi) * s));
+		const vint yi = to_int(round(min(max(y, lo), hi) * s));
+		const vint zi = to_int(round(min(max(z, lo), hi) * s));
+		const vint wi = to_int(round(min(max(w, lo), hi) * sw));
+		store(out + i, xi | shift_left<10>(yi) | shift_left<20>(zi) | shift_left<30>(wi));
+	}
+
+	scalar_kernels.pack_unorm_10_10_10_2(v + i, out + i, count - i);
+}
+
+void pack_unorm_16_16(const float2* v, uint32_t* out, size_t count) noexcept
+{
+	const vfloat s = broadcast(65535.0f);
+
+	size_t i = 0;
+	for (; i + width <= count; i += width) {
+		vfloat x, y;
+		load_soa(v + i, x, y);
+
+		store(out + i, shift_left<16>(to_int(x * s)) | to_int(y * s));
+	}
+
+	scalar_kernels.pack_unorm_16_16(v + i, out + i, count - i);
+}
+
+void pack_unorm_8_8_8(const float3* v, uint32_t* out, size_t count) noexcept
+{
+	const vfloat s = broadcast(255.0f);
+
+	size_t i = 0;
+	for (; i + width <= count; i += width) {
+		vfloat x, y, z;
+		load_soa(v + i, x, y, z);
+
+		store(out + i, shift_left<16>(to_int(x * s)) | shift_left<8>(to_int(y * s)) | to_int(z * s));
+	}
+
+	scalar_kernels.pack_unorm_8_8_8(v + i, out + i, count - i);
+}
+
+void pack_unorm_8_8_8_8(const float4* v, uint32_t* out, size_t count) noexcept
+{
+	const vfloat s = broadcast(255.0f);
+
+	size_t i = 0;
+	for (; i + width <= count; i += width) {
+		vfloat x, y, z, w;
+		load_soa(v + i, x, y, z, w);
+
+		store(out + i, shift_left<24>(to_int(x * s)) | shift_left<16>(to_int(y * s))
+			| shift_left<8>(to_int(z * s)) | to_int(w * s));
+	}
+
+	scalar_kernels.pack_unorm_8_8_8_8(v + i, out + i, count - i);
+}
+
+// Converts the n-bit two's complement values u (the higher bits are zero) to float, half_range = 2^(n - 1).
+inline vfloat sign_extend(vint u, float half_range) noexcept
+{
+	const vfloat f = to_float(u);
+	return select(f >= broadcast(half_range), f - broadcast(2.0f * half_range), f);
+}
+
+// The unpack kernels multiply and divide as their scalar counterparts do, so the results are the same.
+
+void unpack_snorm_10_10_10_2(const uint32_t* p, float4* out, size_t count) noexcept
+{
+	const vint mask = broadcast_int(0x3ff);
+	const vfloat s = broadcast(1.0f / 511.0f);
+
+	size_t i = 0;
+	for (; i + width <= count; i += width) {
+		const vint v = load(p + i);
+		store_soa(out + i,
+			sign_extend(v & mask, 512.0f) * s,
+			sign_extend(shift_right<10>(v) & mask, 512.0f) * s,
+			sign_extend(shift_right<20>(v) & mask, 512.0f) * s,
+			sign_extend(shift_right<30>(v), 2.0f));
+	}
+
+	scalar_kernels.unpack_snorm_10_10_10_2(p + i, out + i, count - i);
+}
+
+void unpack_unorm_10_10_10_2(const uint32_t* p, float4* out, size_t count) noexcept
+{
+	const vint mask = broadcast_int(0x3ff);
+	const vfloat s = broadcast(1.0f / 1023.0f);
+	const vfloat sw = broadcast(1.0f / 3.0f);
+
+	size_t i = 0;
+	for (; i + width <= count; i += width) {
+		const vint v = load(p + i);
+		store_soa(out + i,
+			to_float(v & mask) * s,
+			to_float(shift_right<10>(v) & mask) * s,
+			to_float(shift_right<20>(v) & mask) * s,
+			to_float(shift_right<30>(v)) * sw);
+	}
+
+	scalar_kernels.unpack_unorm_10_10_10_2(p + i, out + i, count - i);
+}
+
+void unpack_unorm_16_16(const uint32_t* p, float2* out, size_t count) noexcept
+{
+	const vint mask = broadcast_int(0xffff);
+	const vfloat s = broadcast(65535.0f);
+
+	size_t i = 0;
+	for (; i + width <= count; i += width) {
+		const vint v = load(p + i);
+		store_soa(out + i, to_float(shift_right<16>(v)) / s, to_float(v & mask) / s);
+	}
+
+	scalar_kernels.unpack_unorm_16_16(p + i, out + i, count - i);
+}
+
+void unpack_unorm_8_8_8(const uint32_t* p, float3* out, size_t count) noexcept
+{
+	const vint mask = broadcast_int(0xff);
+	const vfloat s = broadcast(255.0f);
+
+	size_t i = 0;
+	for (; i + width <= count; i += width) {
+		const vint v = load(p + i);
+		store_soa(out + i, to_float(shift_right<16>(v) & mask) / s, to_float(shift_right<8>(v) & mask) / s,
+			to_float(v & mask) / s);
+	}
+
+	scalar_kernels.unpack_unorm_8_8_8(p + i, out + i, count - i);
+}
+
+void unpack_unorm_8_8_8_8(const uint32_t* p, float4* out, size_t count) noexcept
+{
+	const vint mask = broadcast_int(0xff);
+	const vfloat s = broadcast(255.0f);
+
+	size_t i = 0;
+	for (; i + width <= count; i += width) {
+		const vint v = load(p + i);
+		store_soa(out + i, to_float(shift_right<24>(v)) / s, to_float(shift_right<16>(v) & mask) / s,
+			to_float(shift_right<8>(v) & mask) / s, to_float(v & mask) / s);
+	}
+
+	scalar_kernels.unpack_unorm_8_8_8_8(p + i, out + i, count - i);
+}
+
+// Computes the octahedral encoding (ex, ey) of the vectors (x, y, z) as encode_octahedral does.
+inline void encode_octahedral_block(vfloat x, vfloat y, vfloat z, vfloat& ex, vfloat& ey) noexcept
+{
+	const vfloat one = broadcast(1.0f);
+	const vfloat inv_l1 = one / ((abs(x) + abs(y)) + abs(z));
+	const vfloat px = x * inv_l1;
+	const vfloat py = y * inv_l1;
+
+	const vmask lower = z < broadcast(0.0f);
+	ex = select(lower, copy_sign(one - abs(py), px), px);
+	ey = select(lower, copy_sign(one - abs(px), py), py);
+}
+
+// Computes the unit vectors (x, y, z) of the octahedral encoding (ex, ey) as decode_octahedral does.
+inline void decode_octahedral_block(vfloat ex, vfloat ey, vfloat& x, vfloat& y, vfloat& z) noexcept
+{
+	const vfloat zero = broadcast(0.0f);
+	const vfloat one = broadcast(1.0f);
+	z = (one - abs(ex)) - abs(ey);
+
+	const vfloat t = max(zero - z, zero);
+	x = ex + select(ex >= zero, zero - t, t);
+	y = ey + select(ey >= zero, zero - t, t);
+
+	const vfloat inv_len = one / sqrt(mul_add(x, x, mul_add(y, y, z * z)));
+	x = x * inv_len;
+	y = y * inv_len;
+	z = z * inv_len;
+}
+
+void encode_octahedral(const float3* n, float2* out, size_t count) noexcept
+{
+	size_t i = 0;
+	for (; i + width <= count; i += width) {
+		vfloat x, y, z, ex, ey;
+		load_soa(n + i, x, y, z);
+		encode_octahedral_block(x, y, z, ex, ey);
+		store_soa(out + i, ex, ey);
+	}
+
+	scalar_kernels.encode_octahedral(n + i, out + i, count - i);
+}
+
+void decode_octahedral(const float2* e, float3* out, size_t count) noexcept
+{
+	size_t i = 0;
+	for (; i + width <= count; i += width) {
+		vfloat ex, ey, x, y, z;
+		load_soa(e + i, ex, ey);
+		decode_octahedral_block(ex, ey, x, y, z);
+		store_soa(out + i, x, y, z);
+	}
+
+	scalar_kernels.decode_octahedral(e + i, out + i, count - i);
+}
+
+void pack_octahedral_snorm_16_16(const float3* n, uint32_t* out, size_t count) noexcept
+{
+	const vfloat s = broadcast(32767.0f);
+	const vint mask = broadcast_int(0xffff);
+
+	size_t i = 0;
+	for (; i + width <= count; i += width) {
+		vfloat x, y, z, ex, ey;
+		load_soa(n + i, x, y, z);
+		encode_octahedral_block(x, y, z, ex, ey);
+		store(out + i, shift_left<16>(to_int(round(ex * s))) | (to_int(round(ey * s)) & mask));
+	}
+
+	scalar_kernels.pack_octahedral_snorm_16_16(n + i, out + i, count - i);
+}
+
+void unpack_octahedral_snorm_16_16(const uint32_t* p, float3* out, size_t count) noexcept
+{
+	const vfloat s = broadcast(32767.0f);
+	const vfloat lo = broadcast(-1.0f);
+	const vint mask = broadcast_int(0xffff);
+
+	size_t i = 0;
+	for (; i + width <= count; i += width) {
+		const vint v = load(p + i);
+		const vfloat ex = max(sign_extend(shift_right<16>(v), 32768.0f) / s, lo);
+		const vfloat ey = max(sign_extend(v & mask, 32768.0f) / s, lo);
+
+		vfloat x, y, z;
+		decode_octahedral_block(ex, ey, x, y, z);
+		store_soa(out + i, x, y, z);
+	}
+
+	scalar_kernels.unpack_octahedral_snorm_16_16(p + i, out + i, count - i);
+}
+
+void pack_octahedral_unorm_8_8(const float3* n, uint16_t* out, size_t count) noexcept
+{
+	const vfloat one = broadcast(1.0f);
+	const vfloat s = broadcast(127.5f);
+
+	size_t i = 0;
+	for (; i + width <= count; i += width) {
+		vfloat x, y, z, ex, ey;
+		load_soa(n + i, x, y, z);
+		encode_octahedral_block(x, y, z, ex, ey);
+
+		uint32_t packed[width];
+		store(packed, shift_left<8>(to_int(round((ex + one) * s))) | to_int(round((ey + one) * s)));
+		for (size_t j = 0; j < width; ++j)
+			out[i + j] = uint16_t(packed[j]);
+	}
+
+	scalar_kernels.pack_octahedral_unorm_8_8(n + i, out + i, count - i);
+}
+
+void unpack_octahedral_unorm_8_8(const uint16_t* p, float3* out, size_t count) noexcept
+{
+	const vfloat one = broadcast(1.0f);
+	const vfloat s = broadcast(127.5f);
+	const vint mask = broadcast_int(0xff);
+
+	size_t i = 0;
+	for (; i + width <= count; i += width) {
+		uint32_t packed[width];
+		for (size_t j = 0; j < width; ++j)
+			packed[j] = p[i + j];
+
+		const vint v = load(packed);
+		const vfloat ex = to_float(shift_right<8>(v)) / s - one;
+		const vfloat ey = to_float(v & mask) / s - one;
+
+		vfloat x, y, z;
+		decode_octahedral_block(ex, ey, x, y, z);
+		store_soa(out + i, x, y, z);
+	}
+
+	scalar_kernels.unpack_octahedral_unorm_8_8(p + i, out + i, count - i);
+}
+
+// The smallest three kernels select the components in registers, the fields whose shifts depend on bits
+// are combined with the integer instructions of the scalar code.
+
+void pack_smallest_three(const quat* q, uint32_t bits, void* out, size_t out_size, size_t count) noexcept
+{
+	const float q_max = float((1u << (bits - 1)) - 1);
+	const vfloat zero = broadcast(0.0f);
+	const vfloat hi = broadcast(q_max);
+	const vfloat lo = broadcast(-q_max);
+	const vfloat s = broadcast(q_max * 1.41421356f);
+
+	size_t i = 0;
+	for (; i + width <= count; i += width) {
+		vfloat x, y, z, a;
+		load_soa(reinterpret_cast<const float4*>(q + i), x, y, z, a);
+
+		// m is the index of the largest component, the first one of the equal ones.
+		vfloat largest = x;
+		vfloat m = zero;
+		const vmask gt_y = abs(y) > abs(largest);
+		largest = select(gt_y, y, largest);
+		m = select(gt_y, broadcast(1.0f), m);
+		const vmask gt_z = abs(z) > abs(largest);
+		largest = select(gt_z, z, largest);
+		m = select(gt_z, broadcast(2.0f), m);
+		const vmask gt_a = abs(a) > abs(largest);
+		largest = select(gt_a, a, largest);
+		m = select(gt_a, broadcast(3.0f), m);
+
+		// the components except the m-th one.
+		const vfloat c0 = select(m > broadcast(0.5f), x, y);
+		const vfloat c1 = select(m > broadcast(1.5f), y, z);
+		const vfloat c2 = select(m > broadcast(2.5f), z, a);
+
+		const vfloat sm = select(largest < zero, zero - s, s);
+		uint32_t fields[4][width];
+		store(fields[0], to_int(m));
+		store(fields[1], to_int(round(min(max(c0 * sm, lo), hi)) + hi));
+		store(fields[2], to_int(round(min(max(c1 * sm, lo), hi)) + hi));
+		store(fields[3], to_int(round(min(max(c2 * sm, lo), hi)) + hi));
+
+		if (out_size == sizeof(uint32_t)) {
+			uint32_t* o = static_cast<uint32_t*>(out) + i;
+			for (size_t j = 0; j < width; ++j) {
+				o[j] = (fields[0][j] << (3 * bits)) | (fields[1][j] << (2 * bits))
+					| (fields[2][j] << bits) | fields[3][j];
+			}
+		}
+		else {
+			uint64_t* o = static_cast<uint64_t*>(out) + i;
+			for (size_t j = 0; j < width; ++j) {
+				o[j] = (uint64_t(fields[0][j]) << (3 * bits)) | (uint64_t(fields[1][j]) << (2 * bits))
+					| (uint64_t(fields[2][j]) << bits) | fields[3][j];
+			}
+		}
+	}
+
+	scalar_kernels.pack_smallest_three(q + i, bits, static_cast<uint8_t*>(out) + i * out_size, out_size, count - i);
+}
+
+void unpack_smallest_three(const void* p, size_t p_size, uint32_t bits, quat* out, size_t count) noexcept
+{
+	const float q_max = float((1u << (bits - 1)) - 1);
+	const uint64_t mask = (uint64_t(1) << bits) - 1;
+	const vfloat zero = broadcast(0.0f);
+	const vfloat one = broadcast(1.0f);
+	const vfloat eps = broadcast(1e-5f);
+	const vfloat hi = broadcast(q_max);
+	const vfloat inv_s = broadcast(1.0f / (q_max * 1.41421356f));
+
+	size_t i = 0;
+	for (; i + width <= count; i += width) {
+		uint32_t fields[4][width];
+		for (size_t j = 0; j < width; ++j) {
+			const uint64_t v = (p_size == sizeof(uint32_t))
+				? static_cast<const uint32_t*>(p)[i + j]
+				: static_cast<const uint64_t*>(p)[i + j];
+			fields[0][j] = uint32_t(v >> (3 * bits)) & 3;
+			fields[1][j] = uint32_t((v >> (2 * bits)) & mask);
+			fields[2][j] = uint32_t((v >> bits) & mask);
+			fields[3][j] = uint32_t(v & mask);
+		}
+
+		const vfloat m = to_float(load(fields[0]));
+		const vfloat c0 = (to_float(load(fields[1])) - hi) * inv_s;
+		const vfloat c1 = (to_float(load(fields[2])) - hi) * inv_s;
+		const vfloat c2 = (to_float(load(fields[3])) - hi) * inv_s;
+		const vfloat l = sqrt(max(one - mul_add(c2, c2, mul_add(c1, c1, c0 * c0)), zero));
+
+		// puts the largest component l at the m-th place.
+		const vmask m_ge1 = m > broadcast(0.5f);
+		const vmask m_ge2 = m > broadcast(1.5f);
+		const vmask m_ge3 = m > broadcast(2.5f);
+		const vfloat x = select(m_ge1, c0, l);
+		const vfloat y = select(m_ge2, c1, select(m_ge1, l, c0));
+		const vfloat z = select(m_ge3, c2, select(m_ge2, l, c1));
+		const vfloat a = select(m_ge3, l, c2);
+
+		// as normalize(quat) does, unit quaternions are returned unchanged.
+		const vfloat l2 = mul_add(a, a, mul_add(z, z, mul_add(y, y, x * x)));
+		const vmask keep = (abs(l2 - zero) <= eps) | (abs(l2 - one) <= eps);
+		const vfloat f = select(keep, one, one / sqrt(l2));
+		store_soa(reinterpret_cast<float4*>(out + i), x * f, y * f, z * f, a * f);
+	}
+
+	scalar_kernels.unpack_smallest_three(static_cast<const uint8_t*>(p) + i * p_size, p_size, bits, out + i, count - i);
+}
+
+void pack_half(const float* v, uint16_t* out, size_t count) noexcept
+{
+	size_t i = 0;
+	for (; i + width <= count; i += width)
+		store_half(out + i, load(v + i));
+
+	scalar_kernels.pack_half(v + i, out + i, count - i);
+}
+
+void unpack_half(const uint16_t* v, float* out, size_t count) noexcept
+{
+	size_t i = 0;
+	for (; i + width <= count; i += width)
+		store(out + i, load_half(v + i));
+
+	scalar_kernels.unpack_half(v + i, out + i, count - i);
+}
+
+// SoA kernels. Component arrays are padded (see kernel_table), so they are processed by whole registers.
+
+void aos_to_soa(const float* v, size_t n, float* const* out, size_t count) noexcept
+{
+	size_t i = 0;
+	if (n == 3) {
+		const float3* v3 = reinterpret_cast<const float3*>(v);
+		for (; i + width <= count; i += width) {
+			vfloat x, y, z;
+			load_soa(v3 + i, x, y, z);
+			store(out[0] + i, x);
+			store(out[1] + i, y);
+			store(out[2] + i, z);
+		}
+	}
+	else {
+		const float4* v4 = reinterpret_cast<const float4*>(v);
+		for (; i + width <= count; i += width) {
+			vfloat x, y, z, w;
+			load_soa(v4 + i, x, y, z, w);
+			store(out[0] + i, x);
+			store(out[1] + i, y);
+			store(out[2] + i, z);
+			store(out[3] + i, w);
+		}
+	}
+
+	for (; i < count; ++i) {
+		for (size_t c = 0; c < n; ++c)
+			out[c][i] = v[i * n + c];
+	}
+}
+
+void soa_to_aos(const float* const* v, size_t n, float* out, size_t count) noexcept
+{
+	size_t i = 0;
+	if (n == 3) {
+		float3* out3 = reinterpret_cast<float3*>(out);
+		for (; i + width <= count; i += width)
+			store_soa(out3 + i, load(v[0] + i), load(v[1] + i), load(v[2] + i));
+	}
+	else {
+		float4* out4 = reinterpret_cast<float4*>(out);
+		for (; i + width <= count; i += width)
+			store_soa(out4 + i, load(v[0] + i), load(v[1] + i), load(v[2] + i), load(v[3] + i));
+	}
+
+	for (; i < count; ++i) {
+		for (size_t c = 0; c < n; ++c)
+			out[i * n + c] = v[c][i];
+	}
+}
+
+void clamp_soa(const float* v, float lo, float hi, float* out, size_t count) noexcept
+{
+	const vfloat vlo = broadcast(lo);
+	const vfloat vhi = broadcast(hi);
+
+	for (size_t i = 0; i < count; i += width)
+		store(out + i, min(max(load(v + i), vlo), vhi));
+}
+
+void cross_soa(const float* const* l, const float* const* r, float* const* out, size_t count) noexcept
+{
+	for (size_t i = 0; i < count; i += width) {
+		const vfloat lx = load(l[0] + i), ly = load(l[1] + i), lz = load(l[2] + i);
+		const vfloat rx = load(r[0] + i), ry = load(r[1] + i), rz = load(r[2] + i);
+
+		store(out[0] + i, (ly * rz) - (lz * ry));
+		store(out[1] + i, (lz * rx) - (lx * rz));
+		store(out[2] + i, (lx * ry) - (ly * rx));
+	}
+}
+
+// Returns the dot products of the width elements starting at i.
+inline vfloat dot_block(const float* const* l, const float* const* r, size_t n, size_t i) noexcept
+{
+	vfloat d = load(l[0] + i) * load(r[0] + i);
+	for (size_t c = 1; c < n; ++c)
+		d = mul_add(load(l[c] + i), load(r[c] + i), d);
+
+	return d;
+}
+
+void dot_soa(const float* const* l, const float* const* r, size_t n, float* out, size_t count) noexcept
+{
+	for (size_t i = 0; i < count; i += width)
+		store_first(out + i, dot_block(l, r, n, i), count - i);
+}
+
+void len_soa(const float* const* v, size_t n, float* out, size_t count) noexcept
+{
+	for (size_t i = 0; i < count; i += width)
+		store_first(out + i, sqrt(dot_block(v, v, n, i)), count - i);
+}
+
+void lerp_soa(const float* l, const float* r, float factor, float* out, size_t count) noexcept
+{
+	const vfloat f = broadcast(factor);
+
+	for (size_t i = 0; i < count; i += width) {
+		const vfloat lv = load(l + i);
+		store(out + i, mul_add(f, load(r + i) - lv, lv));
+	}
+}
+
+void normalize_soa(const float* const* v, size_t n, float* const* out, size_t count) noexcept
+{
+	const vfloat zero = broadcast(0.0f);
+	const vfloat one = broadcast(1.0f);
+	const vfloat eps = broadcast(1e-5f);
+
+	for (size_t i = 0; i < count; i += width) {
+		// as normalize(float3) and normalize(float4) do, zero and unit vectors are left unchanged.
+		const vfloat l2 = dot_block(v, v, n, i);
+		const vmask keep = (abs(l2 - zero) <= eps) | (abs(l2 - one) <= eps);
+		const vfloat factor = select(keep, one, one / sqrt(l2));
+
+		for (size_t c = 0; c < n; ++c)
+			store(out[c] + i, load(v[c] + i) * factor);
+	}
+}
+
+// Clears the bits of the last visible value which do not correspond to any of count elements.
+inline void clear_tail_bits(uint32_t* visible, size_t count) noexcept
+{
+	if (count % 32 != 0)
+		visible[count / 32] &= (uint32_t(1) << (count % 32)) - 1;
+}
+
+void intersects_spheres_soa(const frustum& f, const float* const* spheres, uint32_t* visible, size_t count) noexcept
+{
+	vfloat nx[6], ny[6], nz[6], nd[6];
+	for (size_t k = 0; k < 6; ++k) {
+		nx[k] = broadcast(f.planes[k].normal.x);
+		ny[k] = broadcast(f.planes[k].normal.y);
+		nz[k] = broadcast(f.planes[k].normal.z);
+		nd[k] = broadcast(f.planes[k].distance);
+	}
+
+	std::memset(visible, 0, ((count + 31) / 32) * sizeof(uint32_t));
+
+	// width divides 32, so a block never crosses a visible value.
+	const vfloat zero = broadcast(0.0f);
+	for (size_t i = 0; i < count; i += width) {
+		const vfloat x = load(spheres[0] + i);
+		const vfloat y = load(spheres[1] + i);
+		const vfloat z = load(spheres[2] + i);
+		const vfloat neg_r = zero - load(spheres[3] + i);
+
+		vmask inside = mul_add(nz[0], z, mul_add(ny[0], y, mul_add(nx[0], x, nd[0]))) >= neg_r;
+		for (size_t k = 1; k < 6; ++k)
+			inside = inside & (mul_add(nz[k], z, mul_add(ny[k], y, mul_add(nx[k], x, nd[k]))) >= neg_r);
+
+		visible[i / 32] |= to_bits(inside) << (i % 32);
+	}
+
+	clear_tail_bits(visible, count);
+}
+
+void intersects_aabbs_soa(const frustum& f, const float* const* lo, const float* const* hi,
+	uint32_t* visible, size_t count) noexcept
+{
+	vfloat nx[6], ny[6], nz[6], nd[6];
+	for (size_t k = 0; k < 6; ++k) {
+		nx[k] = broadcast(f.planes[k].normal.x);
+		ny[k] = broadcast(f.planes[k].normal.y);
+		nz[k] = broadcast(f.planes[k].normal.z);
+		nd[k] = broadcast(f.planes[k].distance);
+	}
+
+	std::memset(visible, 0, ((count + 31) / 32) * sizeof(uint32_t));
+
+	const vfloat zero = broadcast(0.0f);
+	for (size_t i = 0; i < count; i += width) {
+		const vfloat x0 = load(lo[0] + i), y0 = load(lo[1] + i), z0 = load(lo[2] + i);
+		const vfloat x1 = load(hi[0] + i), y1 = load(hi[1] + i), z1 = load(hi[2] + i);
+
+		// as intersects(f, min, max) does, max(n * lo, n * hi) picks the box corner farthest along the normal.
+		// The box is visible if the smallest of the corner distances is not negative.
+		vfloat d = broadcast(std::numeric_limits<float>::max());
+		for (size_t k = 0; k < 6; ++k) {
+			d = min(d, max(nx[k] * x0, nx[k] * x1) + max(ny[k] * y0, ny[k] * y1)
+				+ max(nz[k] * z0, nz[k] * z1) + nd[k]);
+		}
+
+		visible[i / 32] |= to_bits(d >= zero) << (i % 32);
+	}
+
+	clear_tail_bits(visible, count);
+}
+
+void sincos(const float* angles, float* s, float* c, size_t count, bool fast) noexcept
+{
+	const vfloat two_pi = broadcast(sincos_2_pi);
+	const vfloat pi_2_0 = broadcast(sincos_pi_2[0]);
+	const vfloat pi_2_1 = broadcast(sincos_pi_2[1]);
+	const vfloat pi_2_2 = broadcast(sincos_pi_2[2]);
+	const vfloat zero = broadcast(0.0f);
+	const vfloat half = broadcast(0.5f);
+	const vfloat one = broadcast(1.0f);
+	const vint bit0 = broadcast_int(1);
+	const vint bit1 = broadcast_int(2);
+	const vint three = broadcast_int(3);
+
+	// see sincos_poly
+	size_t i = 0;
+	for (; i + width <= count; i += width) {
+		const vfloat a = load(angles + i);
+		const vfloat j = round(a * two_pi);
+		const vfloat r = ((a - j * pi_2_0) - j * pi_2_1) - j * pi_2_2;
+		const vfloat r2 = r * r;
+
+		vfloat ps, pc;
+		if (fast) {
+			ps = mul_add(r * r2, mul_add(r2, broadcast(sincos_sin_fast[1]), broadcast(sincos_sin_fast[0])), r);
+			pc = mul_add(r2, mul_add(r2, broadcast(sincos_cos_fast[1]), broadcast(sincos_cos_fast[0])), one);
+		}
+		else {
+			ps = mul_add(r2, broadcast(sincos_sin_full[2]), broadcast(sincos_sin_full[1]));
+			ps = mul_add(r * r2, mul_add(r2, ps, broadcast(sincos_sin_full[0])), r);
+			pc = mul_add(r2, broadcast(sincos_cos_full[3]), broadcast(sincos_cos_full[2]));
+			pc = mul_add(r2, pc, broadcast(sincos_cos_full[1]));
+			pc = mul_add(r2, mul_add(r2, pc, broadcast(sincos_cos_full[0])), one);
+		}
+
+		// the quadrant j mod 4, two's complement keeps it right for negative j. A j out of the range of int
+		// converts to INT_MIN, whose quadrant 0 is right: such j are multiples of 4. NaN angles give NaN r.
+		const vint q = to_int(j);
+		const vmask swap = to_float(q & bit0) > half;
+		const vmask neg_s = to_float(q & bit1) > half;
+		const vfloat q3 = to_float(q & three);
+		const vmask neg_c = (q3 > half) & (q3 < broadcast(2.5f));
+
+		const vfloat sv = select(swap, pc, ps);
+		const vfloat cv = select(swap, ps, pc);
+		store(s + i, select(neg_s, zero - sv, sv));
+		store(c + i, select(neg_c, zero - cv, cv));
+	}
+
+	// the tail is computed with the same polynomials: scalar_kernels.sincos calls std::sin and std::cos
+	// for the full precision.
+	for (; i < count; ++i)
+		sincos_poly(angles[i], fast, s[i], c[i]);
+}
+
+void transform_float3(const float4x4& m, float w, const void* in, size_t in_stride,
+	void* out, size_t out_stride, size_t n, size_t count) noexcept
+{
+	const vfloat m00 = broadcast(m.m00), m01 = broadcast(m.m01), m02 = broadcast(m.m02), c0 = broadcast(m.m03 * w);
+	const vfloat m10 = broadcast(m.m10), m11 = broadcast(m.m11), m12 = broadcast(m.m12), c1 = broadcast(m.m13 * w);
+	const vfloat m20 = broadcast(m.m20), m21 = broadcast(m.m21), m22 = broadcast(m.m22), c2 = broadcast(m.m23 * w);
+	const vfloat m30 = broadcast(m.m30), m31 = broadcast(m.m31), m32 = broadcast(m.m32), c3 = broadcast(m.m33 * w);
+
+	// interleaved values are gathered into/scattered from the packed temporary arrays.
+	const bool in_packed = (in_stride == sizeof(float3));
+	const bool out_packed = (out_stride == n * sizeof(float));
+	float3 in_tmp[width];
+	float4 out_tmp[width];
+
+	const char* src = static_cast<const char*>(in);
+	char* dst = static_cast<char*>(out);
+
+	size_t i = 0;
+	for (; i + width <= count; i += width, src += width * in_stride, dst += width * out_stride) {
+		const float3* p = reinterpret_cast<const float3*>(src);
+		if (!in_packed) {
+			for (size_t k = 0; k < width; ++k)
+				in_tmp[k] = *reinterpret_cast<const float3*>(src + k * in_stride);
+
+			p = in_tmp;
+		}
+
+		vfloat x, y, z;
+		load_soa(p, x, y, z);
+
+		const vfloat rx = mul_add(m02, z, mul_add(m01, y, m00 * x)) + c0;
+		const vfloat ry = mul_add(m12, z, mul_add(m11, y, m10 * x)) + c1;
+		const vfloat rz = mul_add(m22, z, mul_add(m21, y, m20 * x)) + c2;
+
+		float* q = out_packed ? reinterpret_cast<float*>(dst) : &out_tmp[0].x;
+		if (n == 3) {
+			store_soa(reinterpret_cast<float3*>(q), rx, ry, rz);
+		}
+		else {
+			const vfloat rw = mul_add(m32, z, mul_add(m31, y, m30 * x)) + c3;
+			store_soa(reinterpret_cast<float4*>(q), rx, ry, rz, rw);
+		}
+
+		if (!out_packed) {
+			for (size_t k = 0; k < width; ++k)
+				std::memcpy(dst + k * out_stride, q + k * n, n * sizeof(float));
+		}
+	}
+
+	scalar_kernels.transform_float3(m, w, src, in_stride, dst, out_stride, n, count - i);
+}
+
+void mul_double4x4_double4(const double4x4& m, const double4* v, double4* out, size_t count) noexcept
+{
+	// every 4-lane group of c* holds the same column of m.
+	double cols[4][dwidth];
+	for (size_t k = 0; k < dwidth; k += 4) {
+		for (size_t r = 0; r < 4; ++r) {
+			const double* row = &m.m00 + r * 4;
+			cols[0][k + r] = row[0];
+			cols[1][k + r] = row[1];
+			cols[2][k + r] = row[2];
+			cols[3][k + r] = row[3];
+		}
+	}
+
+	const vdouble c0 = load(cols[0]);
+	const vdouble c1 = load(cols[1]);
+	const vdouble c2 = load(cols[2]);
+	const vdouble c3 = load(cols[3]);
+
+	// dwidth / 4 vectors are processed at once.
+	constexpr size_t step = dwidth / 4;
+	size_t i = 0;
+	for (; i + step <= count; i += step) {
+		const vdouble p = load(&v[i].x);
+
+		vdouble res = c0 * splat4<0>(p);
+		res = mul_add(c1, splat4<1>(p), res);
+		res = mul_add(c2, splat4<2>(p), res);
+		res = mul_add(c3, splat4<3>(p), res);
+		store(&out[i].x, res);
+	}
+
+	scalar_kernels.mul_double4x4_double4(m, v + i, out + i, count - i);
+}
+
+void to_float_relative(const double3* p, const double3& origin, float3* out, size_t count) noexcept
+{
+	// dwidth positions are 3 vectors of doubles, o* repeat origin along them.
+	double o[3 * dwidth];
+	for (size_t k = 0; k < 3 * dwidth; k += 3) {
+		o[k] = origin.x;
+		o[k + 1] = origin.y;
+		o[k + 2] = origin.z;
+	}
+
+	const vdouble o0 = load(o);
+	const vdouble o1 = load(o + dwidth);
+	const vdouble o2 = load(o + 2 * dwidth);
+
+	size_t i = 0;
+	for (; i + dwidth <= count; i += dwidth) {
+		const double* src = &p[i].x;
+		float* dst = &out[i].x;
+
+		store_float(dst, load(src) - o0);
+		store_float(dst + dwidth, load(src + dwidth) - o1);
+		store_float(dst + 2 * dwidth, load(src + 2 * dwidth) - o2);
+	}
+
+	scalar_kernels.to_float_relative(p + i, origin, out + i, count - i);
+}
+
+// dual_quat components of palette gathered per lane: real x, y, z, a and dual x, y, z, a.
+inline void gather_dual_quat(const float* palette, vint idx, vfloat (&dq)[8]) noexcept
+{
+	for (int c = 0; c < 8; ++c)
+		dq[c] = gather(palette + c, idx);
+}
+
+void skin_dual_quat(const dual_quat* palette, const float3* positions, const float3* normals,
+	const ubyte4* joints, const uint32_t* weights, float3* out_positions, float3* out_normals, size_t count) noexcept
+{
+	const float* base = &palette->real.x;
+	const vint byte_mask = broadcast_int(0xff);
+	const vfloat s = broadcast(255.0f);
+	const vfloat zero = broadcast(0.0f);
+	const vfloat one = broadcast(1.0f);
+	const vfloat two = broadcast(2.0f);
+
+	size_t i = 0;
+	for (; i + width <= count; i += width) {
+		// joint k of a vertex is byte k of ubyte4, its weight is packed into bits 24 - 8k...31 - 8k.
+		const vint j = load(reinterpret_cast<const uint32_t*>(joints + i));
+		const vint pw = load(weights + i);
+
+		// the indices of the first floats of the joints.
+		const vint idx[4] = {
+			shift_left<3>(j & byte_mask),
+			shift_left<3>(shift_right<8>(j) & byte_mask),
+			shift_left<3>(shift_right<16>(j) & byte_mask),
+			shift_left<3>(shift_right<24>(j))
+		};
+		const vfloat w[4] = {
+			to_float(shift_right<24>(pw)) / s,
+			to_float(shift_right<16>(pw) & byte_mask) / s,
+			to_float(shift_right<8>(pw) & byte_mask) / s,
+			to_float(pw & byte_mask) / s
+		};
+
+		// as blend does, the joints whose real parts are in the opposite hemisphere of the first one are negated.
+		vfloat b[8];
+		gather_dual_quat(base, idx[0], b);
+		const vfloat r0x = b[0], r0y = b[1], r0z = b[2], r0a = b[3];
+		for (int c = 0; c < 8; ++c)
+			b[c] = w[0] * b[c];
+
+		for (int k = 1; k < 4; ++k) {
+			vfloat dq[8];
+			gather_dual_quat(base, idx[k], dq);
+
+			const vfloat d = mul_add(r0a, dq[3], mul_add(r0z, dq[2], mul_add(r0y, dq[1], r0x * dq[0])));
+			const vfloat wk = select(d < zero, zero - w[k], w[k]);
+			for (int c = 0; c < 8; ++c)
+				b[c] = mul_add(wk, dq[c], b[c]);
+		}
+
+		// normalize
+		const vfloat inv_len = one / sqrt(mul_add(b[3], b[3], mul_add(b[2], b[2], mul_add(b[1], b[1], b[0] * b[0]))));
+		const vfloat rx = b[0] * inv_len, ry = b[1] * inv_len, rz = b[2] * inv_len, ra = b[3] * inv_len;
+		const vfloat dx = b[4] * inv_len, dy = b[5] * inv_len, dz = b[6] * inv_len, da = b[7] * inv_len;
+
+		// translation: 2 * (ra * dv - da * rv + cross(rv, dv)).
+		const vfloat tx = two * (mul_add(ra, dx, zero - da * rx) + (ry * dz - rz * dy));
+		const vfloat ty = two * (mul_add(ra, dy, zero - da * ry) + (rz * dx - rx * dz));
+		const vfloat tz = two * (mul_add(ra, dz, zero - da * rz) + (rx * dy - ry * dx));
+
+		// rotation: v + 2 * cross(rv, cross(rv, v) + ra * v).
+		vfloat px, py, pz;
+		load_soa(positions + i, px, py, pz);
+		{
+			const vfloat cx = mul_add(ra, px, ry * pz - rz * py);
+			const vfloat cy = mul_add(ra, py, rz * px - rx * pz);
+			const vfloat cz = mul_add(ra, pz, rx * py - ry * px);
+			store_soa(out_positions + i,
+				mul_add(two, ry * cz - rz * cy, px) + tx,
+				mul_add(two, rz * cx - rx * cz, py) + ty,
+				mul_add(two, rx * cy - ry * cx, pz) + tz);
+		}
+
+		if (normals) {
+			vfloat nx, ny, nz;
+			load_soa(normals + i, nx, ny, nz);
+
+			const vfloat cx = mul_add(ra, nx, ry * nz - rz * ny);
+			const vfloat cy = mul_add(ra, ny, rz * nx - rx * nz);
+			const vfloat cz = mul_add(ra, nz, rx * ny - ry * nx);
+			store_soa(out_normals + i,
+				mul_add(two, ry * cz - rz * cy, nx),
+				mul_add(two, rz * cx - rx * cz, ny),
+				mul_add(two, rx * cy - ry * cx, nz));
+		}
+	}
+
+	scalar_kernels.skin_dual_quat(palette, positions + i, normals ? normals + i : nullptr, joints + i, weights + i,
+		out_positions + i, out_normals ? out_normals + i : nullptr, count - i);
+}
+
+
+void skin_float4x4(const float4x4* palette, const float3* positions, const float3* normals,
+	const ubyte4* joints, const float4* weights, float3* out_positions, float3* out_normals, size_t count) noexcept
+{
+	const float* base = &palette->m00;
+	const vint byte_mask = broadcast_int(0xff);
+	const vfloat one = broadcast(1.0f);
+
+	size_t i = 0;
+	for (; i + width <= count; i += width) {
+		// joint k of a vertex is byte k of ubyte4.
+		const vint j = load(reinterpret_cast<const uint32_t*>(joints + i));
+		const vint idx[4] = {
+			shift_left<4>(j & byte_mask),
+			shift_left<4>(shift_right<8>(j) & byte_mask),
+			shift_left<4>(shift_right<16>(j) & byte_mask),
+			shift_left<4>(shift_right<24>(j))
+		};
+		vfloat w[4];
+		load_soa(weights + i, w[0], w[1], w[2], w[3]);
+
+		// b: the first 3 rows of the blended matrix, the 4th one is not needed for the affine palette.
+		vfloat b[12];
+		for (int c = 0; c < 12; ++c)
+			b[c] = w[0] * gather(base + c, idx[0]);
+
+		for (int k = 1; k < 4; ++k) {
+			for (int c = 0; c < 12; ++c)
+				b[c] = mul_add(w[k], gather(base + c, idx[k]), b[c]);
+		}
+
+		vfloat px, py, pz;
+		load_soa(positions + i, px, py, pz);
+		store_soa(out_positions + i,
+			mul_add(b[0], px, mul_add(b[1], py, mul_add(b[2], pz, b[3]))),
+			mul_add(b[4], px, mul_add(b[5], py, mul_add(b[6], pz, b[7]))),
+			mul_add(b[8], px, mul_add(b[9], py, mul_add(b[10], pz, b[11]))));
+
+		if (normals) {
+			vfloat nx, ny, nz;
+			load_soa(normals + i, nx, ny, nz);
+
+			const vfloat x = mul_add(b[0], nx, mul_add(b[1], ny, b[2] * nz));
+			const vfloat y = mul_add(b[4], nx, mul_add(b[5], ny, b[6] * nz));
+			const vfloat z = mul_add(b[8], nx, mul_add(b[9], ny, b[10] * nz));
+			const vfloat inv_len = one / sqrt(mul_add(x, x, mul_add(y, y, z * z)));
+			store_soa(out_normals + i, x * inv_len, y * inv_len, z * inv_len);
+		}
+	}
+
+	scalar_kernels.skin_float4x4(palette, positions + i, normals ? normals + i : nullptr, joints + i, weights + i,
+		out_positions + i, out_normals ? out_normals + i : nullptr, count - i);
+}
+
+void bounds_float3(const float3* p, size_t count, float3& min3, float3& max3) noexcept
+{
+	// width float3 values are 3 vectors of interleaved components, lane l of vector k holds
+	// component (k * width + l) % 3. The vectors are reduced separately and the components are
+	// separated only once at the end, the loop needs no shuffles.
+	const float* f = &p->x;
+	vfloat lo[3], hi[3];
+	for (size_t k = 0; k < 3; ++k) {
+		lo[k] = broadcast(std::numeric_limits<float>::max());
+		hi[k] = broadcast(-std::numeric_limits<float>::max());
+	}
+
+	size_t i = 0;
+	for (; i + width <= count; i += width, f += 3 * width) {
+		for (size_t k = 0; k < 3; ++k) {
+			const vfloat v = load(f + k * width);
+			lo[k] = min(lo[k], v);
+			hi[k] = max(hi[k], v);
+		}
+	}
+
+	if (i > 0) {
+		float l[3 * width], h[3 * width];
+		for (size_t k = 0; k < 3; ++k) {
+			store(l + k * width, lo[k]);
+			store(h + k * width, hi[k]);
+		}
+
+		float* mn = &min3.x;
+		float* mx = &max3.x;
+		for (size_t j = 0; j < 3 * width; ++j) {
+			mn[j % 3] = std::min(mn[j % 3], l[j]);
+			mx[j % 3] = std::max(mx[j % 3], h[j]);
+		}
+	}
+
+	scalar_kernels.bounds_float3(p + i, count - i, min3, max3);
+}
+
+// The ray kernels compute width hits at a time as the scalar intersects(const ray&, ...) does and return
+// their distances or +infinity. A ray and a primitive are the vectors of their components,
+// the kernels broadcast the single ray or primitive and load the SoA arrays of the other side.
+
+inline vfloat intersect_ray_aabb(const vfloat o[3], const vfloat inv_d[3], vfloat t_max,
+	const vfloat lo[3], const vfloat hi[3]) noexcept
+{
+	vfloat t_near = broadcast(0.0f);
+	vfloat t_far = t_max;
+	for (size_t k = 0; k < 3; ++k) {
+		const vfloat t0 = (lo[k] - o[k]) * inv_d[k];
+		const vfloat t1 = (hi[k] - o[k]) * inv_d[k];
+		t_near = max(t_near, min(t0, t1));
+		t_far = min(t_far, max(t0, t1));
+	}
+
+	return select(t_near <= t_far, t_near, broadcast(std::numeric_limits<float>::infinity()));
+}
+
+inline vfloat intersect_ray_sphere(const vfloat o[3], const vfloat d[3], vfloat t_max,
+	const vfloat c[3], vfloat radius) noexcept
+{
+	const vfloat zero = broadcast(0.0f);
+	const vfloat ocx = o[0] - c[0], ocy = o[1] - c[1], ocz = o[2] - c[2];
+	const vfloat a = d[0] * d[0] + d[1] * d[1] + d[2] * d[2];
+	const vfloat b = ocx * d[0] + ocy * d[1] + ocz * d[2];
+	const vfloat cc = (ocx * ocx + ocy * ocy + ocz * ocz) - radius * radius;
+	const vfloat disc = b * b - a * cc;
+
+	const vfloat sq = sqrt(max(disc, zero));
+	const vfloat t0 = (zero - b - sq) / a;
+	const vfloat t1 = (zero - b + sq) / a;
+	const vfloat t = select(t0 >= zero, t0, t1);
+
+	const vmask hit = (disc >= zero) & (t >= zero) & (t <= t_max);
+	return select(hit, t, broadcast(std::numeric_limits<float>::infinity()));
+}
+
+inline vfloat intersect_ray_triangle(const vfloat o[3], const vfloat d[3], vfloat t_max,
+	const vfloat v0[3], const vfloat v1[3], const vfloat v2[3]) noexcept
+{
+	const vfloat zero = broadcast(0.0f);
+	const vfloat one = broadcast(1.0f);
+	const vfloat e1x = v1[0] - v0[0], e1y = v1[1] - v0[1], e1z = v1[2] - v0[2];
+	const vfloat e2x = v2[0] - v0[0], e2y = v2[1] - v0[1], e2z = v2[2] - v0[2];
+
+	// p = cross(d, e2), det = dot(e1, p)
+	const vfloat px = d[1] * e2z - d[2] * e2y;
+	const vfloat py = d[2] * e2x - d[0] * e2z;
+	const vfloat pz = d[0] * e2y - d[1] * e2x;
+	const vfloat det = e1x * px + e1y * py + e1z * pz;
+	const vfloat inv_det = one / det;
+
+	// s = o - v0, q = cross(s, e1)
+	const vfloat sx = o[0] - v0[0], sy = o[1] - v0[1], sz = o[2] - v0[2];
+	const vfloat u = (sx * px + sy * py + sz * pz) * inv_det;
+	const vfloat qx = sy * e1z - sz * e1y;
+	const vfloat qy = sz * e1x - sx * e1z;
+	const vfloat qz = sx * e1y - sy * e1x;
+	const vfloat v = (d[0] * qx + d[1] * qy + d[2] * qz) * inv_det;
+	const vfloat t = (e2x * qx + e2y * qy + e2z * qz) * inv_det;
+
+	const vmask hit = ((det < zero) | (det > zero)) & (u >= zero) & (v >= zero) & (u + v <= one)
+		& (t >= zero) & (t <= t_max);
+	return select(hit, t, broadcast(std::numeric_limits<float>::infinity()));
+}
+
+// Broadcasts the components of v.
+inline void broadcast3(const float3& v, vfloat out[3]) noexcept
+{
+	out[0] = broadcast(v.x);
+	out[1] = broadcast(v.y);
+	out[2] = broadcast(v.z);
+}
+
+// Loads width values of every SoA component array p[k] starting at i.
+inline void load3(const float* const* p, size_t i, vfloat out[3]) noexcept
+{
+	out[0] = load(p[0] + i);
+	out[1] = load(p[1] + i);
+	out[2] = load(p[2] + i);
+}
+
+void intersects_ray_aabbs_soa(const ray& r, const float* const* min, const float* const* max,
+	float t_max, float* t, size_t count) noexcept
+{
+	vfloat o[3], inv_d[3];
+	broadcast3(r.origin, o);
+	broadcast3(float3(1.0f / r.direction.x, 1.0f / r.direction.y, 1.0f / r.direction.z), inv_d);
+	const vfloat tm = broadcast(t_max);
+
+	for (size_t i = 0; i < count; i += width) {
+		vfloat lo[3], hi[3];
+		load3(min, i, lo);
+		load3(max, i, hi);
+		store_first(t + i, intersect_ray_aabb(o, inv_d, tm, lo, hi), count - i);
+	}
+}
+
+void intersects_ray_spheres_soa(const ray& r, const float* const* spheres,
+	float t_max, float* t, size_t count) noexcept
+{
+	vfloat o[3], d[3];
+	broadcast3(r.origin, o);
+	broadcast3(r.direction, d);
+	const vfloat tm = broadcast(t_max);
+
+	for (size_t i = 0; i < count; i += width) {
+		vfloat c[3];
+		load3(spheres, i, c);
+		store_first(t + i, intersect_ray_sphere(o, d, tm, c, load(spheres[3] + i)), count - i);
+	}
+}
+
+void intersects_ray_triangles_soa(const ray& r, const float* const* v0, const float* const* v1,
+	const float* const* v2, float t_max, float* t, size_t count) noexcept
+{
+	vfloat o[3], d[3];
+	broadcast3(r.origin, o);
+	broadcast3(r.direction, d);
+	const vfloat tm = broadcast(t_max);
+
+	for (size_t i = 0; i < count; i += width) {
+		vfloat a[3], b[3], c[3];
+		load3(v0, i, a);
+		load3(v1, i, b);
+		load3(v2, i, c);
+		store_first(t + i, intersect_ray_triangle(o, d, tm, a, b, c), count - i);
+	}
+}
+
+void intersects_rays_aabb_soa(const float* const* origins, const float* const* directions,
+	const float* t_max, const aabb& b, float* t, size_t count) noexcept
+{
+	vfloat lo[3], hi[3];
+	broadcast3(b.min, lo);
+	broadcast3(b.max, hi);
+	const vfloat one = broadcast(1.0f);
+
+	for (size_t i = 0; i < count; i += width) {
+		vfloat o[3], inv_d[3];
+		load3(origins, i, o);
+		load3(directions, i, inv_d);
+		for (size_t k = 0; k < 3; ++k)
+			inv_d[k] = one / inv_d[k];
+
+		store_first(t + i, intersect_ray_aabb(o, inv_d, load_first(t_max + i, count - i), lo, hi), count - i);
+	}
+}
+
+void intersects_rays_sphere_soa(const float* const* origins, const float* const* directions,
+	const float* t_max, const float3& center, float radius, float* t, size_t count) noexcept
+{
+	vfloat c[3];
+	broadcast3(center, c);
+	const vfloat rad = broadcast(radius);
+
+	for (size_t i = 0; i < count; i += width) {
+		vfloat o[3], d[3];
+		load3(origins, i, o);
+		load3(directions, i, d);
+		store_first(t + i, intersect_ray_sphere(o, d, load_first(t_max + i, count - i), c, rad), count - i);
+	}
+}
+
+void intersects_rays_triangle_soa(const float* const* origins, const float* const* directions,
+	const float* t_max, const float3& v0, const float3& v1, const float3& v2, float* t, size_t count) noexcept
+{
+	vfloat a[3], b[3], c[3];
+	broadcast3(v0, a);
+	broadcast3(v1, b);
+	broadcast3(v2, c);
+
+	for (size_t i = 0; i < count; i += width) {
+		vfloat o[3], d[3];
+		load3(origins, i, o);
+		load3(directions, i, d);
+		store_first(t + i, intersect_ray_triangle(o, d, load_first(t_max + i, count - i), a, b, c), count - i);
+	}
+}
+
+// Inserts two zero bits before each of the lowest 10 bits of every lane as detail::morton_spread3 does.
+inline vint morton_spread3(vint v) noexcept
+{
+	v = (v | shift_left<16>(v)) & broadcast_int(0x030000ff);
+	v = (v | shift_left<8>(v)) & broadcast_int(0x0300f00f);
+	v = (v | shift_left<4>(v)) & broadcast_int(0x030c30c3);
+	v = (v | shift_left<2>(v)) & broadcast_int(0x09249249);
+	return v;
+}
+
+// Returns the 30-bit codes of the lanes of x, y and z, every lane must be less than 2^10.
+inline vint morton_encode30(vint x, vint y, vint z) noexcept
+{
+	return morton_spread3(x) | shift_left<1>(morton_spread3(y)) | shift_left<2>(morton_spread3(z));
+}
+
+// The 64-bit lanes do not fit vint, the 63-bit codes are assembled by the scalar code from the 30-bit codes
+// of the lowest 10 bits, of the next 10 bits and from the 3 highest bits of the components.
+void morton_encode_float3(const float3* p, const float3& origin, const float3& scale,
+	void* out, size_t out_size, size_t count) noexcept
+{
+	const uint32_t bits = (out_size == sizeof(uint32_t)) ? 10 : 21;
+	const vfloat ox = broadcast(origin.x), oy = broadcast(origin.y), oz = broadcast(origin.z);
+	const vfloat sx = broadcast(scale.x), sy = broadcast(scale.y), sz = broadcast(scale.z);
+	const vfloat zero = broadcast(0.0f);
+	const vfloat hi = broadcast(float((uint32_t(1) << bits) - 1));
+	const vint low = broadcast_int(0x3ff);
+
+	size_t i = 0;
+	for (; i + width <= count; i += width) {
+		vfloat x, y, z;
+		load_soa(p + i, x, y, z);
+
+		const vint xi = to_int(min(max((x - ox) * sx, zero), hi));
+		const vint yi = to_int(min(max((y - oy) * sy, zero), hi));
+		const vint zi = to_int(min(max((z - oz) * sz, zero), hi));
+		if (out_size == sizeof(uint32_t)) {
+			store(static_cast<uint32_t*>(out) + i, morton_encode30(xi, yi, zi));
+			continue;
+		}
+
+		uint32_t fields[3][width];
+		store(fields[0], morton_encode30(xi & low, yi & low, zi & low));
+		store(fields[1], morton_encode30(shift_right<10>(xi) & low, shift_right<10>(yi) & low, shift_right<10>(zi) & low));
+		store(fields[2], shift_right<20>(xi) | shift_left<1>(shift_right<20>(yi)) | shift_left<2>(shift_right<20>(zi)));
+
+		uint64_t* o = static_cast<uint64_t*>(out) + i;
+		for (size_t j = 0; j < width; ++j)
+			o[j] = (uint64_t(fields[2][j]) << 60) | (uint64_t(fields[1][j]) << 30) | fields[0][j];
+	}
+
+	scalar_kernels.morton_encode_float3(p + i, origin, scale, static_cast<uint8_t*>(out) + i * out_size,
+		out_size, count - i);
+}
+
+
+constexpr kernel_table table = {
+	mul_float4x4_float4,
+	mul_float4x4_float4x4,
+	fast_normalize_aos,
+	normalize_float3,
+	normalize_float4,
+	nlerp_quat,
+	slerp_fast_quat,
+	pack_snorm_10_10_10_2,
+	pack_unorm_10_10_10_2,
+	pack_unorm_16_16,
+	pack_unorm_8_8_8,
+	pack_unorm_8_8_8_8,
+	unpack_snorm_10_10_10_2,
+	unpack_unorm_10_10_10_2,
+	unpack_unorm_16_16,
+	unpack_unorm_8_8_8,
+	unpack_unorm_8_8_8_8,
+	encode_octahedral,
+	decode_octahedral,
+	pack_octahedral_snorm_16_16,
+	unpack_octahedral_snorm_16_16,
+	pack_octahedral_unorm_8_8,
+	unpack_octahedral_unorm_8_8,
+	pack_smallest_three,
+	unpack_smallest_three,
+	pack_half,
+	unpack_half,
+	aos_to_soa,
+	soa_to_aos,
+	clamp_soa,
+	cross_soa,
+	dot_soa,
+	len_soa,
+	lerp_soa,
+	normalize_soa,
+	intersects_spheres_soa,
+	intersects_aabbs_soa,
+	sincos,
+	transform_float3,
+	mul_double4x4_double4,
+	to_float_relative,
+	skin_dual_quat,
+	skin_float4x4,
+	bounds_float3,
+	intersects_ray_aabbs_soa,
+	intersects_ray_spheres_soa,
+	intersects_ray_triangles_soa,
+	intersects_rays_aabb_soa,
+	intersects_rays_sphere_soa,
+	intersects_rays_triangle_soa,
+	morton_encode_float3
+};
@@ -0,0 +1,499 @@
+#include "kernels.h"
+
+#include "math/vector_utility.h"
+
+
+namespace math {
+namespace scalar {
+
+void mul_float4x4_float4(const float4x4& m, const float4* v, float4* out, size_t count) noexcept
+{
+	for (size_t i = 0; i < count; ++i)
+		out[i] = mul(m, v[i]);
+}
+
+void mul_float4x4_float4x4(const float4x4* l, const float4x4* r, float4x4* out, size_t count) noexcept
+{
+	for (size_t i = 0; i < count; ++i)
+		out[i] = l[i] * r[i];
+}
+
+void fast_normalize_aos(const float* v, size_t n, float* out, size_t count) noexcept
+{
+	assert(2 <= n && n <= 4);
+
+	for (size_t i = 0; i < count; ++i, v += n, out += n) {
+		float l2 = 0.0f;
+		for (size_t c = 0; c < n; ++c)
+			l2 += v[c] * v[c];
+
+		// the SIMD kernels process their tails here, their estimate gives inf or NaN for the denormal lengths.
+		assert(l2 == 0.0f || std::isnormal(l2));
+		const float factor = (l2 > 0.0f) ? rsqrt(l2) : 1.0f;
+		for (size_t c = 0; c < n; ++c)
+			out[c] = v[c] * factor;
+	}
+}
+
+void normalize_float3(const float3* v, float3* out, size_t count) noexcept
+{
+	for (size_t i = 0; i < count; ++i)
+		out[i] = normalize(v[i]);
+}
+
+void normalize_float4(const float4* v, float4* out, size_t count) noexcept
+{
+	for (size_t i = 0; i < count; ++i)
+		out[i] = normalize(v[i]);
+}
+
+void nlerp_quat(const quat* q, const quat* r, const float* factor, quat* out, size_t count) noexcept
+{
+	for (size_t i = 0; i < count; ++i)
+		out[i] = nlerp(q[i], r[i], factor[i]);
+}
+
+void slerp_fast_quat(const quat* q, const quat* r, const float* factor, quat* out, size_t count) noexcept
+{
+	for (size_t i = 0; i < count; ++i)
+		out[i] = slerp_fast(q[i], r[i], factor[i]);
+}
+
+void pack_snorm_10_10_10_2(const float4* v, uint32_t* out, size_t count) noexcept
+{
+	for (size_t i = 0; i < count; ++i)
+		out[i] = math::pack_snorm_10_10_10_2(v[i]);
+}
+
+void pack_unorm_10_10_10_2(const float4* v, uint32_t* out, size_t count) noexcept
+{
+	for (size_t i = 0; i < count; ++i)
+		out[i] = math::pack_unorm_10_10_10_2(v[i]);
+}
+
+void pack_unorm_16_16(const float2* v, uint32_t* out, size_t count) noexcept
+{
+	for (size_t i = 0; i < count; ++i)
+		out[i] = math::pack_unorm_16_16(v[i]);
+}
+
+void pack_unorm_8_8_8(const float3* v, uint32_t* out, size_t count) noexcept
+{
+	for (size_t i = 0; i < count; ++i)
+		out[i] = math::pack_unorm_8_8_8(v[i]);
+}
+
+void pack_unorm_8_8_8_8(const float4* v, uint32_t* out, size_t count) noexcept
+{
+	for (size_t i = 0; i < count; ++i)
+		out[i] = math::pack_unorm_8_8_8_8(v[i]);
+}
+
+void unpack_snorm_10_10_10_2(const uint32_t* p, float4* out, size_t count) noexcept
+{
+	for (size_t i = 0; i < count; ++i)
+		out[i] = math::unpack_snorm_10_10_10_2(p[i]);
+}
+
+void unpack_unorm_10_10_10_2(const uint32_t* p, float4* out, size_t count) noexcept
+{
+	for (size_t i = 0; i < count; ++i)
+		out[i] = math::unpack_unorm_10_10_10_2(p[i]);
+}
+
+void unpack_unorm_16_16(const uint32_t* p, float2* out, size_t count) noexcept
+{
+	for (size_t i = 0; i < count; ++i)
+		out[i] = math::unpack_unorm_16_16(p[i]);
+}
+
+void unpack_unorm_8_8_8(const uint32_t* p, float3* out, size_t count) noexcept
+{
+	for (size_t i = 0; i < count; ++i)
+		out[i] = math::unpack_unorm_8_8_8(p[i]);
+}
+
+void unpack_unorm_8_8_8_8(const uint32_t* p, float4* out, size_t count) noexcept
+{
+	for (size_t i = 0; i < count; ++i)
+		out[i] = math::unpack_unorm_8_8_8_8(p[i]);
+}
+
+void encode_octahedral(const float3* n, float2* out, size_t count) noexcept
+{
+	for (size_t i = 0; i < count; ++i)
+		out[i] = math::encode_octahedral(n[i]);
+}
+
+void decode_octahedral(const float2* e, float3* out, size_t count) noexcept
+{
+	for (size_t i = 0; i < count; ++i)
+		out[i] = math::decode_octahedral(e[i]);
+}
+
+void pack_octahedral_snorm_16_16(const float3* n, uint32_t* out, size_t count) noexcept
+{
+	for (size_t i = 0; i < count; ++i)
+		out[i] = math::pack_octahedral_snorm_16_16(n[i]);
+}
+
+void unpack_octahedral_snorm_16_16(const uint32_t* p, float3* out, size_t count) noexcept
+{
+	for (size_t i = 0; i < count; ++i)
+		out[i] = math::unpack_octahedral_snorm_16_16(p[i]);
+}
+
+void pack_octahedral_unorm_8_8(const float3* n, uint16_t* out, size_t count) noexcept
+{
+	for (size_t i = 0; i < count; ++i)
+		out[i] = math::pack_octahedral_unorm_8_8(n[i]);
+}
+
+void unpack_octahedral_unorm_8_8(const uint16_t* p, float3* out, size_t count) noexcept
+{
+	for (size_t i = 0; i < count; ++i)
+		out[i] = math::unpack_octahedral_unorm_8_8(p[i]);
+}
+
+void pack_smallest_three(const quat* q, uint32_t bits, void* out, size_t out_size, size_t count) noexcept
+{
+	for (size_t i = 0; i < count; ++i) {
+		const uint64_t p = math::pack_smallest_three(q[i], bits);
+		if (out_size == sizeof(uint32_t))
+			static_cast<uint32_t*>(out)[i] = uint32_t(p);
+		else
+			static_cast<uint64_t*>(out)[i] = p;
+	}
+}
+
+void unpack_smallest_three(const void* p, size_t p_size, uint32_t bits, quat* out, size_t count) noexcept
+{
+	for (size_t i = 0; i < count; ++i) {
+		const uint64_t v = (p_size == sizeof(uint32_t))
+			? static_cast<const uint32_t*>(p)[i]
+			: static_cast<const uint64_t*>(p)[i];
+		out[i] = math::unpack_smallest_three(v, bits);
+	}
+}
+
+void pack_half(const float* v, uint16_t* out, size_t count) noexcept
+{
+	for (size_t i = 0; i < count; ++i)
+		out[i] = math::pack_half(v[i]).bits;
+}
+
+void unpack_half(const uint16_t* v, float* out, size_t count) noexcept
+{
+	for (size_t i = 0; i < count; ++i)
+		out[i] = math::unpack_half(half(v[i]));
+}
+
+void aos_to_soa(const float* v, size_t n, float* const* out, size_t count) noexcept
+{
+	for (size_t i = 0; i < count; ++i) {
+		for (size_t c = 0; c < n; ++c)
+			out[c][i] = v[i * n + c];
+	}
+}
+
+void soa_to_aos(const float* const* v, size_t n, float* out, size_t count) noexcept
+{
+	for (size_t i = 0; i < count; ++i) {
+		for (size_t c = 0; c < n; ++c)
+			out[i * n + c] = v[c][i];
+	}
+}
+
+void clamp_soa(const float* v, float lo, float hi, float* out, size_t count) noexcept
+{
+	for (size_t i = 0; i < count; ++i)
+		out[i] = clamp(v[i], lo, hi);
+}
+
+void cross_soa(const float* const* l, const float* const* r, float* const* out, size_t count) noexcept
+{
+	for (size_t i = 0; i < count; ++i) {
+		const float3 c = cross(float3(l[0][i], l[1][i], l[2][i]), float3(r[0][i], r[1][i], r[2][i]));
+		out[0][i] = c.x;
+		out[1][i] = c.y;
+		out[2][i] = c.z;
+	}
+}
+
+void dot_soa(const float* const* l, const float* const* r, size_t n, float* out, size_t count) noexcept
+{
+	for (size_t i = 0; i < count; ++i) {
+		float d = l[0][i] * r[0][i];
+		for (size_t c = 1; c < n; ++c)
+			d += l[c][i] * r[c][i];
+
+		out[i] = d;
+	}
+}
+
+void len_soa(const float* const* v, size_t n, float* out, size_t count) noexcept
+{
+	dot_soa(v, v, n, out, count);
+
+	for (size_t i = 0; i < count; ++i)
+		out[i] = std::sqrt(out[i]);
+}
+
+void lerp_soa(const float* l, const float* r, float factor, float* out, size_t count) noexcept
+{
+	for (size_t i = 0; i < count; ++i)
+		out[i] = l[i] + factor * (r[i] - l[i]);
+}
+
+void normalize_soa(const float* const* v, size_t n, float* const* out, size_t count) noexcept
+{
+	for (size_t i = 0; i < count; ++i) {
+		float l2 = v[0][i] * v[0][i];
+		for (size_t c = 1; c < n; ++c)
+			l2 += v[c][i] * v[c][i];
+
+		// as normalize(float3) and normalize(float4) do, zero and unit vectors are left unchanged.
+		const bool keep = approx_equal(l2, 0.0f) || approx_equal(l2, 1.0f);
+		const float factor = keep ? 1.0f : 1.0f / std::sqrt(l2);
+		for (size_t c = 0; c < n; ++c)
+			out[c][i] = v[c][i] * factor;
+	}
+}
+
+void intersects_spheres_soa(const frustum& f, const float* const* spheres, uint32_t* visible, size_t count) noexcept
+{
+	std::memset(visible, 0, ((count + 31) / 32) * sizeof(uint32_t));
+
+	for (size_t i = 0; i < count; ++i) {
+		if (intersects(f, float3(spheres[0][i], spheres[1][i], spheres[2][i]), spheres[3][i]))
+			visible[i / 32] |= uint32_t(1) << (i % 32);
+	}
+}
+
+void intersects_aabbs_soa(const frustum& f, const float* const* min, const float* const* max,
+	uint32_t* visible, size_t count) noexcept
+{
+	std::memset(visible, 0, ((count + 31) / 32) * sizeof(uint32_t));
+
+	for (size_t i = 0; i < count; ++i) {
+		const float3 lo(min[0][i], min[1][i], min[2][i]);
+		const float3 hi(max[0][i], max[1][i], max[2][i]);
+		if (intersects(f, lo, hi))
+			visible[i / 32] |= uint32_t(1) << (i % 32);
+	}
+}
+
+void sincos(const float* angles, float* s, float* c, size_t count, bool fast) noexcept
+{
+	if (fast) {
+		for (size_t i = 0; i < count; ++i)
+			sincos_poly(angles[i], true, s[i], c[i]);
+	}
+	else {
+		for (size_t i = 0; i < count; ++i) {
+			const float a = angles[i];
+			s[i] = std::sin(a);
+			c[i] = std::cos(a);
+		}
+	}
+}
+
+void transform_float3(const float4x4& m, float w, const void* in, size_t in_stride,
+	void* out, size_t out_stride, size_t n, size_t count) noexcept
+{
+	const char* src = static_cast<const char*>(in);
+	char* dst = static_cast<char*>(out);
+
+	for (size_t i = 0; i < count; ++i, src += in_stride, dst += out_stride) {
+		const float4 p = mul(m, *reinterpret_cast<const float3*>(src), w);
+		std::memcpy(dst, &p.x, n * sizeof(float));
+	}
+}
+
+void mul_double4x4_double4(const double4x4& m, const double4* v, double4* out, size_t count) noexcept
+{
+	for (size_t i = 0; i < count; ++i)
+		out[i] = mul(m, v[i]);
+}
+
+void to_float_relative(const double3* p, const double3& origin, float3* out, size_t count) noexcept
+{
+	for (size_t i = 0; i < count; ++i)
+		out[i] = math::to_float_relative(p[i], origin);
+}
+
+void skin_dual_quat(const dual_quat* palette, const float3* positions, const float3* normals,
+	const ubyte4* joints, const uint32_t* weights, float3* out_positions, float3* out_normals, size_t count) noexcept
+{
+	for (size_t i = 0; i < count; ++i) {
+		const ubyte4& j = joints[i];
+		const dual_quat dq[4] = { palette[j.x], palette[j.y], palette[j.z], palette[j.w] };
+		const float4 w = math::unpack_unorm_8_8_8_8(weights[i]);
+		const dual_quat b = blend(dq, &w.x, 4);
+
+		out_positions[i] = transform_point(b, positions[i]);
+		if (normals) out_normals[i] = transform_direction(b, normals[i]);
+	}
+}
+
+void skin_float4x4(const float4x4* palette, const float3* positions, const float3* normals,
+	const ubyte4* joints, const float4* weights, float3* out_positions, float3* out_normals, size_t count) noexcept
+{
+	for (size_t i = 0; i < count; ++i) {
+		const ubyte4& j = joints[i];
+		const float4& w = weights[i];
+		const float4x4 b = w.x * palette[j.x] + w.y * palette[j.y] + w.z * palette[j.z] + w.w * palette[j.w];
+
+		const float4 p = mul(b, positions[i], 1.0f);
+		out_positions[i] = float3(p.x, p.y, p.z);
+		if (normals) {
+			const float4 n = mul(b, normals[i], 0.0f);
+			out_normals[i] = normalize(float3(n.x, n.y, n.z));
+		}
+	}
+}
+
+void bounds_float3(const float3* p, size_t count, float3& min, float3& max) noexcept
+{
+	for (size_t i = 0; i < count; ++i) {
+		min = float3(std::min(min.x, p[i].x), std::min(min.y, p[i].y), std::min(min.z, p[i].z));
+		max = float3(std::max(max.x, p[i].x), std::max(max.y, p[i].y), std::max(max.z, p[i].z));
+	}
+}
+
+void intersects_ray_aabbs_soa(const ray& r, const float* const* min, const float* const* max,
+	float t_max, float* t, size_t count) noexcept
+{
+	for (size_t i = 0; i < count; ++i) {
+		const aabb b(float3(min[0][i], min[1][i], min[2][i]), float3(max[0][i], max[1][i], max[2][i]));
+		t[i] = std::numeric_limits<float>::infinity();
+		math::intersects(r, b, t_max, t[i]);
+	}
+}
+
+void intersects_ray_spheres_soa(const ray& r, const float* const* spheres,
+	float t_max, float* t, size_t count) noexcept
+{
+	for (size_t i = 0; i < count; ++i) {
+		const float3 c(spheres[0][i], spheres[1][i], spheres[2][i]);
+		t[i] = std::numeric_limits<float>::infinity();
+		math::intersects(r, c, spheres[3][i], t_max, t[i]);
+	}
+}
+
+void intersects_ray_triangles_soa(const ray& r, const float* const* v0, const float* const* v1,
+	const float* const* v2, float t_max, float* t, size_t count) noexcept
+{
+	for (size_t i = 0; i < count; ++i) {
+		const float3 a(v0[0][i], v0[1][i], v0[2][i]);
+		const float3 b(v1[0][i], v1[1][i], v1[2][i]);
+		const float3 c(v2[0][i], v2[1][i], v2[2][i]);
+		t[i] = std::numeric_limits<float>::infinity();
+		math::intersects(r, a, b, c, t_max, t[i]);
+	}
+}
+
+void intersects_rays_aabb_soa(const float* const* origins, const float* const* directions,
+	const float* t_max, const aabb& b, float* t, size_t count) noexcept
+{
+	for (size_t i = 0; i < count; ++i) {
+		const ray r(float3(origins[0][i], origins[1][i], origins[2][i]),
+			float3(directions[0][i], directions[1][i], directions[2][i]));
+		const float tm = t_max[i];
+		t[i] = std::numeric_limits<float>::infinity();
+		math::intersects(r, b, tm, t[i]);
+	}
+}
+
+void intersects_rays_sphere_soa(const float* const* origins, const float* const* directions,
+	const float* t_max, const float3& center, float radius, float* t, size_t count) noexcept
+{
+	for (size_t i = 0; i < count; ++i) {
+		const ray r(float3(origins[0][i], origins[1][i], origins[2][i]),
+			float3(directions[0][i], directions[1][i], directions[2][i]));
+		const float tm = t_max[i];
+		t[i] = std::numeric_limits<float>::infinity();
+		math::intersects(r, center, radius, tm, t[i]);
+	}
+}
+
+void intersects_rays_triangle_soa(const float* const* origins, const float* const* directions,
+	const float* t_max, const float3& v0, const float3& v1, const float3& v2, float* t, size_t count) noexcept
+{
+	for (size_t i = 0; i < count; ++i) {
+		const ray r(float3(origins[0][i], origins[1][i], origins[2][i]),
+			float3(directions[0][i], directions[1][i], directions[2][i]));
+		const float tm = t_max[i];
+		t[i] = std::numeric_limits<float>::infinity();
+		math::intersects(r, v0, v1, v2, tm, t[i]);
+	}
+}
+
+void morton_encode_float3(const float3* p, const float3& origin, const float3& scale,
+	void* out, size_t out_size, size_t count) noexcept
+{
+	for (size_t i = 0; i < count; ++i) {
+		if (out_size == sizeof(uint32_t))
+			static_cast<uint32_t*>(out)[i] = math::morton_encode32(math::detail::quantize(p[i], origin, scale, 10));
+		else
+			static_cast<uint64_t*>(out)[i] = math::morton_encode64(math::detail::quantize(p[i], origin, scale, 21));
+	}
+}
+
+} // namespace scalar
+
+const kernel_table scalar_kernels = {
+	scalar::mul_float4x4_float4,
+	scalar::mul_float4x4_float4x4,
+	scalar::fast_normalize_aos,
+	scalar::normalize_float3,
+	scalar::normalize_float4,
+	scalar::nlerp_quat,
+	scalar::slerp_fast_quat,
+	scalar::pack_snorm_10_10_10_2,
+	scalar::pack_unorm_10_10_10_2,
+	scalar::pack_unorm_16_16,
+	scalar::pack_unorm_8_8_8,
+	scalar::pack_unorm_8_8_8_8,
+	scalar::unpack_snorm_10_10_10_2,
+	scalar::unpack_unorm_10_10_10_2,
+	scalar::unpack_unorm_16_16,
+	scalar::unpack_unorm_8_8_8,
+	scalar::unpack_unorm_8_8_8_8,
+	scalar::encode_octahedral,
+	scalar::decode_octahedral,
+	scalar::pack_octahedral_snorm_16_16,
+	scalar::unpack_octahedral_snorm_16_16,
+	scalar::pack_octahedral_unorm_8_8,
+	scalar::unpack_octahedral_unorm_8_8,
+	scalar::pack_smallest_three,
+	scalar::unpack_smallest_three,
+	scalar::pack_half,
+	scalar::unpack_half,
+	scalar::aos_to_soa,
+	scalar::soa_to_aos,
+	scalar::clamp_soa,
+	scalar::cross_soa,
+	scalar::dot_soa,
+	scalar::len_soa,
+	scalar::lerp_soa,
+	scalar::normalize_soa,
+	scalar::intersects_spheres_soa,
+	scalar::intersects_aabbs_soa,
+	scalar::sincos,
+	scalar::transform_float3,
+	scalar::mul_double4x4_double4,
+	scalar::to_float_relative,
+	scalar::skin_dual_quat,
+	scalar::skin_float4x4,
+	scalar::bounds_float3,
+	scalar::intersects_ray_aabbs_soa,
+	scalar::intersects_ray_spheres_soa,
+	scalar::intersects_ray_triangles_soa,
+	scalar::intersects_rays_aabb_soa,
+	scalar::intersects_rays_sphere_soa,
+	scalar::intersects_rays_triangle_soa,
+	scalar::morton_encode_float3
+};
+
+} // namespace math
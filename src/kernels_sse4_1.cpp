@@ -0,0 +1,167 @@
+#include "kernels.h"
+
+#if MATH_X86
+
+#include <smmintrin.h>
+
+
+MATH_BEGIN_TARGET("sse4.1")
+
+namespace math {
+namespace sse4_1 {
+
+constexpr size_t width = 4;
+
+struct vfloat { __m128 v; };
+struct vint { __m128i v; };
+struct vmask { __m128 v; };
+
+inline vfloat broadcast(float f) noexcept { return { _mm_set1_ps(f) }; }
+inline vint broadcast_int(int32_t i) noexcept { return { _mm_set1_epi32(i) }; }
+
+inline vfloat load(const float* p) noexcept { return { _mm_loadu_ps(p) }; }
+inline void store(float* p, vfloat a) noexcept { _mm_storeu_ps(p, a.v); }
+inline void store(uint32_t* p, vint a) noexcept { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), a.v); }
+
+inline vfloat load_lanes(const float* p, size_t) noexcept { return { _mm_loadu_ps(p) }; }
+inline void store_lanes(float* p, size_t, vfloat a) noexcept { _mm_storeu_ps(p, a.v); }
+
+template<int a, int b, int c, int d>
+inline vfloat shuffle(vfloat l, vfloat r) noexcept { return { _mm_shuffle_ps(l.v, r.v, _MM_SHUFFLE(d, c, b, a)) }; }
+inline vfloat unpack_lo(vfloat l, vfloat r) noexcept { return { _mm_unpacklo_ps(l.v, r.v) }; }
+inline vfloat unpack_hi(vfloat l, vfloat r) noexcept { return { _mm_unpackhi_ps(l.v, r.v) }; }
+
+inline vfloat operator+(vfloat l, vfloat r) noexcept { return { _mm_add_ps(l.v, r.v) }; }
+inline vfloat operator-(vfloat l, vfloat r) noexcept { return { _mm_sub_ps(l.v, r.v) }; }
+inline vfloat operator*(vfloat l, vfloat r) noexcept { return { _mm_mul_ps(l.v, r.v) }; }
+inline vfloat operator/(vfloat l, vfloat r) noexcept { return { _mm_div_ps(l.v, r.v) }; }
+inline vfloat mul_add(vfloat a, vfloat b, vfloat c) noexcept { return { _mm_add_ps(_mm_mul_ps(a.v, b.v), c.v) }; }
+inline vfloat min(vfloat l, vfloat r) noexcept { return { _mm_min_ps(l.v, r.v) }; }
+inline vfloat max(vfloat l, vfloat r) noexcept { return { _mm_max_ps(l.v, r.v) }; }
+inline vfloat sqrt(vfloat a) noexcept { return { _mm_sqrt_ps(a.v) }; }
+inline vfloat rsqrt(vfloat a) noexcept { return { _mm_rsqrt_ps(a.v) }; }
+inline vfloat abs(vfloat a) noexcept { return { _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v) }; }
+inline vfloat trunc(vfloat a) noexcept { return { _mm_round_ps(a.v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC) }; }
+
+inline vfloat copy_sign(vfloat mag, vfloat sgn) noexcept
+{
+	const __m128 sign_mask = _mm_set1_ps(-0.0f);
+	return { _mm_or_ps(_mm_andnot_ps(sign_mask, mag.v), _mm_and_ps(sign_mask, sgn.v)) };
+}
+
+inline vmask operator<(vfloat l, vfloat r) noexcept { return { _mm_cmplt_ps(l.v, r.v) }; }
+inline vmask operator>(vfloat l, vfloat r) noexcept { return { _mm_cmpgt_ps(l.v, r.v) }; }
+inline vmask operator<=(vfloat l, vfloat r) noexcept { return { _mm_cmple_ps(l.v, r.v) }; }
+inline vmask operator>=(vfloat l, vfloat r) noexcept { return { _mm_cmpge_ps(l.v, r.v) }; }
+inline vmask operator|(vmask l, vmask r) noexcept { return { _mm_or_ps(l.v, r.v) }; }
+inline vmask operator&(vmask l, vmask r) noexcept { return { _mm_and_ps(l.v, r.v) }; }
+inline vfloat select(vmask m, vfloat a, vfloat b) noexcept { return { _mm_blendv_ps(b.v, a.v, m.v) }; }
+inline uint32_t to_bits(vmask m) noexcept { return uint32_t(_mm_movemask_ps(m.v)); }
+
+inline vint to_int(vfloat a) noexcept { return { _mm_cvttps_epi32(a.v) }; }
+inline vint operator|(vint l, vint r) noexcept { return { _mm_or_si128(l.v, r.v) }; }
+inline vint operator&(vint l, vint r) noexcept { return { _mm_and_si128(l.v, r.v) }; }
+
+template<int n>
+inline vint shift_left(vint a) noexcept { return { _mm_slli_epi32(a.v, n) }; }
+
+template<int n>
+inline vint shift_right(vint a) noexcept { return { _mm_srli_epi32(a.v, n) }; }
+
+inline vint load(const uint32_t* p) noexcept { return { _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)) }; }
+inline vfloat to_float(vint a) noexcept { return { _mm_cvtepi32_ps(a.v) }; }
+
+// SSE4.1 has no gather instruction.
+inline vfloat gather(const float* p, vint idx) noexcept
+{
+	return { _mm_setr_ps(p[_mm_extract_epi32(idx.v, 0)], p[_mm_extract_epi32(idx.v, 1)],
+		p[_mm_extract_epi32(idx.v, 2)], p[_mm_extract_epi32(idx.v, 3)]) };
+}
+
+// The CPUs of this level may lack F16C, the half conversions are the ones of pack_half/unpack_half
+// (see vector.cpp) with the branches replaced by blends.
+inline void store_half(uint16_t* p, vfloat a) noexcept
+{
+	const __m128i u = _mm_castps_si128(a.v);
+	const __m128i sign = _mm_and_si128(u, _mm_set1_epi32(int32_t(0x80000000)));
+	const __m128i abs = _mm_xor_si128(u, sign);
+
+	const __m128i nan = _mm_or_si128(_mm_set1_epi32(0x7e00), _mm_and_si128(_mm_srli_epi32(abs, 13), _mm_set1_epi32(0x3ff)));
+	const __m128i inf_nan = _mm_blendv_epi8(_mm_set1_epi32(0x7c00), nan, _mm_cmpgt_epi32(abs, _mm_set1_epi32(0x7f800000)));
+	const __m128i subnormal = _mm_sub_epi32(
+		_mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(abs), _mm_set1_ps(0.5f))), _mm_set1_epi32(0x3f000000));
+	const __m128i odd = _mm_and_si128(_mm_srli_epi32(abs, 13), _mm_set1_epi32(1));
+	const __m128i normal = _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(abs, _mm_set1_epi32(int32_t(0xc8000fff))), odd), 13);
+
+	__m128i h = _mm_blendv_epi8(normal, subnormal, _mm_cmplt_epi32(abs, _mm_set1_epi32(0x38800000)));
+	h = _mm_blendv_epi8(h, inf_nan, _mm_cmpgt_epi32(abs, _mm_set1_epi32(0x477fffff)));
+	h = _mm_or_si128(h, _mm_srli_epi32(sign, 16));
+	_mm_storel_epi64(reinterpret_cast<__m128i*>(p), _mm_packus_epi32(h, h));
+}
+
+inline vfloat load_half(const uint16_t* p) noexcept
+{
+	const __m128i h = _mm_cvtepu16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p)));
+	const __m128i sign = _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(0x8000)), 16);
+	const __m128i a = _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(0x7fff)), 13);
+	const __m128i e = _mm_and_si128(a, _mm_set1_epi32(0x0f800000));
+	const __m128i zero = _mm_setzero_si128();
+
+	const __m128i quiet = _mm_andnot_si128(_mm_cmpeq_epi32(_mm_and_si128(a, _mm_set1_epi32(0x007fffff)), zero),
+		_mm_set1_epi32(0x00400000));
+	const __m128i inf_nan = _mm_or_si128(_mm_add_epi32(a, _mm_set1_epi32(0x70000000)), quiet);
+	const __m128i subnormal = _mm_castps_si128(_mm_sub_ps(
+		_mm_castsi128_ps(_mm_add_epi32(a, _mm_set1_epi32(0x38800000))), _mm_set1_ps(6.103515625e-5f)));
+	const __m128i normal = _mm_add_epi32(a, _mm_set1_epi32(0x38000000));
+
+	__m128i u = _mm_blendv_epi8(normal, subnormal, _mm_cmpeq_epi32(e, zero));
+	u = _mm_blendv_epi8(u, inf_nan, _mm_cmpeq_epi32(e, _mm_set1_epi32(0x0f800000)));
+	return { _mm_castsi128_ps(_mm_or_si128(u, sign)) };
+}
+
+// vdouble holds dwidth doubles in a pair of registers, i.e. a single double4.
+constexpr size_t dwidth = 4;
+
+struct vdouble { __m128d lo, hi; };
+
+inline vdouble broadcast_double(double d) noexcept { return { _mm_set1_pd(d), _mm_set1_pd(d) }; }
+inline vdouble load(const double* p) noexcept { return { _mm_loadu_pd(p), _mm_loadu_pd(p + 2) }; }
+
+inline void store(double* p, vdouble a) noexcept
+{
+	_mm_storeu_pd(p, a.lo);
+	_mm_storeu_pd(p + 2, a.hi);
+}
+
+// Converts a to float and stores dwidth floats.
+inline void store_float(float* p, vdouble a) noexcept
+{
+	_mm_storeu_ps(p, _mm_movelh_ps(_mm_cvtpd_ps(a.lo), _mm_cvtpd_ps(a.hi)));
+}
+
+inline vdouble operator-(vdouble l, vdouble r) noexcept { return { _mm_sub_pd(l.lo, r.lo), _mm_sub_pd(l.hi, r.hi) }; }
+inline vdouble operator*(vdouble l, vdouble r) noexcept { return { _mm_mul_pd(l.lo, r.lo), _mm_mul_pd(l.hi, r.hi) }; }
+inline vdouble mul_add(vdouble a, vdouble b, vdouble c) noexcept
+{
+	return { _mm_add_pd(_mm_mul_pd(a.lo, b.lo), c.lo), _mm_add_pd(_mm_mul_pd(a.hi, b.hi), c.hi) };
+}
+
+template<int i>
+inline vdouble splat4(vdouble v) noexcept
+{
+	const __m128d h = (i < 2) ? v.lo : v.hi;
+	const __m128d s = (i % 2 == 0) ? _mm_unpacklo_pd(h, h) : _mm_unpackhi_pd(h, h);
+	return { s, s };
+}
+
+#include "kernels_impl.h"
+
+} // namespace sse4_1
+
+const kernel_table sse4_1_kernels = sse4_1::table;
+
+} // namespace math
+
+MATH_END_TARGET
+
+#endif // MATH_X86
@@ -7,6 +7,7 @@ using math::float2;
 using math::float3;
 using math::float4;
 using math::float3x3;
+using math::float3x4;
 using math::float4x4;
 using math::int2;
 using math::int3;
@@ -54,6 +55,7 @@ public:
 		using math::is_matrix;
 
 		Assert::IsTrue(is_matrix<float3x3>());
+		Assert::IsTrue(is_matrix<float3x4>());
 		Assert::IsTrue(is_matrix<float4x4>());
 
 		Assert::IsFalse(is_matrix<int>());
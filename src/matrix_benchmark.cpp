@@ -0,0 +1,189 @@
+#include "math/matrix.h"
+
+#include <vector>
+#include "benchmark.h"
+
+using math::float2;
+using math::float3;
+using math::float4;
+using math::float3x3;
+using math::float3x4;
+using math::float4x4;
+
+
+namespace {
+
+// Returns count diagonally dominant matrices, which are always invertible.
+template<typename M>
+std::vector<M> invertible_matrices(size_t count, uint32_t seed)
+{
+	std::vector<M> v = benchmark::random_values<M>(count, -1.0f, 1.0f, seed);
+	for (M& m : v)
+		m = m + M::identity * 8.0f;
+
+	return v;
+}
+
+// float3x4 has no arithmetic operators, the diagonal is shifted directly.
+template<>
+std::vector<float3x4> invertible_matrices<float3x4>(size_t count, uint32_t seed)
+{
+	std::vector<float3x4> v = benchmark::random_values<float3x4>(count, -1.0f, 1.0f, seed);
+	for (float3x4& m : v) {
+		m.m00 += 8.0f;
+		m.m11 += 8.0f;
+		m.m22 += 8.0f;
+	}
+
+	return v;
+}
+
+template<typename M>
+void bench_inverse(benchmark::state& state)
+{
+	const std::vector<M> in = invertible_matrices<M>(state.size(), 1);
+	std::vector<M> out(state.size());
+	benchmark::map(state, in, out, [](const M& m) { return math::inverse(m); });
+}
+
+template<typename M>
+void bench_set_ox(benchmark::state& state)
+{
+	const std::vector<float3> in = benchmark::random_values<float3>(state.size(), -1.0f, 1.0f, 1);
+	std::vector<M> out(state.size(), M::identity);
+	const size_t n = state.size();
+
+	while (state.keep_running()) {
+		for (size_t i = 0; i < n; ++i) {
+			math::set_ox(out[i], in[i]);
+			math::set_oy(out[i], in[i]);
+			math::set_oz(out[i], in[i]);
+		}
+
+		benchmark::clobber_memory();
+	}
+
+	state.set_items_per_iteration(3 * n);
+}
+
+template<typename M>
+void bench_to_array(benchmark::state& state, bool column_major)
+{
+	constexpr size_t c = sizeof(M) / sizeof(float);
+	const std::vector<M> in = benchmark::random_values<M>(state.size(), -1.0f, 1.0f, 1);
+	std::vector<float> out(state.size() * c);
+	const size_t n = state.size();
+
+	while (state.keep_running()) {
+		for (size_t i = 0; i < n; ++i) {
+			if (column_major)
+				math::to_array_column_major_order(in[i], out.data() + i * c);
+			else
+				math::to_array_row_major_order(in[i], out.data() + i * c);
+		}
+
+		benchmark::clobber_memory();
+	}
+}
+
+
+// ----- float3x3 -----
+
+BENCHMARK_MAP2(add_float3x3, float3x3, float3x3, float3x3, -1.0f, 1.0f, a + b);
+BENCHMARK_MAP2(approx_equal_float3x3, uint8_t, float3x3, float3x3, -1.0f, 1.0f, math::approx_equal(a, b));
+BENCHMARK_MAP(det_float3x3, float, float3x3, -1.0f, 1.0f, math::det(a));
+BENCHMARK_MAP(div_float3x3_float, float3x3, float3x3, -1.0f, 1.0f, a / 3.0f);
+BENCHMARK_MAP2(equal_float3x3, uint8_t, float3x3, float3x3, -1.0f, 1.0f, a == b);
+BENCHMARK_MAP(is_orthogonal_float3x3, uint8_t, float3x3, -1.0f, 1.0f, math::is_orthogonal(a));
+BENCHMARK_MAP2(mul_float3x3, float3x3, float3x3, float3x3, -1.0f, 1.0f, a * b);
+BENCHMARK_MAP(mul_float3x3_float, float3x3, float3x3, -1.0f, 1.0f, a * 3.0f);
+BENCHMARK_MAP2(mul_float3x3_float2, float3, float3x3, float2, -1.0f, 1.0f, math::mul(a, b));
+BENCHMARK_MAP2(mul_float3x3_float3, float3, float3x3, float3, -1.0f, 1.0f, math::mul(a, b));
+BENCHMARK_MAP(ox_float3x3, float3, float3x3, -1.0f, 1.0f, math::ox(a) + math::oy(a) + math::oz(a));
+BENCHMARK_MAP2(sub_float3x3, float3x3, float3x3, float3x3, -1.0f, 1.0f, a - b);
+BENCHMARK_MAP(trace_float3x3, float, float3x3, -1.0f, 1.0f, math::trace(a));
+BENCHMARK_MAP(transpose_float3x3, float3x3, float3x3, -1.0f, 1.0f, math::transpose(a));
+
+void inverse_float3x3(benchmark::state& state) { bench_inverse<float3x3>(state); }
+BENCHMARK(inverse_float3x3);
+
+void set_ox_float3x3(benchmark::state& state) { bench_set_ox<float3x3>(state); }
+BENCHMARK(set_ox_float3x3);
+
+void to_array_column_major_order_float3x3(benchmark::state& state) { bench_to_array<float3x3>(state, true); }
+BENCHMARK(to_array_column_major_order_float3x3);
+
+void to_array_row_major_order_float3x3(benchmark::state& state) { bench_to_array<float3x3>(state, false); }
+BENCHMARK(to_array_row_major_order_float3x3);
+
+// ----- float3x4 -----
+
+BENCHMARK_MAP2(approx_equal_float3x4, uint8_t, float3x4, float3x4, -1.0f, 1.0f, math::approx_equal(a, b));
+BENCHMARK_MAP(det_float3x4, float, float3x4, -1.0f, 1.0f, math::det(a));
+BENCHMARK_MAP2(equal_float3x4, uint8_t, float3x4, float3x4, -1.0f, 1.0f, a == b);
+BENCHMARK_MAP2(mul_float3x4, float3x4, float3x4, float3x4, -1.0f, 1.0f, a * b);
+BENCHMARK_MAP2(transform_direction_float3x4, float3, float3x4, float3, -1.0f, 1.0f, math::transform_direction(a, b));
+BENCHMARK_MAP2(transform_point_float3x4, float3, float3x4, float3, -1.0f, 1.0f, math::transform_point(a, b));
+
+void inverse_float3x4(benchmark::state& state) { bench_inverse<float3x4>(state); }
+BENCHMARK(inverse_float3x4);
+
+// ----- float4x4 -----
+
+BENCHMARK_MAP2(add_float4x4, float4x4, float4x4, float4x4, -1.0f, 1.0f, a + b);
+BENCHMARK_MAP2(approx_equal_float4x4, uint8_t, float4x4, float4x4, -1.0f, 1.0f, math::approx_equal(a, b));
+BENCHMARK_MAP(det_float4x4, float, float4x4, -1.0f, 1.0f, math::det(a));
+BENCHMARK_MAP(div_float4x4_float, float4x4, float4x4, -1.0f, 1.0f, a / 3.0f);
+BENCHMARK_MAP2(equal_float4x4, uint8_t, float4x4, float4x4, -1.0f, 1.0f, a == b);
+BENCHMARK_MAP(is_orthogonal_float4x4, uint8_t, float4x4, -1.0f, 1.0f, math::is_orthogonal(a));
+BENCHMARK_MAP2(mul_float4x4, float4x4, float4x4, float4x4, -1.0f, 1.0f, a * b);
+BENCHMARK_MAP(mul_float4x4_float, float4x4, float4x4, -1.0f, 1.0f, a * 3.0f);
+BENCHMARK_MAP2(mul_float4x4_float2, float4, float4x4, float2, -1.0f, 1.0f, math::mul(a, b));
+BENCHMARK_MAP2(mul_float4x4_float3, float4, float4x4, float3, -1.0f, 1.0f, math::mul(a, b));
+BENCHMARK_MAP2(mul_float4x4_float4, float4, float4x4, float4, -1.0f, 1.0f, math::mul(a, b));
+BENCHMARK_MAP(ox_float4x4, float3, float4x4, -1.0f, 1.0f, math::ox(a) + math::oy(a) + math::oz(a));
+BENCHMARK_MAP2(sub_float4x4, float4x4, float4x4, float4x4, -1.0f, 1.0f, a - b);
+BENCHMARK_MAP(trace_float4x4, float, float4x4, -1.0f, 1.0f, math::trace(a));
+BENCHMARK_MAP(transpose_float4x4, float4x4, float4x4, -1.0f, 1.0f, math::transpose(a));
+
+void inverse_float4x4(benchmark::state& state) { bench_inverse<float4x4>(state); }
+BENCHMARK(inverse_float4x4);
+
+void set_ox_float4x4(benchmark::state& state) { bench_set_ox<float4x4>(state); }
+BENCHMARK(set_ox_float4x4);
+
+void to_array_column_major_order_float4x4(benchmark::state& state) { bench_to_array<float4x4>(state, true); }
+BENCHMARK(to_array_column_major_order_float4x4);
+
+void to_array_row_major_order_float4x4(benchmark::state& state) { bench_to_array<float4x4>(state, false); }
+BENCHMARK(to_array_row_major_order_float4x4);
+
+// ----- batch functions -----
+
+void mul_float4x4_batch(benchmark::state& state)
+{
+	const std::vector<float4x4> l = benchmark::random_values<float4x4>(state.size(), -1.0f, 1.0f, 1);
+	const std::vector<float4x4> r = benchmark::random_values<float4x4>(state.size(), -1.0f, 1.0f, 2);
+	std::vector<float4x4> out(state.size());
+
+	while (state.keep_running()) {
+		math::mul(l.data(), r.data(), out.data(), state.size());
+		benchmark::clobber_memory();
+	}
+}
+BENCHMARK(mul_float4x4_batch);
+
+void mul_float4x4_float4_batch(benchmark::state& state)
+{
+	const float4x4 m = benchmark::random_values<float4x4>(1, -1.0f, 1.0f, 1)[0];
+	const std::vector<float4> v = benchmark::random_values<float4>(state.size(), -1.0f, 1.0f, 2);
+	std::vector<float4> out(state.size());
+
+	while (state.keep_running()) {
+		math::mul(m, v.data(), out.data(), state.size());
+		benchmark::clobber_memory();
+	}
+}
+BENCHMARK(mul_float4x4_float4_batch);
+
+} // namespace
@@ -0,0 +1,131 @@
+#include "math/matrix_double.h"
+
+#include "kernels.h"
+
+
+namespace math {
+
+const double3x3 double3x3::identity(1, 0, 0, 0, 1, 0, 0, 0, 1);
+const double3x3 double3x3::zero;
+
+const double4x4 double4x4::identity(1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1);
+const double4x4 double4x4::zero;
+
+
+void mul(const double4x4& m, const double4* v, double4* out, size_t count) noexcept
+{
+	assert(count == 0 || (v && out));
+	active_kernels().mul_double4x4_double4(m, v, out, count);
+}
+
+std::ostream& operator<<(std::ostream& out, const double3x3& m)
+{
+	out << "double3x3("
+		<< m.m00 << ", " << m.m01 << ", " << m.m02 << ",  "
+		<< m.m10 << ", " << m.m11 << ", " << m.m12 << ",  "
+		<< m.m20 << ", " << m.m21 << ", " << m.m22 << ")";
+
+	return out;
+}
+
+std::wostream& operator<<(std::wostream& out, const double3x3& m)
+{
+	out << "double3x3("
+		<< m.m00 << ", " << m.m01 << ", " << m.m02 << ",  "
+		<< m.m10 << ", " << m.m11 << ", " << m.m12 << ",  "
+		<< m.m20 << ", " << m.m21 << ", " << m.m22 << ")";
+
+	return out;
+}
+
+std::ostream& operator<<(std::ostream& out, const double4x4& m)
+{
+	out << "double4x4("
+		<< m.m00 << ", " << m.m01 << ", " << m.m02 << ", " << m.m03 << ",  "
+		<< m.m10 << ", " << m.m11 << ", " << m.m12 << ", " << m.m13 << ",  "
+		<< m.m20 << ", " << m.m21 << ", " << m.m22 << ", " << m.m23 << ",  "
+		<< m.m30 << ", " << m.m31 << ", " << m.m32 << ", " << m.m33 << ")";
+
+	return out;
+}
+
+std::wostream& operator<<(std::wostream& out, const double4x4& m)
+{
+	out << "double4x4("
+		<< m.m00 << ", " << m.m01 << ", " << m.m02 << ", " << m.m03 << ",  "
+		<< m.m10 << ", " << m.m11 << ", " << m.m12 << ", " << m.m13 << ",  "
+		<< m.m20 << ", " << m.m21 << ", " << m.m22 << ", " << m.m23 << ",  "
+		<< m.m30 << ", " << m.m31 << ", " << m.m32 << ", " << m.m33 << ")";
+
+	return out;
+}
+
+double3x3 inverse(const double3x3& m) noexcept
+{
+	// inverse is found by Cramer's rule.
+
+	// Check whether m is a singular matix
+	const double d = det(m);
+	assert(!approx_equal(d, 0.0));
+
+	// construct the adjugate matrix.
+	// cofactor00 cofactor10 cofactor20
+	// cofactor01 cofactor11 cofactor21
+	// cofactor02 cofactor12 cofactor22
+	double3x3 adj;
+	adj.m00 = m.m11*m.m22 - m.m12*m.m21;
+	adj.m01 = -(m.m01*m.m22 - m.m02*m.m21);
+	adj.m02 = m.m01*m.m12 - m.m02*m.m11;
+
+	adj.m10 = -(m.m10*m.m22 - m.m12*m.m20);
+	adj.m11 = m.m00*m.m22 - m.m02*m.m20;
+	adj.m12 = -(m.m00*m.m12 - m.m02*m.m10);
+
+	adj.m20 = m.m10*m.m21 - m.m11*m.m20;
+	adj.m21 = -(m.m00*m.m21 - m.m01*m.m20);
+	adj.m22 = m.m00*m.m11 - m.m01*m.m10;
+
+	const double inv_d = 1.0 / d;
+	return adj * inv_d;
+}
+
+double4x4 inverse(const double4x4& m) noexcept
+{
+	// inverse is found by Cramer's rule.
+
+	// Check whether m is a singular matix
+	const double d = det(m);
+	assert(!approx_equal(d, 0.0));
+
+
+	// construct the adjugate matrix.
+	// cofactor00 cofactor10 cofactor20 cofactor30
+	// cofactor01 cofactor11 cofactor21 cofactor31
+	// cofactor02 cofactor12 cofactor22 cofactor32
+	// cofactor03 cofactor13 cofactor23 cofactor33
+	double4x4 adj;
+	adj.m00 = m.m11*m.m22*m.m33 + m.m12*m.m23*m.m31 + m.m13*m.m21*m.m32 - m.m13*m.m22*m.m31 - m.m12*m.m21*m.m33 - m.m11*m.m23*m.m32;
+	adj.m01 = -(m.m01*m.m22*m.m33 + m.m02*m.m23*m.m31 + m.m03*m.m21*m.m32 - m.m03*m.m22*m.m31 - m.m02*m.m21*m.m33 - m.m01*m.m23*m.m32);
+	adj.m02 = m.m01*m.m12*m.m33 + m.m02*m.m13*m.m31 + m.m03*m.m11*m.m32 - m.m03*m.m12*m.m31 - m.m02*m.m11*m.m33 - m.m01*m.m13*m.m32;
+	adj.m03 = -(m.m01*m.m12*m.m23 + m.m02*m.m13*m.m21 + m.m03*m.m11*m.m22 - m.m03*m.m12*m.m21 - m.m02*m.m11*m.m23 - m.m01*m.m13*m.m22);
+
+	adj.m10 = -(m.m10*m.m22*m.m33 + m.m12*m.m23*m.m30 + m.m13*m.m20*m.m32 - m.m13*m.m22*m.m30 - m.m12*m.m20*m.m33 - m.m10*m.m23*m.m32);
+	adj.m11 = m.m00*m.m22*m.m33 + m.m02*m.m23*m.m30 + m.m03*m.m20*m.m32 - m.m03*m.m22*m.m30 - m.m02*m.m20*m.m33 - m.m00*m.m23*m.m32;
+	adj.m12 = -(m.m00*m.m12*m.m33 + m.m02*m.m13*m.m30 + m.m03*m.m10*m.m32 - m.m03*m.m12*m.m30 - m.m02*m.m10*m.m33 - m.m00*m.m13*m.m32);
+	adj.m13 = m.m00*m.m12*m.m23 + m.m02*m.m13*m.m20 + m.m03*m.m10*m.m22 - m.m03*m.m12*m.m20 - m.m02*m.m10*m.m23 - m.m00*m.m13*m.m22;
+
+	adj.m20 = m.m10*m.m21*m.m33 + m.m11*m.m23*m.m30 + m.m13*m.m20*m.m31 - m.m13*m.m21*m.m30 - m.m11*m.m20*m.m33 - m.m10*m.m23*m.m31;
+	adj.m21 = -(m.m00*m.m21*m.m33 + m.m01*m.m23*m.m30 + m.m03*m.m20*m.m31 - m.m03*m.m21*m.m30 - m.m01*m.m20*m.m33 - m.m00*m.m23*m.m31);
+	adj.m22 = m.m00*m.m11*m.m33 + m.m01*m.m13*m.m30 + m.m03*m.m10*m.m31 - m.m03*m.m11*m.m30 - m.m01*m.m10*m.m33 - m.m00*m.m13*m.m31;
+	adj.m23 = -(m.m00*m.m11*m.m23 + m.m01*m.m13*m.m20 + m.m03*m.m10*m.m21 - m.m03*m.m11*m.m20 - m.m01*m.m10*m.m23 - m.m00*m.m13*m.m21);
+
+	adj.m30 = -(m.m10*m.m21*m.m32 + m.m11*m.m22*m.m30 + m.m12*m.m20*m.m31 - m.m12*m.m21*m.m30 - m.m11*m.m20*m.m32 - m.m10*m.m22*m.m31);
+	adj.m31 = m.m00*m.m21*m.m32 + m.m01*m.m22*m.m30 + m.m02*m.m20*m.m31 - m.m02*m.m21*m.m30 - m.m01*m.m20*m.m32 - m.m00*m.m22*m.m31;
+	adj.m32 = -(m.m00*m.m11*m.m32 + m.m01*m.m12*m.m30 + m.m02*m.m10*m.m31 - m.m02*m.m11*m.m30 - m.m01*m.m10*m.m32 - m.m00*m.m12*m.m31);
+	adj.m33 = m.m00*m.m11*m.m22 + m.m01*m.m12*m.m20 + m.m02*m.m10*m.m21 - m.m02*m.m11*m.m20 - m.m01*m.m10*m.m22 - m.m00*m.m12*m.m21;
+
+	const double inv_d = 1.0 / d;
+	return adj * inv_d;
+}
+
+} // namespace math
@@ -0,0 +1,70 @@
+#include "math/matrix_double.h"
+
+#include <vector>
+#include "benchmark.h"
+
+using math::double3;
+using math::double3x3;
+using math::double4;
+using math::double4x4;
+
+
+namespace {
+
+// Returns count diagonally dominant matrices, which are always invertible.
+template<typename M>
+std::vector<M> invertible_matrices(size_t count, uint32_t seed)
+{
+	std::vector<M> v = benchmark::random_values<M>(count, -1.0f, 1.0f, seed);
+	for (M& m : v)
+		m = m + M::identity * 8.0;
+
+	return v;
+}
+
+template<typename M>
+void bench_inverse(benchmark::state& state)
+{
+	const std::vector<M> in = invertible_matrices<M>(state.size(), 1);
+	std::vector<M> out(state.size());
+	benchmark::map(state, in, out, [](const M& m) { return math::inverse(m); });
+}
+
+
+// ----- double3x3 -----
+
+BENCHMARK_MAP(det_double3x3, double, double3x3, -1.0f, 1.0f, math::det(a));
+BENCHMARK_MAP2(mul_double3x3, double3x3, double3x3, double3x3, -1.0f, 1.0f, a * b);
+BENCHMARK_MAP2(mul_double3x3_double3, double3, double3x3, double3, -1.0f, 1.0f, math::mul(a, b));
+
+void inverse_double3x3(benchmark::state& state) { bench_inverse<double3x3>(state); }
+BENCHMARK(inverse_double3x3);
+
+// ----- double4x4 -----
+
+BENCHMARK_MAP2(add_double4x4, double4x4, double4x4, double4x4, -1.0f, 1.0f, a + b);
+BENCHMARK_MAP(det_double4x4, double, double4x4, -1.0f, 1.0f, math::det(a));
+BENCHMARK_MAP2(mul_double4x4, double4x4, double4x4, double4x4, -1.0f, 1.0f, a * b);
+BENCHMARK_MAP(mul_double4x4_double, double4x4, double4x4, -1.0f, 1.0f, a * 3.0);
+BENCHMARK_MAP2(mul_double4x4_double4, double4, double4x4, double4, -1.0f, 1.0f, math::mul(a, b));
+BENCHMARK_MAP(transpose_double4x4, double4x4, double4x4, -1.0f, 1.0f, math::transpose(a));
+
+void inverse_double4x4(benchmark::state& state) { bench_inverse<double4x4>(state); }
+BENCHMARK(inverse_double4x4);
+
+// ----- batch functions -----
+
+void mul_double4x4_double4_batch(benchmark::state& state)
+{
+	const double4x4 m = benchmark::random_values<double4x4>(1, -1.0f, 1.0f, 1)[0];
+	const std::vector<double4> v = benchmark::random_values<double4>(state.size(), -1.0f, 1.0f, 2);
+	std::vector<double4> out(state.size());
+
+	while (state.keep_running()) {
+		math::mul(m, v.data(), out.data(), state.size());
+		benchmark::clobber_memory();
+	}
+}
+BENCHMARK(mul_double4x4_double4_batch);
+
+} // namespace
@@ -0,0 +1,135 @@
+#include "math/matrix_double.h"
+
+#include <vector>
+#include "CppUnitTest.h"
+
+using math::double3;
+using math::double3x3;
+using math::double4;
+using math::double4x4;
+using math::float3x3;
+using math::float4;
+using math::float4x4;
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+
+namespace Microsoft { namespace VisualStudio { namespace CppUnitTestFramework {
+
+template<> inline std::wstring ToString<math::double3>(const math::double3& t) { RETURN_WIDE_STRING(t); }
+template<> inline std::wstring ToString<math::double4>(const math::double4& t) { RETURN_WIDE_STRING(t); }
+template<> inline std::wstring ToString<math::double3x3>(const math::double3x3& t) { RETURN_WIDE_STRING(t); }
+template<> inline std::wstring ToString<math::double4x4>(const math::double4x4& t) { RETURN_WIDE_STRING(t); }
+
+}}} // namespace Microsoft::VisualStudio::CppUnitTestFramework
+
+
+namespace unittest {
+
+TEST_CLASS(math_matrix_double_double3x3) {
+public:
+
+	TEST_METHOD(conversions)
+	{
+		const float3x3 f(1, 2, 3, 4, 5, 6, 7, 8, 9);
+		const double3x3 d(f);
+		Assert::AreEqual(double3x3(1, 2, 3, 4, 5, 6, 7, 8, 9), d);
+		Assert::IsTrue(f == float3x3(d));
+	}
+
+	TEST_METHOD(det_inverse_transpose)
+	{
+		const double3x3 m(4, 7, 2, 3, 6, 1, 2, 5, 3);
+		Assert::AreEqual(9.0, math::det(m));
+		Assert::IsTrue(math::approx_equal(double3x3::identity, m * math::inverse(m), 1e-12));
+		Assert::AreEqual(double3x3(4, 3, 2, 7, 6, 5, 2, 1, 3), math::transpose(m));
+		Assert::AreEqual(13.0, math::trace(m));
+	}
+
+	TEST_METHOD(mul)
+	{
+		const double3x3 m(1, 2, 3, 4, 5, 6, 7, 8, 9);
+		Assert::AreEqual(double3(14, 32, 50), math::mul(m, double3(1, 2, 3)));
+
+		double3x3 p = m;
+		p *= double3x3::identity;
+		Assert::AreEqual(m, p);
+		Assert::AreEqual(m * 2.0, m + m);
+		Assert::AreEqual(double3x3::zero, m - m);
+	}
+};
+
+TEST_CLASS(math_matrix_double_double4x4) {
+public:
+
+	TEST_METHOD(arithmetic_operators)
+	{
+		const double4x4 m(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16);
+
+		Assert::AreEqual(m * 2.0, m + m);
+		Assert::AreEqual(m * 2.0, 2.0 * m);
+		Assert::AreEqual(double4x4::zero, m - m);
+		Assert::AreEqual(m, (m * 4.0) / 4.0);
+
+		double4x4 c = m;
+		(c += m) -= m;
+		Assert::AreEqual(m, c);
+		(c *= 3.0) /= 3.0;
+		Assert::AreEqual(m, c);
+	}
+
+	TEST_METHOD(conversions)
+	{
+		const float4x4 f(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16);
+		const double4x4 d(f);
+		Assert::AreEqual(double4x4(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16), d);
+		Assert::IsTrue(f == float4x4(d));
+		Assert::AreEqual(double3x3(1, 2, 3, 5, 6, 7, 9, 10, 11), double3x3(d));
+	}
+
+	TEST_METHOD(det_inverse_transpose)
+	{
+		const double4x4 m(2, 0, 0, 1, 0, 3, 0, 2, 0, 0, 4, 3, 0, 0, 0, 1);
+		Assert::AreEqual(24.0, math::det(m));
+		Assert::IsTrue(math::approx_equal(double4x4::identity, m * math::inverse(m), 1e-12));
+		Assert::IsTrue(math::approx_equal(double4x4::identity, math::inverse(m) * m, 1e-12));
+		Assert::AreEqual(m, math::transpose(math::transpose(m)));
+		Assert::IsTrue(math::is_orthogonal(double4x4::identity));
+	}
+
+	TEST_METHOD(mul)
+	{
+		const double4x4 l(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16);
+		const double4x4 r(2, 0, 1, 0, 1, 3, 0, 1, 0, 1, 4, 2, 3, 0, 1, 5);
+
+		// compares with the float product, the values are exact in float.
+		const double4x4 expected(float4x4(l) * float4x4(r));
+		Assert::AreEqual(expected, l * r);
+
+		double4x4 p = l;
+		p *= r;
+		Assert::AreEqual(expected, p);
+
+		Assert::AreEqual(double4(30, 70, 110, 150), math::mul(l, double4(1, 2, 3, 4)));
+		Assert::AreEqual(double4(54, 118, 182, 246), math::mul(l, double3(1, 2, 3), 10.0));
+	}
+
+	TEST_METHOD(mul_batch)
+	{
+		const double4x4 m(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16);
+
+		std::vector<double4> v(11);
+		for (size_t i = 0; i < v.size(); ++i)
+			v[i] = double4(double(i), 1.0 - double(i), 0.5 * double(i), 2.0);
+
+		std::vector<double4> out(v.size());
+		math::mul(m, v.data(), out.data(), v.size());
+		for (size_t i = 0; i < v.size(); ++i)
+			Assert::AreEqual(math::mul(m, v[i]), out[i]);
+
+		// in place
+		math::mul(m, v.data(), v.data(), v.size());
+		Assert::IsTrue(out == v);
+	}
+};
+
+} // namespace unittest
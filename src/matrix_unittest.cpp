@@ -1,12 +1,12 @@
 #include "math/matrix.h"
 
-#include <Windows.h>
 #include "CppUnitTest.h"
 
 using math::float2;
 using math::float3;
 using math::float4;
 using math::float3x3;
+using math::float3x4;
 using math::float4x4;
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
@@ -16,6 +16,7 @@ namespace Microsoft { namespace VisualStudio { namespace CppUnitTestFramework {
 template<> inline std::wstring ToString<float3>(const float3& t) { RETURN_WIDE_STRING(t); }
 template<> inline std::wstring ToString<float4>(const float4& t) { RETURN_WIDE_STRING(t); }
 template<> inline std::wstring ToString<float3x3>(const float3x3& t) { RETURN_WIDE_STRING(t); }
+template<> inline std::wstring ToString<float3x4>(const float3x4& t) { RETURN_WIDE_STRING(t); }
 template<> inline std::wstring ToString<float4x4>(const float4x4& t) { RETURN_WIDE_STRING(t); }
 
 }}} // namespace Microsoft::VisualStudio::CppUnitTestFramework
@@ -175,7 +176,7 @@ public:
 		float3x3 n(0, -3, 4, 5, 6, 7, -1, 9, 2);
 
 		Assert::AreEqual(det(m * n), det(m) * det(n));
-		Assert::AreEqual(det(5.f * m), std::pow(5.f, 3)* det(m), L"|aM| = a^3 * |M|");
+		Assert::AreEqual(det(5.f * m), std::pow(5.f, 3.f)* det(m), L"|aM| = a^3 * |M|");
 		Assert::AreEqual(det(m), det(transpose(m)));
 	}
 
@@ -341,6 +342,158 @@ public:
 	}
 };
 
+TEST_CLASS(math_matrix_float3x4) {
+public:
+
+	TEST_METHOD(approx_equal)
+	{
+		using math::approx_equal;
+
+		float3x4 m(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11);
+
+		Assert::IsFalse(approx_equal(m, float3x4(100, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11)));
+		Assert::IsFalse(approx_equal(m, float3x4(0, 1, 2, 100, 4, 5, 6, 7, 8, 9, 10, 11)));
+		Assert::IsFalse(approx_equal(m, float3x4(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 100)));
+
+		Assert::IsTrue(approx_equal(m, float3x4(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11)));
+		Assert::IsTrue(approx_equal(m, float3x4(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11), 0.0f));
+		Assert::IsFalse(approx_equal(m, float3x4(0, 1, 2, 3.0001f, 4, 5, 6, 7, 8, 9, 10, 11), 0.0f));
+	}
+
+	TEST_METHOD(conversions)
+	{
+		float4x4 m4(
+			1, 2, 3, 4,
+			5, 6, 7, 8,
+			9, 10, 11, 12,
+			0, 0, 0, 1);
+
+		float3x4 m(m4);
+		Assert::AreEqual(float3x4(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12), m);
+		Assert::AreEqual(m4, static_cast<float4x4>(m));
+		Assert::AreEqual(float3x3(1, 2, 3, 5, 6, 7, 9, 10, 11), static_cast<float3x3>(m));
+	}
+
+	TEST_METHOD(ctors)
+	{
+		float3x4 m;
+		Assert::IsTrue(m.m00 == 0 && m.m01 == 0 && m.m02 == 0 && m.m03 == 0);
+		Assert::IsTrue(m.m10 == 0 && m.m11 == 0 && m.m12 == 0 && m.m13 == 0);
+		Assert::IsTrue(m.m20 == 0 && m.m21 == 0 && m.m22 == 0 && m.m23 == 0);
+
+		float3x4 m1(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12);
+		Assert::IsTrue(m1.m00 == 1 && m1.m01 == 2 && m1.m02 == 3 && m1.m03 == 4);
+		Assert::IsTrue(m1.m10 == 5 && m1.m11 == 6 && m1.m12 == 7 && m1.m13 == 8);
+		Assert::IsTrue(m1.m20 == 9 && m1.m21 == 10 && m1.m22 == 11 && m1.m23 == 12);
+
+		Assert::AreEqual(sizeof(float) * 12, sizeof(float3x4));
+	}
+
+	TEST_METHOD(det)
+	{
+		using math::det;
+
+		Assert::AreEqual(0.0f, det(float3x4::zero));
+		Assert::AreEqual(1.0f, det(float3x4::identity));
+
+		float4x4 m4(5, 7, -9, 3, 3, 4, 4, -2, 9, 8, 7, 6, 0, 0, 0, 1);
+		Assert::AreEqual(det(m4), det(float3x4(m4)));
+	}
+
+	TEST_METHOD(equal_operator)
+	{
+		float3x4 m(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11);
+
+		Assert::IsTrue(m != float3x4(100, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11));
+		Assert::IsTrue(m != float3x4(0, 1, 2, 100, 4, 5, 6, 7, 8, 9, 10, 11));
+		Assert::IsTrue(m != float3x4(0, 1, 2, 3, 4, 5, 100, 7, 8, 9, 10, 11));
+		Assert::IsTrue(m != float3x4(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 100));
+
+		Assert::IsTrue(m == float3x4(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11));
+	}
+
+	TEST_METHOD(inverse)
+	{
+		using math::approx_equal;
+		using math::inverse;
+
+		Assert::AreEqual(float3x4::identity, inverse(float3x4::identity));
+
+		float3x4 m(5, 7, -9, 3, 3, 4, 4, -2, 9, 8, 7, 6);
+		float3x4 n(4, 5, 6, 7, 9, 8, -7, 6, 1, 2, 3, 4);
+
+		Assert::IsTrue(approx_equal(float3x4::identity, m * inverse(m)));
+		Assert::IsTrue(approx_equal(float3x4::identity, inverse(m) * m));
+		Assert::IsTrue(approx_equal(m, inverse(inverse(m)), 1e-4f));
+		Assert::IsTrue(approx_equal(inverse(m * n), inverse(n) * inverse(m)));
+
+		const float4x4 m4 = static_cast<float4x4>(m);
+		Assert::IsTrue(approx_equal(float3x4(inverse(m4)), inverse(m)));
+	}
+
+	TEST_METHOD(inverse_orthonormal)
+	{
+		using math::approx_equal;
+		using math::inverse;
+		using math::inverse_orthonormal;
+
+		Assert::AreEqual(float3x4::identity, inverse_orthonormal(float3x4::identity));
+
+		// rotation by pi/2 about oz and translation (1, 2, 3).
+		float3x4 m(
+			0, -1, 0, 1,
+			1, 0, 0, 2,
+			0, 0, 1, 3);
+
+		Assert::AreEqual(float3x4(0, 1, 0, -2, -1, 0, 0, 1, 0, 0, 1, -3), inverse_orthonormal(m));
+		Assert::IsTrue(approx_equal(inverse(m), inverse_orthonormal(m)));
+		Assert::AreEqual(float3x4::identity, m * inverse_orthonormal(m));
+	}
+
+	TEST_METHOD(mul)
+	{
+		float3x4 m(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12);
+		float3x4 n(5, 7, -9, 3, 3, 4, 4, -2, 9, 8, 7, 6);
+
+		Assert::AreEqual(m, m * float3x4::identity);
+		Assert::AreEqual(m, float3x4::identity * m);
+
+		const float4x4 m4 = static_cast<float4x4>(m);
+		const float4x4 n4 = static_cast<float4x4>(n);
+		Assert::AreEqual(float3x4(m4 * n4), m * n);
+
+		float3x4 mc = m;
+		Assert::AreEqual(m * n, (mc *= n));
+
+		// out of place aliasing: the right hand side is updated.
+		float3x4 nc = n;
+		nc = m * nc;
+		Assert::AreEqual(m * n, nc);
+	}
+
+	TEST_METHOD(transform_point_direction)
+	{
+		using math::mul;
+		using math::transform_direction;
+		using math::transform_point;
+
+		float3x4 m(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12);
+		const float4x4 m4 = static_cast<float4x4>(m);
+		const float3 v(1, -2, 3);
+
+		Assert::AreEqual(float3(mul(m4, v, 1.0f)), transform_point(m, v));
+		Assert::AreEqual(float3(mul(m4, v, 0.0f)), transform_direction(m, v));
+		Assert::AreEqual(float3(4, 8, 12), transform_point(m, float3::zero));
+		Assert::AreEqual(float3::zero, transform_direction(m, float3::zero));
+	}
+
+	TEST_METHOD(static_members)
+	{
+		Assert::AreEqual(float3x4(1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0), float3x4::identity);
+		Assert::AreEqual(float3x4(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0), float3x4::zero);
+	}
+};
+
 TEST_CLASS(math_matrix_float4x4) {
 public:
 
@@ -536,7 +689,7 @@ public:
 		float4x4 n(0, -3, 4, 5, 6, 7, -1, 9, 2, -16, 4, 9, -1, 0, 5, 8);
 
 		Assert::AreEqual(det(m * n), det(m) * det(n));
-		Assert::AreEqual(det(5.0f * m), std::pow(5.0f, 4) * det(m), L"|aM| = a^4 * |M|");
+		Assert::AreEqual(det(5.0f * m), std::pow(5.0f, 4.f) * det(m), L"|aM| = a^4 * |M|");
 		Assert::AreEqual(det(m), det(transpose(m)));
 	}
 
@@ -0,0 +1,103 @@
+#include "math/morton.h"
+
+#include <algorithm>
+#include <vector>
+#include "kernels.h"
+
+
+namespace {
+
+// The sort moves the keys by digits of digit_bits bits: the histogram of a digit (8 KiB) stays in the L1 cache
+// and the 30-bit codes take 3 passes, the 63-bit ones 6.
+constexpr size_t digit_bits = 11;
+constexpr size_t bucket_count = size_t(1) << digit_bits;
+
+template<typename Key>
+void radix_sort_impl(Key* keys, uint32_t* order, size_t count)
+{
+	assert(count == 0 || (keys && order));
+	assert(count <= UINT32_MAX);
+
+	constexpr size_t digit_count = (sizeof(Key) * 8 + digit_bits - 1) / digit_bits;
+	const auto digit = [](Key k, size_t d) { return size_t(k >> (d * digit_bits)) & (bucket_count - 1); };
+
+	// the histograms of all the digits are counted in a single pass over the keys.
+	std::vector<uint32_t> histograms(digit_count * bucket_count, 0);
+	for (size_t i = 0; i < count; ++i) {
+		for (size_t d = 0; d < digit_count; ++d)
+			++histograms[d * bucket_count + digit(keys[i], d)];
+	}
+
+	// every pass moves the keys and their indices from one pair of buffers to the other,
+	// the first one reads no indices: they are the positions of the keys.
+	std::vector<Key> tmp_keys(count);
+	std::vector<uint32_t> tmp_order(count);
+	Key* const key_buffers[2] = { keys, tmp_keys.data() };
+	uint32_t* const order_buffers[2] = { order, tmp_order.data() };
+	size_t src = 0;
+	bool identity = true;
+
+	for (size_t d = 0; d < digit_count; ++d) {
+		const uint32_t* h = histograms.data() + d * bucket_count;
+		const Key* src_keys = key_buffers[src];
+		if (count == 0 || h[digit(src_keys[0], d)] == count) continue;
+
+		uint32_t offsets[bucket_count];
+		uint32_t sum = 0;
+		for (size_t b = 0; b < bucket_count; ++b) {
+			offsets[b] = sum;
+			sum += h[b];
+		}
+
+		const uint32_t* src_order = order_buffers[src];
+		Key* dst_keys = key_buffers[1 - src];
+		uint32_t* dst_order = order_buffers[1 - src];
+		for (size_t i = 0; i < count; ++i) {
+			const Key k = src_keys[i];
+			const uint32_t j = offsets[digit(k, d)]++;
+			dst_keys[j] = k;
+			dst_order[j] = identity ? uint32_t(i) : src_order[i];
+		}
+
+		src = 1 - src;
+		identity = false;
+	}
+
+	if (identity) {
+		for (size_t i = 0; i < count; ++i)
+			order[i] = uint32_t(i);
+	}
+	else if (src == 1) {
+		std::copy(tmp_keys.begin(), tmp_keys.end(), keys);
+		std::copy(tmp_order.begin(), tmp_order.end(), order);
+	}
+}
+
+} // namespace
+
+
+namespace math {
+
+void morton_encode32(const float3* p, const aabb& bounds, uint32_t* out, size_t count) noexcept
+{
+	assert(count == 0 || (p && out));
+	active_kernels().morton_encode_float3(p, bounds.min, detail::grid_scale(bounds, 10), out, sizeof(*out), count);
+}
+
+void morton_encode64(const float3* p, const aabb& bounds, uint64_t* out, size_t count) noexcept
+{
+	assert(count == 0 || (p && out));
+	active_kernels().morton_encode_float3(p, bounds.min, detail::grid_scale(bounds, 21), out, sizeof(*out), count);
+}
+
+void radix_sort(uint32_t* keys, uint32_t* order, size_t count)
+{
+	radix_sort_impl(keys, order, count);
+}
+
+void radix_sort(uint64_t* keys, uint32_t* order, size_t count)
+{
+	radix_sort_impl(keys, order, count);
+}
+
+} // namespace math
@@ -0,0 +1,101 @@
+#include "math/morton.h"
+
+#include <vector>
+#include "benchmark.h"
+
+using math::aabb;
+using math::float3;
+using math::uint3;
+
+
+namespace benchmark {
+
+// The components are within [0, 2^10).
+template<>
+inline std::vector<uint3> inputs<uint3>(size_t count, float lo, float hi, uint32_t seed)
+{
+	const std::vector<float3> f = random_values<float3>(count, lo, hi, seed);
+	std::vector<uint3> v(count);
+	for (size_t i = 0; i < count; ++i)
+		v[i] = uint3(uint32_t(f[i].x), uint32_t(f[i].y), uint32_t(f[i].z));
+
+	return v;
+}
+
+} // namespace benchmark
+
+
+namespace {
+
+BENCHMARK_MAP(morton_encode32_uint3, uint32_t, uint3, 0.0f, 1023.0f, math::morton_encode32(a));
+BENCHMARK_MAP(morton_encode64_uint3, uint64_t, uint3, 0.0f, 1023.0f, math::morton_encode64(a));
+
+// ----- batch functions -----
+
+void morton_encode32_batch(benchmark::state& state)
+{
+	const std::vector<float3> points = benchmark::random_values<float3>(state.size(), -10.0f, 10.0f, 1);
+	const aabb b = math::bounds(points.data(), points.size());
+	std::vector<uint32_t> codes(state.size());
+
+	while (state.keep_running()) {
+		math::morton_encode32(points.data(), b, codes.data(), state.size());
+		benchmark::clobber_memory();
+	}
+}
+BENCHMARK(morton_encode32_batch);
+
+void morton_encode64_batch(benchmark::state& state)
+{
+	const std::vector<float3> points = benchmark::random_values<float3>(state.size(), -10.0f, 10.0f, 1);
+	const aabb b = math::bounds(points.data(), points.size());
+	std::vector<uint64_t> codes(state.size());
+
+	while (state.keep_running()) {
+		math::morton_encode64(points.data(), b, codes.data(), state.size());
+		benchmark::clobber_memory();
+	}
+}
+BENCHMARK(morton_encode64_batch);
+
+void encode(const float3* p, const aabb& b, uint32_t* out, size_t count) noexcept
+{
+	math::morton_encode32(p, b, out, count);
+}
+
+void encode(const float3* p, const aabb& b, uint64_t* out, size_t count) noexcept
+{
+	math::morton_encode64(p, b, out, count);
+}
+
+// The keys are copied back every iteration, the sort would skip every digit of the sorted ones otherwise.
+template<typename Key>
+void radix_sort_batch(benchmark::state& state)
+{
+	const std::vector<float3> points = benchmark::random_values<float3>(state.size(), -10.0f, 10.0f, 1);
+	const aabb b = math::bounds(points.data(), points.size());
+	std::vector<Key> codes(state.size());
+	encode(points.data(), b, codes.data(), state.size());
+
+	std::vector<Key> keys(state.size());
+	std::vector<uint32_t> order(state.size());
+	while (state.keep_running()) {
+		keys = codes;
+		math::radix_sort(keys.data(), order.data(), state.size());
+		benchmark::clobber_memory();
+	}
+}
+
+void radix_sort32_batch(benchmark::state& state)
+{
+	radix_sort_batch<uint32_t>(state);
+}
+BENCHMARK(radix_sort32_batch);
+
+void radix_sort64_batch(benchmark::state& state)
+{
+	radix_sort_batch<uint64_t>(state);
+}
+BENCHMARK(radix_sort64_batch);
+
+} // namespace
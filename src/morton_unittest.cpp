@@ -0,0 +1,219 @@
+#include "math/morton.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <vector>
+#include "CppUnitTest.h"
+#include "test_utility.h"
+
+
+using math::aabb;
+using math::float3;
+using math::uint2;
+using math::uint3;
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+
+namespace Microsoft { namespace VisualStudio { namespace CppUnitTestFramework {
+
+template<> inline std::wstring ToString<math::uint2>(const math::uint2& t) { RETURN_WIDE_STRING(t); }
+template<> inline std::wstring ToString<math::uint3>(const math::uint3& t) { RETURN_WIDE_STRING(t); }
+
+}}} // namespace Microsoft::VisualStudio::CppUnitTestFramework
+
+
+namespace {
+
+// Returns a pseudo-random value of the lowest bits bits which depends on i and seed.
+uint32_t test_bits(size_t i, size_t seed, uint32_t bits) noexcept
+{
+	uint64_t h = (i + 1) * 0x9e3779b97f4a7c15 + seed * 0xbf58476d1ce4e5b9;
+	h ^= h >> 31;
+	h *= 0x94d049bb133111eb;
+	h ^= h >> 29;
+	return uint32_t(h) & uint32_t((uint64_t(1) << bits) - 1);
+}
+
+// Interleaves the bits of the components one by one: bit i of c[k] goes to bit i * n + k.
+uint64_t reference_encode(const uint32_t* c, size_t n, uint32_t bits) noexcept
+{
+	uint64_t code = 0;
+	for (uint32_t i = 0; i < bits; ++i) {
+		for (size_t k = 0; k < n; ++k)
+			code |= uint64_t((c[k] >> i) & 1) << (i * n + k);
+	}
+
+	return code;
+}
+
+// Checks that radix_sort sorts keys and that the order is the one of the stable sort.
+template<typename Key>
+void check_radix_sort(std::vector<Key> keys)
+{
+	std::vector<uint32_t> expected_order(keys.size());
+	std::iota(expected_order.begin(), expected_order.end(), 0);
+	std::stable_sort(expected_order.begin(), expected_order.end(), [&](uint32_t a, uint32_t b) { return keys[a] < keys[b]; });
+
+	std::vector<Key> expected(keys.size());
+	for (size_t i = 0; i < keys.size(); ++i)
+		expected[i] = keys[expected_order[i]];
+
+	std::vector<uint32_t> order(keys.size() + 1, 7);
+	math::radix_sort(keys.data(), order.data(), keys.size());
+	Assert::IsTrue(expected == keys);
+	Assert::IsTrue(std::equal(expected_order.begin(), expected_order.end(), order.begin()));
+	Assert::AreEqual<uint32_t>(7, order.back());
+}
+
+} // namespace
+
+
+namespace unittest {
+
+TEST_CLASS(math_morton) {
+public:
+
+	TEST_METHOD(encode_decode_2d)
+	{
+		Assert::AreEqual<uint32_t>(0, math::morton_encode32(uint2(0, 0)));
+		Assert::AreEqual<uint32_t>(1, math::morton_encode32(uint2(1, 0)));
+		Assert::AreEqual<uint32_t>(2, math::morton_encode32(uint2(0, 1)));
+		Assert::AreEqual<uint32_t>(12, math::morton_encode32(uint2(2, 2)));
+		Assert::AreEqual<uint32_t>(UINT32_MAX, math::morton_encode32(uint2(0xffff, 0xffff)));
+		Assert::AreEqual<uint64_t>(UINT64_MAX, math::morton_encode64(uint2(UINT32_MAX, UINT32_MAX)));
+
+		for (size_t i = 0; i < 1000; ++i) {
+			const uint32_t c16[2] = { test_bits(i, 1, 16), test_bits(i, 2, 16) };
+			const uint32_t code32 = math::morton_encode32(uint2(c16[0], c16[1]));
+			Assert::AreEqual(uint32_t(reference_encode(c16, 2, 16)), code32);
+			Assert::AreEqual(uint2(c16[0], c16[1]), math::morton_decode2(code32));
+
+			const uint32_t c32[2] = { test_bits(i, 3, 32), test_bits(i, 4, 32) };
+			const uint64_t code64 = math::morton_encode64(uint2(c32[0], c32[1]));
+			Assert::AreEqual(reference_encode(c32, 2, 32), code64);
+			Assert::AreEqual(uint2(c32[0], c32[1]), math::morton_decode2(code64));
+		}
+	}
+
+	TEST_METHOD(encode_decode_3d)
+	{
+		Assert::AreEqual<uint32_t>(1, math::morton_encode32(uint3(1, 0, 0)));
+		Assert::AreEqual<uint32_t>(2, math::morton_encode32(uint3(0, 1, 0)));
+		Assert::AreEqual<uint32_t>(4, math::morton_encode32(uint3(0, 0, 1)));
+		Assert::AreEqual<uint32_t>(56, math::morton_encode32(uint3(2, 2, 2)));
+		Assert::AreEqual<uint32_t>(0x3fffffff, math::morton_encode32(uint3(0x3ff)));
+		Assert::AreEqual<uint64_t>(0x7fffffffffffffff, math::morton_encode64(uint3(0x1fffff)));
+
+		for (size_t i = 0; i < 1000; ++i) {
+			const uint32_t c10[3] = { test_bits(i, 1, 10), test_bits(i, 2, 10), test_bits(i, 3, 10) };
+			const uint32_t code32 = math::morton_encode32(uint3(c10[0], c10[1], c10[2]));
+			Assert::AreEqual(uint32_t(reference_encode(c10, 3, 10)), code32);
+			Assert::AreEqual(uint3(c10[0], c10[1], c10[2]), math::morton_decode3(code32));
+
+			const uint32_t c21[3] = { test_bits(i, 4, 21), test_bits(i, 5, 21), test_bits(i, 6, 21) };
+			const uint64_t code64 = math::morton_encode64(uint3(c21[0], c21[1], c21[2]));
+			Assert::AreEqual(reference_encode(c21, 3, 21), code64);
+			Assert::AreEqual(uint3(c21[0], c21[1], c21[2]), math::morton_decode3(code64));
+		}
+
+		// the unused highest bits are ignored.
+		Assert::AreEqual(uint3(1, 2, 3), math::morton_decode3(math::morton_encode32(uint3(1, 2, 3)) | 0xc0000000));
+		Assert::AreEqual(uint3(1, 2, 3), math::morton_decode3(math::morton_encode64(uint3(1, 2, 3)) | (uint64_t(1) << 63)));
+	}
+
+	TEST_METHOD(encode_batch)
+	{
+		const aabb b(float3(-10, 0, 5), float3(10, 40, 6));
+		std::vector<float3> points(max_test_count);
+		for (size_t i = 0; i < max_test_count; ++i)
+			points[i] = float3(test_value(i, 1, 12.0f), test_value(i, 2, 40.0f) + 20.0f, test_value(i, 3, 0.5f) + 5.5f);
+
+		// the corners and the points outside of the bounds.
+		points[1] = b.min;
+		points[5] = b.max;
+		points[16] = float3(-20, 50, 5.5f);
+		// NaN goes to the cell 0.
+		points[8] = float3(std::numeric_limits<float>::quiet_NaN(), 20, std::numeric_limits<float>::infinity());
+
+		for_each_isa_level([&] {
+			for (size_t count : test_counts) {
+				std::vector<uint32_t> codes32(count + 1, 7);
+				math::morton_encode32(points.data(), b, codes32.data(), count);
+				std::vector<uint64_t> codes64(count + 1, 7);
+				math::morton_encode64(points.data(), b, codes64.data(), count);
+
+				for (size_t i = 0; i < count; ++i) {
+					Assert::AreEqual(math::morton_encode32(math::quantize(points[i], b, 10)), codes32[i]);
+					Assert::AreEqual(math::morton_encode64(math::quantize(points[i], b, 21)), codes64[i]);
+				}
+
+				Assert::AreEqual<uint32_t>(7, codes32[count]);
+				Assert::AreEqual<uint64_t>(7, codes64[count]);
+			}
+		});
+
+		// every point of a flat box is in the cell 0 along the flat axis.
+		const aabb flat(float3(0, 0, 1), float3(1, 1, 1));
+		const std::vector<float3> corners(max_test_count, flat.max);
+		for_each_isa_level([&] {
+			std::vector<uint64_t> codes(max_test_count, 7);
+			math::morton_encode64(corners.data(), flat, codes.data(), max_test_count);
+			for (uint64_t c : codes)
+				Assert::AreEqual(math::morton_encode64(uint3(0x1fffff, 0x1fffff, 0)), c);
+		});
+	}
+
+	TEST_METHOD(quantize)
+	{
+		const aabb b(float3(-1, 0, 2), float3(1, 4, 3));
+		Assert::AreEqual(uint3(0, 0, 0), math::quantize(b.min, b, 10));
+		Assert::AreEqual(uint3(1023, 1023, 1023), math::quantize(b.max, b, 10));
+		Assert::AreEqual(uint3(512, 512, 512), math::quantize(math::center(b), b, 10));
+		Assert::AreEqual(uint3(1, 3, 0), math::quantize(float3(-0.5f, 3.5f, 2.1f), b, 2));
+
+		// the points outside of the bounds are clamped.
+		Assert::AreEqual(uint3(0, 3, 0), math::quantize(float3(-5, 9, 2.1f), b, 2));
+		Assert::AreEqual(uint3(0x1fffff, 0, 0x1fffff), math::quantize(float3(8, -1, 100), b, 21));
+
+		// NaN coordinates go to the cell 0.
+		const float nan = std::numeric_limits<float>::quiet_NaN();
+		Assert::AreEqual(uint3(0, 3, 0), math::quantize(float3(nan, 9, nan), b, 2));
+
+		// the axes of no extent.
+		const aabb p(float3(1, 2, 3), float3(1, 2, 3));
+		Assert::AreEqual(uint3(0, 0, 0), math::quantize(float3(1, 2, 3), p, 10));
+		Assert::AreEqual(uint3(0, 0, 0), math::quantize(float3(4, 5, 6), p, 10));
+	}
+
+	TEST_METHOD(radix_sort)
+	{
+		for (size_t count : { 0, 1, 2, 17, 1000, 5000 }) {
+			std::vector<uint32_t> keys32(count);
+			std::vector<uint64_t> keys64(count);
+			for (size_t i = 0; i < count; ++i) {
+				// a few duplicates check the stability.
+				keys32[i] = test_bits(i % 900, 1, 30);
+				keys64[i] = (uint64_t(test_bits(i % 900, 2, 31)) << 32) | test_bits(i % 900, 3, 32);
+			}
+
+			check_radix_sort(keys32);
+			check_radix_sort(keys64);
+		}
+
+		// the digits every key has the same are skipped, so the keys end up in either of the buffers.
+		for (uint32_t shift : { 0, 11, 22 }) {
+			std::vector<uint32_t> keys(300);
+			for (size_t i = 0; i < keys.size(); ++i)
+				keys[i] = 0x5a5a5a5a ^ (test_bits(i, 4, 11) << shift);
+
+			check_radix_sort(keys);
+		}
+
+		check_radix_sort(std::vector<uint32_t>(100, 42));
+		check_radix_sort(std::vector<uint64_t>(100, UINT64_MAX));
+		check_radix_sort(std::vector<uint64_t>{ UINT64_MAX, 0, uint64_t(1) << 63, 1, UINT32_MAX });
+	}
+};
+
+} // namespace unittest
@@ -0,0 +1,70 @@
+#include "math/ray.h"
+
+#include "kernels.h"
+
+
+namespace math {
+
+std::ostream& operator<<(std::ostream& o, const ray& r)
+{
+	o << "ray(" << r.origin << ", " << r.direction << ")";
+	return o;
+}
+
+std::wostream& operator<<(std::wostream& o, const ray& r)
+{
+	o << "ray(" << r.origin << ", " << r.direction << ")";
+	return o;
+}
+
+void intersects(const ray& r, const float3_soa& min, const float3_soa& max, float t_max, float* t) noexcept
+{
+	assert(min.size() == max.size());
+	assert(min.size() == 0 || t);
+	active_kernels().intersects_ray_aabbs_soa(r, min.components(), max.components(), t_max, t, min.size());
+}
+
+void intersects(const ray& r, const float4_soa& spheres, float t_max, float* t) noexcept
+{
+	assert(spheres.size() == 0 || t);
+	active_kernels().intersects_ray_spheres_soa(r, spheres.components(), t_max, t, spheres.size());
+}
+
+void intersects(const ray& r, const float3_soa& v0, const float3_soa& v1, const float3_soa& v2,
+	float t_max, float* t) noexcept
+{
+	assert(v0.size() == v1.size() && v0.size() == v2.size());
+	assert(v0.size() == 0 || t);
+	active_kernels().intersects_ray_triangles_soa(r, v0.components(), v1.components(), v2.components(),
+		t_max, t, v0.size());
+}
+
+void intersects(const float3_soa& origins, const float3_soa& directions, const float* t_max,
+	const aabb& b, float* t) noexcept
+{
+	assert(origins.size() == directions.size());
+	assert(origins.size() == 0 || (t_max && t));
+	active_kernels().intersects_rays_aabb_soa(origins.components(), directions.components(), t_max,
+		b, t, origins.size());
+}
+
+void intersects(const float3_soa& origins, const float3_soa& directions, const float* t_max,
+	const float3& center, float radius, float* t) noexcept
+{
+	assert(origins.size() == directions.size());
+	assert(origins.size() == 0 || (t_max && t));
+	assert(radius >= 0.0f);
+	active_kernels().intersects_rays_sphere_soa(origins.components(), directions.components(), t_max,
+		center, radius, t, origins.size());
+}
+
+void intersects(const float3_soa& origins, const float3_soa& directions, const float* t_max,
+	const float3& v0, const float3& v1, const float3& v2, float* t) noexcept
+{
+	assert(origins.size() == directions.size());
+	assert(origins.size() == 0 || (t_max && t));
+	active_kernels().intersects_rays_triangle_soa(origins.components(), directions.components(), t_max,
+		v0, v1, v2, t, origins.size());
+}
+
+} // namespace math
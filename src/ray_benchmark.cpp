@@ -0,0 +1,167 @@
+#include "math/ray.h"
+
+#include <limits>
+#include <vector>
+#include "benchmark.h"
+
+using math::aabb;
+using math::float3;
+using math::float3_soa;
+using math::float4;
+using math::float4_soa;
+using math::ray;
+
+
+namespace benchmark {
+
+// The rays start around (0, 0, -20) and point into the [-10, 10] cube the test primitives are placed in.
+template<>
+inline std::vector<ray> inputs<ray>(size_t count, float lo, float hi, uint32_t seed)
+{
+	const std::vector<float3> o = random_values<float3>(count, -1.0f, 1.0f, seed);
+	const std::vector<float3> target = random_values<float3>(count, lo, hi, seed + 1);
+	std::vector<ray> v(count);
+	for (size_t i = 0; i < count; ++i) {
+		const float3 origin = o[i] + float3(0, 0, -20);
+		v[i] = ray(origin, target[i] - origin);
+	}
+
+	return v;
+}
+
+} // namespace benchmark
+
+
+namespace {
+
+constexpr float inf = std::numeric_limits<float>::infinity();
+
+// The primitives of the benchmarks: boxes, spheres and triangles of about 1/10 of the scene size.
+struct ray_scene final {
+	explicit ray_scene(size_t count)
+		: lo(count), hi(count), spheres(count), v0(count), v1(count), v2(count)
+	{
+		const std::vector<float3> c = benchmark::random_values<float3>(count, -10.0f, 10.0f, 2);
+		const std::vector<float3> e = benchmark::random_values<float3>(count, 0.1f, 1.0f, 3);
+		const std::vector<float3> a = benchmark::random_values<float3>(count, -1.0f, 1.0f, 4);
+		const std::vector<float3> b = benchmark::random_values<float3>(count, -1.0f, 1.0f, 5);
+		for (size_t i = 0; i < count; ++i) {
+			lo.set(i, c[i] - e[i]);
+			hi.set(i, c[i] + e[i]);
+			spheres.set(i, float4(c[i].x, c[i].y, c[i].z, e[i].x));
+			v0.set(i, c[i]);
+			v1.set(i, c[i] + a[i]);
+			v2.set(i, c[i] + b[i]);
+		}
+	}
+
+	float3_soa lo, hi;
+	float4_soa spheres;
+	float3_soa v0, v1, v2;
+};
+
+// The rays of the many rays vs a single primitive benchmarks.
+struct ray_packet final {
+	explicit ray_packet(size_t count)
+		: origins(count), directions(count), t_max(count, inf)
+	{
+		const std::vector<ray> rays = benchmark::inputs<ray>(count, -1.0f, 1.0f, 6);
+		for (size_t i = 0; i < count; ++i) {
+			origins.set(i, rays[i].origin);
+			directions.set(i, rays[i].direction);
+		}
+	}
+
+	float3_soa origins, directions;
+	std::vector<float> t_max;
+};
+
+const aabb bench_box(float3(-1.0f), float3(1.0f));
+const float3 bench_v0(-1, -1, 0), bench_v1(1, -1, 0), bench_v2(0, 1, 0);
+
+// t is set to the distance or the infinity: the branch free form of the batch kernels.
+BENCHMARK_MAP(intersects_ray_aabb, float, ray, -1.0f, 1.0f,
+	[&] { float t = inf; math::intersects(a, bench_box, inf, t); return t; }());
+BENCHMARK_MAP(intersects_ray_sphere, float, ray, -1.0f, 1.0f,
+	[&] { float t = inf; math::intersects(a, float3::zero, 1.0f, inf, t); return t; }());
+BENCHMARK_MAP(intersects_ray_triangle, float, ray, -1.0f, 1.0f,
+	[&] { float t = inf; math::intersects(a, bench_v0, bench_v1, bench_v2, inf, t); return t; }());
+
+// ----- batch functions -----
+
+void intersects_ray_aabbs_batch(benchmark::state& state)
+{
+	const ray_scene scene(state.size());
+	const ray r = benchmark::inputs<ray>(1, -10.0f, 10.0f, 1)[0];
+	std::vector<float> t(state.size());
+
+	while (state.keep_running()) {
+		math::intersects(r, scene.lo, scene.hi, inf, t.data());
+		benchmark::clobber_memory();
+	}
+}
+BENCHMARK(intersects_ray_aabbs_batch);
+
+void intersects_ray_spheres_batch(benchmark::state& state)
+{
+	const ray_scene scene(state.size());
+	const ray r = benchmark::inputs<ray>(1, -10.0f, 10.0f, 1)[0];
+	std::vector<float> t(state.size());
+
+	while (state.keep_running()) {
+		math::intersects(r, scene.spheres, inf, t.data());
+		benchmark::clobber_memory();
+	}
+}
+BENCHMARK(intersects_ray_spheres_batch);
+
+void intersects_ray_triangles_batch(benchmark::state& state)
+{
+	const ray_scene scene(state.size());
+	const ray r = benchmark::inputs<ray>(1, -10.0f, 10.0f, 1)[0];
+	std::vector<float> t(state.size());
+
+	while (state.keep_running()) {
+		math::intersects(r, scene.v0, scene.v1, scene.v2, inf, t.data());
+		benchmark::clobber_memory();
+	}
+}
+BENCHMARK(intersects_ray_triangles_batch);
+
+void intersects_rays_aabb_batch(benchmark::state& state)
+{
+	const ray_packet rays(state.size());
+	std::vector<float> t(state.size());
+
+	while (state.keep_running()) {
+		math::intersects(rays.origins, rays.directions, rays.t_max.data(), bench_box, t.data());
+		benchmark::clobber_memory();
+	}
+}
+BENCHMARK(intersects_rays_aabb_batch);
+
+void intersects_rays_sphere_batch(benchmark::state& state)
+{
+	const ray_packet rays(state.size());
+	std::vector<float> t(state.size());
+
+	while (state.keep_running()) {
+		math::intersects(rays.origins, rays.directions, rays.t_max.data(), float3::zero, 1.0f, t.data());
+		benchmark::clobber_memory();
+	}
+}
+BENCHMARK(intersects_rays_sphere_batch);
+
+void intersects_rays_triangle_batch(benchmark::state& state)
+{
+	const ray_packet rays(state.size());
+	std::vector<float> t(state.size());
+
+	while (state.keep_running()) {
+		math::intersects(rays.origins, rays.directions, rays.t_max.data(), bench_v0, bench_v1, bench_v2, t.data());
+		benchmark::clobber_memory();
+	}
+}
+BENCHMARK(intersects_rays_triangle_batch);
+
+} // namespace
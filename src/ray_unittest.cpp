@@ -0,0 +1,266 @@
+#include "math/ray.h"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+#include "CppUnitTest.h"
+#include "test_utility.h"
+
+
+using math::aabb;
+using math::float3;
+using math::float3_soa;
+using math::float4;
+using math::float4_soa;
+using math::ray;
+using unittest::test_float3;
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+
+namespace Microsoft { namespace VisualStudio { namespace CppUnitTestFramework {
+
+template<> inline std::wstring ToString<math::float3>(const math::float3& t) { RETURN_WIDE_STRING(t); }
+template<> inline std::wstring ToString<math::ray>(const math::ray& t) { RETURN_WIDE_STRING(t); }
+
+}}} // namespace Microsoft::VisualStudio::CppUnitTestFramework
+
+
+namespace {
+
+constexpr float inf = std::numeric_limits<float>::infinity();
+
+// Returns a ray from around (0, 0, -10) towards the [-2, 2] cube, the most of the test primitives are hit.
+ray test_ray(size_t i, size_t seed) noexcept
+{
+	const float3 o = float3(0, 0, -10) + test_float3(i, seed, 1.0f);
+	return ray(o, test_float3(i, seed + 3, 2.0f) - o);
+}
+
+// Returns true if both distances are misses or both are the same hits.
+bool near(float expected, float actual) noexcept
+{
+	if (std::isinf(expected) || std::isinf(actual)) return expected == actual;
+	return math::approx_equal(expected, actual, 1e-4f);
+}
+
+// Returns the distance of the hit of the scalar function or infinity.
+template<typename... Args>
+float hit(const ray& r, const Args&... args) noexcept
+{
+	float t = inf;
+	math::intersects(r, args..., t);
+	return t;
+}
+
+} // namespace
+
+
+namespace unittest {
+
+TEST_CLASS(math_ray) {
+public:
+
+	TEST_METHOD(ctors)
+	{
+		const ray r(float3(1, 2, 3), float3(4, 5, 6));
+		Assert::AreEqual(float3(1, 2, 3), r.origin);
+		Assert::AreEqual(float3(4, 5, 6), r.direction);
+
+		const ray z;
+		Assert::AreEqual(float3::zero, z.origin);
+		Assert::AreEqual(float3::zero, z.direction);
+	}
+
+	TEST_METHOD(equal_operator)
+	{
+		const ray r(float3(1, 2, 3), float3(4, 5, 6));
+		Assert::AreEqual(r, ray(float3(1, 2, 3), float3(4, 5, 6)));
+		Assert::AreNotEqual(r, ray(float3(0, 2, 3), float3(4, 5, 6)));
+		Assert::AreNotEqual(r, ray(float3(1, 2, 3), float3(4, 5, 0)));
+	}
+
+	TEST_METHOD(intersects_aabb)
+	{
+		const aabb b(float3(-1, -1, -1), float3(1, 1, 1));
+		float t = 7.0f;
+
+		Assert::IsTrue(math::intersects(ray(float3(0, 0, -5), float3(0, 0, 1)), b, inf, t));
+		Assert::AreEqual(4.0f, t);
+		Assert::IsTrue(math::intersects(ray(float3(0, 0, -5), float3(0, 0, 2)), b, inf, t));
+		Assert::AreEqual(2.0f, t);
+		Assert::IsTrue(math::intersects(ray(float3(-3, 0.5f, -3), float3(1, 0, 1)), b, inf, t));
+		Assert::AreEqual(2.0f, t);
+
+		// the origin is inside.
+		Assert::IsTrue(math::intersects(ray(float3(0.5f, 0, 0), float3(1, 2, 3)), b, inf, t));
+		Assert::AreEqual(0.0f, t);
+
+		// misses keep t.
+		t = 7.0f;
+		Assert::IsFalse(math::intersects(ray(float3(0, 0, -5), float3(0, 0, -1)), b, inf, t));
+		Assert::IsFalse(math::intersects(ray(float3(0, 2, -5), float3(0, 0, 1)), b, inf, t));
+		Assert::IsFalse(math::intersects(ray(float3(0, 0, -5), float3(0, 0, 1)), b, 3.9f, t));
+		Assert::IsFalse(math::intersects(ray(float3(-6, 0, -3), float3(1, 0, 1)), b, inf, t));
+		Assert::AreEqual(7.0f, t);
+	}
+
+	TEST_METHOD(intersects_sphere)
+	{
+		const float3 c(1, 2, 3);
+		float t = 7.0f;
+
+		Assert::IsTrue(math::intersects(ray(float3(1, 2, -5), float3(0, 0, 1)), c, 2.0f, inf, t));
+		Assert::AreEqual(6.0f, t);
+		Assert::IsTrue(math::intersects(ray(float3(1, 2, -5), float3(0, 0, 4)), c, 2.0f, inf, t));
+		Assert::AreEqual(1.5f, t);
+
+		// the origin is inside, the exit point is hit.
+		Assert::IsTrue(math::intersects(ray(c, float3(1, 0, 0)), c, 2.0f, inf, t));
+		Assert::AreEqual(2.0f, t);
+
+		t = 7.0f;
+		Assert::IsFalse(math::intersects(ray(float3(1, 2, -5), float3(0, 0, -1)), c, 2.0f, inf, t));
+		Assert::IsFalse(math::intersects(ray(float3(1, 4.5f, -5), float3(0, 0, 1)), c, 2.0f, inf, t));
+		Assert::IsFalse(math::intersects(ray(float3(1, 2, -5), float3(0, 0, 1)), c, 2.0f, 5.9f, t));
+		Assert::AreEqual(7.0f, t);
+	}
+
+	TEST_METHOD(intersects_triangle)
+	{
+		const float3 v0(0, 0, 1), v1(2, 0, 1), v2(0, 2, 1);
+		float t = 7.0f;
+
+		Assert::IsTrue(math::intersects(ray(float3(0.5f, 0.5f, -3), float3(0, 0, 1)), v0, v1, v2, inf, t));
+		Assert::AreEqual(4.0f, t);
+		Assert::IsTrue(math::intersects(ray(float3(0.5f, 0.5f, -3), float3(0, 0, 2)), v0, v1, v2, inf, t));
+		Assert::AreEqual(2.0f, t);
+
+		// both sides are hit.
+		Assert::IsTrue(math::intersects(ray(float3(0.5f, 0.5f, 3), float3(0, 0, -1)), v0, v1, v2, inf, t));
+		Assert::AreEqual(2.0f, t);
+		Assert::IsTrue(math::intersects(ray(float3(0.5f, 0.5f, 3), float3(0, 0, -1)), v0, v2, v1, inf, t));
+		Assert::AreEqual(2.0f, t);
+
+		t = 7.0f;
+		// outside of every edge, behind, too far and parallel.
+		Assert::IsFalse(math::intersects(ray(float3(1.5f, 1.5f, -3), float3(0, 0, 1)), v0, v1, v2, inf, t));
+		Assert::IsFalse(math::intersects(ray(float3(-0.5f, 0.5f, -3), float3(0, 0, 1)), v0, v1, v2, inf, t));
+		Assert::IsFalse(math::intersects(ray(float3(0.5f, -0.5f, -3), float3(0, 0, 1)), v0, v1, v2, inf, t));
+		Assert::IsFalse(math::intersects(ray(float3(0.5f, 0.5f, -3), float3(0, 0, -1)), v0, v1, v2, inf, t));
+		Assert::IsFalse(math::intersects(ray(float3(0.5f, 0.5f, -3), float3(0, 0, 1)), v0, v1, v2, 3.9f, t));
+		Assert::IsFalse(math::intersects(ray(float3(0.5f, 0.5f, 0), float3(1, 0, 0)), v0, v1, v2, inf, t));
+		Assert::AreEqual(7.0f, t);
+	}
+
+	TEST_METHOD(intersects_ray_batch)
+	{
+		std::vector<aabb> boxes(max_test_count);
+		std::vector<float4> spheres(max_test_count);
+		std::vector<float3> v0(max_test_count), v1(max_test_count), v2(max_test_count);
+		for (size_t i = 0; i < max_test_count; ++i) {
+			const float3 c = test_float3(i, 1, 2.0f);
+			const float3 e = float3(0.1f) + 0.5f * math::abs(test_float3(i, 4, 1.0f));
+			boxes[i] = aabb(c - e, c + e);
+			spheres[i] = float4(c.x, c.y, c.z, e.x);
+			v0[i] = c;
+			v1[i] = c + float3(2.0f, test_value(i, 7), test_value(i, 8));
+			v2[i] = c + float3(test_value(i, 9), 2.0f, test_value(i, 10));
+		}
+
+		for (size_t n : { size_t(0), size_t(3), size_t(11) }) {
+			const ray r = test_ray(n, 13);
+			const float t_max = (n == 3) ? 0.9f : inf;
+
+			for_each_isa_level([&] {
+				for (size_t count : test_counts) {
+					float3_soa lo(count), hi(count);
+					const float4_soa sp(spheres.data(), count);
+					const float3_soa a(v0.data(), count), b(v1.data(), count), c(v2.data(), count);
+					for (size_t i = 0; i < count; ++i) {
+						lo.set(i, boxes[i].min);
+						hi.set(i, boxes[i].max);
+					}
+
+					std::vector<float> t_box(max_test_count, 7.0f);
+					std::vector<float> t_sphere(max_test_count, 7.0f);
+					std::vector<float> t_tri(max_test_count, 7.0f);
+					math::intersects(r, lo, hi, t_max, t_box.data());
+					math::intersects(r, sp, t_max, t_sphere.data());
+					math::intersects(r, a, b, c, t_max, t_tri.data());
+
+					for (size_t i = 0; i < count; ++i) {
+						const float3 sc(spheres[i].x, spheres[i].y, spheres[i].z);
+						Assert::IsTrue(near(hit(r, boxes[i], t_max), t_box[i]));
+						Assert::IsTrue(near(hit(r, sc, spheres[i].w, t_max), t_sphere[i]));
+						Assert::IsTrue(near(hit(r, v0[i], v1[i], v2[i], t_max), t_tri[i]));
+					}
+
+					for (size_t i = count; i < max_test_count; ++i) {
+						Assert::AreEqual(7.0f, t_box[i]);
+						Assert::AreEqual(7.0f, t_sphere[i]);
+						Assert::AreEqual(7.0f, t_tri[i]);
+					}
+				}
+			});
+		}
+	}
+
+	TEST_METHOD(intersects_rays_batch)
+	{
+		std::vector<ray> rays(max_test_count);
+		std::vector<float> t_max(max_test_count);
+		for (size_t i = 0; i < max_test_count; ++i) {
+			rays[i] = test_ray(i, 1);
+			t_max[i] = (i % 3 == 0) ? 0.9f : inf;
+		}
+
+		const aabb box(float3(-1.5f, -1.5f, -1), float3(1.5f, 1.5f, 1));
+		const float3 center(0.5f, 0, 0);
+		const float3 v0(-2, -2, 0), v1(2, -1, 0.5f), v2(0, 2, -0.5f);
+
+		// a part of the rays hit.
+		size_t box_hits = 0;
+		for (size_t i = 0; i < max_test_count; ++i) {
+			if (!std::isinf(hit(rays[i], box, t_max[i]))) ++box_hits;
+		}
+		Assert::IsTrue(box_hits > max_test_count / 4 && box_hits < max_test_count);
+
+		for_each_isa_level([&] {
+			for (size_t count : test_counts) {
+				float3_soa origins(count), directions(count);
+				for (size_t i = 0; i < count; ++i) {
+					origins.set(i, rays[i].origin);
+					directions.set(i, rays[i].direction);
+				}
+
+				std::vector<float> t_box(max_test_count, 7.0f);
+				std::vector<float> t_sphere(max_test_count, 7.0f);
+				std::vector<float> t_tri(max_test_count, 7.0f);
+				math::intersects(origins, directions, t_max.data(), box, t_box.data());
+				math::intersects(origins, directions, t_max.data(), center, 1.5f, t_sphere.data());
+				math::intersects(origins, directions, t_max.data(), v0, v1, v2, t_tri.data());
+
+				for (size_t i = 0; i < count; ++i) {
+					Assert::IsTrue(near(hit(rays[i], box, t_max[i]), t_box[i]));
+					Assert::IsTrue(near(hit(rays[i], center, 1.5f, t_max[i]), t_sphere[i]));
+					Assert::IsTrue(near(hit(rays[i], v0, v1, v2, t_max[i]), t_tri[i]));
+				}
+
+				for (size_t i = count; i < max_test_count; ++i) {
+					Assert::AreEqual(7.0f, t_box[i]);
+					Assert::AreEqual(7.0f, t_sphere[i]);
+					Assert::AreEqual(7.0f, t_tri[i]);
+				}
+			}
+		});
+	}
+
+	TEST_METHOD(point_at)
+	{
+		const ray r(float3(1, 2, 3), float3(4, 5, 6));
+		Assert::AreEqual(r.origin, math::point_at(r, 0.0f));
+		Assert::AreEqual(float3(9, 12, 15), math::point_at(r, 2.0f));
+	}
+};
+
+} // namespace unittest
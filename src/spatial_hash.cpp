@@ -0,0 +1,153 @@
+#include "math/spatial_hash.h"
+
+#include <mutex>
+
+
+namespace {
+
+// The minimum number of points hashed or moved by a single task.
+constexpr size_t grain = 16 * 1024;
+
+// The minimum number of queries run by a single task.
+constexpr size_t query_grain = 256;
+
+// The neighbors of a range of queries, see spatial_hash::query.
+struct query_range final {
+	size_t begin;
+	std::vector<uint32_t> counts;
+	std::vector<uint32_t> neighbors;
+};
+
+} // namespace
+
+
+namespace math {
+
+constexpr int32_t spatial_hash::max_cell;
+constexpr uint64_t spatial_hash::empty_key;
+
+
+spatial_hash::spatial_hash(float cell_size) noexcept
+	: cell_size_(cell_size), inv_cell_size_(1.0f / cell_size)
+{
+	assert(cell_size > 0.0f);
+}
+
+void spatial_hash::build(const float3* positions, size_t count, thread_pool* pool)
+{
+	assert(count == 0 || positions);
+	assert(count <= UINT32_MAX);
+
+	// there are at most count cells, the table is at most half full.
+	size_t capacity = 16;
+	size_t shift = 60;
+	while (capacity < 2 * count) {
+		capacity *= 2;
+		--shift;
+	}
+
+	if (slots_.size() != capacity) slots_ = std::vector<slot>(capacity);
+
+	hash_shift_ = shift;
+	indices_.resize(count);
+	positions_.resize(count);
+	point_slots_.resize(count);
+
+	parallel_for(pool, capacity, grain, [&](size_t begin, size_t end) {
+		for (size_t s = begin; s < end; ++s) {
+			slots_[s].key.store(empty_key, std::memory_order_relaxed);
+			slots_[s].end.store(0, std::memory_order_relaxed);
+		}
+	});
+
+	// the cells are inserted and their points are counted (in slot::end).
+	parallel_for(pool, count, grain, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			const size_t s = insert(cell_key(cell(positions[i])));
+			point_slots_[i] = uint32_t(s);
+			slots_[s].end.fetch_add(1, std::memory_order_relaxed);
+		}
+	});
+
+	// the ranges of the cells follow each other in the order of the slots,
+	// slot::end becomes the position the next point of the cell is moved to.
+	uint32_t sum = 0;
+	cell_count_ = 0;
+	for (slot& s : slots_) {
+		const uint32_t n = s.end.load(std::memory_order_relaxed);
+		s.begin = sum;
+		s.end.store(sum, std::memory_order_relaxed);
+		sum += n;
+		if (n > 0) ++cell_count_;
+	}
+
+	parallel_for(pool, count, grain, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			const uint32_t j = slots_[point_slots_[i]].end.fetch_add(1, std::memory_order_relaxed);
+			indices_[j] = uint32_t(i);
+			positions_[j] = positions[i];
+		}
+	});
+}
+
+size_t spatial_hash::find(const int3& c, const uint32_t*& indices) const noexcept
+{
+	const slot* s = find_slot(cell_key(c));
+	if (!s) return 0;
+
+	indices = indices_.data() + s->begin;
+	return s->end.load(std::memory_order_relaxed) - s->begin;
+}
+
+size_t spatial_hash::insert(uint64_t key) noexcept
+{
+	const size_t mask = slots_.size() - 1;
+	for (size_t s = home_slot(key);; s = (s + 1) & mask) {
+		uint64_t k = slots_[s].key.load(std::memory_order_relaxed);
+		// another thread may take the empty slot first, k is its key then.
+		if (k == empty_key && slots_[s].key.compare_exchange_strong(k, key, std::memory_order_relaxed)) return s;
+		if (k == key) return s;
+	}
+}
+
+void spatial_hash::query(const float3* centers, size_t count, float radius,
+	std::vector<uint32_t>& offsets, std::vector<uint32_t>& neighbors, thread_pool* pool) const
+{
+	assert(count == 0 || centers);
+	assert(radius >= 0.0f);
+
+	// every range of queries collects its neighbors, the ranges are concatenated in their order afterwards.
+	std::vector<query_range> ranges;
+	std::mutex mutex;
+	parallel_for(pool, count, query_grain, [&](size_t begin, size_t end) {
+		query_range r;
+		r.begin = begin;
+		r.counts.reserve(end - begin);
+		for (size_t i = begin; i < end; ++i) {
+			const size_t first = r.neighbors.size();
+			query(centers[i], radius, [&](uint32_t p) { r.neighbors.push_back(p); });
+			r.counts.push_back(uint32_t(r.neighbors.size() - first));
+		}
+
+		std::lock_guard<std::mutex> lock(mutex);
+		ranges.push_back(std::move(r));
+	});
+
+	std::sort(ranges.begin(), ranges.end(), [](const query_range& l, const query_range& r) { return l.begin < r.begin; });
+
+	offsets.resize(count + 1);
+	offsets[0] = 0;
+	neighbors.clear();
+	size_t i = 0;
+	for (const query_range& r : ranges) {
+		for (uint32_t n : r.counts) {
+			assert(size_t(offsets[i]) + n <= UINT32_MAX);
+			offsets[i + 1] = offsets[i] + n;
+			++i;
+		}
+
+		neighbors.insert(neighbors.end(), r.neighbors.begin(), r.neighbors.end());
+	}
+}
+
+} // namespace math
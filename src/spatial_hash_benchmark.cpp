@@ -0,0 +1,49 @@
+#include "math/spatial_hash.h"
+
+#include <cmath>
+#include <vector>
+#include "benchmark.h"
+
+using math::float3;
+using math::spatial_hash;
+
+
+namespace {
+
+// The points fill a cube with about 8 points per unit cell whatever their number is.
+std::vector<float3> bench_points(size_t count, uint32_t seed)
+{
+	const float half = 0.5f * std::cbrt(float(count) / 8.0f);
+	return benchmark::random_values<float3>(count, -half, half, seed);
+}
+
+// ----- batch functions -----
+
+void build_spatial_hash_batch(benchmark::state& state)
+{
+	const std::vector<float3> points = bench_points(state.size(), 1);
+	spatial_hash h(1.0f);
+
+	while (state.keep_running()) {
+		h.build(points.data(), state.size());
+		benchmark::do_not_optimize(h.cell_count());
+	}
+}
+BENCHMARK(build_spatial_hash_batch);
+
+// Every point queries its neighbors, about 35 of them.
+void query_spatial_hash_batch(benchmark::state& state)
+{
+	const std::vector<float3> points = bench_points(state.size(), 1);
+	spatial_hash h(1.0f);
+	h.build(points.data(), state.size());
+	std::vector<uint32_t> offsets, neighbors;
+
+	while (state.keep_running()) {
+		h.query(points.data(), state.size(), 1.0f, offsets, neighbors);
+		benchmark::clobber_memory();
+	}
+}
+BENCHMARK(query_spatial_hash_batch);
+
+} // namespace
@@ -0,0 +1,217 @@
+#include "math/spatial_hash.h"
+
+#include <algorithm>
+#include <limits>
+#include <set>
+#include <tuple>
+#include <vector>
+#include "CppUnitTest.h"
+#include "test_utility.h"
+
+
+using math::float3;
+using math::int3;
+using math::spatial_hash;
+using unittest::test_float3;
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+
+namespace Microsoft { namespace VisualStudio { namespace CppUnitTestFramework {
+
+template<> inline std::wstring ToString<math::int3>(const math::int3& t) { RETURN_WIDE_STRING(t); }
+
+}}} // namespace Microsoft::VisualStudio::CppUnitTestFramework
+
+
+namespace {
+
+std::vector<float3> test_points(size_t count, float range)
+{
+	std::vector<float3> points(count);
+	for (size_t i = 0; i < count; ++i)
+		points[i] = test_float3(i, 1, range);
+
+	return points;
+}
+
+// Returns the sorted indices of the points found by the query.
+std::vector<uint32_t> find_neighbors(const spatial_hash& h, const float3& center, float radius)
+{
+	std::vector<uint32_t> res;
+	h.query(center, radius, [&](uint32_t p) { res.push_back(p); });
+	std::sort(res.begin(), res.end());
+	return res;
+}
+
+// Returns the sorted indices of the points within radius of center testing every point.
+std::vector<uint32_t> reference_query(const std::vector<float3>& points, const float3& center, float radius)
+{
+	std::vector<uint32_t> res;
+	for (uint32_t i = 0; i < points.size(); ++i) {
+		if (math::len_squared(points[i] - center) <= radius * radius) res.push_back(i);
+	}
+
+	return res;
+}
+
+// Checks that every point is in its cell once and the number of the cells.
+void check_cells(const spatial_hash& h, const std::vector<float3>& points)
+{
+	Assert::AreEqual(points.size(), h.size());
+
+	std::vector<uint32_t> sorted(h.point_indices(), h.point_indices() + h.size());
+	std::sort(sorted.begin(), sorted.end());
+	for (size_t i = 0; i < sorted.size(); ++i)
+		Assert::AreEqual<uint32_t>(uint32_t(i), sorted[i]);
+
+	std::set<std::tuple<int32_t, int32_t, int32_t>> cells;
+	for (uint32_t i = 0; i < points.size(); ++i) {
+		const int3 c = h.cell(points[i]);
+		cells.emplace(c.x, c.y, c.z);
+
+		const uint32_t* indices = nullptr;
+		const size_t n = h.find(c, indices);
+		Assert::IsTrue(std::find(indices, indices + n, i) != indices + n);
+	}
+
+	Assert::AreEqual(cells.size(), h.cell_count());
+}
+
+} // namespace
+
+
+namespace unittest {
+
+TEST_CLASS(math_spatial_hash) {
+public:
+
+	TEST_METHOD(build)
+	{
+		spatial_hash h(0.5f);
+		Assert::AreEqual(0.5f, h.cell_size());
+
+		// the hash is rebuilt with more and fewer points.
+		for (size_t count : { 1, 17, 1000, 5000, 100 }) {
+			const std::vector<float3> points = test_points(count, 10.0f);
+			h.build(points.data(), count);
+			check_cells(h, points);
+		}
+
+		// the coincident points share their cell.
+		const std::vector<float3> same(100, float3(1, 2, 3));
+		h.build(same.data(), same.size());
+		check_cells(h, same);
+		Assert::AreEqual<size_t>(1, h.cell_count());
+	}
+
+	TEST_METHOD(build_parallel)
+	{
+		const std::vector<float3> points = test_points(100000, 50.0f);
+		test_thread_pool pool;
+		spatial_hash h(2.0f);
+		h.build(points.data(), points.size(), &pool);
+		Assert::IsTrue(pool.run_count > 0);
+		check_cells(h, points);
+
+		for (size_t i = 0; i < 50; ++i) {
+			const float3 c = test_float3(i, 10, 50.0f);
+			Assert::IsTrue(reference_query(points, c, 3.0f) == find_neighbors(h, c, 3.0f));
+		}
+	}
+
+	TEST_METHOD(cell)
+	{
+		const spatial_hash h(2.0f);
+		Assert::AreEqual(int3(0, -1, 1), h.cell(float3(0.5f, -0.5f, 2.0f)));
+		Assert::AreEqual(int3(-2, 3, 0), h.cell(float3(-4.0f, 7.9f, 0.0f)));
+
+		// the far away points are clamped to the border cells.
+		Assert::AreEqual(int3(spatial_hash::max_cell, -spatial_hash::max_cell, 0), h.cell(float3(1e20f, -1e20f, 1.0f)));
+		const float inf = std::numeric_limits<float>::infinity();
+		Assert::AreEqual(int3(-spatial_hash::max_cell, spatial_hash::max_cell, 0), h.cell(float3(-inf, inf, 1.0f)));
+
+		// NaN goes to the cell -max_cell.
+		const float nan = std::numeric_limits<float>::quiet_NaN();
+		Assert::AreEqual(int3(-spatial_hash::max_cell, 1, -spatial_hash::max_cell), h.cell(float3(nan, 2.0f, nan)));
+	}
+
+	TEST_METHOD(empty)
+	{
+		spatial_hash h;
+		Assert::AreEqual<size_t>(0, h.size());
+		Assert::AreEqual<size_t>(0, h.cell_count());
+		Assert::IsTrue(find_neighbors(h, float3::zero, 10.0f).empty());
+
+		const uint32_t* indices = nullptr;
+		Assert::AreEqual<size_t>(0, h.find(int3(0, 0, 0), indices));
+
+		h.build(nullptr, 0);
+		Assert::AreEqual<size_t>(0, h.cell_count());
+		Assert::IsTrue(find_neighbors(h, float3::zero, 10.0f).empty());
+
+		std::vector<uint32_t> offsets, neighbors(3);
+		h.query(nullptr, 0, 1.0f, offsets, neighbors);
+		Assert::IsTrue(offsets == std::vector<uint32_t>(1, 0));
+		Assert::IsTrue(neighbors.empty());
+	}
+
+	TEST_METHOD(query)
+	{
+		const std::vector<float3> points = test_points(3000, 10.0f);
+		spatial_hash h(1.0f);
+		h.build(points.data(), points.size());
+
+		// the radii are smaller and larger than the cells.
+		for (float radius : { 0.0f, 0.3f, 1.0f, 2.5f }) {
+			size_t found = 0;
+			for (size_t i = 0; i < 100; ++i) {
+				const float3 c = test_float3(i, 20, 11.0f);
+				const std::vector<uint32_t> expected = reference_query(points, c, radius);
+				Assert::IsTrue(expected == find_neighbors(h, c, radius));
+				found += expected.size();
+			}
+
+			Assert::IsTrue(radius < 1.0f || found > 100);
+		}
+
+		// the points themselves and the points exactly at the radius are found.
+		Assert::IsTrue(find_neighbors(h, points[7], 0.0f) == reference_query(points, points[7], 0.0f));
+		const float3 p[2] = { float3(0.5f, 0.5f, 0.5f), float3(2.5f, 0.5f, 0.5f) };
+		spatial_hash h2(1.0f);
+		h2.build(p, 2);
+		Assert::IsTrue(find_neighbors(h2, p[0], 2.0f) == std::vector<uint32_t>({ 0, 1 }));
+	}
+
+	TEST_METHOD(query_batch)
+	{
+		const std::vector<float3> points = test_points(5000, 20.0f);
+		std::vector<float3> centers(1000);
+		for (size_t i = 0; i < centers.size(); ++i)
+			centers[i] = test_float3(i, 30, 20.0f);
+
+		spatial_hash h(1.5f);
+		h.build(points.data(), points.size());
+
+		std::vector<uint32_t> offsets, neighbors;
+		h.query(centers.data(), centers.size(), 1.5f, offsets, neighbors);
+		Assert::AreEqual(centers.size() + 1, offsets.size());
+		Assert::AreEqual(size_t(offsets.back()), neighbors.size());
+		Assert::IsTrue(neighbors.size() > centers.size());
+
+		for (size_t i = 0; i < centers.size(); ++i) {
+			std::vector<uint32_t> found(neighbors.begin() + offsets[i], neighbors.begin() + offsets[i + 1]);
+			std::sort(found.begin(), found.end());
+			Assert::IsTrue(reference_query(points, centers[i], 1.5f) == found);
+		}
+
+		// the queries run on the pool give the same results.
+		test_thread_pool pool;
+		std::vector<uint32_t> pool_offsets, pool_neighbors(7);
+		h.query(centers.data(), centers.size(), 1.5f, pool_offsets, pool_neighbors, &pool);
+		Assert::AreEqual<size_t>(1, pool.run_count);
+		Assert::IsTrue(offsets == pool_offsets);
+		Assert::IsTrue(neighbors == pool_neighbors);
+	}
+};
+
+} // namespace unittest
@@ -0,0 +1,78 @@
+#ifndef MATH_SRC_TEST_UTILITY_H_
+#define MATH_SRC_TEST_UTILITY_H_
+
+// The helpers shared by the unittests.
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
+#include "math/dispatch.h"
+#include "math/parallel.h"
+#include "math/vector_float.h"
+
+
+namespace unittest {
+
+// The numbers of elements the batch functions are tested with.
+// They cover the empty input, the input shorter than a SIMD register and the inputs with tails.
+constexpr size_t test_counts[] = { 0, 1, 3, 4, 5, 8, 15, 16, 17, 37 };
+constexpr size_t max_test_count = 37;
+
+// Returns a value from [-range, range] which depends on i and seed.
+inline float test_value(size_t i, size_t seed, float range = 1.0f) noexcept
+{
+	const size_t h = (i * 7919 + seed * 104729) % 2001;
+	return range * (float(h) / 1000.0f - 1.0f);
+}
+
+// Returns a vector from the [-range, range] cube which depends on i and seed.
+inline math::float3 test_float3(size_t i, size_t seed, float range) noexcept
+{
+	return math::float3(test_value(i, seed, range), test_value(i, seed + 1, range), test_value(i, seed + 2, range));
+}
+
+// Runs every task on its own thread, counts the run calls.
+class test_thread_pool final : public math::thread_pool {
+public:
+
+	size_t concurrency() const noexcept override
+	{
+		return 3;
+	}
+
+	void run(size_t task_count, const std::function<void(size_t)>& task) override
+	{
+		++run_count;
+
+		std::vector<std::thread> threads;
+		for (size_t i = 1; i < task_count; ++i)
+			threads.emplace_back(task, i);
+
+		if (task_count > 0) task(0);
+		for (std::thread& t : threads)
+			t.join();
+	}
+
+
+	size_t run_count = 0;
+};
+
+// Calls func once for every instruction set level supported by the CPU.
+template<typename Func>
+void for_each_isa_level(Func func)
+{
+	const math::isa_level prev_level = math::active_isa_level();
+
+	for (uint8_t l = 0; l <= uint8_t(math::supported_isa_level()); ++l) {
+		math::force_isa_level(math::isa_level(l));
+		func();
+	}
+
+	math::force_isa_level(prev_level);
+}
+
+} // namespace unittest
+
+#endif // MATH_SRC_TEST_UTILITY_H_
@@ -1,18 +1,186 @@
 #include "math/transform.h"
 
+#include "kernels.h"
+
 
 namespace math {
+namespace {
 
-quat from_axis_angle_rotation(const float3& axis, float angle) noexcept
+// The batch rotation builders compute the sines and cosines of sincos_block angles at a time.
+constexpr size_t sincos_block = 256;
+
+// Calls build(i, s, c) for every i in [0, count), s and c are the sine and cosine of angles[i] * scale.
+template<typename Build>
+void for_each_sincos(const float* angles, float scale, size_t count, sincos_precision precision, Build build) noexcept
+{
+	float a[sincos_block];
+	float s[sincos_block];
+	float c[sincos_block];
+	const kernel_table& kernels = active_kernels();
+
+	for (size_t begin = 0; begin < count; begin += sincos_block) {
+		const size_t n = std::min(sincos_block, count - begin);
+		for (size_t k = 0; k < n; ++k)
+			a[k] = angles[begin + k] * scale;
+
+		kernels.sincos(a, s, c, n, precision == sincos_precision::fast);
+		for (size_t k = 0; k < n; ++k)
+			build(begin + k, s[k], c[k]);
+	}
+}
+
+// The functions below implement the builders of both the float and the double families.
+// Q, V and M are quaternion, vector and matrix types of the same family, T is their component type.
+
+template<typename Q, typename V, typename T>
+Q from_axis_angle_rotation_impl(const V& axis, T angle) noexcept
 {
 	assert(is_normalized(axis));
 
-	if (approx_equal(angle, 0.0f)) return quat::identity; // no angle - no rotation
+	if (approx_equal(angle, T(0))) return Q::identity; // no angle - no rotation
+
+	const T half_angle = angle * T(0.5);
+	const T c = std::cos(half_angle);
+	const T s = std::sin(half_angle);
+	return Q(axis.x * s, axis.y * s, axis.z * s, c);
+}
 
-	const float half_angle = angle * 0.5f;
-	const float c = std::cos(half_angle);
-	const float s = std::sin(half_angle);
-	return quat(axis.x * s, axis.y * s, axis.z * s, c);
+template<typename M, typename Q>
+M rotation_matrix_impl(const Q& q) noexcept
+{
+	using T = decltype(q.x);
+
+	const T l = len(q);
+	if (approx_equal(l, T(0))) return M::zero;
+
+	const T s = T(2) / l;
+	const T xx = q.x * q.x;
+	const T yy = q.y * q.y;
+	const T zz = q.z * q.z;
+	const T ax = q.a * q.x;
+	const T ay = q.a * q.y;
+	const T az = q.a * q.z;
+	const T xy = q.x * q.y;
+	const T xz = q.x * q.z;
+	const T yz = q.y * q.z;
+
+	M rot = M::identity;
+	rot.m00 = T(1) - s * (yy + zz);
+	rot.m01 = s * (xy - az);
+	rot.m02 = s * (xz + ay);
+
+	rot.m10 = s * (xy + az);
+	rot.m11 = T(1) - s * (xx + zz);
+	rot.m12 = s * (yz - ax);
+
+	rot.m20 = s * (xz - ay);
+	rot.m21 = s * (yz + ax);
+	rot.m22 = T(1) - s * (xx + yy);
+
+	return rot;
+}
+
+template<typename M, typename V, typename T>
+M rotation_matrix_impl(const V& axis, T angle) noexcept
+{
+	assert(is_normalized(axis));
+
+	const T cos_a = std::cos(angle);
+	const T sin_a = std::sin(angle);
+	const T one_minus_cos_a = (T(1) - cos_a);
+	const T xx = axis.x * axis.x;
+	const T xy = axis.x * axis.y;
+	const T xz = axis.x * axis.z;
+	const T yy = axis.y * axis.y;
+	const T yz = axis.y * axis.z;
+	const T zz = axis.z * axis.z;
+
+	M rot = M::identity;
+	rot.m00 = cos_a + one_minus_cos_a * xx;
+	rot.m01 = one_minus_cos_a * xy - axis.z * sin_a;
+	rot.m02 = one_minus_cos_a * xz + axis.y * sin_a;
+
+	rot.m10 = one_minus_cos_a * xy + axis.z * sin_a;
+	rot.m11 = cos_a + one_minus_cos_a * yy;
+	rot.m12 = one_minus_cos_a * yz - axis.x * sin_a;
+
+	rot.m20 = one_minus_cos_a * xz - axis.y * sin_a;
+	rot.m21 = one_minus_cos_a * yz + axis.x * sin_a;
+	rot.m22 = cos_a + one_minus_cos_a * zz;
+
+	return rot;
+}
+
+template<typename M, typename V>
+M rotation_matrix_impl(const V& position, const V& target, const V& up) noexcept
+{
+	assert(position != target);
+	assert(is_normalized(up));
+
+	const V forward = normalize(target - position);
+	const V right = normalize(cross(up, forward));
+	const V new_up = normalize(cross(forward, right));
+
+	M r = M::identity;
+	r.m00 = right.x;	r.m01 = new_up.x;	r.m02 = forward.x;
+	r.m10 = right.y;	r.m11 = new_up.y;	r.m12 = forward.y;
+	r.m20 = right.z;	r.m21 = new_up.z;	r.m22 = forward.z;
+
+	return r;
+}
+
+template<typename M, typename V>
+M scale_matrix_impl(const V& s) noexcept
+{
+	assert(!approx_equal(s, V::zero));
+
+	M m = M::identity;
+	m.m00 = s.x;
+	m.m11 = s.y;
+	m.m22 = s.z;
+	return m;
+}
+
+template<typename M, typename V>
+M view_matrix_impl(const V& position, const V& target, const V& up) noexcept
+{
+	assert(position != target);
+	assert(is_normalized(up));
+
+	const V forward = normalize(target - position);
+	const V right = normalize(cross(forward, up));
+	const V new_up = normalize(cross(right, forward));
+
+	M r = M::identity;
+	r.m00 = right.x;	r.m01 = right.y;	r.m02 = right.z;	r.m03 = dot(right, -position);
+	r.m10 = new_up.x;	r.m11 = new_up.y;	r.m12 = new_up.z;	r.m13 = dot(new_up, -position);
+	r.m20 = -forward.x;	r.m21 = -forward.y;	r.m22 = -forward.z;	r.m23 = dot(forward, position);
+
+	return r;
+}
+
+} // namespace
+
+quat from_axis_angle_rotation(const float3& axis, float angle) noexcept
+{
+	return from_axis_angle_rotation_impl<quat>(axis, angle);
+}
+
+dquat from_axis_angle_rotation(const double3& axis, double angle) noexcept
+{
+	return from_axis_angle_rotation_impl<dquat>(axis, angle);
+}
+
+void from_axis_angle_rotation(const float3* axes, const float* angles, quat* out, size_t count,
+	sincos_precision precision) noexcept
+{
+	assert(count == 0 || (axes && angles && out));
+
+	for_each_sincos(angles, 0.5f, count, precision, [axes, out](size_t i, float s, float c) {
+		const float3& axis = axes[i];
+		assert(is_normalized(axis));
+		out[i] = quat(axis.x * s, axis.y * s, axis.z * s, c);
+	});
 }
 
 template<typename M>
@@ -68,6 +236,7 @@ quat from_rotation_matrix(const M& m) noexcept
 }
 
 template quat from_rotation_matrix(const float3x3& m) noexcept;
+template quat from_rotation_matrix(const float3x4& m) noexcept;
 template quat from_rotation_matrix(const float4x4& m) noexcept;
 
 float4x4 orthographic_matrix_directx(float width, float height, float near_z, float far_z) noexcept
@@ -217,96 +386,65 @@ template<typename M>
 M rotation_matrix(const quat& q) noexcept
 {
 	static_assert(is_matrix<M>(), "M must be a matrix.");
-
-	const float l = len(q);
-	if (approx_equal(l, 0.0f)) return M::zero;
-
-	const float s = 2.0f / l;
-	const float xx = q.x * q.x;
-	const float yy = q.y * q.y;
-	const float zz = q.z * q.z;
-	const float ax = q.a * q.x;
-	const float ay = q.a * q.y;
-	const float az = q.a * q.z;
-	const float xy = q.x * q.y;
-	const float xz = q.x * q.z;
-	const float yz = q.y * q.z;
-
-	M rot = M::identity;
-	rot.m00 = 1.0f - s * (yy + zz);
-	rot.m01 = s * (xy - az);
-	rot.m02 = s * (xz + ay);
-
-	rot.m10 = s * (xy + az);
-	rot.m11 = 1.0f - s * (xx + zz);
-	rot.m12 = s * (yz - ax);
-
-	rot.m20 = s * (xz - ay);
-	rot.m21 = s * (yz + ax);
-	rot.m22 = 1.0f - s * (xx + yy);
-
-	return rot;
+	return rotation_matrix_impl<M>(q);
 }
 
 template float3x3 rotation_matrix(const quat& q) noexcept;
+template float3x4 rotation_matrix(const quat& q) noexcept;
 template float4x4 rotation_matrix(const quat& q) noexcept;
 
 template<typename M>
-M rotation_matrix(const float3& axis, float angle) noexcept
+M rotation_matrix(const dquat& q) noexcept
 {
 	static_assert(is_matrix<M>(), "M must be a matrix.");
-	assert(is_normalized(axis));
-
-	const float cos_a = std::cos(angle);
-	const float sin_a = std::sin(angle);
-	const float one_minus_cos_a = (1.f - cos_a);
-	const float xx = axis.x * axis.x;
-	const float xy = axis.x * axis.y;
-	const float xz = axis.x * axis.z;
-	const float yy = axis.y * axis.y;
-	const float yz = axis.y * axis.z;
-	const float zz = axis.z * axis.z;
-
-	M rot = M::identity;
-	rot.m00 = cos_a + one_minus_cos_a * xx;
-	rot.m01 = one_minus_cos_a * xy - axis.z * sin_a;
-	rot.m02 = one_minus_cos_a * xz + axis.y * sin_a;
-
-	rot.m10 = one_minus_cos_a * xy + axis.z * sin_a;
-	rot.m11 = cos_a + one_minus_cos_a * yy;
-	rot.m12 = one_minus_cos_a * yz - axis.x * sin_a;
+	return rotation_matrix_impl<M>(q);
+}
 
-	rot.m20 = one_minus_cos_a * xz - axis.y * sin_a;
-	rot.m21 = one_minus_cos_a * yz + axis.x * sin_a;
-	rot.m22 = cos_a + one_minus_cos_a * zz;
+template double3x3 rotation_matrix(const dquat& q) noexcept;
+template double4x4 rotation_matrix(const dquat& q) noexcept;
 
-	return rot;
+template<typename M>
+M rotation_matrix(const float3& axis, float angle) noexcept
+{
+	static_assert(is_matrix<M>(), "M must be a matrix.");
+	return rotation_matrix_impl<M>(axis, angle);
 }
 
 template float3x3 rotation_matrix(const float3& axis, float angle) noexcept;
+template float3x4 rotation_matrix(const float3& axis, float angle) noexcept;
 template float4x4 rotation_matrix(const float3& axis, float angle) noexcept;
 
 template<typename M>
-M rotation_matrix(const float3& position, const float3& target, const float3& up) noexcept
+M rotation_matrix(const double3& axis, double angle) noexcept
 {
 	static_assert(is_matrix<M>(), "M must be a matrix.");
-	assert(position != target);
-	assert(is_normalized(up));
-
-	const float3 forward = normalize(target - position);
-	const float3 right = normalize(cross(up, forward));
-	const float3 new_up = normalize(cross(forward, right));
+	return rotation_matrix_impl<M>(axis, angle);
+}
 
-	M r = M::identity;
-	set_ox(r, right);
-	set_oy(r, new_up);
-	set_oz(r, forward);
+template double3x3 rotation_matrix(const double3& axis, double angle) noexcept;
+template double4x4 rotation_matrix(const double3& axis, double angle) noexcept;
 
-	return r;
+template<typename M>
+M rotation_matrix(const float3& position, const float3& target, const float3& up) noexcept
+{
+	static_assert(is_matrix<M>(), "M must be a matrix.");
+	return rotation_matrix_impl<M>(position, target, up);
 }
+
 template float3x3 rotation_matrix(const float3& position, const float3& target, const float3& up) noexcept;
+template float3x4 rotation_matrix(const float3& position, const float3& target, const float3& up) noexcept;
 template float4x4 rotation_matrix(const float3& position, const float3& target, const float3& up) noexcept;
 
+template<typename M>
+M rotation_matrix(const double3& position, const double3& target, const double3& up) noexcept
+{
+	static_assert(is_matrix<M>(), "M must be a matrix.");
+	return rotation_matrix_impl<M>(position, target, up);
+}
+
+template double3x3 rotation_matrix(const double3& position, const double3& target, const double3& up) noexcept;
+template double4x4 rotation_matrix(const double3& position, const double3& target, const double3& up) noexcept;
+
 template<typename M>
 M rotation_matrix_ox(float angle) noexcept
 {
@@ -327,8 +465,29 @@ M rotation_matrix_ox(float angle) noexcept
 }
 
 template float3x3 rotation_matrix_ox(float angle) noexcept;
+template float3x4 rotation_matrix_ox(float angle) noexcept;
 template float4x4 rotation_matrix_ox(float angle) noexcept;
 
+template<typename M>
+void rotation_matrix_ox(const float* angles, M* out, size_t count, sincos_precision precision) noexcept
+{
+	static_assert(is_matrix<M>(), "M must be a matrix.");
+	assert(count == 0 || (angles && out));
+
+	for_each_sincos(angles, 1.0f, count, precision, [out](size_t i, float sin_a, float cos_a) {
+		M r = M::identity;
+		r.m11 = cos_a;
+		r.m21 = sin_a;
+		r.m12 = -sin_a;
+		r.m22 = cos_a;
+		out[i] = r;
+	});
+}
+
+template void rotation_matrix_ox(const float* angles, float3x3* out, size_t count, sincos_precision precision) noexcept;
+template void rotation_matrix_ox(const float* angles, float3x4* out, size_t count, sincos_precision precision) noexcept;
+template void rotation_matrix_ox(const float* angles, float4x4* out, size_t count, sincos_precision precision) noexcept;
+
 template<typename M>
 M rotation_matrix_oy(float angle) noexcept
 {
@@ -349,8 +508,29 @@ M rotation_matrix_oy(float angle) noexcept
 }
 
 template float3x3 rotation_matrix_oy(float angle) noexcept;
+template float3x4 rotation_matrix_oy(float angle) noexcept;
 template float4x4 rotation_matrix_oy(float angle) noexcept;
 
+template<typename M>
+void rotation_matrix_oy(const float* angles, M* out, size_t count, sincos_precision precision) noexcept
+{
+	static_assert(is_matrix<M>(), "M must be a matrix.");
+	assert(count == 0 || (angles && out));
+
+	for_each_sincos(angles, 1.0f, count, precision, [out](size_t i, float sin_a, float cos_a) {
+		M r = M::identity;
+		r.m00 = cos_a;
+		r.m20 = -sin_a;
+		r.m02 = sin_a;
+		r.m22 = cos_a;
+		out[i] = r;
+	});
+}
+
+template void rotation_matrix_oy(const float* angles, float3x3* out, size_t count, sincos_precision precision) noexcept;
+template void rotation_matrix_oy(const float* angles, float3x4* out, size_t count, sincos_precision precision) noexcept;
+template void rotation_matrix_oy(const float* angles, float4x4* out, size_t count, sincos_precision precision) noexcept;
+
 template<typename M>
 M rotation_matrix_oz(float angle) noexcept
 {
@@ -371,39 +551,127 @@ M rotation_matrix_oz(float angle) noexcept
 }
 
 template float3x3 rotation_matrix_oz(float angle) noexcept;
+template float3x4 rotation_matrix_oz(float angle) noexcept;
 template float4x4 rotation_matrix_oz(float angle) noexcept;
 
 template<typename M>
-M scale_matrix(const float3& s) noexcept
+void rotation_matrix_oz(const float* angles, M* out, size_t count, sincos_precision precision) noexcept
 {
 	static_assert(is_matrix<M>(), "M must be a matrix.");
-	assert(!approx_equal(s, float3::zero));
+	assert(count == 0 || (angles && out));
+
+	for_each_sincos(angles, 1.0f, count, precision, [out](size_t i, float sin_a, float cos_a) {
+		M r = M::identity;
+		r.m00 = cos_a;
+		r.m10 = sin_a;
+		r.m01 = -sin_a;
+		r.m11 = cos_a;
+		out[i] = r;
+	});
+}
 
-	M m = M::identity;
-	m.m00 = s.x;
-	m.m11 = s.y;
-	m.m22 = s.z;
-	return m;
+template void rotation_matrix_oz(const float* angles, float3x3* out, size_t count, sincos_precision precision) noexcept;
+template void rotation_matrix_oz(const float* angles, float3x4* out, size_t count, sincos_precision precision) noexcept;
+template void rotation_matrix_oz(const float* angles, float4x4* out, size_t count, sincos_precision precision) noexcept;
+
+template<typename M>
+M scale_matrix(const float3& s) noexcept
+{
+	static_assert(is_matrix<M>(), "M must be a matrix.");
+	return scale_matrix_impl<M>(s);
 }
 
 template float3x3 scale_matrix(const float3& s) noexcept;
+template float3x4 scale_matrix(const float3& s) noexcept;
 template float4x4 scale_matrix(const float3& s) noexcept;
 
-float4x4 view_matrix(const float3& position, const float3& target, const float3& up) noexcept
+template<typename M>
+M scale_matrix(const double3& s) noexcept
 {
-	assert(position != target);
-	assert(is_normalized(up));
+	static_assert(is_matrix<M>(), "M must be a matrix.");
+	return scale_matrix_impl<M>(s);
+}
 
-	const float3 forward = normalize(target - position);
-	const float3 right = normalize(cross(forward, up));
-	const float3 new_up = normalize(cross(right, forward));
+template double3x3 scale_matrix(const double3& s) noexcept;
+template double4x4 scale_matrix(const double3& s) noexcept;
 
-	float4x4 r = float4x4::identity;
-	r.m00 = right.x;	r.m01 = right.y;	r.m02 = right.z;	r.m03 = dot(right, -position);
-	r.m10 = new_up.x;	r.m11 = new_up.y;	r.m12 = new_up.z;	r.m13 = dot(new_up, -position);
-	r.m20 = -forward.x;	r.m21 = -forward.y;	r.m22 = -forward.z;	r.m23 = dot(forward, position);
+void sincos(float angle, float& s, float& c, sincos_precision precision) noexcept
+{
+	if (precision == sincos_precision::fast) {
+		sincos_poly(angle, true, s, c);
+		return;
+	}
 
-	return r;
+	s = std::sin(angle);
+	c = std::cos(angle);
+}
+
+void sincos(const float* angles, float* s, float* c, size_t count, sincos_precision precision) noexcept
+{
+	assert(count == 0 || (angles && s && c));
+	active_kernels().sincos(angles, s, c, count, precision == sincos_precision::fast);
+}
+
+void skin(const float4x4* palette, const float3* positions, const float3* normals, const ubyte4* joints,
+	const float4* weights, float3* out_positions, float3* out_normals, size_t count, thread_pool* pool)
+{
+	assert(count == 0 || (palette && positions && joints && weights && out_positions));
+	assert((normals == nullptr) == (out_normals == nullptr));
+
+	// a range is large enough to hide the cost of a task and a multiple of any SIMD width.
+	constexpr size_t grain = 1024;
+
+	const kernel_table& kernels = active_kernels();
+	parallel_for(pool, count, grain, [&](size_t begin, size_t end) {
+		kernels.skin_float4x4(palette, positions + begin, normals ? normals + begin : nullptr,
+			joints + begin, weights + begin, out_positions + begin, out_normals ? out_normals + begin : nullptr, end - begin);
+	});
+}
+
+void transform_directions(const float4x4& m, const float3* in, float3* out, size_t count) noexcept
+{
+	transform_directions(m, in, sizeof(float3), out, sizeof(float3), count);
+}
+
+void transform_directions(const float4x4& m, const float3* in, size_t in_stride,
+	float3* out, size_t out_stride, size_t count) noexcept
+{
+	assert(count == 0 || (in && out));
+	assert(in_stride >= sizeof(float3) && in_stride % sizeof(float) == 0);
+	assert(out_stride >= sizeof(float3) && out_stride % sizeof(float) == 0);
+
+	active_kernels().transform_float3(m, 0.0f, in, in_stride, out, out_stride, 3, count);
+}
+
+void transform_points(const float4x4& m, const float3* in, float3* out, size_t count) noexcept
+{
+	transform_points(m, in, sizeof(float3), out, sizeof(float3), count);
+}
+
+void transform_points(const float4x4& m, const float3* in, float4* out, size_t count) noexcept
+{
+	assert(count == 0 || (in && out));
+	active_kernels().transform_float3(m, 1.0f, in, sizeof(float3), out, sizeof(float4), 4, count);
+}
+
+void transform_points(const float4x4& m, const float3* in, size_t in_stride,
+	float3* out, size_t out_stride, size_t count) noexcept
+{
+	assert(count == 0 || (in && out));
+	assert(in_stride >= sizeof(float3) && in_stride % sizeof(float) == 0);
+	assert(out_stride >= sizeof(float3) && out_stride % sizeof(float) == 0);
+
+	active_kernels().transform_float3(m, 1.0f, in, in_stride, out, out_stride, 3, count);
+}
+
+float4x4 view_matrix(const float3& position, const float3& target, const float3& up) noexcept
+{
+	return view_matrix_impl<float4x4>(position, target, up);
+}
+
+double4x4 view_matrix(const double3& position, const double3& target, const double3& up) noexcept
+{
+	return view_matrix_impl<double4x4>(position, target, up);
 }
 
 
@@ -0,0 +1,240 @@
+#include "math/transform.h"
+
+#include <random>
+#include <vector>
+#include "benchmark.h"
+
+using math::double3;
+using math::double4x4;
+using math::dquat;
+using math::float3;
+using math::float4;
+using math::float3x3;
+using math::float3x4;
+using math::float4x4;
+using math::quat;
+using math::ubyte4;
+
+
+namespace {
+
+float4x4 with_position(const float4x4& m, const float3& p) noexcept
+{
+	float4x4 r = m;
+	math::set_position(r, p);
+	return r;
+}
+
+template<typename M>
+void bench_from_rotation_matrix(benchmark::state& state)
+{
+	const std::vector<quat> q = benchmark::random_unit_quat(state.size(), 1);
+	std::vector<M> in(state.size());
+	for (size_t i = 0; i < in.size(); ++i) {
+		in[i] = math::rotation_matrix<M>(q[i]);
+		// rounding errors may break is_orthogonal's strict tolerance.
+		if (!math::is_orthogonal(in[i])) in[i] = M::identity;
+	}
+
+	std::vector<quat> out(state.size());
+	benchmark::map(state, in, out, [](const M& m) { return math::from_rotation_matrix(m); });
+}
+
+template<typename M>
+void bench_rotation_matrix_axis_angle(benchmark::state& state)
+{
+	const std::vector<float3> axis = benchmark::random_unit_float3(state.size(), 1);
+	const std::vector<float> angle = benchmark::random_values<float>(state.size(), -math::pi, math::pi, 2);
+	std::vector<M> out(state.size());
+	benchmark::map(state, axis, angle, out,
+		[](const float3& a, float b) { return math::rotation_matrix<M>(a, b); });
+}
+
+// Measures the batch transform function func(m, in, out, count).
+template<typename In, typename Out, typename Func>
+void bench_transform(benchmark::state& state, Func func)
+{
+	const float4x4 m = math::trs_matrix(float3(1, 2, 3), math::normalize(quat(1, 2, 3, 4)), float3(2));
+	const std::vector<In> in = benchmark::random_values<In>(state.size(), -10.0f, 10.0f, 1);
+	std::vector<Out> out(state.size());
+
+	while (state.keep_running()) {
+		func(m, in.data(), out.data(), state.size());
+		benchmark::clobber_memory();
+	}
+}
+
+
+BENCHMARK_MAP(from_axis_angle_rotation, quat, float, -math::pi, math::pi,
+	math::from_axis_angle_rotation(float3::unit_y, a));
+BENCHMARK_MAP(orthographic_matrix_directx, float4x4, float, 1.0f, 10.0f,
+	math::orthographic_matrix_directx(a, 0.75f * a, 0.1f, 100.0f));
+BENCHMARK_MAP(orthographic_matrix_directx_lrbt, float4x4, float, 1.0f, 10.0f,
+	math::orthographic_matrix_directx(-a, a, -0.75f * a, 0.75f * a, 0.1f, 100.0f));
+BENCHMARK_MAP(orthographic_matrix_opengl, float4x4, float, 1.0f, 10.0f,
+	math::orthographic_matrix_opengl(a, 0.75f * a, 0.1f, 100.0f));
+BENCHMARK_MAP(orthographic_matrix_opengl_lrbt, float4x4, float, 1.0f, 10.0f,
+	math::orthographic_matrix_opengl(-a, a, -0.75f * a, 0.75f * a, 0.1f, 100.0f));
+BENCHMARK_MAP(perspective_matrix_directx, float4x4, float, 0.5f, 1.5f,
+	math::perspective_matrix_directx(a, 1.5f, 0.1f, 100.0f));
+BENCHMARK_MAP(perspective_matrix_directx_lrbt, float4x4, float, 0.5f, 1.5f,
+	math::perspective_matrix_directx(-a, a, -0.75f * a, 0.75f * a, 0.1f, 100.0f));
+BENCHMARK_MAP(perspective_matrix_opengl, float4x4, float, 0.5f, 1.5f,
+	math::perspective_matrix_opengl(a, 1.5f, 0.1f, 100.0f));
+BENCHMARK_MAP(perspective_matrix_opengl_lrbt, float4x4, float, 0.5f, 1.5f,
+	math::perspective_matrix_opengl(-a, a, -0.75f * a, 0.75f * a, 0.1f, 100.0f));
+BENCHMARK_MAP(position, float3, float4x4, -1.0f, 1.0f, math::position(a));
+BENCHMARK_MAP2(rotate, float3, quat, float3, -10.0f, 10.0f, math::rotate(a, b));
+BENCHMARK_MAP(rotation_matrix_float3x3, float3x3, quat, -1.0f, 1.0f, math::rotation_matrix<float3x3>(a));
+BENCHMARK_MAP(rotation_matrix_float4x4, float4x4, quat, -1.0f, 1.0f, math::rotation_matrix<float4x4>(a));
+BENCHMARK_MAP2(rotation_matrix_look_at_float3x3, float3x3, float3, float3, -10.0f, 10.0f,
+	math::rotation_matrix<float3x3>(a, b));
+BENCHMARK_MAP2(rotation_matrix_look_at_float4x4, float4x4, float3, float3, -10.0f, 10.0f,
+	math::rotation_matrix<float4x4>(a, b));
+BENCHMARK_MAP(rotation_matrix_ox_float4x4, float4x4, float, -math::pi, math::pi, math::rotation_matrix_ox<float4x4>(a));
+BENCHMARK_MAP(rotation_matrix_oy_float4x4, float4x4, float, -math::pi, math::pi, math::rotation_matrix_oy<float4x4>(a));
+BENCHMARK_MAP(rotation_matrix_oz_float4x4, float4x4, float, -math::pi, math::pi, math::rotation_matrix_oz<float4x4>(a));
+BENCHMARK_MAP(scale_matrix_float4x4, float4x4, float3, 0.5f, 2.0f, math::scale_matrix<float4x4>(a));
+BENCHMARK_MAP2(set_position, float4x4, float4x4, float3, -1.0f, 1.0f, with_position(a, b));
+BENCHMARK_MAP2(tr_affine_matrix, float3x4, float3, quat, -10.0f, 10.0f, math::tr_affine_matrix(a, b));
+BENCHMARK_MAP2(tr_matrix, float4x4, float3, quat, -10.0f, 10.0f, math::tr_matrix(a, b));
+BENCHMARK_MAP2(tr_matrix_look_at, float4x4, float3, float3, -10.0f, 10.0f, math::tr_matrix(a, b));
+BENCHMARK_MAP(translation_matrix, float4x4, float3, -10.0f, 10.0f, math::translation_matrix(a));
+BENCHMARK_MAP2(trs_affine_matrix, float3x4, float3, quat, -10.0f, 10.0f,
+	math::trs_affine_matrix(a, b, float3(2.0f)));
+BENCHMARK_MAP2(trs_matrix, float4x4, float3, quat, -10.0f, 10.0f, math::trs_matrix(a, b, float3(2.0f)));
+BENCHMARK_MAP2(ts_matrix, float4x4, float3, float3, 0.5f, 2.0f, math::ts_matrix(a, b));
+BENCHMARK_MAP2(view_matrix, float4x4, float3, float3, -10.0f, 10.0f, math::view_matrix(a, b));
+
+// ----- double -----
+
+BENCHMARK_MAP(rotation_matrix_double4x4, double4x4, dquat, -1.0f, 1.0f, math::rotation_matrix<double4x4>(a));
+BENCHMARK_MAP2(trs_matrix_double, double4x4, double3, dquat, -10.0f, 10.0f, math::trs_matrix(a, b, double3(2.0)));
+BENCHMARK_MAP2(view_matrix_double, double4x4, double3, double3, -10.0f, 10.0f, math::view_matrix(a, b));
+
+void from_rotation_matrix_float3x3(benchmark::state& state) { bench_from_rotation_matrix<float3x3>(state); }
+BENCHMARK(from_rotation_matrix_float3x3);
+
+void from_rotation_matrix_float4x4(benchmark::state& state) { bench_from_rotation_matrix<float4x4>(state); }
+BENCHMARK(from_rotation_matrix_float4x4);
+
+void inverse_orthonormal_float3x4(benchmark::state& state)
+{
+	const std::vector<float3> p = benchmark::random_values<float3>(state.size(), -10.0f, 10.0f, 1);
+	const std::vector<quat> q = benchmark::random_unit_quat(state.size(), 2);
+	std::vector<float3x4> in(state.size());
+	for (size_t i = 0; i < in.size(); ++i) {
+		in[i] = math::tr_affine_matrix(p[i], q[i]);
+		// rounding errors may break is_orthogonal's strict tolerance.
+		if (!math::is_orthogonal(in[i])) in[i] = float3x4::identity;
+	}
+
+	std::vector<float3x4> out(state.size());
+	benchmark::map(state, in, out, [](const float3x4& m) { return math::inverse_orthonormal(m); });
+}
+BENCHMARK(inverse_orthonormal_float3x4);
+
+void rotation_matrix_axis_angle_float3x3(benchmark::state& state) { bench_rotation_matrix_axis_angle<float3x3>(state); }
+BENCHMARK(rotation_matrix_axis_angle_float3x3);
+
+void rotation_matrix_axis_angle_float4x4(benchmark::state& state) { bench_rotation_matrix_axis_angle<float4x4>(state); }
+BENCHMARK(rotation_matrix_axis_angle_float4x4);
+
+// ----- batch functions -----
+
+void from_axis_angle_rotation_batch(benchmark::state& state)
+{
+	const std::vector<float3> axes = benchmark::random_unit_float3(state.size(), 1);
+	const std::vector<float> angles = benchmark::random_values<float>(state.size(), -math::pi, math::pi, 2);
+	std::vector<quat> out(state.size());
+
+	while (state.keep_running()) {
+		math::from_axis_angle_rotation(axes.data(), angles.data(), out.data(), state.size());
+		benchmark::clobber_memory();
+	}
+}
+BENCHMARK(from_axis_angle_rotation_batch);
+
+void rotation_matrix_oz_float4x4_batch(benchmark::state& state)
+{
+	const std::vector<float> angles = benchmark::random_values<float>(state.size(), -math::pi, math::pi, 1);
+	std::vector<float4x4> out(state.size());
+
+	while (state.keep_running()) {
+		math::rotation_matrix_oz(angles.data(), out.data(), state.size());
+		benchmark::clobber_memory();
+	}
+}
+BENCHMARK(rotation_matrix_oz_float4x4_batch);
+
+// Measures the batch sincos of the given precision.
+void bench_sincos_batch(benchmark::state& state, math::sincos_precision precision)
+{
+	const std::vector<float> angles = benchmark::random_values<float>(state.size(), -10.0f, 10.0f, 1);
+	std::vector<float> s(state.size());
+	std::vector<float> c(state.size());
+
+	while (state.keep_running()) {
+		math::sincos(angles.data(), s.data(), c.data(), state.size(), precision);
+		benchmark::clobber_memory();
+	}
+}
+
+void sincos_batch(benchmark::state& state) { bench_sincos_batch(state, math::sincos_precision::full); }
+BENCHMARK(sincos_batch);
+
+void sincos_fast_batch(benchmark::state& state) { bench_sincos_batch(state, math::sincos_precision::fast); }
+BENCHMARK(sincos_fast_batch);
+
+void skin_float4x4_batch(benchmark::state& state)
+{
+	constexpr size_t joint_count = 64;
+	const std::vector<float3> jp = benchmark::random_values<float3>(joint_count, -1.0f, 1.0f, 1);
+	const std::vector<quat> jq = benchmark::random_unit_quat(joint_count, 2);
+	std::vector<float4x4> palette(joint_count);
+	for (size_t i = 0; i < joint_count; ++i)
+		palette[i] = math::tr_matrix(jp[i], jq[i]);
+
+	const std::vector<float3> positions = benchmark::random_values<float3>(state.size(), -1.0f, 1.0f, 3);
+	const std::vector<float3> normals = benchmark::random_unit_float3(state.size(), 4);
+	std::vector<float4> weights = benchmark::random_values<float4>(state.size(), 0.0f, 1.0f, 5);
+	std::vector<ubyte4> joints(state.size());
+	std::mt19937 gen(6);
+	std::uniform_int_distribution<int> joint(0, joint_count - 1);
+	for (size_t i = 0; i < state.size(); ++i) {
+		joints[i] = ubyte4(uint8_t(joint(gen)), uint8_t(joint(gen)), uint8_t(joint(gen)), uint8_t(joint(gen)));
+		weights[i] /= weights[i].x + weights[i].y + weights[i].z + weights[i].w;
+	}
+
+	std::vector<float3> out_p(state.size());
+	std::vector<float3> out_n(state.size());
+	while (state.keep_running()) {
+		math::skin(palette.data(), positions.data(), normals.data(), joints.data(), weights.data(),
+			out_p.data(), out_n.data(), state.size());
+		benchmark::clobber_memory();
+	}
+}
+BENCHMARK(skin_float4x4_batch);
+
+void transform_directions_batch(benchmark::state& state)
+{
+	bench_transform<float3, float3>(state,
+		[](const float4x4& m, const float3* in, float3* out, size_t count) { math::transform_directions(m, in, out, count); });
+}
+BENCHMARK(transform_directions_batch);
+
+void transform_points_batch(benchmark::state& state)
+{
+	bench_transform<float3, float3>(state,
+		[](const float4x4& m, const float3* in, float3* out, size_t count) { math::transform_points(m, in, out, count); });
+}
+BENCHMARK(transform_points_batch);
+
+void transform_points_float4_batch(benchmark::state& state)
+{
+	bench_transform<float3, float4>(state,
+		[](const float4x4& m, const float3* in, float4* out, size_t count) { math::transform_points(m, in, out, count); });
+}
+BENCHMARK(transform_points_float4_batch);
+
+} // namespace
@@ -1,28 +1,58 @@
 #include "math/transform.h"
 
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "math/dispatch.h"
 #include "CppUnitTest.h"
+#include "test_utility.h"
 
+using math::double3;
+using math::double4;
+using math::double4x4;
+using math::dquat;
 using math::float2;
 using math::float3;
 using math::float4;
 using math::quat;
 using math::float3x3;
+using math::float3x4;
 using math::float4x4;
+using math::ubyte4;
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
 
 namespace Microsoft { namespace VisualStudio { namespace CppUnitTestFramework {
 
+template<> inline std::wstring ToString<double3>(const double3& t) { RETURN_WIDE_STRING(t); }
+template<> inline std::wstring ToString<double4x4>(const double4x4& t) { RETURN_WIDE_STRING(t); }
 template<> inline std::wstring ToString<float2>(const float2& t) { RETURN_WIDE_STRING(t); }
 template<> inline std::wstring ToString<float3>(const float3& t) { RETURN_WIDE_STRING(t); }
 template<> inline std::wstring ToString<float4>(const float4& t) { RETURN_WIDE_STRING(t); }
 template<> inline std::wstring ToString<quat>(const quat& t) { RETURN_WIDE_STRING(t); }
 template<> inline std::wstring ToString<float3x3>(const float3x3& t) { RETURN_WIDE_STRING(t); }
+template<> inline std::wstring ToString<float3x4>(const float3x4& t) { RETURN_WIDE_STRING(t); }
 template<> inline std::wstring ToString<float4x4>(const float4x4& t) { RETURN_WIDE_STRING(t); }
 
 }}} // namespace Microsoft::VisualStudio::CppUnitTestFramework
 
 
+namespace {
+
+// Returns count angles from [-range, range].
+std::vector<float> test_angles(size_t count, float range)
+{
+	std::vector<float> a(count);
+	for (size_t i = 0; i < count; ++i)
+		a[i] = range * (2.0f * float((i * 7919) % 1001) / 1000.0f - 1.0f);
+
+	return a;
+}
+
+} // namespace
+
+
 namespace unittest {
 
 TEST_CLASS(math_transform_fucns) {
@@ -42,6 +72,31 @@ public:
 		Assert::IsTrue(approx_equal(q.a, std::cos(math::pi_4)));
 	}
 
+	TEST_METHOD(from_axis_angle_rotation_batch)
+	{
+		using math::sincos_precision;
+
+		constexpr size_t count = 300;
+		const std::vector<float> angles = test_angles(count, 10.0f);
+		std::vector<float3> axes(count);
+		for (size_t i = 0; i < count; ++i)
+			axes[i] = math::normalize(float3(1.0f, float(i % 5), -float(i % 7)));
+
+		for_each_isa_level([&] {
+			for (sincos_precision p : { sincos_precision::full, sincos_precision::fast }) {
+				const float max_abs_diff = (p == sincos_precision::full) ? 1e-6f : 4e-5f;
+
+				std::vector<quat> out(count + 1, quat(7, 7, 7, 7));
+				math::from_axis_angle_rotation(axes.data(), angles.data(), out.data(), count, p);
+				for (size_t i = 0; i < count; ++i) {
+					const quat expected = math::from_axis_angle_rotation(axes[i], angles[i]);
+					Assert::IsTrue(math::approx_equal(expected, out[i], max_abs_diff));
+				}
+				Assert::AreEqual(quat(7, 7, 7, 7), out[count]);
+			}
+		});
+	}
+
 	TEST_METHOD(from_rotation_matrix)
 	{
 		using math::from_axis_angle_rotation;
@@ -191,6 +246,16 @@ public:
 
 		set_position(m, float3(1, 2, 3));
 		Assert::AreEqual(float3(1, 2, 3), position(m));
+
+		float3x4 a(
+			0, 0, 0, 24,
+			0, 0, 0, 42,
+			0, 0, 0, 60);
+
+		Assert::AreEqual(float3(24, 42, 60), position(a));
+
+		set_position(a, float3(1, 2, 3));
+		Assert::AreEqual(float3(1, 2, 3), position(a));
 	}
 
 	TEST_METHOD(rotate)
@@ -339,6 +404,35 @@ public:
 		Assert::IsTrue(approx_equal(rotation_matrix_oz<float4x4>(angle), rotation_matrix<float4x4>(float3::unit_z, angle)));
 	}
 
+	TEST_METHOD(rotation_matrix_ox_oy_oz_batch)
+	{
+		using math::approx_equal;
+		using math::sincos_precision;
+
+		constexpr size_t count = 300;
+		std::vector<float> angles = test_angles(count, 10.0f);
+		angles[3] = 0.0f;
+
+		for_each_isa_level([&] {
+			for (sincos_precision p : { sincos_precision::full, sincos_precision::fast }) {
+				const float max_abs_diff = (p == sincos_precision::full) ? 1e-6f : 4e-5f;
+
+				std::vector<float3x3> ox(count);
+				std::vector<float3x4> oy(count);
+				std::vector<float4x4> oz(count);
+				math::rotation_matrix_ox(angles.data(), ox.data(), count, p);
+				math::rotation_matrix_oy(angles.data(), oy.data(), count, p);
+				math::rotation_matrix_oz(angles.data(), oz.data(), count, p);
+
+				for (size_t i = 0; i < count; ++i) {
+					Assert::IsTrue(approx_equal(math::rotation_matrix_ox<float3x3>(angles[i]), ox[i], max_abs_diff));
+					Assert::IsTrue(approx_equal(math::rotation_matrix_oy<float3x4>(angles[i]), oy[i], max_abs_diff));
+					Assert::IsTrue(approx_equal(math::rotation_matrix_oz<float4x4>(angles[i]), oz[i], max_abs_diff));
+				}
+			}
+		});
+	}
+
 	TEST_METHOD(scale_matrix)
 	{
 		using math::scale_matrix;
@@ -347,6 +441,167 @@ public:
 		Assert::AreEqual(float4x4(7, 0, 0, 0, 0, 8, 0, 0, 0, 0, 9, 0, 0, 0, 0, 1), scale_matrix<float4x4>(float3(7, 8, 9)));
 	}
 
+	TEST_METHOD(sincos)
+	{
+		using math::sincos_precision;
+
+		float s, c;
+		math::sincos(0.5f, s, c);
+		Assert::AreEqual(std::sin(0.5f), s);
+		Assert::AreEqual(std::cos(0.5f), c);
+
+		// the quadrants and the range of the documented error.
+		std::vector<float> angles = test_angles(1001, 1e4f);
+		for (float a : { 0.0f, math::pi_4, math::pi_2, math::pi, -math::pi_2, 3.0f * math::pi_4, 1e4f, -1e4f })
+			angles.push_back(a);
+
+		auto check = [&](const float* as, const float* ac, sincos_precision p) {
+			const double max_abs_diff = (p == sincos_precision::full) ? 2e-7 : 2e-5;
+			for (size_t i = 0; i < angles.size(); ++i) {
+				Assert::IsTrue(std::abs(as[i] - std::sin(double(angles[i]))) <= max_abs_diff);
+				Assert::IsTrue(std::abs(ac[i] - std::cos(double(angles[i]))) <= max_abs_diff);
+			}
+		};
+
+		std::vector<float> fs(angles.size());
+		std::vector<float> fc(angles.size());
+		for (size_t i = 0; i < angles.size(); ++i)
+			math::sincos(angles[i], fs[i], fc[i], sincos_precision::fast);
+		check(fs.data(), fc.data(), sincos_precision::fast);
+
+		for_each_isa_level([&] {
+			for (sincos_precision p : { sincos_precision::full, sincos_precision::fast }) {
+				for (size_t count : { size_t(0), size_t(1), size_t(5), size_t(17), angles.size() }) {
+					std::vector<float> bs(angles.size(), 7.0f);
+					std::vector<float> bc(angles.size(), 7.0f);
+					math::sincos(angles.data(), bs.data(), bc.data(), count, p);
+
+					for (size_t i = count; i < angles.size(); ++i)
+						Assert::IsTrue(bs[i] == 7.0f && bc[i] == 7.0f);
+					if (count == angles.size()) check(bs.data(), bc.data(), p);
+				}
+
+				// s in place of angles
+				std::vector<float> inout = angles;
+				std::vector<float> bc(angles.size());
+				math::sincos(inout.data(), inout.data(), bc.data(), angles.size(), p);
+				check(inout.data(), bc.data(), p);
+			}
+		});
+
+		// NaN and infinite angles give NaN, the SIMD kernels get them in their main loops and their tails.
+		const float inf = std::numeric_limits<float>::infinity();
+		const float special[] = { std::numeric_limits<float>::quiet_NaN(), inf, -inf };
+		std::vector<float> nan_angles(max_test_count);
+		for (size_t i = 0; i < nan_angles.size(); ++i)
+			nan_angles[i] = special[i % 3];
+
+		for (sincos_precision p : { sincos_precision::full, sincos_precision::fast }) {
+			for (float a : special) {
+				math::sincos(a, s, c, p);
+				Assert::IsTrue(std::isnan(s) && std::isnan(c));
+			}
+		}
+
+		for_each_isa_level([&] {
+			for (sincos_precision p : { sincos_precision::full, sincos_precision::fast }) {
+				std::vector<float> bs(nan_angles.size());
+				std::vector<float> bc(nan_angles.size());
+				math::sincos(nan_angles.data(), bs.data(), bc.data(), nan_angles.size(), p);
+				for (size_t i = 0; i < nan_angles.size(); ++i)
+					Assert::IsTrue(std::isnan(bs[i]) && std::isnan(bc[i]));
+			}
+		});
+	}
+
+	TEST_METHOD(skin)
+	{
+		using math::isa_level;
+
+		std::vector<float4x4> palette(11);
+		for (size_t i = 0; i < palette.size(); ++i) {
+			const float f = float(i);
+			palette[i] = math::trs_matrix(float3(f, -0.5f * f, 2.0f),
+				math::from_axis_angle_rotation(math::normalize(float3(1, f, 3)), 0.3f * f), float3(1.0f + 0.1f * f));
+		}
+
+		// the large count is skinned in several ranges.
+		constexpr size_t count = 2500;
+		std::vector<float3> positions(count);
+		std::vector<float3> normals(count);
+		std::vector<ubyte4> joints(count);
+		std::vector<float4> weights(count);
+		for (size_t i = 0; i < count; ++i) {
+			positions[i] = float3(float(i % 13), 0.5f * float(i % 7), -0.25f * float(i % 5));
+			normals[i] = math::normalize(float3(1.0f, float(i % 3), -float(i % 4)));
+			joints[i] = ubyte4(uint8_t(i % 11), uint8_t((i * 3) % 11), uint8_t((i * 7 + 1) % 11), uint8_t((i + 5) % 11));
+			// a few vertices are bound to a single joint.
+			weights[i] = (i % 4 == 0) ? float4(1, 0, 0, 0) : float4(0.5f, 0.25f, 0.125f, 0.125f);
+		}
+
+		std::vector<float3> expected_p(count);
+		std::vector<float3> expected_n(count);
+		for (size_t i = 0; i < count; ++i) {
+			const ubyte4& j = joints[i];
+			const float4& w = weights[i];
+			float4x4 b = float4x4::zero;
+			b = b + w.x * palette[j.x];
+			b = b + w.y * palette[j.y];
+			b = b + w.z * palette[j.z];
+			b = b + w.w * palette[j.w];
+
+			const float4 p = math::mul(b, positions[i], 1.0f);
+			const float4 n = math::mul(b, normals[i], 0.0f);
+			expected_p[i] = float3(p.x, p.y, p.z);
+			expected_n[i] = math::normalize(float3(n.x, n.y, n.z));
+		}
+
+		auto near = [](const float3& l, const float3& r) {
+			return math::approx_equal(l, r, 1e-4f);
+		};
+
+		const isa_level prev_level = math::active_isa_level();
+		for (uint8_t l = 0; l <= uint8_t(math::supported_isa_level()); ++l) {
+			math::force_isa_level(isa_level(l));
+
+			for (size_t n : { size_t(0), size_t(1), size_t(5), size_t(17), size_t(37), count }) {
+				test_thread_pool pool;
+				std::vector<float3> out_p(count, float3(7.0f));
+				std::vector<float3> out_n(count, float3(7.0f));
+				math::skin(palette.data(), positions.data(), normals.data(), joints.data(), weights.data(),
+					out_p.data(), out_n.data(), n, &pool);
+				Assert::AreEqual<size_t>((n > 1024) ? 1 : 0, pool.run_count);
+
+				for (size_t i = 0; i < count; ++i) {
+					Assert::IsTrue(near((i < n) ? expected_p[i] : float3(7.0f), out_p[i]));
+					Assert::IsTrue(near((i < n) ? expected_n[i] : float3(7.0f), out_n[i]));
+				}
+			}
+
+			// positions only, in place, on the calling thread.
+			std::vector<float3> inout = positions;
+			math::skin(palette.data(), inout.data(), nullptr, joints.data(), weights.data(),
+				inout.data(), nullptr, count);
+			for (size_t i = 0; i < count; ++i)
+				Assert::IsTrue(near(expected_p[i], inout[i]));
+		}
+		math::force_isa_level(prev_level);
+	}
+
+	TEST_METHOD(tr_affine_matrix)
+	{
+		using math::approx_equal;
+		using math::from_axis_angle_rotation;
+		using math::normalize;
+		using math::tr_affine_matrix;
+		using math::tr_matrix;
+
+		const quat q = from_axis_angle_rotation(normalize(float3(-5, 3, -10)), math::pi_4);
+		const float3 pos(7, 8, 9);
+
+		Assert::IsTrue(approx_equal(float3x4(tr_matrix(pos, q)), tr_affine_matrix(pos, q)));
+	}
+
 	TEST_METHOD(tr_matrix_pos_quat)
 	{
 		using math::approx_equal;
@@ -373,6 +628,78 @@ public:
 		Assert::IsTrue(approx_equal(translation_matrix(p) * rotation_matrix<float4x4>(p, t), tr_matrix(p, t)));
 	}
 
+	TEST_METHOD(transform_points_directions)
+	{
+		using math::isa_level;
+		using math::mul;
+		using math::transform_directions;
+		using math::transform_points;
+
+		struct vertex final {
+			float3 position;
+			float3 normal;
+			float2 uv;
+		};
+
+		const float4x4 m = math::trs_matrix(float3(1, -2, 3),
+			math::from_axis_angle_rotation(math::normalize(float3(1, 2, 3)), 0.7f), float3(2, 3, 0.5f));
+
+		constexpr size_t count = 37;
+		std::vector<float3> p(count);
+		std::vector<vertex> vb(count);
+		for (size_t i = 0; i < count; ++i) {
+			p[i] = float3(float(i), 0.5f * float(i % 7), -0.25f * float(i % 5));
+			vb[i] = { p[i], -p[i], float2(float(i)) };
+		}
+
+		auto near = [](const float3& l, const float3& r) {
+			return math::approx_equal(l.x, r.x, 1e-4f) && math::approx_equal(l.y, r.y, 1e-4f)
+				&& math::approx_equal(l.z, r.z, 1e-4f);
+		};
+
+		const isa_level prev_level = math::active_isa_level();
+		for (uint8_t l = 0; l <= uint8_t(math::supported_isa_level()); ++l) {
+			math::force_isa_level(isa_level(l));
+
+			for (size_t n : { size_t(0), size_t(3), size_t(16), count }) {
+				std::vector<float3> pts(count, float3::zero);
+				std::vector<float3> dirs(count, float3::zero);
+				std::vector<float4> hpts(count, float4::zero);
+				transform_points(m, p.data(), pts.data(), n);
+				transform_directions(m, p.data(), dirs.data(), n);
+				transform_points(m, p.data(), hpts.data(), n);
+
+				for (size_t i = 0; i < count; ++i) {
+					const float4 ep = (i < n) ? mul(m, p[i], 1.0f) : float4::zero;
+					const float4 ed = (i < n) ? mul(m, p[i], 0.0f) : float4::zero;
+					Assert::IsTrue(near(float3(ep.x, ep.y, ep.z), pts[i]));
+					Assert::IsTrue(near(float3(ed.x, ed.y, ed.z), dirs[i]));
+					Assert::IsTrue(math::approx_equal(ep.w, hpts[i].w)
+						&& near(float3(ep.x, ep.y, ep.z), float3(hpts[i].x, hpts[i].y, hpts[i].z)));
+				}
+			}
+
+			// interleaved, in place
+			std::vector<vertex> vbo = vb;
+			transform_points(m, &vbo[0].position, sizeof(vertex), &vbo[0].position, sizeof(vertex), count);
+			transform_directions(m, &vbo[0].normal, sizeof(vertex), &vbo[0].normal, sizeof(vertex), count);
+
+			// interleaved into packed
+			std::vector<float3> pts(count);
+			transform_points(m, &vb[0].position, sizeof(vertex), pts.data(), sizeof(float3), count);
+
+			for (size_t i = 0; i < count; ++i) {
+				const float4 ep = mul(m, vb[i].position, 1.0f);
+				const float4 en = mul(m, vb[i].normal, 0.0f);
+				Assert::IsTrue(near(float3(ep.x, ep.y, ep.z), vbo[i].position));
+				Assert::IsTrue(near(float3(en.x, en.y, en.z), vbo[i].normal));
+				Assert::AreEqual(vb[i].uv, vbo[i].uv);
+				Assert::IsTrue(near(float3(ep.x, ep.y, ep.z), pts[i]));
+			}
+		}
+		math::force_isa_level(prev_level);
+	}
+
 	TEST_METHOD(translation_matrix)
 	{
 		using math::translation_matrix;
@@ -406,6 +733,24 @@ public:
 		Assert::IsTrue(approx_equal(mT * mR * mS, trs_matrix(p, q, s)));
 	}
 
+	TEST_METHOD(trs_affine_matrix)
+	{
+		using math::approx_equal;
+		using math::from_axis_angle_rotation;
+		using math::inverse;
+		using math::normalize;
+		using math::trs_affine_matrix;
+		using math::trs_matrix;
+
+		const float3 p(7, 8, 9);
+		const quat q = from_axis_angle_rotation(normalize(float3(-5, 3, -10)), math::pi_4);
+		const float3 s(2, 3, 4);
+
+		const float3x4 m = trs_affine_matrix(p, q, s);
+		Assert::IsTrue(approx_equal(float3x4(trs_matrix(p, q, s)), m));
+		Assert::IsTrue(approx_equal(float3x4(inverse(trs_matrix(p, q, s))), inverse(m)));
+	}
+
 	TEST_METHOD(ts_matrix)
 	{
 		using math::scale_matrix;
@@ -418,4 +763,53 @@ public:
 	}
 };
 
+TEST_CLASS(math_transform_double) {
+public:
+
+	TEST_METHOD(builders_match_float)
+	{
+		using math::approx_equal;
+		using math::from_axis_angle_rotation;
+		using math::normalize;
+
+		const float3 axis = normalize(float3(-5, 3, -10));
+		const float3 p(7, 8, 9);
+		const float3 s(2, 3, 4);
+		const quat q = from_axis_angle_rotation(axis, math::pi_4);
+		const dquat dq = from_axis_angle_rotation(double3(axis), double(math::pi_4));
+
+		Assert::IsTrue(approx_equal(dquat(q), dq));
+		Assert::IsTrue(approx_equal(double4x4(math::rotation_matrix<float4x4>(q)), math::rotation_matrix<double4x4>(dq)));
+		Assert::IsTrue(approx_equal(double4x4(math::rotation_matrix<float4x4>(axis, math::pi_4)),
+			math::rotation_matrix<double4x4>(double3(axis), double(math::pi_4))));
+		Assert::IsTrue(approx_equal(double4x4(math::scale_matrix<float4x4>(s)), math::scale_matrix<double4x4>(double3(s))));
+		Assert::IsTrue(approx_equal(double4x4(math::translation_matrix(p)), math::translation_matrix(double3(p))));
+		Assert::IsTrue(approx_equal(double4x4(math::tr_matrix(p, q)), math::tr_matrix(double3(p), dq)));
+		Assert::IsTrue(approx_equal(double4x4(math::trs_matrix(p, q, s)), math::trs_matrix(double3(p), dq, double3(s))));
+		Assert::IsTrue(approx_equal(double4x4(math::ts_matrix(p, s)), math::ts_matrix(double3(p), double3(s))));
+		Assert::IsTrue(approx_equal(double4x4(math::tr_matrix(p, float3::zero)), math::tr_matrix(double3(p), double3::zero)));
+		Assert::IsTrue(approx_equal(double4x4(math::view_matrix(p, float3::zero)), math::view_matrix(double3(p), double3::zero)));
+		Assert::IsTrue(approx_equal(double3(math::rotate(q, p)), math::rotate(dq, double3(p)), 1e-4));
+	}
+
+	TEST_METHOD(position_get_set)
+	{
+		double4x4 m = double4x4::identity;
+		math::set_position(m, double3(1.0e8, 2.0, -3.0e-3));
+		Assert::AreEqual(double3(1.0e8, 2.0, -3.0e-3), math::position(m));
+	}
+
+	TEST_METHOD(world_positions)
+	{
+		// an object a meter away from a camera, both 10^7 meters from the origin.
+		const double3 camera(1.0e7, 0.0, 1.0e7);
+		const double3 object = camera + double3(0.0, 0.0, -1.0);
+
+		const double4x4 world = math::translation_matrix(object);
+		const double4x4 view = math::view_matrix(camera, object);
+		const double4 p = math::mul(view * world, double4::unit_w);
+		Assert::IsTrue(math::approx_equal(double4(0, 0, -1, 1), p, 1e-9));
+	}
+};
+
 } // namespace unittest
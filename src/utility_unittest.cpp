@@ -43,6 +43,13 @@ public:
 
 		Assert::IsFalse(approx_equal(1.0, 1.001, 0.0009));
 		Assert::IsFalse(approx_equal(1.0, 1.001, 0.0001));
+
+		// integers
+		Assert::IsTrue(approx_equal(24, 24));
+		Assert::IsFalse(approx_equal(24, 25));
+		Assert::IsTrue(approx_equal(24, 26, 2));
+		Assert::IsTrue(approx_equal(26u, 24u, 2u));
+		Assert::IsFalse(approx_equal(24u, 27u, 2u));
 	}
 
 	TEST_METHOD(clamp)
@@ -54,6 +61,23 @@ public:
 		Assert::AreEqual(0, clamp(0, -1, 1));
 		Assert::AreEqual(1, clamp(1, -1, 1));
 		Assert::AreEqual(1, clamp(24, -1, 1));
+
+		Assert::AreEqual<int16_t>(8, clamp<int16_t>(24, 0, 8));
+		Assert::AreEqual(0.5f, clamp(0.5f, 0.0f, 1.0f));
+	}
+
+	TEST_METHOD(constexpr_usage)
+	{
+		static_assert(math::approx_equal(1.0f, 1.000001f), "approx_equal must be constexpr");
+		static_assert(math::clamp(24, -1, 1) == 1, "clamp must be constexpr");
+		static_assert(math::lerp(0.0f, 2.0f, 0.5f) == 1.0f, "lerp must be constexpr");
+		static_assert(math::saturate(-24.0) == 0.0, "saturate must be constexpr");
+		static_assert(math::select(0, 24, true) == 24, "select must be constexpr");
+		static_assert(math::sign(-24) == -1, "sign must be constexpr");
+		static_assert(math::step(1.0f, 1.5f) == 1.0f, "step must be constexpr");
+
+		constexpr float v = math::clamp(math::lerp(0.0f, 4.0f, 0.75f), 0.0f, 2.0f);
+		Assert::AreEqual(2.0f, v);
 	}
 
 	TEST_METHOD(lerp)
@@ -63,6 +87,7 @@ public:
 		Assert::AreEqual(0.0f, lerp(0.0f, 1.0f, 0.0f));
 		Assert::AreEqual(0.6, lerp(0.0, 1.0, 0.6));
 		Assert::AreEqual(1.0l, lerp(0.0l, 1.0l, 1.0l));
+		Assert::AreEqual(24, lerp(0, 24, 1));
 
 		//Assert::AreEqual(24.0f, lerp(24.0f, 24.0f, 0.4f));
 		//Assert::AreEqual(24.0f, lerp(24.0f, 24.0f, 0.7f));
@@ -91,8 +116,11 @@ public:
 		using math::sign;
 
 		Assert::AreEqual(-1.0f, sign(-24.0f));
-		//Assert::AreEqual(0.0, sign(0.0));
-		//Assert::AreEqual(1, sign(24));
+		Assert::AreEqual(0.0, sign(0.0));
+		Assert::AreEqual(1, sign(24));
+		Assert::AreEqual(int8_t(-1), sign(int8_t(-24)));
+		Assert::AreEqual(1u, sign(24u));
+		Assert::AreEqual(0u, sign(0u));
 	}
 
 	TEST_METHOD(step)
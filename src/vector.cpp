@@ -1,8 +1,14 @@
+#include "math/math_traits.h"
 #include "math/vector_bool.h"
 #include "math/vector_float.h"
 #include "math/vector_int.h"
 #include "math/vector_utility.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "kernels.h"
+
 
 namespace {
 
@@ -90,6 +96,14 @@ const quat quat::k(0, 0, 1, 0);
 const quat quat::identity(0, 0, 0, 1);
 const quat quat::zero(0, 0, 0, 0);
 
+// The static data members are odr-used when bound to references, e.g. by std::min.
+constexpr size_t vector_traits<float2>::component_count;
+constexpr size_t vector_traits<float2>::byte_count;
+constexpr size_t vector_traits<float3>::component_count;
+constexpr size_t vector_traits<float3>::byte_count;
+constexpr size_t vector_traits<float4>::component_count;
+constexpr size_t vector_traits<float4>::byte_count;
+
 
 std::ostream& operator<<(std::ostream& o, const bool2& v)
 {
@@ -175,6 +189,42 @@ std::wostream& operator<<(std::wostream& out, const quat& q)
 	return out;
 }
 
+void fast_normalize(const float2* v, float2* out, size_t count) noexcept
+{
+	assert(count == 0 || (v && out));
+	active_kernels().fast_normalize_aos(&v->x, 2, &out->x, count);
+}
+
+void fast_normalize(const float3* v, float3* out, size_t count) noexcept
+{
+	assert(count == 0 || (v && out));
+	active_kernels().fast_normalize_aos(&v->x, 3, &out->x, count);
+}
+
+void fast_normalize(const float4* v, float4* out, size_t count) noexcept
+{
+	assert(count == 0 || (v && out));
+	active_kernels().fast_normalize_aos(&v->x, 4, &out->x, count);
+}
+
+void fast_normalize(const quat* q, quat* out, size_t count) noexcept
+{
+	assert(count == 0 || (q && out));
+	active_kernels().fast_normalize_aos(&q->x, 4, &out->x, count);
+}
+
+void normalize(const float3* v, float3* out, size_t count) noexcept
+{
+	assert(count == 0 || (v && out));
+	active_kernels().normalize_float3(v, out, count);
+}
+
+void normalize(const float4* v, float4* out, size_t count) noexcept
+{
+	assert(count == 0 || (v && out));
+	active_kernels().normalize_float4(v, out, count);
+}
+
 quat slerp(const quat& q, const quat& r, float factor)
 {
 	assert(is_normalized(q));
@@ -205,6 +255,92 @@ quat slerp(const quat& q, const quat& r, float factor)
 	return normalize(f0 * q + f1 * q1);
 }
 
+quat slerp_fast(const quat& q, const quat& r, float factor) noexcept
+{
+	assert(is_normalized(q));
+	assert(is_normalized(r));
+	assert(0.0f <= factor && factor <= 1.0f);
+
+	// see slerp_fast_u in kernels.h.
+	const float dot = (q.x * r.x) + (q.y * r.y) + (q.z * r.z) + (q.a * r.a);
+	const float sign = (dot < 0.0f) ? -1.0f : 1.0f;
+	const float cos_omega_m1 = sign * dot - 1.0f;
+
+	const float d = 1.0f - factor;
+	const float t2 = factor * factor;
+	const float d2 = d * d;
+
+	float ct = 1.0f;
+	float cd = 1.0f;
+	for (size_t i = slerp_fast_terms; i-- > 0;) {
+		ct = 1.0f + (slerp_fast_u[i] * t2 - slerp_fast_v[i]) * cos_omega_m1 * ct;
+		cd = 1.0f + (slerp_fast_u[i] * d2 - slerp_fast_v[i]) * cos_omega_m1 * cd;
+	}
+
+	return (d * cd) * q + (sign * factor * ct) * r;
+}
+
+half pack_half(float f) noexcept
+{
+	uint32_t u;
+	std::memcpy(&u, &f, sizeof(u));
+	const uint32_t sign = u & 0x8000'0000;
+	const uint32_t a = u ^ sign;
+
+	uint32_t h;
+	if (a >= 0x4780'0000) {
+		// |f| >= 65536 (and the infinities) overflow, NaNs keep the high 10 bits of the payload.
+		h = (a > 0x7f80'0000) ? (0x7e00 | ((a >> 13) & 0x3ff)) : 0x7c00;
+	}
+	else if (a < 0x3880'0000) {
+		// |f| < 2^-14 is a subnormal half. Adding 0.5 shifts the mantissa so that its lowest bit is 2^-24,
+		// the float addition rounds the rest to nearest even.
+		float t;
+		std::memcpy(&t, &a, sizeof(t));
+		t += 0.5f;
+		std::memcpy(&h, &t, sizeof(h));
+		h -= 0x3f00'0000;
+	}
+	else {
+		// rebiases the exponent and rounds the 13 dropped mantissa bits to nearest even,
+		// the carry may propagate into the exponent up to the infinity.
+		h = (a + 0xc800'0fff + ((a >> 13) & 1)) >> 13;
+	}
+
+	return half(uint16_t(h | (sign >> 16)));
+}
+
+float unpack_half(half h) noexcept
+{
+	const uint32_t sign = uint32_t(h.bits & 0x8000) << 16;
+	// the exponent and the mantissa at their float positions.
+	const uint32_t a = uint32_t(h.bits & 0x7fff) << 13;
+	const uint32_t e = a & 0x0f80'0000;
+
+	uint32_t u;
+	if (e == 0x0f80'0000) {
+		// infinities and NaNs, the latter become quiet.
+		u = a + 0x7000'0000;
+		if (a & 0x007f'ffff) u |= 0x0040'0000;
+	}
+	else if (e == 0) {
+		// zero and the subnormals: 2^-14 * (1 + m / 1024) - 2^-14 is exact.
+		u = a + 0x3880'0000;
+		float t;
+		std::memcpy(&t, &u, sizeof(t));
+		t -= 6.103515625e-5f;
+		std::memcpy(&u, &t, sizeof(u));
+	}
+	else {
+		u = a + 0x3800'0000;
+	}
+
+	u |= sign;
+	float f;
+	std::memcpy(&f, &u, sizeof(f));
+	return f;
+}
+
 uint32_t pack_snorm_10_10_10_2(const float4& vo) noexcept
 {
 	const float4 v = float4(511.0f, 511.0f, 511.0f, 1.0f)
@@ -237,4 +373,293 @@ float4 unpack_unorm_10_10_10_2(uint32_t p) noexcept
 		* float4(float(packed.x), float(packed.y), float(packed.z), float(packed.w));
 }
 
+float2 encode_octahedral(const float3& n) noexcept
+{
+	const float l1 = std::abs(n.x) + std::abs(n.y) + std::abs(n.z);
+	assert(l1 > 0.0f);
+
+	const float inv_l1 = 1.0f / l1;
+	const float x = n.x * inv_l1;
+	const float y = n.y * inv_l1;
+	if (n.z >= 0.0f) return float2(x, y);
+
+	// the lower half is reflected over the edges of the diamond.
+	return float2(std::copysign(1.0f - std::abs(y), x), std::copysign(1.0f - std::abs(x), y));
+}
+
+float3 decode_octahedral(const float2& e) noexcept
+{
+	float3 n(e.x, e.y, 1.0f - std::abs(e.x) - std::abs(e.y));
+
+	// z < 0 are the folded corners, t unfolds them.
+	const float t = std::max(-n.z, 0.0f);
+	n.x += (n.x >= 0.0f) ? -t : t;
+	n.y += (n.y >= 0.0f) ? -t : t;
+
+	return n * (1.0f / std::sqrt(len_squared(n)));
+}
+
+uint32_t pack_octahedral_snorm_16_16(const float3& n) noexcept
+{
+	const float2 e = encode_octahedral(n);
+	const int32_t x = int32_t(std::round(e.x * 32767.0f));
+	const int32_t y = int32_t(std::round(e.y * 32767.0f));
+	return (uint32_t(x) << 16) | (uint32_t(y) & 0xffff);
+}
+
+float3 unpack_octahedral_snorm_16_16(uint32_t p) noexcept
+{
+	const float x = float(int16_t(uint16_t(p >> 16))) / 32767.0f;
+	const float y = float(int16_t(uint16_t(p & 0xffff))) / 32767.0f;
+	return decode_octahedral(float2(std::max(x, -1.0f), std::max(y, -1.0f)));
+}
+
+uint16_t pack_octahedral_unorm_8_8(const float3& n) noexcept
+{
+	const float2 e = encode_octahedral(n);
+	const uint32_t x = uint32_t(std::round((e.x + 1.0f) * 127.5f));
+	const uint32_t y = uint32_t(std::round((e.y + 1.0f) * 127.5f));
+	return uint16_t((x << 8) | y);
+}
+
+float3 unpack_octahedral_unorm_8_8(uint16_t p) noexcept
+{
+	return decode_octahedral(float2(float(p >> 8) / 127.5f - 1.0f, float(p & 0xff) / 127.5f - 1.0f));
+}
+
+uint64_t pack_smallest_three(const quat& q, uint32_t bits) noexcept
+{
+	assert(2 <= bits && bits <= 20);
+	assert(is_normalized(q));
+
+	const float c[4] = { q.x, q.y, q.z, q.a };
+	uint32_t m = 0;
+	for (uint32_t i = 1; i < 4; ++i) {
+		if (std::abs(c[i]) > std::abs(c[m])) m = i;
+	}
+
+	// s makes the largest component positive and maps the rest to [-q_max, q_max],
+	// they are stored with the offset q_max.
+	const float q_max = float((1u << (bits - 1)) - 1);
+	const float s = (c[m] < 0.0f) ? -q_max * 1.41421356f : q_max * 1.41421356f;
+
+	uint64_t p = m;
+	for (uint32_t i = 0; i < 4; ++i) {
+		if (i == m) continue;
+
+		const float v = std::round(clamp(c[i] * s, -q_max, q_max));
+		p = (p << bits) | uint64_t(int32_t(v) + int32_t(q_max));
+	}
+
+	return p;
+}
+
+quat unpack_smallest_three(uint64_t p, uint32_t bits) noexcept
+{
+	assert(2 <= bits && bits <= 20);
+
+	const uint32_t m = uint32_t(p >> (3 * bits)) & 3;
+	const uint64_t mask = (uint64_t(1) << bits) - 1;
+	const float q_max = float((1u << (bits - 1)) - 1);
+	const float inv_s = 1.0f / (q_max * 1.41421356f);
+
+	float c[4];
+	float l2 = 0.0f;
+	uint32_t shift = 3 * bits;
+	for (uint32_t i = 0; i < 4; ++i) {
+		if (i == m) continue;
+
+		shift -= bits;
+		c[i] = (float(uint32_t((p >> shift) & mask)) - q_max) * inv_s;
+		l2 += c[i] * c[i];
+	}
+
+	c[m] = std::sqrt(std::max(1.0f - l2, 0.0f));
+	return normalize(quat(c[0], c[1], c[2], c[3]));
+}
+
+void nlerp(const quat* q, const quat* r, const float* factor, quat* out, size_t count) noexcept
+{
+	assert(count == 0 || (q && r && factor && out));
+	active_kernels().nlerp_quat(q, r, factor, out, count);
+}
+
+void slerp_fast(const quat* q, const quat* r, const float* factor, quat* out, size_t count) noexcept
+{
+	assert(count == 0 || (q && r && factor && out));
+	active_kernels().slerp_fast_quat(q, r, factor, out, count);
+}
+
+void pack_snorm_10_10_10_2(const float4* v, uint32_t* out, size_t count) noexcept
+{
+	assert(count == 0 || (v && out));
+	active_kernels().pack_snorm_10_10_10_2(v, out, count);
+}
+
+void pack_unorm_10_10_10_2(const float4* v, uint32_t* out, size_t count) noexcept
+{
+	assert(count == 0 || (v && out));
+	active_kernels().pack_unorm_10_10_10_2(v, out, count);
+}
+
+void pack_unorm_16_16(const float2* v, uint32_t* out, size_t count) noexcept
+{
+	assert(count == 0 || (v && out));
+	active_kernels().pack_unorm_16_16(v, out, count);
+}
+
+void pack_unorm_8_8_8(const float3* v, uint32_t* out, size_t count) noexcept
+{
+	assert(count == 0 || (v && out));
+	active_kernels().pack_unorm_8_8_8(v, out, count);
+}
+
+void pack_unorm_8_8_8_8(const float4* v, uint32_t* out, size_t count) noexcept
+{
+	assert(count == 0 || (v && out));
+	active_kernels().pack_unorm_8_8_8_8(v, out, count);
+}
+
+void unpack_snorm_10_10_10_2(const uint32_t* p, float4* out, size_t count) noexcept
+{
+	assert(count == 0 || (p && out));
+	active_kernels().unpack_snorm_10_10_10_2(p, out, count);
+}
+
+void unpack_unorm_10_10_10_2(const uint32_t* p, float4* out, size_t count) noexcept
+{
+	assert(count == 0 || (p && out));
+	active_kernels().unpack_unorm_10_10_10_2(p, out, count);
+}
+
+void unpack_unorm_16_16(const uint32_t* p, float2* out, size_t count) noexcept
+{
+	assert(count == 0 || (p && out));
+	active_kernels().unpack_unorm_16_16(p, out, count);
+}
+
+void unpack_unorm_8_8_8(const uint32_t* p, float3* out, size_t count) noexcept
+{
+	assert(count == 0 || (p && out));
+	active_kernels().unpack_unorm_8_8_8(p, out, count);
+}
+
+void unpack_unorm_8_8_8_8(const uint32_t* p, float4* out, size_t count) noexcept
+{
+	assert(count == 0 || (p && out));
+	active_kernels().unpack_unorm_8_8_8_8(p, out, count);
+}
+
+void encode_octahedral(const float3* n, float2* out, size_t count) noexcept
+{
+	assert(count == 0 || (n && out));
+	active_kernels().encode_octahedral(n, out, count);
+}
+
+void decode_octahedral(const float2* e, float3* out, size_t count) noexcept
+{
+	assert(count == 0 || (e && out));
+	active_kernels().decode_octahedral(e, out, count);
+}
+
+void pack_octahedral_snorm_16_16(const float3* n, uint32_t* out, size_t count) noexcept
+{
+	assert(count == 0 || (n && out));
+	active_kernels().pack_octahedral_snorm_16_16(n, out, count);
+}
+
+void unpack_octahedral_snorm_16_16(const uint32_t* p, float3* out, size_t count) noexcept
+{
+	assert(count == 0 || (p && out));
+	active_kernels().unpack_octahedral_snorm_16_16(p, out, count);
+}
+
+void pack_octahedral_unorm_8_8(const float3* n, uint16_t* out, size_t count) noexcept
+{
+	assert(count == 0 || (n && out));
+	active_kernels().pack_octahedral_unorm_8_8(n, out, count);
+}
+
+void unpack_octahedral_unorm_8_8(const uint16_t* p, float3* out, size_t count) noexcept
+{
+	assert(count == 0 || (p && out));
+	active_kernels().unpack_octahedral_unorm_8_8(p, out, count);
+}
+
+void pack_smallest_three(const quat* q, uint32_t bits, uint32_t* out, size_t count) noexcept
+{
+	assert(count == 0 || (q && out));
+	assert(2 <= bits && bits <= 10);
+	active_kernels().pack_smallest_three(q, bits, out, sizeof(*out), count);
+}
+
+void pack_smallest_three(const quat* q, uint32_t bits, uint64_t* out, size_t count) noexcept
+{
+	assert(count == 0 || (q && out));
+	assert(2 <= bits && bits <= 20);
+	active_kernels().pack_smallest_three(q, bits, out, sizeof(*out), count);
+}
+
+void unpack_smallest_three(const uint32_t* p, uint32_t bits, quat* out, size_t count) noexcept
+{
+	assert(count == 0 || (p && out));
+	assert(2 <= bits && bits <= 10);
+	active_kernels().unpack_smallest_three(p, sizeof(*p), bits, out, count);
+}
+
+void unpack_smallest_three(const uint64_t* p, uint32_t bits, quat* out, size_t count) noexcept
+{
+	assert(count == 0 || (p && out));
+	assert(2 <= bits && bits <= 20);
+	active_kernels().unpack_smallest_three(p, sizeof(*p), bits, out, count);
+}
+
+void pack_half(const float* v, half* out, size_t count) noexcept
+{
+	assert(count == 0 || (v && out));
+	active_kernels().pack_half(v, &out->bits, count);
+}
+
+void pack_half(const float2* v, half2* out, size_t count) noexcept
+{
+	assert(count == 0 || (v && out));
+	active_kernels().pack_half(&v->x, &out->x.bits, 2 * count);
+}
+
+void pack_half(const float3* v, half3* out, size_t count) noexcept
+{
+	assert(count == 0 || (v && out));
+	active_kernels().pack_half(&v->x, &out->x.bits, 3 * count);
+}
+
+void pack_half(const float4* v, half4* out, size_t count) noexcept
+{
+	assert(count == 0 || (v && out));
+	active_kernels().pack_half(&v->x, &out->x.bits, 4 * count);
+}
+
+void unpack_half(const half* v, float* out, size_t count) noexcept
+{
+	assert(count == 0 || (v && out));
+	active_kernels().unpack_half(&v->bits, out, count);
+}
+
+void unpack_half(const half2* v, float2* out, size_t count) noexcept
+{
+	assert(count == 0 || (v && out));
+	active_kernels().unpack_half(&v->x.bits, &out->x, 2 * count);
+}
+
+void unpack_half(const half3* v, float3* out, size_t count) noexcept
+{
+	assert(count == 0 || (v && out));
+	active_kernels().unpack_half(&v->x.bits, &out->x, 3 * count);
+}
+
+void unpack_half(const half4* v, float4* out, size_t count) noexcept
+{
+	assert(count == 0 || (v && out));
+	active_kernels().unpack_half(&v->x.bits, &out->x, 4 * count);
+}
+
 } // namespace math
\ No newline at end of file
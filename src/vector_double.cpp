@@ -0,0 +1,118 @@
+#include "math/vector_double.h"
+
+#include "kernels.h"
+
+
+namespace math {
+
+const double2 double2::unit_x(1, 0);
+const double2 double2::unit_y(0, 1);
+const double2 double2::unit_xy(1);
+const double2 double2::zero(0);
+
+const double3 double3::unit_x(1, 0, 0);
+const double3 double3::unit_y(0, 1, 0);
+const double3 double3::unit_z(0, 0, 1);
+const double3 double3::unit_xy(1, 1, 0);
+const double3 double3::unit_xyz(1);
+const double3 double3::zero(0);
+
+const double4 double4::unit_x(1, 0, 0, 0);
+const double4 double4::unit_y(0, 1, 0, 0);
+const double4 double4::unit_z(0, 0, 1, 0);
+const double4 double4::unit_w(0, 0, 0, 1);
+const double4 double4::unit_xyzw(1);
+const double4 double4::zero(0);
+
+const dquat dquat::i(1, 0, 0, 0);
+const dquat dquat::j(0, 1, 0, 0);
+const dquat dquat::k(0, 0, 1, 0);
+const dquat dquat::identity(0, 0, 0, 1);
+const dquat dquat::zero(0, 0, 0, 0);
+
+
+std::ostream& operator<<(std::ostream& out, const double2& v)
+{
+	out << "double2(" << v.x << ", " << v.y << ")";
+	return out;
+}
+
+std::wostream& operator<<(std::wostream& out, const double2& v)
+{
+	out << "double2(" << v.x << ", " << v.y << ")";
+	return out;
+}
+
+std::ostream& operator<<(std::ostream& out, const double3& v)
+{
+	out << "double3(" << v.x << ", " << v.y << ", " << v.z << ")";
+	return out;
+}
+
+std::wostream& operator<<(std::wostream& out, const double3& v)
+{
+	out << "double3(" << v.x << ", " << v.y << ", " << v.z << ")";
+	return out;
+}
+
+std::ostream& operator<<(std::ostream& out, const double4& v)
+{
+	out << "double4(" << v.x << ", " << v.y << ", " << v.z << ", " << v.w << ")";
+	return out;
+}
+
+std::wostream& operator<<(std::wostream& out, const double4& v)
+{
+	out << "double4(" << v.x << ", " << v.y << ", " << v.z << ", " << v.w << ")";
+	return out;
+}
+
+std::ostream& operator<<(std::ostream& out, const dquat& q)
+{
+	out << "dquat(" << q.x << ", " << q.y << ", " << q.z << ", " << q.a << ")";
+	return out;
+}
+
+std::wostream& operator<<(std::wostream& out, const dquat& q)
+{
+	out << "dquat(" << q.x << ", " << q.y << ", " << q.z << ", " << q.a << ")";
+	return out;
+}
+
+dquat slerp(const dquat& q, const dquat& r, double factor)
+{
+	assert(is_normalized(q));
+	assert(is_normalized(r));
+	assert(0.0 <= factor && factor <= 1.0);
+
+	double cos_omega = (q.x * r.x) + (q.y * r.y) + (q.z * r.z) + (q.a * r.a);
+	dquat q1 = r;
+	if (cos_omega < 0) {
+		cos_omega = -cos_omega;
+		q1 = -q1;
+	}
+
+	double f0;
+	double f1;
+	if (cos_omega > 0.9999999) {
+		// fallback to linear interpolation
+		f0 = 1.0 - factor;
+		f1 = factor;
+	}
+	else {
+		double omega = std::acos(cos_omega);
+		double inv_sin = 1.0 / std::sin(omega);
+		f0 = std::sin((1.0 - factor) * omega) * inv_sin;
+		f1 = std::sin(factor * omega) * inv_sin;
+	}
+
+	return normalize(f0 * q + f1 * q1);
+}
+
+void to_float_relative(const double3* p, const double3& origin, float3* out, size_t count) noexcept
+{
+	assert(count == 0 || (p && out));
+	active_kernels().to_float_relative(p, origin, out, count);
+}
+
+} // namespace math
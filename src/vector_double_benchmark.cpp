@@ -0,0 +1,52 @@
+#include "math/vector_double.h"
+
+#include <vector>
+#include "benchmark.h"
+
+using math::double3;
+using math::double4;
+using math::dquat;
+using math::float3;
+
+
+namespace {
+
+// ----- double3 -----
+
+BENCHMARK_MAP2(add_double3, double3, double3, double3, -1.0f, 1.0f, a + b);
+BENCHMARK_MAP2(cross_double3, double3, double3, double3, -1.0f, 1.0f, math::cross(a, b));
+BENCHMARK_MAP2(dot_double3, double, double3, double3, -1.0f, 1.0f, math::dot(a, b));
+BENCHMARK_MAP(len_double3, double, double3, -1.0f, 1.0f, math::len(a));
+BENCHMARK_MAP2(lerp_double3, double3, double3, double3, -1.0f, 1.0f, math::lerp(a, b, 0.3));
+BENCHMARK_MAP(normalize_double3, double3, double3, -1.0f, 1.0f, math::normalize(a));
+BENCHMARK_MAP2(to_float_relative, float3, double3, double3, -1.0e6f, 1.0e6f, math::to_float_relative(a, b));
+
+// ----- double4 -----
+
+BENCHMARK_MAP2(add_double4, double4, double4, double4, -1.0f, 1.0f, a + b);
+BENCHMARK_MAP2(dot_double4, double, double4, double4, -1.0f, 1.0f, math::dot(a, b));
+BENCHMARK_MAP2(mul_double4, double4, double4, double4, -1.0f, 1.0f, a * b);
+BENCHMARK_MAP(mul_double4_double, double4, double4, -1.0f, 1.0f, a * 3.0);
+BENCHMARK_MAP(normalize_double4, double4, double4, -1.0f, 1.0f, math::normalize(a));
+
+// ----- dquat -----
+
+BENCHMARK_MAP2(mul_dquat, dquat, dquat, dquat, -1.0f, 1.0f, a * b);
+BENCHMARK_MAP2(slerp_dquat, dquat, dquat, dquat, -1.0f, 1.0f, math::slerp(a, b, 0.3));
+
+// ----- batch functions -----
+
+void to_float_relative_batch(benchmark::state& state)
+{
+	const std::vector<double3> p = benchmark::random_values<double3>(state.size(), -1.0e6f, 1.0e6f, 1);
+	const double3 origin(1.0e6, -2.0e6, 3.0e5);
+	std::vector<float3> out(state.size());
+
+	while (state.keep_running()) {
+		math::to_float_relative(p.data(), origin, out.data(), state.size());
+		benchmark::clobber_memory();
+	}
+}
+BENCHMARK(to_float_relative_batch);
+
+} // namespace
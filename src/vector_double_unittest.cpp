@@ -0,0 +1,189 @@
+#include "math/vector_double.h"
+
+#include <vector>
+#include "CppUnitTest.h"
+
+using math::double2;
+using math::double3;
+using math::double4;
+using math::dquat;
+using math::float2;
+using math::float3;
+using math::float4;
+using math::quat;
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+
+namespace Microsoft { namespace VisualStudio { namespace CppUnitTestFramework {
+
+template<> inline std::wstring ToString<math::double2>(const math::double2& t) { RETURN_WIDE_STRING(t); }
+template<> inline std::wstring ToString<math::double3>(const math::double3& t) { RETURN_WIDE_STRING(t); }
+template<> inline std::wstring ToString<math::double4>(const math::double4& t) { RETURN_WIDE_STRING(t); }
+template<> inline std::wstring ToString<math::dquat>(const math::dquat& t) { RETURN_WIDE_STRING(t); }
+template<> inline std::wstring ToString<math::float3>(const math::float3& t) { RETURN_WIDE_STRING(t); }
+
+}}} // namespace Microsoft::VisualStudio::CppUnitTestFramework
+
+
+namespace unittest {
+
+TEST_CLASS(math_vector_double_double3) {
+public:
+
+	TEST_METHOD(binary_operators)
+	{
+		const double3 v(1, 2, 3);
+
+		Assert::AreEqual(double3(11, 12, 13), v + 10.0);
+		Assert::AreEqual(double3(11, 12, 13), 10.0 + v);
+		Assert::AreEqual(double3(2, 4, 6), v + v);
+		Assert::AreEqual(double3(0, 1, 2), v - 1.0);
+		Assert::AreEqual(double3(0, 1, 2), 3.0 - double3(3, 2, 1));
+		Assert::AreEqual(double3::zero, v - v);
+		Assert::AreEqual(double3(2, 4, 6), v * 2.0);
+		Assert::AreEqual(double3(2, 4, 6), 2.0 * v);
+		Assert::AreEqual(double3(0.5, 1, 1.5), v / 2.0);
+		Assert::AreEqual(double3(6, 3, 2), 6.0 / v);
+		Assert::AreEqual(double3::unit_xyz, v / v);
+		Assert::AreEqual(double3(-1, -2, -3), -v);
+	}
+
+	TEST_METHOD(compound_assignment_operators)
+	{
+		double3 v(1, 2, 3);
+
+		(v += 1.0) += double3(1, 2, 3);
+		Assert::AreEqual(double3(3, 5, 7), v);
+
+		(v -= double3(1, 2, 3)) -= 1.0;
+		Assert::AreEqual(double3(1, 2, 3), v);
+
+		(v *= 2.0) *= 3.0;
+		Assert::AreEqual(double3(6, 12, 18), v);
+
+		(v /= double3(3, 6, 9)) /= 2.0;
+		Assert::AreEqual(double3::unit_xyz, v);
+	}
+
+	TEST_METHOD(conversions)
+	{
+		const float3 f(1.5f, -2.25f, 3.0f);
+		const double3 d(f);
+		Assert::AreEqual(double3(1.5, -2.25, 3.0), d);
+		Assert::AreEqual(f, float3(d));
+		Assert::AreEqual(double2(1.5, -2.25), double2(d));
+		Assert::AreEqual(double2(1.5, -2.25), math::xy(d));
+
+		const double4 d4(d, 7.0);
+		Assert::AreEqual(double4(1.5, -2.25, 3.0, 7.0), d4);
+		Assert::AreEqual(d, double3(d4));
+		Assert::AreEqual(d, math::xyz(d4));
+		Assert::AreEqual(float4(1.5f, -2.25f, 3.0f, 7.0f), float4(d4));
+	}
+
+	TEST_METHOD(cross_and_dot_product)
+	{
+		using math::cross;
+		using math::dot;
+
+		Assert::AreEqual(double3::unit_z, cross(double3::unit_x, double3::unit_y));
+		Assert::AreEqual(-double3::unit_z, cross(double3::unit_y, double3::unit_x));
+		Assert::AreEqual(32.0, dot(double3(1, 2, 3), double3(4, 5, 6)));
+		Assert::AreEqual(70.0, dot(double4(1, 2, 3, 4), double4(5, 6, 7, 8)));
+	}
+
+	TEST_METHOD(len_and_normalize)
+	{
+		using math::is_normalized;
+		using math::len;
+		using math::len_squared;
+
+		Assert::AreEqual(25.0, len_squared(double3(0, 3, 4)));
+		Assert::AreEqual(5.0, len(double3(0, 3, 4)));
+		Assert::AreEqual(double3::zero, math::normalize(double3::zero));
+		Assert::IsTrue(is_normalized(math::normalize(double3(1, 2, 3))));
+		Assert::IsTrue(math::approx_equal(double3(0, 0.6, 0.8), math::normalize(double3(0, 3, 4)), 1e-12));
+	}
+
+	TEST_METHOD(precision)
+	{
+		// a millimeter at 10^7 meters from the origin is lost by float but not by double.
+		const double3 p(1.0e7, -2.0e7, 3.0e7);
+		const double3 q = p + double3(0.001, 0.002, -0.003);
+
+		Assert::IsTrue(float3(p) == float3(q));
+		Assert::IsTrue(math::approx_equal(double3(0.001, 0.002, -0.003), q - p, 1e-8));
+	}
+
+	TEST_METHOD(to_float_relative)
+	{
+		const double3 origin(1.0e7, -2.0e7, 3.0e7);
+		const double3 p = origin + double3(1.5, -0.25, 0.001);
+
+		const float3 r = math::to_float_relative(p, origin);
+		Assert::IsTrue(math::approx_equal(float3(1.5f, -0.25f, 0.001f), r, 1e-6f));
+
+		std::vector<double3> pts(19);
+		for (size_t i = 0; i < pts.size(); ++i)
+			pts[i] = origin + double3(double(i), -0.5 * double(i), 0.001 * double(i));
+
+		std::vector<float3> out(pts.size());
+		math::to_float_relative(pts.data(), origin, out.data(), pts.size());
+		for (size_t i = 0; i < pts.size(); ++i)
+			Assert::AreEqual(math::to_float_relative(pts[i], origin), out[i]);
+	}
+};
+
+TEST_CLASS(math_vector_double_dquat) {
+public:
+
+	TEST_METHOD(binary_operators)
+	{
+		const dquat q(1, 2, 3, 4);
+		const dquat r(5, 6, 7, 8);
+
+		Assert::AreEqual(dquat(6, 8, 10, 12), q + r);
+		Assert::AreEqual(dquat(-4, -4, -4, -4), q - r);
+		Assert::AreEqual(dquat(2, 4, 6, 8), q * 2.0);
+		Assert::AreEqual(dquat(0.5, 1, 1.5, 2), q / 2.0);
+
+		// the Hamilton product equals to the float one.
+		const dquat p = q * r;
+		Assert::IsTrue(math::approx_equal(dquat(quat(1, 2, 3, 4) * quat(5, 6, 7, 8)), p));
+
+		dquat c = q;
+		c *= r;
+		Assert::AreEqual(p, c);
+	}
+
+	TEST_METHOD(conversions)
+	{
+		const quat q(0.5f, -0.5f, 0.25f, 1.0f);
+		Assert::AreEqual(dquat(0.5, -0.5, 0.25, 1.0), dquat(q));
+		Assert::IsTrue(q == quat(dquat(q)));
+	}
+
+	TEST_METHOD(inverse)
+	{
+		const dquat q(1, 2, 3, 4);
+		Assert::IsTrue(math::approx_equal(dquat::identity, q * math::inverse(q), 1e-12));
+	}
+
+	TEST_METHOD(slerp)
+	{
+		using math::approx_equal;
+		using math::normalize;
+
+		const dquat q = normalize(dquat(1, 2, 3, 4));
+		const dquat r = normalize(dquat(-4, 3, 2, 1));
+
+		Assert::IsTrue(approx_equal(q, math::slerp(q, r, 0.0)));
+		Assert::IsTrue(approx_equal(r, math::slerp(q, r, 1.0)));
+
+		const dquat m = math::slerp(q, r, 0.3);
+		const dquat mf(math::slerp(quat(q), quat(r), 0.3f));
+		Assert::IsTrue(approx_equal(mf, m, 1e-5));
+	}
+};
+
+} // namespace unittest
@@ -0,0 +1,196 @@
+#include "math/vector_float.h"
+
+#include <vector>
+#include "benchmark.h"
+
+using math::float2;
+using math::float3;
+using math::float4;
+using math::quat;
+
+
+namespace {
+
+// Measures the batch normalization function func(in, out, count).
+template<typename T, typename Func>
+void bench_normalize_batch(benchmark::state& state, Func func)
+{
+	const std::vector<T> in = benchmark::random_values<T>(state.size(), -10.0f, 10.0f, 1);
+	std::vector<T> out(state.size());
+
+	while (state.keep_running()) {
+		func(in.data(), out.data(), state.size());
+		benchmark::clobber_memory();
+	}
+}
+
+// Measures the batch interpolation function func(q, r, factor, out, count).
+template<typename Func>
+void bench_interpolate_batch(benchmark::state& state, Func func)
+{
+	const std::vector<quat> q = benchmark::random_unit_quat(state.size(), 1);
+	const std::vector<quat> r = benchmark::random_unit_quat(state.size(), 2);
+	const std::vector<float> factor = benchmark::random_values<float>(state.size(), 0.0f, 1.0f, 3);
+	std::vector<quat> out(state.size());
+
+	while (state.keep_running()) {
+		func(q.data(), r.data(), factor.data(), out.data(), state.size());
+		benchmark::clobber_memory();
+	}
+}
+
+
+// ----- float2 -----
+
+BENCHMARK_MAP(abs_float2, float2, float2, -1.0f, 1.0f, math::abs(a));
+BENCHMARK_MAP2(add_float2, float2, float2, float2, -1.0f, 1.0f, a + b);
+BENCHMARK_MAP2(approx_equal_float2, uint8_t, float2, float2, -1.0f, 1.0f, math::approx_equal(a, b));
+BENCHMARK_MAP(aspect_ratio, float, float2, 0.5f, 2.0f, math::aspect_ratio(a));
+BENCHMARK_MAP(clamp_float2, float2, float2, -1.0f, 1.0f, math::clamp(a, float2(-0.5f), float2(0.5f)));
+BENCHMARK_MAP2(div_float2, float2, float2, float2, 0.5f, 2.0f, a / b);
+BENCHMARK_MAP(div_float2_float, float2, float2, -1.0f, 1.0f, a / 3.0f);
+BENCHMARK_MAP2(dot_float2, float, float2, float2, -1.0f, 1.0f, math::dot(a, b));
+BENCHMARK_MAP2(equal_float2, uint8_t, float2, float2, -1.0f, 1.0f, a == b);
+BENCHMARK_MAP(fast_normalize_float2, float2, float2, -1.0f, 1.0f, math::fast_normalize(a));
+BENCHMARK_MAP(greater_float2_float, uint8_t, float2, -1.0f, 1.0f, a > 0.0f);
+BENCHMARK_MAP(is_normalized_float2, uint8_t, float2, -1.0f, 1.0f, math::is_normalized(a));
+BENCHMARK_MAP(len_float2, float, float2, -1.0f, 1.0f, math::len(a));
+BENCHMARK_MAP(len_squared_float2, float, float2, -1.0f, 1.0f, math::len_squared(a));
+BENCHMARK_MAP2(lerp_float2, float2, float2, float2, -1.0f, 1.0f, math::lerp(a, b, 0.3f));
+BENCHMARK_MAP(less_float2_float, uint8_t, float2, -1.0f, 1.0f, a < 0.0f);
+BENCHMARK_MAP2(mul_float2, float2, float2, float2, -1.0f, 1.0f, a * b);
+BENCHMARK_MAP(mul_float2_float, float2, float2, -1.0f, 1.0f, a * 3.0f);
+BENCHMARK_MAP(negate_float2, float2, float2, -1.0f, 1.0f, -a);
+BENCHMARK_MAP(normalize_float2, float2, float2, -1.0f, 1.0f, math::normalize(a));
+BENCHMARK_MAP(saturate_float2, float2, float2, -1.0f, 2.0f, math::saturate(a));
+BENCHMARK_MAP2(sub_float2, float2, float2, float2, -1.0f, 1.0f, a - b);
+
+// ----- float3 -----
+
+BENCHMARK_MAP(abs_float3, float3, float3, -1.0f, 1.0f, math::abs(a));
+BENCHMARK_MAP2(add_float3, float3, float3, float3, -1.0f, 1.0f, a + b);
+BENCHMARK_MAP2(approx_equal_float3, uint8_t, float3, float3, -1.0f, 1.0f, math::approx_equal(a, b));
+BENCHMARK_MAP(clamp_float3, float3, float3, -1.0f, 1.0f, math::clamp(a, float3(-0.5f), float3(0.5f)));
+BENCHMARK_MAP2(cross_float3, float3, float3, float3, -1.0f, 1.0f, math::cross(a, b));
+BENCHMARK_MAP2(div_float3, float3, float3, float3, 0.5f, 2.0f, a / b);
+BENCHMARK_MAP(div_float3_float, float3, float3, -1.0f, 1.0f, a / 3.0f);
+BENCHMARK_MAP2(dot_float3, float, float3, float3, -1.0f, 1.0f, math::dot(a, b));
+BENCHMARK_MAP2(equal_float3, uint8_t, float3, float3, -1.0f, 1.0f, a == b);
+BENCHMARK_MAP(fast_normalize_float3, float3, float3, -1.0f, 1.0f, math::fast_normalize(a));
+BENCHMARK_MAP(greater_float3_float, uint8_t, float3, -1.0f, 1.0f, a > 0.0f);
+BENCHMARK_MAP(is_normalized_float3, uint8_t, float3, -1.0f, 1.0f, math::is_normalized(a));
+BENCHMARK_MAP(len_float3, float, float3, -1.0f, 1.0f, math::len(a));
+BENCHMARK_MAP(len_squared_float3, float, float3, -1.0f, 1.0f, math::len_squared(a));
+BENCHMARK_MAP2(lerp_float3, float3, float3, float3, -1.0f, 1.0f, math::lerp(a, b, 0.3f));
+BENCHMARK_MAP(less_float3_float, uint8_t, float3, -1.0f, 1.0f, a < 0.0f);
+BENCHMARK_MAP2(mul_float3, float3, float3, float3, -1.0f, 1.0f, a * b);
+BENCHMARK_MAP(mul_float3_float, float3, float3, -1.0f, 1.0f, a * 3.0f);
+BENCHMARK_MAP(negate_float3, float3, float3, -1.0f, 1.0f, -a);
+BENCHMARK_MAP(normalize_float3, float3, float3, -1.0f, 1.0f, math::normalize(a));
+BENCHMARK_MAP(saturate_float3, float3, float3, -1.0f, 2.0f, math::saturate(a));
+BENCHMARK_MAP2(sub_float3, float3, float3, float3, -1.0f, 1.0f, a - b);
+BENCHMARK_MAP(xy_float3, float2, float3, -1.0f, 1.0f, math::xy(a));
+
+// ----- float4 -----
+
+BENCHMARK_MAP(abs_float4, float4, float4, -1.0f, 1.0f, math::abs(a));
+BENCHMARK_MAP2(add_float4, float4, float4, float4, -1.0f, 1.0f, a + b);
+BENCHMARK_MAP2(approx_equal_float4, uint8_t, float4, float4, -1.0f, 1.0f, math::approx_equal(a, b));
+BENCHMARK_MAP(clamp_float4, float4, float4, -1.0f, 1.0f, math::clamp(a, float4(-0.5f), float4(0.5f)));
+BENCHMARK_MAP2(div_float4, float4, float4, float4, 0.5f, 2.0f, a / b);
+BENCHMARK_MAP(div_float4_float, float4, float4, -1.0f, 1.0f, a / 3.0f);
+BENCHMARK_MAP2(dot_float4, float, float4, float4, -1.0f, 1.0f, math::dot(a, b));
+BENCHMARK_MAP2(equal_float4, uint8_t, float4, float4, -1.0f, 1.0f, a == b);
+BENCHMARK_MAP(fast_normalize_float4, float4, float4, -1.0f, 1.0f, math::fast_normalize(a));
+BENCHMARK_MAP(greater_float4_float, uint8_t, float4, -1.0f, 1.0f, a > 0.0f);
+BENCHMARK_MAP(is_normalized_float4, uint8_t, float4, -1.0f, 1.0f, math::is_normalized(a));
+BENCHMARK_MAP(len_float4, float, float4, -1.0f, 1.0f, math::len(a));
+BENCHMARK_MAP(len_squared_float4, float, float4, -1.0f, 1.0f, math::len_squared(a));
+BENCHMARK_MAP2(lerp_float4, float4, float4, float4, -1.0f, 1.0f, math::lerp(a, b, 0.3f));
+BENCHMARK_MAP(less_float4_float, uint8_t, float4, -1.0f, 1.0f, a < 0.0f);
+BENCHMARK_MAP2(mul_float4, float4, float4, float4, -1.0f, 1.0f, a * b);
+BENCHMARK_MAP(mul_float4_float, float4, float4, -1.0f, 1.0f, a * 3.0f);
+BENCHMARK_MAP(negate_float4, float4, float4, -1.0f, 1.0f, -a);
+BENCHMARK_MAP(normalize_float4, float4, float4, -1.0f, 1.0f, math::normalize(a));
+BENCHMARK_MAP(round_float4, float4, float4, -10.0f, 10.0f, math::round(a));
+BENCHMARK_MAP(saturate_float4, float4, float4, -1.0f, 2.0f, math::saturate(a));
+BENCHMARK_MAP2(sub_float4, float4, float4, float4, -1.0f, 1.0f, a - b);
+BENCHMARK_MAP(xy_float4, float2, float4, -1.0f, 1.0f, math::xy(a));
+BENCHMARK_MAP(xyz_float4, float3, float4, -1.0f, 1.0f, math::xyz(a));
+
+// ----- quat -----
+
+BENCHMARK_MAP2(add_quat, quat, quat, quat, -1.0f, 1.0f, a + b);
+BENCHMARK_MAP2(approx_equal_quat, uint8_t, quat, quat, -1.0f, 1.0f, math::approx_equal(a, b));
+BENCHMARK_MAP(conjugate_quat, quat, quat, -1.0f, 1.0f, math::conjugate(a));
+BENCHMARK_MAP(div_quat_float, quat, quat, -1.0f, 1.0f, a / 3.0f);
+BENCHMARK_MAP2(equal_quat, uint8_t, quat, quat, -1.0f, 1.0f, a == b);
+BENCHMARK_MAP(fast_normalize_quat, quat, quat, -1.0f, 1.0f, math::fast_normalize(a));
+BENCHMARK_MAP(inverse_quat, quat, quat, -1.0f, 1.0f, math::inverse(a));
+BENCHMARK_MAP(is_normalized_quat, uint8_t, quat, -1.0f, 1.0f, math::is_normalized(a));
+BENCHMARK_MAP(len_quat, float, quat, -1.0f, 1.0f, math::len(a));
+BENCHMARK_MAP(len_squared_quat, float, quat, -1.0f, 1.0f, math::len_squared(a));
+BENCHMARK_MAP2(mul_quat, quat, quat, quat, -1.0f, 1.0f, a * b);
+BENCHMARK_MAP(mul_quat_float, quat, quat, -1.0f, 1.0f, a * 3.0f);
+BENCHMARK_MAP(negate_quat, quat, quat, -1.0f, 1.0f, -a);
+BENCHMARK_MAP2(nlerp, quat, quat, quat, -1.0f, 1.0f, math::nlerp(a, b, 0.3f));
+BENCHMARK_MAP(normalize_quat, quat, quat, -1.0f, 1.0f, math::normalize(a));
+BENCHMARK_MAP2(slerp, quat, quat, quat, -1.0f, 1.0f, math::slerp(a, b, 0.3f));
+BENCHMARK_MAP2(slerp_fast, quat, quat, quat, -1.0f, 1.0f, math::slerp_fast(a, b, 0.3f));
+BENCHMARK_MAP2(sub_quat, quat, quat, quat, -1.0f, 1.0f, a - b);
+
+// ----- batch functions -----
+
+void fast_normalize_float2_batch(benchmark::state& state)
+{
+	bench_normalize_batch<float2>(state, [](const float2* in, float2* out, size_t count) { math::fast_normalize(in, out, count); });
+}
+BENCHMARK(fast_normalize_float2_batch);
+
+void fast_normalize_float3_batch(benchmark::state& state)
+{
+	bench_normalize_batch<float3>(state, [](const float3* in, float3* out, size_t count) { math::fast_normalize(in, out, count); });
+}
+BENCHMARK(fast_normalize_float3_batch);
+
+void fast_normalize_float4_batch(benchmark::state& state)
+{
+	bench_normalize_batch<float4>(state, [](const float4* in, float4* out, size_t count) { math::fast_normalize(in, out, count); });
+}
+BENCHMARK(fast_normalize_float4_batch);
+
+void fast_normalize_quat_batch(benchmark::state& state)
+{
+	bench_normalize_batch<quat>(state, [](const quat* in, quat* out, size_t count) { math::fast_normalize(in, out, count); });
+}
+BENCHMARK(fast_normalize_quat_batch);
+
+void nlerp_batch(benchmark::state& state)
+{
+	bench_interpolate_batch(state, [](const quat* q, const quat* r, const float* factor, quat* out, size_t count) {
+		math::nlerp(q, r, factor, out, count);
+	});
+}
+BENCHMARK(nlerp_batch);
+
+void normalize_float3_batch(benchmark::state& state)
+{
+	bench_normalize_batch<float3>(state, [](const float3* in, float3* out, size_t count) { math::normalize(in, out, count); });
+}
+BENCHMARK(normalize_float3_batch);
+
+void normalize_float4_batch(benchmark::state& state)
+{
+	bench_normalize_batch<float4>(state, [](const float4* in, float4* out, size_t count) { math::normalize(in, out, count); });
+}
+BENCHMARK(normalize_float4_batch);
+
+void slerp_fast_batch(benchmark::state& state)
+{
+	bench_interpolate_batch(state, [](const quat* q, const quat* r, const float* factor, quat* out, size_t count) {
+		math::slerp_fast(q, r, factor, out, count);
+	});
+}
+BENCHMARK(slerp_fast_batch);
+
+} // namespace
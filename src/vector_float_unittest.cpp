@@ -198,6 +198,20 @@ public:
 		Assert::AreEqual(v, float2(1, 2));
 	}
 
+	TEST_METHOD(fast_normalize)
+	{
+		using math::approx_equal;
+		using math::fast_normalize;
+
+		Assert::AreEqual(float2::zero, fast_normalize(float2::zero));
+
+		for (const float2& v : { float2(24, 0), float2(-8, 6), float2(1e-2f, 2e-2f), float2(1e4f, -3e4f) }) {
+			const float2 n = fast_normalize(v);
+			Assert::IsTrue(approx_equal(1.0f, math::len(n), 1e-6f));
+			Assert::IsTrue(approx_equal(math::normalize(v), n, 1e-6f));
+		}
+	}
+
 	TEST_METHOD(is_normalized)
 	{
 		using math::is_normalized;
@@ -547,6 +561,20 @@ public:
 		Assert::AreEqual(v, float3(1, 2, 3));
 	}
 
+	TEST_METHOD(fast_normalize)
+	{
+		using math::approx_equal;
+		using math::fast_normalize;
+
+		Assert::AreEqual(float3::zero, fast_normalize(float3::zero));
+
+		for (const float3& v : { float3(24, 0, 0), float3(-8, 6, 3), float3(1e-2f, 2e-2f, 0), float3(1e4f, -3e4f, 2e4f) }) {
+			const float3 n = fast_normalize(v);
+			Assert::IsTrue(approx_equal(1.0f, math::len(n), 1e-6f));
+			Assert::IsTrue(approx_equal(math::normalize(v), n, 1e-6f));
+		}
+	}
+
 	TEST_METHOD(is_normalized)
 	{
 		using math::is_normalized;
@@ -861,6 +889,24 @@ public:
 		Assert::AreEqual(v, float4(1, 2, 3, 4));
 	}
 
+	TEST_METHOD(fast_normalize)
+	{
+		using math::approx_equal;
+		using math::fast_normalize;
+
+		Assert::AreEqual(float4::zero, fast_normalize(float4::zero));
+
+		for (const float4& v : { float4(24, 0, 0, 0), float4(-8, 6, 3, 1), float4(1e-2f, 2e-2f, 0, 1e-2f), float4(1e4f, -3e4f, 2e4f, 5) }) {
+			const float4 n = fast_normalize(v);
+			Assert::IsTrue(approx_equal(1.0f, math::len(n), 1e-6f));
+			Assert::IsTrue(approx_equal(math::normalize(v), n, 1e-6f));
+		}
+
+		// rsqrt's relative error
+		for (float x = 1e-6f; x < 1e6f; x *= 1.37f)
+			Assert::IsTrue(std::abs(double(math::rsqrt(x)) * std::sqrt(double(x)) - 1.0) < 5e-7);
+	}
+
 	TEST_METHOD(is_normalized)
 	{
 		using math::is_normalized;
@@ -1171,16 +1217,38 @@ public:
 		Assert::AreEqual(q, quat(1, 2, 3, 4));
 	}
 
+	TEST_METHOD(fast_normalize)
+	{
+		using math::approx_equal;
+		using math::fast_normalize;
+
+		Assert::AreEqual(quat::zero, fast_normalize(quat::zero));
+
+		for (const quat& v : { quat(24, 0, 0, 0), quat(-8, 6, 3, 1), quat(1e-2f, 2e-2f, 0, 1e-2f), quat(1e4f, -3e4f, 2e4f, 5) }) {
+			const quat n = fast_normalize(v);
+			Assert::IsTrue(approx_equal(1.0f, math::len(n), 1e-6f));
+			Assert::IsTrue(approx_equal(math::normalize(v), n, 1e-6f));
+		}
+	}
+
 	TEST_METHOD(inverse)
 	{
+		using math::approx_equal;
 		using math::inverse;
 
 		Assert::AreEqual(quat::identity, inverse(quat::identity));
 
 		quat q = quat(2, 3, 4, 5);
 
+#if (MATH_SIMD >= MATH_SIMD_SSE4_1)
+		// the SIMD product sums the terms in another order and the compiler may fuse them into FMAs,
+		// the result may be off by an ulp.
+		Assert::IsTrue(approx_equal(quat::identity, q * inverse(q)));
+		Assert::IsTrue(approx_equal(quat::identity, inverse(q) * q));
+#else
 		Assert::AreEqual(quat::identity, q * inverse(q));
 		Assert::AreEqual(quat::identity, inverse(q) * q);
+#endif
 	}
 
 	TEST_METHOD(is_normalized)
@@ -1222,6 +1290,25 @@ public:
 			L"|QP| = |Q| * |P|");
 	}
 
+	TEST_METHOD(nlerp)
+	{
+		using math::approx_equal;
+		using math::is_normalized;
+		using math::nlerp;
+		using math::normalize;
+
+		const quat q = normalize(quat(1, 2, 3, 4));
+		const quat r = normalize(quat(5, 6, 7, 8));
+		Assert::IsTrue(approx_equal(q, nlerp(q, r, 0.f)));
+		Assert::IsTrue(approx_equal(r, nlerp(q, r, 1.f)));
+		Assert::IsTrue(approx_equal(normalize(q + r), nlerp(q, r, 0.5f)));
+		Assert::IsTrue(is_normalized(nlerp(q, r, 0.3f)));
+
+		// the shortest arc: -r is the same rotation as r.
+		Assert::IsTrue(approx_equal(normalize(q + r), nlerp(q, -r, 0.5f)));
+		Assert::IsTrue(approx_equal(r, nlerp(q, -r, 1.f)));
+	}
+
 	TEST_METHOD(normalize)
 	{
 		using math::approx_equal;
@@ -1250,6 +1337,36 @@ public:
 		Assert::IsTrue(is_normalized(qs));
 	}
 
+	TEST_METHOD(slerp_fast)
+	{
+		using math::approx_equal;
+		using math::len;
+		using math::normalize;
+		using math::slerp;
+		using math::slerp_fast;
+
+		const quat q = normalize(quat(1, 2, 3, 4));
+		const quat r = normalize(quat(5, 6, 7, 8));
+		Assert::IsTrue(approx_equal(q, slerp_fast(q, r, 0.f)));
+		Assert::IsTrue(approx_equal(r, slerp_fast(q, r, 1.f)));
+
+		// the documented error bound holds for the angles up to pi between the rotations
+		// and for the both signs of the quaternions.
+		for (int a = 0; a <= 36; ++a) {
+			const float angle = math::pi * float(a) / 36.0f;
+			const quat qa(std::sin(0.15f) * normalize(float3(1, 2, 3)), std::cos(0.15f));
+			const quat ra = qa * quat(std::sin(0.5f * angle) * normalize(float3(-2, 1, 0.5f)), std::cos(0.5f * angle));
+
+			for (int f = 0; f <= 20; ++f) {
+				const float factor = float(f) / 20.0f;
+				const quat expected = slerp(qa, ra, factor);
+				Assert::IsTrue(approx_equal(expected, slerp_fast(qa, ra, factor), 5e-5f));
+				Assert::IsTrue(approx_equal(expected, slerp_fast(qa, -ra, factor), 5e-5f));
+				Assert::IsTrue(approx_equal(1.0f, len(slerp_fast(qa, ra, factor)), 5e-5f));
+			}
+		}
+	}
+
 	TEST_METHOD(static_members)
 	{
 		Assert::AreEqual(quat(1, 0, 0, 0), quat::i);
@@ -0,0 +1,251 @@
+#include "math/vector_soa.h"
+
+#include <algorithm>
+#include <cstdint>
+#include "kernels.h"
+
+
+namespace {
+
+size_t padded(size_t size) noexcept
+{
+	return (size + math::soa_block_size - 1) / math::soa_block_size * math::soa_block_size;
+}
+
+} // namespace
+
+
+namespace math {
+namespace detail {
+
+soa_buffer::soa_buffer(size_t component_count) noexcept
+	: component_count_(component_count)
+{
+	assert(0 < component_count && component_count <= 4);
+}
+
+soa_buffer::soa_buffer(size_t component_count, size_t size)
+	: soa_buffer(component_count)
+{
+	resize(size);
+}
+
+soa_buffer::soa_buffer(const soa_buffer& b)
+	: soa_buffer(b.component_count_, b.size_)
+{
+	for (size_t c = 0; c < component_count_; ++c)
+		std::copy(b.components_[c], b.components_[c] + size_, components_[c]);
+}
+
+soa_buffer::soa_buffer(soa_buffer&& b) noexcept
+	: memory_(std::move(b.memory_)),
+	component_count_(b.component_count_),
+	size_(b.size_),
+	padded_size_(b.padded_size_)
+{
+	std::copy(b.components_, b.components_ + 4, components_);
+	std::fill(b.components_, b.components_ + 4, nullptr);
+	b.size_ = 0;
+	b.padded_size_ = 0;
+}
+
+soa_buffer& soa_buffer::operator=(const soa_buffer& b)
+{
+	if (this == &b) return *this;
+
+	soa_buffer tmp(b);
+	*this = std::move(tmp);
+	return *this;
+}
+
+soa_buffer& soa_buffer::operator=(soa_buffer&& b) noexcept
+{
+	if (this == &b) return *this;
+
+	memory_ = std::move(b.memory_);
+	std::copy(b.components_, b.components_ + 4, components_);
+	component_count_ = b.component_count_;
+	size_ = b.size_;
+	padded_size_ = b.padded_size_;
+
+	std::fill(b.components_, b.components_ + 4, nullptr);
+	b.size_ = 0;
+	b.padded_size_ = 0;
+	return *this;
+}
+
+void soa_buffer::resize(size_t size)
+{
+	const size_t padded_size = padded(size);
+	if (padded_size == padded_size_) {
+		// the padding may hold garbage, the new elements must be zeros.
+		for (size_t c = 0; c < component_count_; ++c)
+			std::fill(components_[c] + std::min(size_, size), components_[c] + padded_size, 0.0f);
+
+		size_ = size;
+		return;
+	}
+
+	// new[] does not guarantee soa_alignment, the memory is aligned manually.
+	std::unique_ptr<float[]> memory(new float[component_count_ * padded_size + soa_block_size]());
+	const uintptr_t addr = reinterpret_cast<uintptr_t>(memory.get());
+	float* aligned = reinterpret_cast<float*>((addr + soa_alignment - 1) & ~uintptr_t(soa_alignment - 1));
+
+	float* components[4] = {};
+	const size_t keep_size = std::min(size_, size);
+	for (size_t c = 0; c < component_count_; ++c) {
+		components[c] = aligned + c * padded_size;
+		if (keep_size > 0)
+			std::copy(components_[c], components_[c] + keep_size, components[c]);
+	}
+
+	memory_ = std::move(memory);
+	std::copy(components, components + 4, components_);
+	size_ = size;
+	padded_size_ = padded_size;
+}
+
+} // namespace detail
+
+
+float3_soa::float3_soa(const float3* v, size_t count)
+	: buffer_(3, count)
+{
+	aos_to_soa(v, *this);
+}
+
+float4_soa::float4_soa(const float4* v, size_t count)
+	: buffer_(4, count)
+{
+	aos_to_soa(v, *this);
+}
+
+
+void aos_to_soa(const float3* v, float3_soa& out) noexcept
+{
+	assert(out.size() == 0 || v);
+	active_kernels().aos_to_soa(reinterpret_cast<const float*>(v), 3, out.components(), out.size());
+}
+
+void aos_to_soa(const float4* v, float4_soa& out) noexcept
+{
+	assert(out.size() == 0 || v);
+	active_kernels().aos_to_soa(reinterpret_cast<const float*>(v), 4, out.components(), out.size());
+}
+
+void soa_to_aos(const float3_soa& v, float3* out) noexcept
+{
+	assert(v.size() == 0 || out);
+	active_kernels().soa_to_aos(v.components(), 3, reinterpret_cast<float*>(out), v.size());
+}
+
+void soa_to_aos(const float4_soa& v, float4* out) noexcept
+{
+	assert(v.size() == 0 || out);
+	active_kernels().soa_to_aos(v.components(), 4, reinterpret_cast<float*>(out), v.size());
+}
+
+void clamp(const float3_soa& v, const float3& lo, const float3& hi, float3_soa& out) noexcept
+{
+	assert(v.size() == out.size());
+	assert(lo.x <= hi.x && lo.y <= hi.y && lo.z <= hi.z);
+
+	const kernel_table& k = active_kernels();
+	k.clamp_soa(v.x(), lo.x, hi.x, out.x(), v.size());
+	k.clamp_soa(v.y(), lo.y, hi.y, out.y(), v.size());
+	k.clamp_soa(v.z(), lo.z, hi.z, out.z(), v.size());
+}
+
+void clamp(const float4_soa& v, const float4& lo, const float4& hi, float4_soa& out) noexcept
+{
+	assert(v.size() == out.size());
+	assert(lo.x <= hi.x && lo.y <= hi.y && lo.z <= hi.z && lo.w <= hi.w);
+
+	const kernel_table& k = active_kernels();
+	k.clamp_soa(v.x(), lo.x, hi.x, out.x(), v.size());
+	k.clamp_soa(v.y(), lo.y, hi.y, out.y(), v.size());
+	k.clamp_soa(v.z(), lo.z, hi.z, out.z(), v.size());
+	k.clamp_soa(v.w(), lo.w, hi.w, out.w(), v.size());
+}
+
+void cross(const float3_soa& l, const float3_soa& r, float3_soa& out) noexcept
+{
+	assert(l.size() == r.size());
+	assert(l.size() == out.size());
+	active_kernels().cross_soa(l.components(), r.components(), out.components(), l.size());
+}
+
+void dot(const float3_soa& l, const float3_soa& r, float* out) noexcept
+{
+	assert(l.size() == r.size());
+	assert(l.size() == 0 || out);
+	active_kernels().dot_soa(l.components(), r.components(), 3, out, l.size());
+}
+
+void dot(const float4_soa& l, const float4_soa& r, float* out) noexcept
+{
+	assert(l.size() == r.size());
+	assert(l.size() == 0 || out);
+	active_kernels().dot_soa(l.components(), r.components(), 4, out, l.size());
+}
+
+void len(const float3_soa& v, float* out) noexcept
+{
+	assert(v.size() == 0 || out);
+	active_kernels().len_soa(v.components(), 3, out, v.size());
+}
+
+void len(const float4_soa& v, float* out) noexcept
+{
+	assert(v.size() == 0 || out);
+	active_kernels().len_soa(v.components(), 4, out, v.size());
+}
+
+void lerp(const float3_soa& l, const float3_soa& r, float factor, float3_soa& out) noexcept
+{
+	assert(l.size() == r.size());
+	assert(l.size() == out.size());
+	assert(0.0f <= factor && factor <= 1.0f);
+
+	const kernel_table& k = active_kernels();
+	k.lerp_soa(l.x(), r.x(), factor, out.x(), l.size());
+	k.lerp_soa(l.y(), r.y(), factor, out.y(), l.size());
+	k.lerp_soa(l.z(), r.z(), factor, out.z(), l.size());
+}
+
+void lerp(const float4_soa& l, const float4_soa& r, float factor, float4_soa& out) noexcept
+{
+	assert(l.size() == r.size());
+	assert(l.size() == out.size());
+	assert(0.0f <= factor && factor <= 1.0f);
+
+	const kernel_table& k = active_kernels();
+	k.lerp_soa(l.x(), r.x(), factor, out.x(), l.size());
+	k.lerp_soa(l.y(), r.y(), factor, out.y(), l.size());
+	k.lerp_soa(l.z(), r.z(), factor, out.z(), l.size());
+	k.lerp_soa(l.w(), r.w(), factor, out.w(), l.size());
+}
+
+void normalize(const float3_soa& v, float3_soa& out) noexcept
+{
+	assert(v.size() == out.size());
+	active_kernels().normalize_soa(v.components(), 3, out.components(), v.size());
+}
+
+void normalize(const float4_soa& v, float4_soa& out) noexcept
+{
+	assert(v.size() == out.size());
+	active_kernels().normalize_soa(v.components(), 4, out.components(), v.size());
+}
+
+void saturate(const float3_soa& v, float3_soa& out) noexcept
+{
+	clamp(v, float3::zero, float3::unit_xyz, out);
+}
+
+void saturate(const float4_soa& v, float4_soa& out) noexcept
+{
+	clamp(v, float4::zero, float4::unit_xyzw, out);
+}
+
+} // namespace math
@@ -0,0 +1,133 @@
+#include "math/vector_soa.h"
+
+#include <vector>
+#include "benchmark.h"
+
+using math::float3;
+using math::float3_soa;
+using math::float4;
+using math::float4_soa;
+
+
+namespace {
+
+// Measures func(l, r, out) for the streams of state.size() values.
+template<typename S, typename T, typename Func>
+void bench_soa(benchmark::state& state, Func func)
+{
+	const std::vector<T> lv = benchmark::random_values<T>(state.size(), -1.0f, 1.0f, 1);
+	const std::vector<T> rv = benchmark::random_values<T>(state.size(), -1.0f, 1.0f, 2);
+	const S l(lv.data(), lv.size());
+	const S r(rv.data(), rv.size());
+	S out(state.size());
+	std::vector<float> fout(state.size());
+
+	while (state.keep_running()) {
+		func(l, r, out, fout.data());
+		benchmark::clobber_memory();
+	}
+}
+
+template<typename S, typename T>
+void bench_aos_to_soa(benchmark::state& state)
+{
+	const std::vector<T> v = benchmark::random_values<T>(state.size(), -1.0f, 1.0f, 1);
+	S out(state.size());
+
+	while (state.keep_running()) {
+		math::aos_to_soa(v.data(), out);
+		benchmark::clobber_memory();
+	}
+}
+
+template<typename S, typename T>
+void bench_soa_to_aos(benchmark::state& state)
+{
+	const std::vector<T> v = benchmark::random_values<T>(state.size(), -1.0f, 1.0f, 1);
+	const S s(v.data(), v.size());
+	std::vector<T> out(state.size());
+
+	while (state.keep_running()) {
+		math::soa_to_aos(s, out.data());
+		benchmark::clobber_memory();
+	}
+}
+
+
+void aos_to_soa_float3(benchmark::state& state) { bench_aos_to_soa<float3_soa, float3>(state); }
+BENCHMARK(aos_to_soa_float3);
+
+void aos_to_soa_float4(benchmark::state& state) { bench_aos_to_soa<float4_soa, float4>(state); }
+BENCHMARK(aos_to_soa_float4);
+
+void soa_to_aos_float3(benchmark::state& state) { bench_soa_to_aos<float3_soa, float3>(state); }
+BENCHMARK(soa_to_aos_float3);
+
+void soa_to_aos_float4(benchmark::state& state) { bench_soa_to_aos<float4_soa, float4>(state); }
+BENCHMARK(soa_to_aos_float4);
+
+void clamp_float3_soa(benchmark::state& state)
+{
+	bench_soa<float3_soa, float3>(state, [](const float3_soa& l, const float3_soa&, float3_soa& out, float*) {
+		math::clamp(l, float3(-0.5f), float3(0.5f), out);
+	});
+}
+BENCHMARK(clamp_float3_soa);
+
+void cross_float3_soa(benchmark::state& state)
+{
+	bench_soa<float3_soa, float3>(state, [](const float3_soa& l, const float3_soa& r, float3_soa& out, float*) {
+		math::cross(l, r, out);
+	});
+}
+BENCHMARK(cross_float3_soa);
+
+void dot_float3_soa(benchmark::state& state)
+{
+	bench_soa<float3_soa, float3>(state, [](const float3_soa& l, const float3_soa& r, float3_soa&, float* out) {
+		math::dot(l, r, out);
+	});
+}
+BENCHMARK(dot_float3_soa);
+
+void dot_float4_soa(benchmark::state& state)
+{
+	bench_soa<float4_soa, float4>(state, [](const float4_soa& l, const float4_soa& r, float4_soa&, float* out) {
+		math::dot(l, r, out);
+	});
+}
+BENCHMARK(dot_float4_soa);
+
+void len_float3_soa(benchmark::state& state)
+{
+	bench_soa<float3_soa, float3>(state, [](const float3_soa& l, const float3_soa&, float3_soa&, float* out) {
+		math::len(l, out);
+	});
+}
+BENCHMARK(len_float3_soa);
+
+void lerp_float3_soa(benchmark::state& state)
+{
+	bench_soa<float3_soa, float3>(state, [](const float3_soa& l, const float3_soa& r, float3_soa& out, float*) {
+		math::lerp(l, r, 0.3f, out);
+	});
+}
+BENCHMARK(lerp_float3_soa);
+
+void normalize_float3_soa(benchmark::state& state)
+{
+	bench_soa<float3_soa, float3>(state, [](const float3_soa& l, const float3_soa&, float3_soa& out, float*) {
+		math::normalize(l, out);
+	});
+}
+BENCHMARK(normalize_float3_soa);
+
+void normalize_float4_soa(benchmark::state& state)
+{
+	bench_soa<float4_soa, float4>(state, [](const float4_soa& l, const float4_soa&, float4_soa& out, float*) {
+		math::normalize(l, out);
+	});
+}
+BENCHMARK(normalize_float4_soa);
+
+} // namespace
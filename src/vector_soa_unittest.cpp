@@ -0,0 +1,310 @@
+#include "math/vector_soa.h"
+
+#include <cstdint>
+#include <vector>
+#include "CppUnitTest.h"
+#include "test_utility.h"
+
+
+using math::float3;
+using math::float3_soa;
+using math::float4;
+using math::float4_soa;
+using unittest::test_value;
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+
+namespace Microsoft { namespace VisualStudio { namespace CppUnitTestFramework {
+
+template<> inline std::wstring ToString<math::float3>(const math::float3& t) { RETURN_WIDE_STRING(t); }
+template<> inline std::wstring ToString<math::float4>(const math::float4& t) { RETURN_WIDE_STRING(t); }
+
+}}} // namespace Microsoft::VisualStudio::CppUnitTestFramework
+
+
+namespace {
+
+// The sizes cover the empty stream, a stream shorter than a SIMD register and streams with tails.
+constexpr size_t test_sizes[] = { 0, 1, 5, 16, 17, 43 };
+
+bool near(float l, float r) noexcept
+{
+	return math::approx_equal(l, r, 1e-4f);
+}
+
+bool near(const float3& l, const float3& r) noexcept
+{
+	return near(l.x, r.x) && near(l.y, r.y) && near(l.z, r.z);
+}
+
+bool near(const float4& l, const float4& r) noexcept
+{
+	return near(l.x, r.x) && near(l.y, r.y) && near(l.z, r.z) && near(l.w, r.w);
+}
+
+std::vector<float3> test_float3s(size_t count, size_t seed)
+{
+	std::vector<float3> v(count);
+	for (size_t i = 0; i < count; ++i)
+		v[i] = float3(test_value(i, seed, 2.0f), test_value(i, seed + 1, 2.0f), test_value(i, seed + 2, 2.0f));
+
+	return v;
+}
+
+std::vector<float4> test_float4s(size_t count, size_t seed)
+{
+	std::vector<float4> v(count);
+	for (size_t i = 0; i < count; ++i)
+		v[i] = float4(test_value(i, seed, 2.0f), test_value(i, seed + 1, 2.0f),
+			test_value(i, seed + 2, 2.0f), test_value(i, seed + 3, 2.0f));
+
+	return v;
+}
+
+} // namespace
+
+
+namespace unittest {
+
+TEST_CLASS(math_float3_soa) {
+public:
+
+	TEST_METHOD(ctors)
+	{
+		const float3_soa s0;
+		Assert::AreEqual(size_t(0), s0.size());
+
+		const float3_soa s1(21);
+		Assert::AreEqual(size_t(21), s1.size());
+		for (size_t i = 0; i < s1.size(); ++i)
+			Assert::AreEqual(float3::zero, s1.get(i));
+
+		// component arrays are aligned
+		Assert::AreEqual(uintptr_t(0), reinterpret_cast<uintptr_t>(s1.x()) % math::soa_alignment);
+		Assert::AreEqual(uintptr_t(0), reinterpret_cast<uintptr_t>(s1.y()) % math::soa_alignment);
+		Assert::AreEqual(uintptr_t(0), reinterpret_cast<uintptr_t>(s1.z()) % math::soa_alignment);
+
+		const std::vector<float3> v = test_float3s(21, 1);
+		const float3_soa s2(v.data(), v.size());
+		Assert::AreEqual(v.size(), s2.size());
+		for (size_t i = 0; i < v.size(); ++i)
+			Assert::AreEqual(v[i], s2.get(i));
+
+		// copy
+		float3_soa s3 = s2;
+		Assert::AreEqual(s2.size(), s3.size());
+		for (size_t i = 0; i < v.size(); ++i)
+			Assert::AreEqual(v[i], s3.get(i));
+
+		// move
+		float3_soa s4 = std::move(s3);
+		Assert::AreEqual(size_t(0), s3.size());
+		Assert::AreEqual(v.size(), s4.size());
+		for (size_t i = 0; i < v.size(); ++i)
+			Assert::AreEqual(v[i], s4.get(i));
+
+		s3 = s4;
+		Assert::AreEqual(v.size(), s3.size());
+		Assert::AreEqual(v[7], s3.get(7));
+	}
+
+	TEST_METHOD(get_set_resize)
+	{
+		float3_soa s;
+		s.resize(3);
+		s.set(0, float3(1, 2, 3));
+		s.set(2, float3(4, 5, 6));
+		Assert::AreEqual(float3(1, 2, 3), s.get(0));
+		Assert::AreEqual(float3::zero, s.get(1));
+		Assert::AreEqual(float3(4, 5, 6), s.get(2));
+		Assert::AreEqual(1.0f, s.x()[0]);
+		Assert::AreEqual(5.0f, s.y()[2]);
+
+		s.resize(40);
+		Assert::AreEqual(size_t(40), s.size());
+		Assert::AreEqual(float3(1, 2, 3), s.get(0));
+		Assert::AreEqual(float3(4, 5, 6), s.get(2));
+		for (size_t i = 3; i < s.size(); ++i)
+			Assert::AreEqual(float3::zero, s.get(i));
+
+		s.resize(1);
+		s.resize(3);
+		Assert::AreEqual(float3(1, 2, 3), s.get(0));
+		Assert::AreEqual(float3::zero, s.get(2));
+	}
+
+	TEST_METHOD(aos_soa_transpose)
+	{
+		for_each_isa_level([] {
+			for (size_t size : test_sizes) {
+				const std::vector<float3> v = test_float3s(size, 4);
+
+				float3_soa s(size);
+				math::aos_to_soa(v.data(), s);
+				for (size_t i = 0; i < size; ++i)
+					Assert::AreEqual(v[i], s.get(i));
+
+				std::vector<float3> out(size + 1, float3(7.0f));
+				math::soa_to_aos(s, out.data());
+				for (size_t i = 0; i < size; ++i)
+					Assert::AreEqual(v[i], out[i]);
+
+				Assert::AreEqual(float3(7.0f), out[size]);
+			}
+		});
+	}
+
+	TEST_METHOD(batch_funcs)
+	{
+		for_each_isa_level([] {
+			for (size_t size : test_sizes) {
+				std::vector<float3> lv = test_float3s(size, 7);
+				const std::vector<float3> rv = test_float3s(size, 10);
+				if (size > 2) {
+					lv[0] = float3::zero;
+					lv[1] = float3::unit_z;
+				}
+
+				const float3_soa l(lv.data(), size);
+				const float3_soa r(rv.data(), size);
+				float3_soa out(size);
+				std::vector<float> fout(size + 1, 7.0f);
+
+				math::clamp(l, float3(-1, -0.5f, 0), float3(1, 0.5f, 1.5f), out);
+				for (size_t i = 0; i < size; ++i)
+					Assert::AreEqual(math::clamp(lv[i], float3(-1, -0.5f, 0), float3(1, 0.5f, 1.5f)), out.get(i));
+
+				math::cross(l, r, out);
+				for (size_t i = 0; i < size; ++i)
+					Assert::IsTrue(near(math::cross(lv[i], rv[i]), out.get(i)));
+
+				math::dot(l, r, fout.data());
+				for (size_t i = 0; i < size; ++i)
+					Assert::IsTrue(near(math::dot(lv[i], rv[i]), fout[i]));
+				Assert::AreEqual(7.0f, fout[size]);
+
+				math::len(l, fout.data());
+				for (size_t i = 0; i < size; ++i)
+					Assert::IsTrue(near(math::len(lv[i]), fout[i]));
+				Assert::AreEqual(7.0f, fout[size]);
+
+				math::lerp(l, r, 0.3f, out);
+				for (size_t i = 0; i < size; ++i)
+					Assert::IsTrue(near(math::lerp(lv[i], rv[i], 0.3f), out.get(i)));
+
+				math::normalize(l, out);
+				for (size_t i = 0; i < size; ++i)
+					Assert::IsTrue(near(math::normalize(lv[i]), out.get(i)));
+
+				math::saturate(l, out);
+				for (size_t i = 0; i < size; ++i)
+					Assert::AreEqual(math::saturate(lv[i]), out.get(i));
+
+				// in place
+				float3_soa inout = l;
+				math::normalize(inout, inout);
+				for (size_t i = 0; i < size; ++i)
+					Assert::IsTrue(near(math::normalize(lv[i]), inout.get(i)));
+			}
+		});
+	}
+};
+
+TEST_CLASS(math_float4_soa) {
+public:
+
+	TEST_METHOD(ctors)
+	{
+		const float4_soa s0;
+		Assert::AreEqual(size_t(0), s0.size());
+
+		const float4_soa s1(35);
+		Assert::AreEqual(size_t(35), s1.size());
+		for (size_t i = 0; i < s1.size(); ++i)
+			Assert::AreEqual(float4::zero, s1.get(i));
+
+		Assert::AreEqual(uintptr_t(0), reinterpret_cast<uintptr_t>(s1.x()) % math::soa_alignment);
+		Assert::AreEqual(uintptr_t(0), reinterpret_cast<uintptr_t>(s1.w()) % math::soa_alignment);
+
+		const std::vector<float4> v = test_float4s(35, 1);
+		const float4_soa s2(v.data(), v.size());
+		Assert::AreEqual(v.size(), s2.size());
+		for (size_t i = 0; i < v.size(); ++i)
+			Assert::AreEqual(v[i], s2.get(i));
+
+		float4_soa s3 = s2;
+		s3.set(4, float4(1, 2, 3, 4));
+		Assert::AreEqual(float4(1, 2, 3, 4), s3.get(4));
+		Assert::AreEqual(v[4], s2.get(4));
+	}
+
+	TEST_METHOD(aos_soa_transpose)
+	{
+		for_each_isa_level([] {
+			for (size_t size : test_sizes) {
+				const std::vector<float4> v = test_float4s(size, 4);
+
+				float4_soa s(size);
+				math::aos_to_soa(v.data(), s);
+				for (size_t i = 0; i < size; ++i)
+					Assert::AreEqual(v[i], s.get(i));
+
+				std::vector<float4> out(size + 1, float4(7.0f));
+				math::soa_to_aos(s, out.data());
+				for (size_t i = 0; i < size; ++i)
+					Assert::AreEqual(v[i], out[i]);
+
+				Assert::AreEqual(float4(7.0f), out[size]);
+			}
+		});
+	}
+
+	TEST_METHOD(batch_funcs)
+	{
+		for_each_isa_level([] {
+			for (size_t size : test_sizes) {
+				std::vector<float4> lv = test_float4s(size, 7);
+				const std::vector<float4> rv = test_float4s(size, 11);
+				if (size > 2) {
+					lv[0] = float4::zero;
+					lv[1] = float4::unit_w;
+				}
+
+				const float4_soa l(lv.data(), size);
+				const float4_soa r(rv.data(), size);
+				float4_soa out(size);
+				std::vector<float> fout(size + 1, 7.0f);
+
+				const float4 lo(-1, -0.5f, 0, 0.5f);
+				const float4 hi(1, 0.5f, 1.5f, 0.5f);
+				math::clamp(l, lo, hi, out);
+				for (size_t i = 0; i < size; ++i)
+					Assert::AreEqual(math::clamp(lv[i], lo, hi), out.get(i));
+
+				math::dot(l, r, fout.data());
+				for (size_t i = 0; i < size; ++i)
+					Assert::IsTrue(near(math::dot(lv[i], rv[i]), fout[i]));
+				Assert::AreEqual(7.0f, fout[size]);
+
+				math::len(l, fout.data());
+				for (size_t i = 0; i < size; ++i)
+					Assert::IsTrue(near(math::len(lv[i]), fout[i]));
+				Assert::AreEqual(7.0f, fout[size]);
+
+				math::lerp(l, r, 0.75f, out);
+				for (size_t i = 0; i < size; ++i)
+					Assert::IsTrue(near(math::lerp(lv[i], rv[i], 0.75f), out.get(i)));
+
+				math::normalize(l, out);
+				for (size_t i = 0; i < size; ++i)
+					Assert::IsTrue(near(math::normalize(lv[i]), out.get(i)));
+
+				math::saturate(l, out);
+				for (size_t i = 0; i < size; ++i)
+					Assert::AreEqual(math::saturate(lv[i]), out.get(i));
+			}
+		});
+	}
+};
+
+} // namespace unittest
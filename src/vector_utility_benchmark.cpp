@@ -0,0 +1,289 @@
+#include "math/vector_utility.h"
+
+#include <random>
+#include <vector>
+#include "benchmark.h"
+
+using math::float2;
+using math::float3;
+using math::float4;
+using math::half4;
+using math::quat;
+using math::ubyte4;
+
+
+namespace benchmark {
+
+// Packed values are random bit patterns.
+template<>
+inline std::vector<uint32_t> inputs<uint32_t>(size_t count, float, float, uint32_t seed)
+{
+	std::mt19937 gen(seed);
+	std::vector<uint32_t> v(count);
+	for (uint32_t& u : v)
+		u = uint32_t(gen());
+
+	return v;
+}
+
+template<>
+inline std::vector<ubyte4> inputs<ubyte4>(size_t count, float, float, uint32_t seed)
+{
+	const std::vector<uint32_t> p = inputs<uint32_t>(count, 0.0f, 0.0f, seed);
+	std::vector<ubyte4> v(count);
+	for (size_t i = 0; i < count; ++i)
+		v[i] = math::unpack_8_8_8_8_into<ubyte4>(p[i]);
+
+	return v;
+}
+
+template<>
+inline std::vector<half4> inputs<half4>(size_t count, float lo, float hi, uint32_t seed)
+{
+	const std::vector<float4> f = random_values<float4>(count, lo, hi, seed);
+	std::vector<half4> v(count);
+	for (size_t i = 0; i < count; ++i)
+		v[i] = math::pack_half(f[i]);
+
+	return v;
+}
+
+} // namespace benchmark
+
+
+namespace {
+
+// Measures the batch pack function func(v, out, count).
+template<typename T, typename Func>
+void bench_pack_batch(benchmark::state& state, float lo, float hi, Func func)
+{
+	const std::vector<T> in = benchmark::random_values<T>(state.size(), lo, hi, 1);
+	std::vector<uint32_t> out(state.size());
+
+	while (state.keep_running()) {
+		func(in.data(), out.data(), state.size());
+		benchmark::clobber_memory();
+	}
+}
+
+// Measures the batch unpack function func(p, out, count).
+template<typename T, typename Func>
+void bench_unpack_batch(benchmark::state& state, Func func)
+{
+	const std::vector<uint32_t> in = benchmark::inputs<uint32_t>(state.size(), 0.0f, 0.0f, 1);
+	std::vector<T> out(state.size());
+
+	while (state.keep_running()) {
+		func(in.data(), out.data(), state.size());
+		benchmark::clobber_memory();
+	}
+}
+
+
+BENCHMARK_MAP(pack_half, half4, float4, -100.0f, 100.0f, math::pack_half(a));
+BENCHMARK_MAP(pack_into_8_8_8_8, uint32_t, ubyte4, 0.0f, 0.0f, math::pack_into_8_8_8_8(a));
+BENCHMARK_MAP(pack_octahedral_snorm_16_16, uint32_t, float3, -1.0f, 1.0f, math::pack_octahedral_snorm_16_16(a));
+BENCHMARK_MAP(pack_snorm_10_10_10_2, uint32_t, float4, -1.0f, 1.0f, math::pack_snorm_10_10_10_2(a));
+BENCHMARK_MAP(pack_unorm_10_10_10_2, uint32_t, float4, 0.0f, 1.0f, math::pack_unorm_10_10_10_2(a));
+BENCHMARK_MAP(pack_unorm_16_16, uint32_t, float2, 0.0f, 1.0f, math::pack_unorm_16_16(a));
+BENCHMARK_MAP(pack_unorm_8_8_8, uint32_t, float3, 0.0f, 1.0f, math::pack_unorm_8_8_8(a));
+BENCHMARK_MAP(pack_unorm_8_8_8_8, uint32_t, float4, 0.0f, 1.0f, math::pack_unorm_8_8_8_8(a));
+BENCHMARK_MAP(unpack_half, float4, half4, -100.0f, 100.0f, math::unpack_half(a));
+BENCHMARK_MAP(unpack_8_8_8_8_into, ubyte4, uint32_t, 0.0f, 0.0f, math::unpack_8_8_8_8_into<ubyte4>(a));
+BENCHMARK_MAP(unpack_octahedral_snorm_16_16, float3, uint32_t, 0.0f, 0.0f, math::unpack_octahedral_snorm_16_16(a));
+BENCHMARK_MAP(unpack_snorm_10_10_10_2, float4, uint32_t, 0.0f, 0.0f, math::unpack_snorm_10_10_10_2(a));
+BENCHMARK_MAP(unpack_unorm_10_10_10_2, float4, uint32_t, 0.0f, 0.0f, math::unpack_unorm_10_10_10_2(a));
+BENCHMARK_MAP(unpack_unorm_16_16, float2, uint32_t, 0.0f, 0.0f, math::unpack_unorm_16_16(a));
+BENCHMARK_MAP(unpack_unorm_8_8_8, float3, uint32_t, 0.0f, 0.0f, math::unpack_unorm_8_8_8(a));
+BENCHMARK_MAP(unpack_unorm_8_8_8_8, float4, uint32_t, 0.0f, 0.0f, math::unpack_unorm_8_8_8_8(a));
+
+// ----- batch functions -----
+
+void pack_half_batch(benchmark::state& state)
+{
+	const std::vector<float4> in = benchmark::random_values<float4>(state.size(), -100.0f, 100.0f, 1);
+	std::vector<half4> out(state.size());
+
+	while (state.keep_running()) {
+		math::pack_half(in.data(), out.data(), state.size());
+		benchmark::clobber_memory();
+	}
+}
+BENCHMARK(pack_half_batch);
+
+void pack_octahedral_snorm_16_16_batch(benchmark::state& state)
+{
+	bench_pack_batch<float3>(state, -1.0f, 1.0f,
+		[](const float3* v, uint32_t* out, size_t count) { math::pack_octahedral_snorm_16_16(v, out, count); });
+}
+BENCHMARK(pack_octahedral_snorm_16_16_batch);
+
+void pack_octahedral_unorm_8_8_batch(benchmark::state& state)
+{
+	const std::vector<float3> in = benchmark::random_values<float3>(state.size(), -1.0f, 1.0f, 1);
+	std::vector<uint16_t> out(state.size());
+
+	while (state.keep_running()) {
+		math::pack_octahedral_unorm_8_8(in.data(), out.data(), state.size());
+		benchmark::clobber_memory();
+	}
+}
+BENCHMARK(pack_octahedral_unorm_8_8_batch);
+
+void pack_snorm_10_10_10_2_batch(benchmark::state& state)
+{
+	bench_pack_batch<float4>(state, -1.0f, 1.0f,
+		[](const float4* v, uint32_t* out, size_t count) { math::pack_snorm_10_10_10_2(v, out, count); });
+}
+BENCHMARK(pack_snorm_10_10_10_2_batch);
+
+void pack_unorm_10_10_10_2_batch(benchmark::state& state)
+{
+	bench_pack_batch<float4>(state, 0.0f, 1.0f,
+		[](const float4* v, uint32_t* out, size_t count) { math::pack_unorm_10_10_10_2(v, out, count); });
+}
+BENCHMARK(pack_unorm_10_10_10_2_batch);
+
+void pack_unorm_16_16_batch(benchmark::state& state)
+{
+	bench_pack_batch<float2>(state, 0.0f, 1.0f,
+		[](const float2* v, uint32_t* out, size_t count) { math::pack_unorm_16_16(v, out, count); });
+}
+BENCHMARK(pack_unorm_16_16_batch);
+
+void pack_unorm_8_8_8_batch(benchmark::state& state)
+{
+	bench_pack_batch<float3>(state, 0.0f, 1.0f,
+		[](const float3* v, uint32_t* out, size_t count) { math::pack_unorm_8_8_8(v, out, count); });
+}
+BENCHMARK(pack_unorm_8_8_8_batch);
+
+void pack_unorm_8_8_8_8_batch(benchmark::state& state)
+{
+	bench_pack_batch<float4>(state, 0.0f, 1.0f,
+		[](const float4* v, uint32_t* out, size_t count) { math::pack_unorm_8_8_8_8(v, out, count); });
+}
+BENCHMARK(pack_unorm_8_8_8_8_batch);
+
+void unpack_octahedral_snorm_16_16_batch(benchmark::state& state)
+{
+	bench_unpack_batch<float3>(state,
+		[](const uint32_t* p, float3* out, size_t count) { math::unpack_octahedral_snorm_16_16(p, out, count); });
+}
+BENCHMARK(unpack_octahedral_snorm_16_16_batch);
+
+void unpack_octahedral_unorm_8_8_batch(benchmark::state& state)
+{
+	const std::vector<uint32_t> p = benchmark::inputs<uint32_t>(state.size(), 0.0f, 0.0f, 1);
+	const std::vector<uint16_t> in(p.begin(), p.end());
+	std::vector<float3> out(state.size());
+
+	while (state.keep_running()) {
+		math::unpack_octahedral_unorm_8_8(in.data(), out.data(), state.size());
+		benchmark::clobber_memory();
+	}
+}
+BENCHMARK(unpack_octahedral_unorm_8_8_batch);
+
+void unpack_snorm_10_10_10_2_batch(benchmark::state& state)
+{
+	bench_unpack_batch<float4>(state,
+		[](const uint32_t* p, float4* out, size_t count) { math::unpack_snorm_10_10_10_2(p, out, count); });
+}
+BENCHMARK(unpack_snorm_10_10_10_2_batch);
+
+void unpack_unorm_10_10_10_2_batch(benchmark::state& state)
+{
+	bench_unpack_batch<float4>(state,
+		[](const uint32_t* p, float4* out, size_t count) { math::unpack_unorm_10_10_10_2(p, out, count); });
+}
+BENCHMARK(unpack_unorm_10_10_10_2_batch);
+
+void unpack_unorm_16_16_batch(benchmark::state& state)
+{
+	bench_unpack_batch<float2>(state,
+		[](const uint32_t* p, float2* out, size_t count) { math::unpack_unorm_16_16(p, out, count); });
+}
+BENCHMARK(unpack_unorm_16_16_batch);
+
+void unpack_unorm_8_8_8_batch(benchmark::state& state)
+{
+	bench_unpack_batch<float3>(state,
+		[](const uint32_t* p, float3* out, size_t count) { math::unpack_unorm_8_8_8(p, out, count); });
+}
+BENCHMARK(unpack_unorm_8_8_8_batch);
+
+void unpack_unorm_8_8_8_8_batch(benchmark::state& state)
+{
+	bench_unpack_batch<float4>(state,
+		[](const uint32_t* p, float4* out, size_t count) { math::unpack_unorm_8_8_8_8(p, out, count); });
+}
+BENCHMARK(unpack_unorm_8_8_8_8_batch);
+
+void unpack_half_batch(benchmark::state& state)
+{
+	const std::vector<half4> in = benchmark::inputs<half4>(state.size(), -100.0f, 100.0f, 1);
+	std::vector<float4> out(state.size());
+
+	while (state.keep_running()) {
+		math::unpack_half(in.data(), out.data(), state.size());
+		benchmark::clobber_memory();
+	}
+}
+BENCHMARK(unpack_half_batch);
+
+// The 32-bit (10 bits per component) and 48-bit (15) encodings.
+
+void pack_smallest_three_32_batch(benchmark::state& state)
+{
+	const std::vector<quat> in = benchmark::random_unit_quat(state.size(), 1);
+	std::vector<uint32_t> out(state.size());
+
+	while (state.keep_running()) {
+		math::pack_smallest_three(in.data(), 10, out.data(), state.size());
+		benchmark::clobber_memory();
+	}
+}
+BENCHMARK(pack_smallest_three_32_batch);
+
+void pack_smallest_three_48_batch(benchmark::state& state)
+{
+	const std::vector<quat> in = benchmark::random_unit_quat(state.size(), 1);
+	std::vector<uint64_t> out(state.size());
+
+	while (state.keep_running()) {
+		math::pack_smallest_three(in.data(), 15, out.data(), state.size());
+		benchmark::clobber_memory();
+	}
+}
+BENCHMARK(pack_smallest_three_48_batch);
+
+void unpack_smallest_three_32_batch(benchmark::state& state)
+{
+	const std::vector<quat> q = benchmark::random_unit_quat(state.size(), 1);
+	std::vector<uint32_t> in(state.size());
+	math::pack_smallest_three(q.data(), 10, in.data(), state.size());
+	std::vector<quat> out(state.size());
+
+	while (state.keep_running()) {
+		math::unpack_smallest_three(in.data(), 10, out.data(), state.size());
+		benchmark::clobber_memory();
+	}
+}
+BENCHMARK(unpack_smallest_three_32_batch);
+
+void unpack_smallest_three_48_batch(benchmark::state& state)
+{
+	const std::vector<quat> q = benchmark::random_unit_quat(state.size(), 1);
+	std::vector<uint64_t> in(state.size());
+	math::pack_smallest_three(q.data(), 15, in.data(), state.size());
+	std::vector<quat> out(state.size());
+
+	while (state.keep_running()) {
+		math::unpack_smallest_three(in.data(), 15, out.data(), state.size());
+		benchmark::clobber_memory();
+	}
+}
+BENCHMARK(unpack_smallest_three_48_batch);
+
+} // namespace
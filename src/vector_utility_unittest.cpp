@@ -1,11 +1,22 @@
 #include "math/vector_utility.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
 #include <type_traits>
 #include "CppUnitTest.h"
 
 
+using math::float2;
 using math::float3;
 using math::float4;
+using math::half;
+using math::half2;
+using math::half3;
+using math::half4;
+using math::quat;
 using math::ubyte4;
 using math::uint3;
 using math::uint4;
@@ -14,6 +25,7 @@ using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
 namespace Microsoft { namespace VisualStudio { namespace CppUnitTestFramework {
 
+template<> inline std::wstring ToString<math::float2>(const math::float2& t) { RETURN_WIDE_STRING(t); }
 template<> inline std::wstring ToString<math::float3>(const math::float3& t) { RETURN_WIDE_STRING(t); }
 template<> inline std::wstring ToString<math::float4>(const math::float4& t) { RETURN_WIDE_STRING(t); }
 template<> inline std::wstring ToString<math::ubyte4>(const math::ubyte4& t) { RETURN_WIDE_STRING(t); }
@@ -23,6 +35,34 @@ template<> inline std::wstring ToString<math::uint4>(const math::uint4& t) { RET
 }}} // namespace Microsoft::VisualStudio::CppUnitTestFramework
 
 
+namespace {
+
+// Returns the angle between the vectors in degrees.
+double angle_deg(const float3& l, const float3& r) noexcept
+{
+	const double cx = double(l.y) * r.z - double(l.z) * r.y;
+	const double cy = double(l.z) * r.x - double(l.x) * r.z;
+	const double cz = double(l.x) * r.y - double(l.y) * r.x;
+	const double d = double(l.x) * r.x + double(l.y) * r.y + double(l.z) * r.z;
+	return std::atan2(std::sqrt(cx * cx + cy * cy + cz * cz), d) * 180.0 / 3.14159265358979323846;
+}
+
+// Returns the angle of the rotation from the one of l to the one of r in degrees.
+double angle_deg(const quat& l, const quat& r) noexcept
+{
+	// the angle between l and +-r on the 4d sphere is a half of the rotation angle.
+	const double d = double(l.x) * r.x + double(l.y) * r.y + double(l.z) * r.z + double(l.a) * r.a;
+	const double s = (d < 0.0) ? -1.0 : 1.0;
+	const double ex = l.x - s * r.x;
+	const double ey = l.y - s * r.y;
+	const double ez = l.z - s * r.z;
+	const double ea = l.a - s * r.a;
+	return 4.0 * std::asin(0.5 * std::sqrt(ex * ex + ey * ey + ez * ez + ea * ea)) * 180.0 / 3.14159265358979323846;
+}
+
+} // namespace
+
+
 namespace unittest {
 
 TEST_CLASS(math_vector_utility_funcs) {
@@ -195,6 +235,165 @@ public:
 			Assert::IsTrue(approx_equal(ue, u));
 		}
 	}
+
+	TEST_METHOD(float_to_half_and_back)
+	{
+		using math::pack_half;
+		using math::unpack_half;
+
+		struct test_data final {
+			float unpacked;
+			uint16_t packed;
+		};
+
+		const float inf = std::numeric_limits<float>::infinity();
+		const test_data list[] = {
+			{ 0.0f,							0x0000 },
+			{ -0.0f,						0x8000 },
+			{ 1.0f,							0x3c00 },
+			{ -2.0f,						0xc000 },
+			{ 0.333251953125f,				0x3555 },
+			{ 65504.0f,						0x7bff },	// the largest half
+			{ 6.103515625e-5f,				0x0400 },	// the smallest normal half, 2^-14
+			{ 5.9604644775390625e-8f,		0x0001 },	// the smallest subnormal half, 2^-24
+			{ -6.0975551605224609375e-5f,	0x83ff },	// the largest subnormal half
+			{ inf,							0x7c00 },
+			{ -inf,							0xfc00 }
+		};
+
+		for (const test_data& t : list) {
+			Assert::AreEqual(t.packed, pack_half(t.unpacked).bits);
+			Assert::AreEqual(t.unpacked, unpack_half(half(t.packed)));
+		}
+
+		// round to nearest even: 1 + 2^-11 is halfway between 1 and 1 + 2^-10.
+		Assert::AreEqual(uint16_t(0x3c00), pack_half(1.00048828125f).bits);
+		Assert::AreEqual(uint16_t(0x3c02), pack_half(1.00146484375f).bits);
+		Assert::AreEqual(uint16_t(0x3c01), pack_half(1.0005f).bits);
+		Assert::AreEqual(uint16_t(0x0000), pack_half(2.98023223876953125e-8f).bits);	// 2^-25
+		Assert::AreEqual(uint16_t(0x0002), pack_half(8.94069671630859375e-8f).bits);	// 3 * 2^-25
+		Assert::AreEqual(uint16_t(0x8000), pack_half(-1e-30f).bits);
+		// overflow
+		Assert::AreEqual(uint16_t(0x7bff), pack_half(65519.0f).bits);
+		Assert::AreEqual(uint16_t(0x7c00), pack_half(65520.0f).bits);
+		Assert::AreEqual(uint16_t(0xfc00), pack_half(-1e10f).bits);
+
+		// NaNs
+		Assert::IsTrue(std::isnan(unpack_half(pack_half(std::numeric_limits<float>::quiet_NaN()))));
+		Assert::IsTrue(std::isnan(unpack_half(half(0x7c01))));
+		// the payload 0x200000 of the signaling NaN is shifted to 0x100, the quiet bit is set.
+		Assert::AreEqual(uint16_t(0x7f00), pack_half(std::numeric_limits<float>::signaling_NaN()).bits);
+
+		// every half but NaNs survives the round trip, the NaNs become quiet ones.
+		for (uint32_t b = 0; b <= 0xffff; ++b) {
+			const half h(static_cast<uint16_t>(b));
+			const bool is_nan = ((b & 0x7c00) == 0x7c00) && ((b & 0x3ff) != 0);
+			Assert::AreEqual(uint16_t(is_nan ? (b | 0x200) : b), pack_half(unpack_half(h)).bits);
+		}
+
+		// vectors
+		Assert::IsTrue(half2(half(0x3c00), half(0xc000)) == pack_half(float2(1, -2)));
+		Assert::IsTrue(half3(half(0x3c00), half(0xc000), half(0x0000)) == pack_half(float3(1, -2, 0)));
+		Assert::IsTrue(half4(half(0x3c00), half(0xc000), half(0x0000), half(0x7bff)) == pack_half(float4(1, -2, 0, 65504)));
+		Assert::IsTrue(half4(half(0x3c00), half(0xc000), half(0x0000), half(0x7bff)) != pack_half(float4(1, -2, 0, 1)));
+		Assert::AreEqual(float2(1, -2), unpack_half(half2(half(0x3c00), half(0xc000))));
+		Assert::AreEqual(float3(1, -2, 0), unpack_half(half3(half(0x3c00), half(0xc000), half(0x0000))));
+		Assert::AreEqual(float4(1, -2, 0, 65504), unpack_half(half4(half(0x3c00), half(0xc000), half(0x0000), half(0x7bff))));
+	}
+
+	TEST_METHOD(octahedral)
+	{
+		using math::approx_equal;
+		using math::decode_octahedral;
+		using math::encode_octahedral;
+
+		// the upper half is the inner diamond, the lower one the corners.
+		Assert::AreEqual(float2(0, 0), encode_octahedral(float3::unit_z));
+		Assert::AreEqual(float2(1, 1), encode_octahedral(float3(0, 0, -1)));
+		// all 4 corners are -z, the signs of zero choose one.
+		Assert::AreEqual(float2(-1, -1), encode_octahedral(float3(-0.0f, -0.0f, -1)));
+		Assert::AreEqual(float2(1, 0), encode_octahedral(float3::unit_x));
+		Assert::AreEqual(float2(0, -1), encode_octahedral(-float3::unit_y));
+		Assert::IsTrue(approx_equal(float2(0.25f, -0.25f), encode_octahedral(float3(1, -1, 2))));
+		Assert::IsTrue(approx_equal(float2(0.75f, -0.75f), encode_octahedral(float3(1, -1, -2))));
+
+		Assert::AreEqual(float3::unit_z, decode_octahedral(float2(0, 0)));
+		Assert::AreEqual(-float3::unit_z, decode_octahedral(float2(-1, 1)));
+		Assert::AreEqual(float3::unit_x, decode_octahedral(float2(1, 0)));
+
+		Assert::AreEqual(uint32_t(0), math::pack_octahedral_snorm_16_16(float3::unit_z));
+		Assert::AreEqual(uint32_t(0x7fff'0000), math::pack_octahedral_snorm_16_16(float3::unit_x));
+		Assert::AreEqual(uint32_t(0x8001'0000), math::pack_octahedral_snorm_16_16(-float3::unit_x));
+		Assert::AreEqual(uint16_t(0x8080), math::pack_octahedral_unorm_8_8(float3::unit_z));
+		Assert::AreEqual(uint16_t(0xff80), math::pack_octahedral_unorm_8_8(float3::unit_x));
+		// -32768 is clamped to -1.
+		Assert::IsTrue(approx_equal(-float3::unit_x, math::unpack_octahedral_snorm_16_16(0x8000'0000)));
+
+		// the round trip errors over the points of the Fibonacci sphere.
+		const size_t count = 20000;
+		double max_error_16 = 0.0;
+		double max_error_8 = 0.0;
+		for (size_t i = 0; i < count; ++i) {
+			const double z = 1.0 - 2.0 * (double(i) + 0.5) / count;
+			const double r = std::sqrt(1.0 - z * z);
+			const double phi = 2.399963229728653 * double(i);
+			const float3 n = math::normalize(float3(float(r * std::cos(phi)), float(r * std::sin(phi)), float(z)));
+
+			Assert::IsTrue(approx_equal(n, decode_octahedral(encode_octahedral(n))));
+			// the encoding of non-unit vectors is the same.
+			Assert::IsTrue(approx_equal(encode_octahedral(n), encode_octahedral(3.0f * n)));
+
+			const float3 n16 = math::unpack_octahedral_snorm_16_16(math::pack_octahedral_snorm_16_16(n));
+			const float3 n8 = math::unpack_octahedral_unorm_8_8(math::pack_octahedral_unorm_8_8(n));
+			Assert::IsTrue(math::is_normalized(n16));
+			Assert::IsTrue(math::is_normalized(n8));
+			max_error_16 = std::max(max_error_16, angle_deg(n, n16));
+			max_error_8 = std::max(max_error_8, angle_deg(n, n8));
+		}
+
+		Assert::IsTrue(max_error_16 < 0.004);
+		Assert::IsTrue(max_error_8 < 0.96);
+	}
+
+	TEST_METHOD(smallest_three)
+	{
+		using math::pack_smallest_three;
+		using math::unpack_smallest_three;
+
+		// the largest component is the index 3, the others are zeros, i.e. the offset 511.
+		const uint64_t identity_10 = (uint64_t(3) << 30) | (511 << 20) | (511 << 10) | 511;
+		Assert::AreEqual(identity_10, pack_smallest_three(quat::identity, 10));
+		Assert::AreEqual(identity_10, pack_smallest_three(-quat::identity, 10));
+		Assert::AreEqual(quat::identity, unpack_smallest_three(identity_10, 10));
+
+		// the first of the equal components is dropped, 0.5 * sqrt(2) * 511 = 361.3.
+		Assert::AreEqual(uint64_t((872 << 20) | (872 << 10) | 872), pack_smallest_three(quat(0.5f, 0.5f, 0.5f, 0.5f), 10));
+		// the largest component is negative, the quaternion is negated.
+		Assert::AreEqual(uint64_t((150 << 20) | (150 << 10) | 150), pack_smallest_three(quat(-0.5f, 0.5f, 0.5f, 0.5f), 10));
+
+		std::mt19937 gen(7);
+		std::normal_distribution<float> dist;
+		const uint32_t bits_list[] = { 4, 10, 15, 20 };
+		const double max_errors[] = { 20.0, 0.26, 0.008, 0.0005 };
+		double errors[4] = { 0.0, 0.0, 0.0, 0.0 };
+		for (size_t i = 0; i < 20000; ++i) {
+			const quat q = math::normalize(quat(dist(gen), dist(gen), dist(gen), dist(gen)));
+
+			for (size_t b = 0; b < 4; ++b) {
+				const uint32_t bits = bits_list[b];
+				const uint64_t p = pack_smallest_three(q, bits);
+				Assert::IsTrue(p < (uint64_t(1) << (2 + 3 * bits)));
+				Assert::AreEqual(p, pack_smallest_three(-q, bits));
+
+				const quat r = unpack_smallest_three(p, bits);
+				Assert::IsTrue(math::is_normalized(r, 1e-5f));
+				errors[b] = std::max(errors[b], angle_deg(q, r));
+			}
+		}
+
+		for (size_t b = 0; b < 4; ++b)
+			Assert::IsTrue(errors[b] < max_errors[b]);
+	}
 };
 
 } // namespace unittest
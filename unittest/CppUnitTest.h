@@ -0,0 +1,204 @@
+#ifndef MATH_UNITTEST_CPP_UNIT_TEST_H_
+#define MATH_UNITTEST_CPP_UNIT_TEST_H_
+
+// A minimal, source compatible subset of the Microsoft native unit test framework (CppUnitTest.h).
+// It lets the unittests from src/*_unittest.cpp be built and run on platforms without Visual Studio.
+// See unittest_main.cpp for the test runner.
+
+#include <cmath>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+#define RETURN_WIDE_STRING(inputValue) \
+	{ std::wstringstream _s; _s << inputValue; return _s.str(); }
+
+#define MATH_UNITTEST_WIDEN_(s) L ## s
+#define MATH_UNITTEST_WSTRINGIZE_(s) MATH_UNITTEST_WIDEN_(#s)
+
+#define TEST_CLASS(className) \
+	class className; \
+	static const ::Microsoft::VisualStudio::CppUnitTestFramework::details::class_registrar<className> \
+		className##_registrar_(MATH_UNITTEST_WSTRINGIZE_(className)); \
+	class className final : public ::Microsoft::VisualStudio::CppUnitTestFramework::TestClass<className>
+
+#define TEST_METHOD(methodName) \
+	::Microsoft::VisualStudio::CppUnitTestFramework::details::method_registrar methodName##_registrar_ { \
+		this, MATH_UNITTEST_WSTRINGIZE_(methodName), \
+		[](::Microsoft::VisualStudio::CppUnitTestFramework::details::test_class_base* t) { \
+			static_cast<this_type*>(t)->methodName(); \
+		} \
+	}; \
+	void methodName()
+
+
+namespace Microsoft { namespace VisualStudio { namespace CppUnitTestFramework {
+
+// ----- ToString -----
+
+template<typename T>
+std::wstring ToString(const T& t);
+
+template<typename T>
+std::wstring ToString(const T* t) { RETURN_WIDE_STRING(static_cast<const void*>(t)); }
+
+template<typename T>
+std::wstring ToString(T* t) { RETURN_WIDE_STRING(static_cast<const void*>(t)); }
+
+template<> inline std::wstring ToString<bool>(const bool& t) { return t ? L"true" : L"false"; }
+template<> inline std::wstring ToString<char>(const char& t) { RETURN_WIDE_STRING(int(t)); }
+template<> inline std::wstring ToString<signed char>(const signed char& t) { RETURN_WIDE_STRING(int(t)); }
+template<> inline std::wstring ToString<unsigned char>(const unsigned char& t) { RETURN_WIDE_STRING(unsigned(t)); }
+template<> inline std::wstring ToString<short>(const short& t) { RETURN_WIDE_STRING(t); }
+template<> inline std::wstring ToString<unsigned short>(const unsigned short& t) { RETURN_WIDE_STRING(t); }
+template<> inline std::wstring ToString<int>(const int& t) { RETURN_WIDE_STRING(t); }
+template<> inline std::wstring ToString<unsigned int>(const unsigned int& t) { RETURN_WIDE_STRING(t); }
+template<> inline std::wstring ToString<long>(const long& t) { RETURN_WIDE_STRING(t); }
+template<> inline std::wstring ToString<unsigned long>(const unsigned long& t) { RETURN_WIDE_STRING(t); }
+template<> inline std::wstring ToString<long long>(const long long& t) { RETURN_WIDE_STRING(t); }
+template<> inline std::wstring ToString<unsigned long long>(const unsigned long long& t) { RETURN_WIDE_STRING(t); }
+template<> inline std::wstring ToString<float>(const float& t) { RETURN_WIDE_STRING(t); }
+template<> inline std::wstring ToString<double>(const double& t) { RETURN_WIDE_STRING(t); }
+template<> inline std::wstring ToString<wchar_t>(const wchar_t& t) { return std::wstring(1, t); }
+template<> inline std::wstring ToString<std::wstring>(const std::wstring& t) { return t; }
+template<> inline std::wstring ToString<std::string>(const std::string& t) { return std::wstring(t.begin(), t.end()); }
+
+
+// ----- Assert -----
+
+// Thrown by Assert on failure. The runner reports the message and moves on to the next test method.
+struct assert_failure final {
+	std::wstring message;
+};
+
+class Assert final {
+public:
+
+	Assert() = delete;
+
+
+	template<typename T>
+	static void AreEqual(const T& expected, const T& actual, const wchar_t* message = nullptr)
+	{
+		if (expected == actual) return;
+		fail(L"AreEqual", ToString(expected), ToString(actual), message);
+	}
+
+	static void AreEqual(float expected, float actual, float tolerance, const wchar_t* message = nullptr)
+	{
+		if (std::abs(expected - actual) <= tolerance) return;
+		fail(L"AreEqual", ToString(expected), ToString(actual), message);
+	}
+
+	static void AreEqual(double expected, double actual, double tolerance, const wchar_t* message = nullptr)
+	{
+		if (std::abs(expected - actual) <= tolerance) return;
+		fail(L"AreEqual", ToString(expected), ToString(actual), message);
+	}
+
+	template<typename T>
+	static void AreNotEqual(const T& not_expected, const T& actual, const wchar_t* message = nullptr)
+	{
+		if (!(not_expected == actual)) return;
+		fail(L"AreNotEqual", ToString(not_expected), ToString(actual), message);
+	}
+
+	static void IsTrue(bool condition, const wchar_t* message = nullptr)
+	{
+		if (condition) return;
+		fail(L"IsTrue", L"true", L"false", message);
+	}
+
+	static void IsFalse(bool condition, const wchar_t* message = nullptr)
+	{
+		if (!condition) return;
+		fail(L"IsFalse", L"false", L"true", message);
+	}
+
+	static void Fail(const wchar_t* message = nullptr)
+	{
+		throw assert_failure{ std::wstring(L"Fail ") + (message ? message : L"") };
+	}
+
+private:
+
+	static void fail(const wchar_t* what, const std::wstring& expected, const std::wstring& actual,
+		const wchar_t* message)
+	{
+		std::wstring m = std::wstring(what) + L" failed. Expected:<" + expected + L"> Actual:<" + actual + L">";
+		if (message) m += std::wstring(L" ") + message;
+		throw assert_failure{ std::move(m) };
+	}
+};
+
+
+// ----- test registration -----
+
+namespace details {
+
+class test_class_base;
+
+using test_method_func = void(*)(test_class_base*);
+using test_class_factory = test_class_base*(*)();
+
+struct test_method final {
+	const wchar_t* name;
+	test_method_func func;
+};
+
+struct test_class_info final {
+	const wchar_t* name;
+	test_class_factory factory;
+};
+
+class test_class_base {
+public:
+
+	virtual ~test_class_base() = default;
+
+
+	std::vector<test_method> methods;
+};
+
+struct method_registrar final {
+	method_registrar(test_class_base* owner, const wchar_t* name, test_method_func func)
+	{
+		owner->methods.push_back(test_method{ name, func });
+	}
+};
+
+// Returns every test class registered by the TEST_CLASS macro in the current executable.
+inline std::vector<test_class_info>& test_classes()
+{
+	static std::vector<test_class_info> list;
+	return list;
+}
+
+template<typename T>
+test_class_base* create_test_class()
+{
+	return new T();
+}
+
+template<typename T>
+struct class_registrar final {
+	explicit class_registrar(const wchar_t* name)
+	{
+		test_classes().push_back(test_class_info{ name, &create_test_class<T> });
+	}
+};
+
+} // namespace details
+
+template<typename T>
+class TestClass : public details::test_class_base {
+protected:
+
+	using this_type = T;
+};
+
+}}} // namespace Microsoft::VisualStudio::CppUnitTestFramework
+
+#endif // MATH_UNITTEST_CPP_UNIT_TEST_H_
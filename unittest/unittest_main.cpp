@@ -0,0 +1,44 @@
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include "CppUnitTest.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+
+// Runs every registered test method and reports failures.
+// An optional argument limits the run to test classes whose name contains it.
+int main(int argc, char* argv[])
+{
+	const std::string filter = (argc > 1) ? argv[1] : "";
+	const std::wstring wfilter(filter.begin(), filter.end());
+
+	size_t run_count = 0;
+	size_t failed_count = 0;
+
+	for (const details::test_class_info& tc : details::test_classes()) {
+		if (!wfilter.empty() && std::wstring(tc.name).find(wfilter) == std::wstring::npos) continue;
+
+		const std::unique_ptr<details::test_class_base> listing(tc.factory());
+		for (const details::test_method& tm : listing->methods) {
+			++run_count;
+
+			// Each method runs on a fresh instance of its test class.
+			const std::unique_ptr<details::test_class_base> instance(tc.factory());
+			try {
+				tm.func(instance.get());
+			}
+			catch (const assert_failure& f) {
+				++failed_count;
+				std::wcerr << L"FAILED " << tc.name << L"::" << tm.name << L": " << f.message << std::endl;
+			}
+			catch (const std::exception& e) {
+				++failed_count;
+				std::wcerr << L"FAILED " << tc.name << L"::" << tm.name << L": exception " << e.what() << std::endl;
+			}
+		}
+	}
+
+	std::wcout << run_count - failed_count << L" of " << run_count << L" test methods passed." << std::endl;
+	return (failed_count == 0) ? 0 : 1;
+}